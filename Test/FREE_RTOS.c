@@ -1,50 +1,63 @@
 #include "main.h"
 #include "cmsis_os.h"
+#include "stack_mon.h"
+#include "rt_stats.h"
+#include "dlog.h"
+#include "periodic.h"
+#include "free_rtos_graph.h"
+#include "board.h"
 #include <stdio.h>
 #include <string.h>
 
 // 핸들러 선언
 ADC_HandleTypeDef hadc1;
 UART_HandleTypeDef huart1;
-osThreadId ledTaskHandle;
-osThreadId uartTaskHandle;
-osThreadId adcTaskHandle;
 
-// 큐 핸들러
+// 주기 / 마감 (ms)
+#define LED_PERIOD_MS     500
+#define ADC_PERIOD_MS     100
+#define ADC_DEADLINE_MS   20
+#define ADC_POLL_MS       2     // 변환은 수십 us, 멈춘 ADC 때문에 주기를 놓치지 않게
+
+// 큐 핸들러 (free_rtos_graph.cpp 가 만듦)
 osMessageQId adcQueueHandle;
-osMessageQDef(adcQueue, 8, uint16_t);
+
+// 주기 태스크 통계
+static PeriodicTask ledPeriod;
+static PeriodicTask adcPeriod;
 
 // 태스크 선언
 void StartLedTask(void const * argument);
 void StartUartTask(void const * argument);
 void StartAdcTask(void const * argument);
+void StartMonitorTask(void const * argument);
 
 void SystemClock_Config(void);
-static void MX_GPIO_Init(void);
-static void MX_ADC1_Init(void);
-static void MX_USART1_UART_Init(void);
 
 int main(void)
 {
   HAL_Init();
   SystemClock_Config();
 
-  MX_GPIO_Init();
-  MX_ADC1_Init();
-  MX_USART1_UART_Init();
-
-  // RTOS 큐 생성
-  adcQueueHandle = osMessageCreate(osMessageQ(adcQueue), NULL);
+  // GPIO / USART1 / ADC1: board.hpp 설정을 레지스터로, HAL 핸들은 같은 설정으로 채우기만
+  Board_Init();
+  Board_BindHal(&huart1, &hadc1);
 
-  // RTOS 태스크 생성
-  osThreadDef(ledTask, StartLedTask, osPriorityLow, 0, 128);
-  ledTaskHandle = osThreadCreate(osThread(ledTask), NULL);
+  // RTOS 큐와 태스크: free_rtos_graph.cpp 의 그래프 (연결 검사는 빌드 때, 저장소는 정적)
+  TaskGraph_Create();
+  adcQueueHandle = TaskGraph_Queue(FRT_QUEUE_ADC);
 
-  osThreadDef(uartTask, StartUartTask, osPriorityNormal, 0, 128);
-  uartTaskHandle = osThreadCreate(osThread(uartTask), NULL);
+  // 스택 high-water 모니터, 실행 시간 통계 등록
+  RtStats_Init();
+  for (uint32_t i = 0; i < FRT_TASK_COUNT; i++)
+  {
+    StackMon_Register(TaskGraph_TaskName(i), TaskGraph_Thread(i), TaskGraph_StackWords(i));
+    RtStats_RegisterTask(TaskGraph_TaskName(i), TaskGraph_Thread(i));
+  }
 
-  osThreadDef(adcTask, StartAdcTask, osPriorityAboveNormal, 0, 128);
-  adcTaskHandle = osThreadCreate(osThread(adcTask), NULL);
+  // 주기 태스크: 틱 격자에 맞춰 깨우고 지터 / 응답 시간 / 마감 초과를 잰다
+  Periodic_Init(&ledPeriod, "led", LED_PERIOD_MS, LED_PERIOD_MS);
+  Periodic_Init(&adcPeriod, "adc", ADC_PERIOD_MS, ADC_DEADLINE_MS);
 
   // RTOS 시작
   osKernelStart();
@@ -56,22 +69,26 @@ void StartLedTask(void const * argument)
 {
   for(;;)
   {
+    Periodic_Wait(&ledPeriod);
     HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_13);
-    osDelay(500);
   }
 }
 
 void StartUartTask(void const * argument)
 {
-  char msg[64];
-  uint16_t adc_val;
+  osEvent evt;
 
   for(;;)
   {
-    if (osMessagePeek(adcQueueHandle, &adc_val, osWaitForever) == osOK)
+    // 1초 동안 쌓인 샘플을 다 꺼내고 가장 최근 것만 보냄
+    // (예전 osMessagePeek 은 큐를 비우지 않아서 첫 샘플만 계속 나가고 큐는 차서 버려졌음)
+    evt = osMessageGet(adcQueueHandle, osWaitForever);
+    if (evt.status == osEventMessage)
     {
-      sprintf(msg, "ADC: %u\r\n", adc_val);
-      HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
+      uint16_t adc_val = (uint16_t)evt.value.v;
+      while ((evt = osMessageGet(adcQueueHandle, 0)).status == osEventMessage)
+        adc_val = (uint16_t)evt.value.v;
+      DLOG("ADC: %u\r\n", adc_val);
     }
     osDelay(1000);
   }
@@ -83,57 +100,36 @@ void StartAdcTask(void const * argument)
 
   for(;;)
   {
+    // 실행 시간과 상관없이 100 ms 격자에서 샘플 (예전 osDelay(100) 은 주기가 실행 시간만큼 밀림)
+    Periodic_Wait(&adcPeriod);
     HAL_ADC_Start(&hadc1);
-    if (HAL_ADC_PollForConversion(&hadc1, HAL_MAX_DELAY) == HAL_OK)
+    if (HAL_ADC_PollForConversion(&hadc1, ADC_POLL_MS) == HAL_OK)
     {
       adc_val = HAL_ADC_GetValue(&hadc1);
-      osMessagePut(adcQueueHandle, adc_val, 10);
+      // 큐가 차 있으면 기다리지 않고 버림 (소비자 때문에 샘플 주기가 밀리지 않게)
+      osMessagePut(adcQueueHandle, adc_val, 0);
     }
     HAL_ADC_Stop(&hadc1);
-    osDelay(100);
   }
 }
 
-// --- 주변장치 초기화 ---
-
-static void MX_ADC1_Init(void)
-{
-  ADC_ChannelConfTypeDef sConfig = {0};
-  __HAL_RCC_ADC1_CLK_ENABLE();
-
-  hadc1.Instance = ADC1;
-  hadc1.Init.ScanConvMode = ADC_SCAN_DISABLE;
-  hadc1.Init.ContinuousConvMode = DISABLE;
-  hadc1.Init.DiscontinuousConvMode = DISABLE;
-  hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
-  hadc1.Init.NbrOfConversion = 1;
-  HAL_ADC_Init(&hadc1);
-
-  sConfig.Channel = ADC_CHANNEL_1;
-  sConfig.Rank = 1;
-  sConfig.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
-  HAL_ADC_ConfigChannel(&hadc1, &sConfig);
-}
-
-static void MX_USART1_UART_Init(void)
+// 1초마다 CPU 사용률 프레임과 로그 프레임, 5초마다 스택 / 주기 태스크 리포트
+void StartMonitorTask(void const * argument)
 {
-  __HAL_RCC_USART1_CLK_ENABLE();
-  huart1.Instance = USART1;
-  huart1.Init.BaudRate = 115200;
-  huart1.Init.WordLength = UART_WORDLENGTH_8B;
-  huart1.Init.StopBits = UART_STOPBITS_1;
-  huart1.Init.Parity = UART_PARITY_NONE;
-  huart1.Init.Mode = UART_MODE_TX_RX;
-  HAL_UART_Init(&huart1);
-}
+  uint32_t count = 0;
+  RtStats_ReportNames();
+  Periodic_ReportNames();
+  StackMon_ReportNames();
 
-static void MX_GPIO_Init(void)
-{
-  GPIO_InitTypeDef GPIO_InitStruct = {0};
-  __HAL_RCC_GPIOC_CLK_ENABLE();
-
-  GPIO_InitStruct.Pin = GPIO_PIN_13;
-  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
-  HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
+  for(;;)
+  {
+    osDelay(RT_STATS_PERIOD_MS);
+    RtStats_Report();
+    DLog_Flush();
+    if (++count % 5 == 0)
+    {
+      StackMon_Report();
+      Periodic_Report();
+    }
+  }
 }
@@ -1,11 +1,18 @@
 import speech_recognition as sr
 import paho.mqtt.client as mqtt
 import re
-from typing import Optional, Tuple
+import shutil
+import subprocess
+from typing import Iterator, Optional, Tuple
 
 TOPIC_IOT_ACTION_LED_ALL = "dsm/em/led/00"
 TOPIC_IOT_ACTION_LED_11 = "dsm/em/led.11"
 
+# host/vad.cpp 가 있으면 마이크를 계속 열어 두고 말이 끝나는 대로 구간 WAV 를 받아 인식
+# (없으면 예전처럼 adjust_for_ambient_noise + listen)
+VAD_BIN = "./vad"
+VAD_CMD = f"arecord -q -f S16_LE -r 16000 -c 1 | {VAD_BIN} -r 16000 -o /tmp/utt -"
+
 def parse_light_command(text: str) -> Tuple[Optional[str], Optional[int]]:
     light_keywords = ['조명', '등', '형광등', '밝기', '밝은', '어두운', '밝게', '어둡게']
 
@@ -25,6 +32,34 @@ def parse_light_command(text: str) -> Tuple[Optional[str], Optional[int]]:
     return command, option
 
 
+def vad_utterances(cmd: str = VAD_CMD) -> Iterator[str]:
+    """vad 의 stdout 을 읽어 구간 WAV 경로를 하나씩 돌려줌
+    start <n> <결정 s>                        말 시작
+    utt <n> <시작 s> <끝 s> <결정 s> <파일>   말 끝, 파일로 저장됨
+    """
+    proc = subprocess.Popen(cmd, shell=True, stdout=subprocess.PIPE, text=True, bufsize=1)
+    try:
+        for line in proc.stdout:
+            f = line.split()
+            if not f:
+                continue
+            if f[0] == "start":
+                print("듣는 중...")
+            elif f[0] == "utt" and len(f) >= 6:
+                yield f[5]
+    finally:
+        proc.terminate()
+
+
+def handle_text(text: str):
+    print(text)
+    command, option = parse_light_command(text)
+    if command == "led":
+        topic = TOPIC_IOT_ACTION_LED_ALL
+        cmqtt.publish(topic, option)
+    print(f"Command: {command}, Option: {option}")
+
+
 def on_connect(client, userdata, flags, reason_code):
     if reason_code != 0:
         raise SyntaxError("브로커에 접속할 수 없습니다.")
@@ -35,6 +70,17 @@ cmqtt.on_connect = on_connect
 cmqtt.connect("mqtt.eclipseprojects.io")
 
 
+if shutil.which(VAD_BIN):
+    print("말씀하세요...")
+    for path in vad_utterances():
+        with sr.AudioFile(path) as source:
+            audio = r.record(source)
+        try:
+            text = r.recognize_google(audio, language='ko-KR')
+        except sr.UnknownValueError:
+            continue
+        handle_text(text)
+
 while True:
     input("음성 인식을 시작할까요?")
     with sr.Microphone() as source:
@@ -44,9 +90,4 @@ while True:
         audio = r.listen(source, 5, 15)
 
     text = r.recognize_google(audio, language='ko-KR')
-    print(text)
-    command, option = parse_light_command(text)
-    if command == "led":
-        topic = TOPIC_IOT_ACTION_LED_ALL
-        cmqtt.publish(topic, option)
-    print(f"Command: {command}, Option: {option}")
\ No newline at end of file
+    handle_text(text)
\ No newline at end of file
@@ -0,0 +1,62 @@
+// board.cpp
+// C 펌웨어(sys.c 등)에서 부를 수 있는 BSP 진입점
+#include "board.hpp"
+#include "main.h"       // bsp.hpp 다음에 (HAL 매크로 이름이 겹침)
+#include "board.h"
+
+static_assert(Board::uarts[0].instance == 1 && Board::adcs[0].instance == 1,
+              "Board_BindHal 은 USART1 / ADC1 핸들만 채움");
+
+extern "C" void Board_Init(void)
+{
+    bsp::Init<Board>();
+}
+
+extern "C" void Board_BindHal(UART_HandleTypeDef *uart, ADC_HandleTypeDef *adc)
+{
+    if (uart) {
+        uart->Instance = USART1;
+        uart->Init.BaudRate = Board::uarts[0].baud;
+        uart->Init.WordLength = UART_WORDLENGTH_8B;
+        uart->Init.StopBits = UART_STOPBITS_1;
+        uart->Init.Parity = UART_PARITY_NONE;
+        uart->Init.Mode = UART_MODE_TX_RX;
+#ifndef HOST_BUILD
+        uart->Init.HwFlowCtl = UART_HWCONTROL_NONE;
+        uart->Init.OverSampling = UART_OVERSAMPLING_16;
+        uart->gState = HAL_UART_STATE_READY;
+        uart->RxState = HAL_UART_STATE_READY;
+#endif
+    }
+    if (adc) {
+        adc->Instance = ADC1;
+        adc->Init.ScanConvMode = ADC_SCAN_DISABLE;
+        adc->Init.ContinuousConvMode = DISABLE;
+        adc->Init.DiscontinuousConvMode = DISABLE;
+        adc->Init.DataAlign = ADC_DATAALIGN_RIGHT;
+        adc->Init.NbrOfConversion = 1;
+#ifndef HOST_BUILD
+        adc->Init.ExternalTrigConv = ADC_SOFTWARE_START;
+        adc->State = HAL_ADC_STATE_READY;
+#endif
+    }
+}
+
+extern "C" void Board_LedWrite(int on)
+{
+    // PC13 LED 는 active low
+    if (on)
+        Led::Reset();
+    else
+        Led::Set();
+}
+
+extern "C" void Board_UartWrite(const uint8_t *data, uint16_t len)
+{
+    Console::Write(data, len);
+}
+
+extern "C" uint16_t Board_AdcRead(void)
+{
+    return LightSensor::Read();
+}
@@ -0,0 +1,29 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// board.hpp 설정으로 클럭 게이트, GPIO, EXTI, USART1, ADC1 을 레지스터 직접 쓰기로 초기화
+// (SystemClock_Config 다음, MX_*_Init 대신 호출)
+void Board_Init(void);
+
+// HAL 을 계속 쓰는 코드(HAL_UART_Transmit, HAL_ADC_Start ..)를 위해 핸들을 Board_Init 과 같은 설정으로 채움.
+// 레지스터는 건드리지 않고 HAL_*_Init 도 부르지 않는다. 없는 쪽은 NULL.
+// main.h 다음에 포함했을 때만 보인다 (HAL 의 GPIOA / USART1 .. 매크로가 bsp.hpp 의 이름과 겹쳐서 끌어오지 않음)
+#if defined(MAIN_H) || defined(__MAIN_H)
+void Board_BindHal(UART_HandleTypeDef *uart, ADC_HandleTypeDef *adc);
+#endif
+
+void Board_LedWrite(int on);
+void Board_UartWrite(const uint8_t *data, uint16_t len);
+uint16_t Board_AdcRead(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+// board.hpp
+// 이 보드(STM32F103, 72 MHz)의 핀/주변장치 설정. sys.c, FREE_RTOS.c, maung.c, sub.c 의
+// MX_GPIO_Init / MX_ADC1_Init / MX_USART1_UART_Init 가 하던 일을 한 곳에 모은 것 (네 펌웨어 모두 Board_Init).
+// sub.c 만 쓰는 것 (PA0 버튼 EXTI, I2C1, TIM3, RTC, DMA) 은 sub.c 가 HAL 로 따로 켠다.
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include "bsp.hpp"
+#include "calib.hpp"
+#include "pwm_fade.hpp"
+
+struct Board {
+    static constexpr bsp::Clock clock = { 72000000u, 36000000u, 72000000u };
+
+    static constexpr std::array<bsp::Pin, 9> pins = {{
+        // PC13: LED (active low, 꺼진 상태로 시작)
+        { bsp::Port::C, 13, bsp::Mode::OutputPP, bsp::Speed::Mhz2, true },
+        // PA0: 버튼 (입력만, 인터럽트는 쓰는 펌웨어인 sub.c 의 Button_Init)
+        { bsp::Port::A, 0, bsp::Mode::Input },
+        // PA1: 조도 센서 (ADC1 채널 1)
+        { bsp::Port::A, 1, bsp::Mode::Analog },
+        // PA9 / PA10: USART1 TX / RX
+        { bsp::Port::A, 9, bsp::Mode::AltPP, bsp::Speed::Mhz50 },
+        { bsp::Port::A, 10, bsp::Mode::Input },
+        // LED PWM (TIM1): CH1 PA8, CH2N PB14, CH3N PB15, CH4 PA11. CH2/CH3 는 PA9/PA10 (USART1) 이라 N 쪽으로.
+        // CH4 는 이 패키지에서 PA11 에만 나오고 (N 출력 없음, 완전 리맵은 PE14 라 48 핀에 없음) PA11 은 USB DM.
+        // 이 펌웨어들은 USB 를 쓰지 않아서 PA11 을 LED 로 쓴다. USB 를 붙이면 이 핀을 빼고 led_pwm 의
+        // 4 번째 채널을 led::Out::None 으로 (LED 세 개)
+        { bsp::Port::A, 8, bsp::Mode::AltPP, bsp::Speed::Mhz2 },
+        { bsp::Port::B, 14, bsp::Mode::AltPP, bsp::Speed::Mhz2 },
+        { bsp::Port::B, 15, bsp::Mode::AltPP, bsp::Speed::Mhz2 },
+        { bsp::Port::A, 11, bsp::Mode::AltPP, bsp::Speed::Mhz2 },
+    }};
+
+    static constexpr std::array<bsp::Uart, 1> uarts = {{ { 1, 115200 } }};
+
+    // 71.5 사이클 (ADC_SAMPLETIME_71CYCLES_5)
+    static constexpr std::array<bsp::Adc, 1> adcs = {{ { 1, 1, 6 } }};
+
+    // VREFINT 공칭값 (F1 은 공장 보정값이 없음, 데이터시트 1.16 ~ 1.24 V)과 재기 전 가정하는 VDDA
+    static constexpr uint32_t vrefint_mv = 1200;
+    static constexpr uint32_t vdda_mv = 3300;
+
+    // PA1 조도 센서: 포토트랜지스터 + 10k 에미터 저항이라 전압이 VDDA 가 아니라 조도에 따라 정해짐.
+    // 벤치에서 잰 mV -> 밀리럭스. 어두운 쪽은 암전류, 3 V 위는 포화로 휘어 있다.
+    using LightGrid = cal::Grid<5, 4096>;       // 32 mV 간격, 129 칸
+    static constexpr std::array<cal::Point, 13> light_curve = {{
+        { 0, 0 },          { 25, 3000 },       { 100, 18000 },     { 250, 48000 },
+        { 500, 98000 },    { 1000, 205000 },   { 1500, 320000 },   { 2000, 450000 },
+        { 2500, 610000 },  { 2800, 760000 },   { 3000, 930000 },   { 3100, 1150000 },
+        { 3200, 1500000 },
+    }};
+
+    // LED 밝기 (pwm_fade): 16비트 PWM, 72 MHz / 65536 = 1.1 kHz. 단계 0~999 는 CIE L* 로 고르게
+    static constexpr led::Bank led_pwm = {
+        1, 5, 72000000u, 65535u, {{ led::Out::Main, led::Out::Comp, led::Out::Comp, led::Out::Main }}
+    };
+    static constexpr led::Curve led_curve = led::Curve::Cie;
+    static constexpr uint32_t led_gamma_x100 = 220;     // led_curve 가 Power 일 때
+};
+
+using Led = bsp::Gpio<bsp::Port::C, 13>;
+using Button = bsp::Gpio<bsp::Port::A, 0>;
+using Console = bsp::UartPort<1>;
+using LightSensor = bsp::AdcPort<1>;
+
+#endif
@@ -0,0 +1,82 @@
+#include "main.h"
+#include "boot_prof.h"
+#include "dlog.h"
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#endif
+
+static BootPhase phases[BOOT_PROF_MAX_PHASES];
+static uint8_t phase_count = 0;
+
+#ifndef HOST_BUILD
+static uint32_t last_cycles;
+static uint32_t last_hz;
+static uint64_t elapsed_us;
+#endif
+
+void BootProf_Start(void)
+{
+    phase_count = 0;
+#ifndef HOST_BUILD
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    last_cycles = 0;
+    last_hz = SystemCoreClock;      // 리셋 직후 HSI 8 MHz
+    elapsed_us = 0;
+#endif
+}
+
+uint32_t BootProf_NowUs(void)
+{
+#ifdef HOST_BUILD
+    return (uint32_t)HostOs_NowUs();
+#else
+    // 구간 시작 때의 클럭으로 환산 (SystemClock_Config 구간은 PLL 락 대기가 대부분 HSI 에서 돎)
+    uint32_t now = DWT->CYCCNT;
+    elapsed_us += (now - last_cycles) / (last_hz / 1000000u);
+    last_cycles = now;
+    last_hz = SystemCoreClock;
+    return (uint32_t)elapsed_us;
+#endif
+}
+
+void BootProf_Mark(const char *name)
+{
+    if (phase_count >= BOOT_PROF_MAX_PHASES)
+        return;
+    phases[phase_count].name = name;
+    phases[phase_count].end_us = BootProf_NowUs();
+    phase_count++;
+}
+
+uint32_t BootProf_At(const char *name)
+{
+    for (uint8_t i = 0; i < phase_count; i++) {
+        if (strcmp(phases[i].name, name) == 0)
+            return phases[i].end_us;
+    }
+    return 0;
+}
+
+int BootProf_Count(void)
+{
+    return phase_count;
+}
+
+const BootPhase *BootProf_Get(int index)
+{
+    return (index >= 0 && index < phase_count) ? &phases[index] : NULL;
+}
+
+int BootProf_LogPhase(int index)
+{
+    if (index < 0 || index >= phase_count)
+        return -1;
+    uint32_t prev = index ? phases[index - 1].end_us : 0;
+    DLOG("BOOT %u +%lu us @%lu us\r\n", (unsigned)index, (unsigned long)(phases[index].end_us - prev),
+         (unsigned long)phases[index].end_us);
+    return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef BOOT_PROF_H
+#define BOOT_PROF_H
+
+#include <stdint.h>
+
+// 부팅 단계별 시간 측정
+// BootProf_Start() 를 main 첫 줄에서 부르고 각 단계가 끝날 때 BootProf_Mark("이름")
+// 타깃은 DWT 사이클을 그 구간의 SystemCoreClock 으로 나눠 us 로 환산 (클럭 전환 구간 포함)
+
+#define BOOT_PROF_MAX_PHASES    12
+
+typedef struct {
+    const char *name;
+    uint32_t end_us;        // 리셋 후 누적 시간
+} BootPhase;
+
+void BootProf_Start(void);
+void BootProf_Mark(const char *name);
+uint32_t BootProf_NowUs(void);
+// name 단계가 끝난 시각, 없으면 0
+uint32_t BootProf_At(const char *name);
+int BootProf_Count(void);
+const BootPhase *BootProf_Get(int index);
+// 단계 하나의 "BOOT <index> +<구간> us @<누적> us" 를 DLOG 레코드로 (UART 를 기다리지 않음).
+// index 는 Mark 순서, 없으면 -1
+int BootProf_LogPhase(int index);
+
+#endif
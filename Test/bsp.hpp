@@ -0,0 +1,533 @@
+// bsp.hpp
+// 컴파일 타임 설정 기반 보드 지원 계층 (STM32F1)
+//
+// MX_GPIO_Init / MX_ADC1_Init / MX_USART1_UART_Init 처럼 HAL 구조체를 런타임에 채우는 대신
+// 보드 설정(board.hpp)을 constexpr 로 선언하면 레지스터 값이 컴파일 중에 계산되고
+// Init<Board>() 는 그 값을 레지스터에 바로 쓴다. 잘못된 조합은 static_assert 로 빌드가 깨진다.
+//
+// HOST_BUILD 에서는 레지스터 접근이 host/bsp_host.cpp 로 가서 쓰기 순서가 기록된다.
+#ifndef BSP_HPP
+#define BSP_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#ifdef HOST_BUILD
+#include <vector>
+#endif
+
+namespace bsp {
+
+// --- 레지스터 접근 ---
+namespace reg {
+#ifdef HOST_BUILD
+void Write(uint32_t addr, uint32_t value);
+void Write8(uint32_t addr, uint8_t value);
+uint32_t Read(uint32_t addr);
+
+// 호스트 백엔드: 접근 기록과 읽기 값 설정
+struct Access {
+    uint32_t addr;
+    uint32_t value;
+    uint8_t width;      // 1 또는 4
+    bool write;
+};
+const std::vector<Access> &Log();
+void ClearLog();
+void Preset(uint32_t addr, uint32_t value);
+#else
+inline void Write(uint32_t addr, uint32_t value) { *reinterpret_cast<volatile uint32_t*>(addr) = value; }
+inline void Write8(uint32_t addr, uint8_t value) { *reinterpret_cast<volatile uint8_t*>(addr) = value; }
+inline uint32_t Read(uint32_t addr) { return *reinterpret_cast<volatile uint32_t*>(addr); }
+#endif
+}
+
+// --- STM32F1 주소 ---
+namespace addr {
+constexpr uint32_t RCC         = 0x40021000;
+constexpr uint32_t RCC_AHBENR  = RCC + 0x14;
+constexpr uint32_t RCC_APB2ENR = RCC + 0x18;
+constexpr uint32_t RCC_APB1ENR = RCC + 0x1C;
+
+constexpr uint32_t GPIOA = 0x40010800;
+constexpr uint32_t GPIO_STRIDE = 0x400;
+constexpr uint32_t GPIO_CRL  = 0x00;
+constexpr uint32_t GPIO_CRH  = 0x04;
+constexpr uint32_t GPIO_IDR  = 0x08;
+constexpr uint32_t GPIO_ODR  = 0x0C;
+constexpr uint32_t GPIO_BSRR = 0x10;
+
+constexpr uint32_t AFIO_EXTICR1 = 0x40010008;
+constexpr uint32_t EXTI      = 0x40010400;
+constexpr uint32_t EXTI_IMR  = EXTI + 0x00;
+constexpr uint32_t EXTI_RTSR = EXTI + 0x08;
+constexpr uint32_t EXTI_FTSR = EXTI + 0x0C;
+
+constexpr uint32_t NVIC_ISER = 0xE000E100;
+constexpr uint32_t NVIC_IPR  = 0xE000E400;
+
+constexpr uint32_t USART_SR  = 0x00;
+constexpr uint32_t USART_DR  = 0x04;
+constexpr uint32_t USART_BRR = 0x08;
+constexpr uint32_t USART_CR1 = 0x0C;
+
+constexpr uint32_t ADC_SR    = 0x00;
+constexpr uint32_t ADC_CR2   = 0x08;
+constexpr uint32_t ADC_SMPR1 = 0x0C;
+constexpr uint32_t ADC_SMPR2 = 0x10;
+constexpr uint32_t ADC_SQR1  = 0x2C;
+constexpr uint32_t ADC_SQR3  = 0x34;
+constexpr uint32_t ADC_DR    = 0x4C;
+
+// TIM1 (고급 타이머: 반복 카운터, 상보 출력, MOE)
+constexpr uint32_t TIM1      = 0x40012C00;
+constexpr uint32_t TIM_CR1   = 0x00;
+constexpr uint32_t TIM_DIER  = 0x0C;
+constexpr uint32_t TIM_SR    = 0x10;
+constexpr uint32_t TIM_EGR   = 0x14;
+constexpr uint32_t TIM_CCMR1 = 0x18;
+constexpr uint32_t TIM_CCMR2 = 0x1C;
+constexpr uint32_t TIM_CCER  = 0x20;
+constexpr uint32_t TIM_CNT   = 0x24;
+constexpr uint32_t TIM_PSC   = 0x28;
+constexpr uint32_t TIM_ARR   = 0x2C;
+constexpr uint32_t TIM_RCR   = 0x30;
+constexpr uint32_t TIM_CCR1  = 0x34;         // CCR2~4 는 4 바이트씩
+constexpr uint32_t TIM_BDTR  = 0x44;
+constexpr uint32_t TIM_DCR   = 0x48;
+constexpr uint32_t TIM_DMAR  = 0x4C;
+
+constexpr uint32_t DMA1       = 0x40020000;
+constexpr uint32_t DMA_ISR    = 0x00;
+constexpr uint32_t DMA_IFCR   = 0x04;
+constexpr uint32_t DMA_CCR    = 0x08;         // 채널 n 은 + 20 * (n - 1)
+constexpr uint32_t DMA_CNDTR  = 0x0C;
+constexpr uint32_t DMA_CPAR   = 0x10;
+constexpr uint32_t DMA_CMAR   = 0x14;
+constexpr uint32_t DMA_STRIDE = 20;
+
+constexpr uint32_t GpioBase(int port) { return GPIOA + (uint32_t)port * GPIO_STRIDE; }
+constexpr uint32_t UsartBase(int n) { return n == 1 ? 0x40013800 : n == 2 ? 0x40004400 : 0x40004800; }
+constexpr uint32_t AdcBase(int n) { return n == 1 ? 0x40012400 : 0x40012800; }
+constexpr uint32_t DmaChannel(int n) { return DMA1 + (uint32_t)(n - 1) * DMA_STRIDE; }     // + DMA_CCR 등
+}
+
+namespace bits {
+constexpr uint32_t APB2_AFIO   = 1u << 0;
+constexpr uint32_t APB2_IOPA   = 1u << 2;     // IOPB = 3, IOPC = 4 ...
+constexpr uint32_t APB2_ADC1   = 1u << 9;
+constexpr uint32_t APB2_ADC2   = 1u << 10;
+constexpr uint32_t APB2_TIM1   = 1u << 11;
+constexpr uint32_t AHB_DMA1    = 1u << 0;
+constexpr uint32_t APB2_USART1 = 1u << 14;
+constexpr uint32_t APB1_USART2 = 1u << 17;
+constexpr uint32_t APB1_USART3 = 1u << 18;
+
+constexpr uint32_t USART_SR_TXE  = 1u << 7;
+constexpr uint32_t USART_SR_RXNE = 1u << 5;
+constexpr uint32_t USART_CR1_UE  = 1u << 13;
+constexpr uint32_t USART_CR1_TE  = 1u << 3;
+constexpr uint32_t USART_CR1_RE  = 1u << 2;
+
+constexpr uint32_t TIM_CR1_CEN   = 1u << 0;
+constexpr uint32_t TIM_CR1_ARPE  = 1u << 7;
+constexpr uint32_t TIM_DIER_UDE  = 1u << 8;
+constexpr uint32_t TIM_EGR_UG    = 1u << 0;
+constexpr uint32_t TIM_OC_PWM1   = 6u << 4;   // CCMR 안 채널 하나 (홀수 채널 자리, 짝수는 << 8)
+constexpr uint32_t TIM_OC_PE     = 1u << 3;
+constexpr uint32_t TIM_BDTR_MOE  = 1u << 15;
+
+constexpr uint32_t DMA_CCR_EN    = 1u << 0;
+constexpr uint32_t DMA_CCR_TCIE  = 1u << 1;
+constexpr uint32_t DMA_CCR_DIR   = 1u << 4;   // 메모리 -> 주변장치
+constexpr uint32_t DMA_CCR_MINC  = 1u << 7;
+constexpr uint32_t DMA_CCR_P16   = 1u << 8;
+constexpr uint32_t DMA_CCR_M16   = 1u << 10;
+constexpr uint32_t DmaTcif(int ch) { return 1u << (4 * (ch - 1) + 1); }
+constexpr uint32_t DmaCgif(int ch) { return 1u << (4 * (ch - 1)); }
+
+constexpr uint32_t ADC_SR_EOC      = 1u << 1;
+constexpr uint32_t ADC_CR2_ADON    = 1u << 0;
+constexpr uint32_t ADC_CR2_CAL     = 1u << 2;
+constexpr uint32_t ADC_CR2_RSTCAL  = 1u << 3;
+constexpr uint32_t ADC_CR2_EXTSEL  = 7u << 17;  // SWSTART
+constexpr uint32_t ADC_CR2_EXTTRIG = 1u << 20;
+constexpr uint32_t ADC_CR2_SWSTART = 1u << 22;
+constexpr uint32_t ADC_CR2_TSVREFE = 1u << 23;
+}
+
+// --- 설정 타입 ---
+enum class Port : uint8_t { A, B, C, D, E };
+
+enum class Mode : uint8_t {
+    Analog,
+    Input,          // 플로팅
+    InputPullUp,
+    InputPullDown,
+    OutputPP,
+    OutputOD,
+    AltPP,
+    AltOD
+};
+
+enum class Speed : uint8_t { Mhz10 = 1, Mhz2 = 2, Mhz50 = 3 };
+enum class Edge : uint8_t { None, Rising, Falling, Both };
+
+struct Pin {
+    Port port;
+    uint8_t num;
+    Mode mode;
+    Speed speed = Speed::Mhz2;
+    bool init_high = false;         // 출력 초기값
+    Edge edge = Edge::None;         // None 이 아니면 EXTI 인터럽트
+    uint8_t irq_prio = 15;          // 0 (높음) ~ 15
+};
+
+struct Clock {
+    uint32_t sysclk_hz;
+    uint32_t pclk1_hz;
+    uint32_t pclk2_hz;
+};
+
+struct Uart {
+    uint8_t instance;               // 1 ~ 3
+    uint32_t baud;
+};
+
+// 샘플링 시간 코드 (ADC_SMPRx): 0 = 1.5, 1 = 7.5, 2 = 13.5, 3 = 28.5, 4 = 41.5, 5 = 55.5, 6 = 71.5, 7 = 239.5 사이클
+struct Adc {
+    uint8_t instance;               // 1 ~ 2
+    uint8_t channel;                // 0 ~ 17 (16 = 온도, 17 = VREFINT)
+    uint8_t sample_time;
+};
+
+// --- 컴파일 타임 검사 / 계산 ---
+namespace detail {
+
+template <size_t N>
+constexpr bool PinsValid(const std::array<Pin, N> &pins)
+{
+    for (size_t i = 0; i < N; i++) {
+        if (pins[i].num > 15 || pins[i].irq_prio > 15) return false;
+        if (pins[i].edge != Edge::None &&
+            pins[i].mode != Mode::Input && pins[i].mode != Mode::InputPullUp &&
+            pins[i].mode != Mode::InputPullDown) return false;
+    }
+    return true;
+}
+
+template <size_t N>
+constexpr bool PinsUnique(const std::array<Pin, N> &pins)
+{
+    for (size_t i = 0; i < N; i++)
+        for (size_t j = i + 1; j < N; j++)
+            if (pins[i].port == pins[j].port && pins[i].num == pins[j].num) return false;
+    return true;
+}
+
+// EXTI 라인은 포트와 무관하게 핀 번호로 하나씩만 쓸 수 있다 (PA0 과 PB0 동시 불가)
+template <size_t N>
+constexpr bool ExtiUnique(const std::array<Pin, N> &pins)
+{
+    for (size_t i = 0; i < N; i++)
+        for (size_t j = i + 1; j < N; j++)
+            if (pins[i].edge != Edge::None && pins[j].edge != Edge::None && pins[i].num == pins[j].num)
+                return false;
+    return true;
+}
+
+template <size_t N>
+constexpr bool HasPin(const std::array<Pin, N> &pins, Port port, uint8_t num, Mode mode)
+{
+    for (size_t i = 0; i < N; i++)
+        if (pins[i].port == port && pins[i].num == num && pins[i].mode == mode) return true;
+    return false;
+}
+
+constexpr uint32_t UartClock(const Clock &c, const Uart &u)
+{
+    return u.instance == 1 ? c.pclk2_hz : c.pclk1_hz;
+}
+
+constexpr uint32_t UartBrr(const Clock &c, const Uart &u)
+{
+    return (UartClock(c, u) + u.baud / 2) / u.baud;
+}
+
+// 실제 보레이트 오차 (0.1% 단위)
+constexpr uint32_t UartErrorPermille(const Clock &c, const Uart &u)
+{
+    uint32_t actual = UartClock(c, u) / UartBrr(c, u);
+    uint32_t diff = actual > u.baud ? actual - u.baud : u.baud - actual;
+    return (uint32_t)((uint64_t)diff * 1000u / u.baud);
+}
+
+// USART 핀 (리맵 없음): 1 = PA9/PA10, 2 = PA2/PA3, 3 = PB10/PB11
+template <size_t N>
+constexpr bool UartPinsOk(const std::array<Pin, N> &pins, const Uart &u)
+{
+    Port port = u.instance == 3 ? Port::B : Port::A;
+    uint8_t tx = u.instance == 1 ? 9 : u.instance == 2 ? 2 : 10;
+    return HasPin(pins, port, tx, Mode::AltPP) &&
+           (HasPin(pins, port, tx + 1, Mode::Input) || HasPin(pins, port, tx + 1, Mode::InputPullUp));
+}
+
+// ADC 채널 0~7 = PA0~7, 8~9 = PB0~1, 10~15 = PC0~5, 16/17 은 내부
+template <size_t N>
+constexpr bool AdcPinOk(const std::array<Pin, N> &pins, const Adc &a)
+{
+    if (a.channel >= 16) return a.instance == 1;        // 내부 채널은 ADC1 전용
+    if (a.channel < 8) return HasPin(pins, Port::A, a.channel, Mode::Analog);
+    if (a.channel < 10) return HasPin(pins, Port::B, (uint8_t)(a.channel - 8), Mode::Analog);
+    return HasPin(pins, Port::C, (uint8_t)(a.channel - 10), Mode::Analog);
+}
+
+constexpr uint32_t Nibble(const Pin &p)
+{
+    uint32_t spd = (uint32_t)p.speed;
+    switch (p.mode) {
+        case Mode::Analog:        return 0x0;
+        case Mode::Input:         return 0x4;
+        case Mode::InputPullUp:
+        case Mode::InputPullDown: return 0x8;
+        case Mode::OutputPP:      return 0x0 | spd;
+        case Mode::OutputOD:      return 0x4 | spd;
+        case Mode::AltPP:         return 0x8 | spd;
+        case Mode::AltOD:         return 0xC | spd;
+    }
+    return 0x4;
+}
+
+struct GpioPlan {
+    uint32_t crl[5] = { 0x44444444, 0x44444444, 0x44444444, 0x44444444, 0x44444444 };
+    uint32_t crh[5] = { 0x44444444, 0x44444444, 0x44444444, 0x44444444, 0x44444444 };
+    uint32_t odr[5] = { 0, 0, 0, 0, 0 };
+    bool lo[5] = { false, false, false, false, false };
+    bool hi[5] = { false, false, false, false, false };
+    uint32_t port_clocks = 0;
+    uint32_t exticr[4] = { 0, 0, 0, 0 };
+    uint32_t imr = 0, rtsr = 0, ftsr = 0;
+};
+
+template <size_t N>
+constexpr GpioPlan PlanGpio(const std::array<Pin, N> &pins)
+{
+    GpioPlan g;
+    for (size_t i = 0; i < N; i++) {
+        const Pin &p = pins[i];
+        int port = (int)p.port;
+        uint32_t shift = (p.num & 7u) * 4u;
+        if (p.num < 8) {
+            g.crl[port] = (g.crl[port] & ~(0xFu << shift)) | (Nibble(p) << shift);
+            g.lo[port] = true;
+        } else {
+            g.crh[port] = (g.crh[port] & ~(0xFu << shift)) | (Nibble(p) << shift);
+            g.hi[port] = true;
+        }
+        if (p.mode == Mode::InputPullUp || (p.init_high && (p.mode == Mode::OutputPP || p.mode == Mode::OutputOD)))
+            g.odr[port] |= 1u << p.num;
+        g.port_clocks |= bits::APB2_IOPA << port;
+
+        if (p.edge != Edge::None) {
+            g.exticr[p.num / 4] |= (uint32_t)port << ((p.num % 4) * 4);
+            g.imr |= 1u << p.num;
+            if (p.edge == Edge::Rising || p.edge == Edge::Both) g.rtsr |= 1u << p.num;
+            if (p.edge == Edge::Falling || p.edge == Edge::Both) g.ftsr |= 1u << p.num;
+        }
+    }
+    return g;
+}
+
+constexpr uint8_t ExtiIrq(uint8_t line)
+{
+    return line <= 4 ? (uint8_t)(6 + line) : line <= 9 ? 23 : 40;
+}
+
+template <typename B>
+constexpr bool UartsValid()
+{
+    for (const Uart &u : B::uarts) {
+        if (u.instance < 1 || u.instance > 3) return false;
+        if (!UartPinsOk(B::pins, u)) return false;
+    }
+    return true;
+}
+
+// BRR 은 16 이상, 실제 보레이트 오차는 2% 이내
+template <typename B>
+constexpr bool BaudsValid()
+{
+    for (const Uart &u : B::uarts)
+        if (UartBrr(B::clock, u) < 16 || UartErrorPermille(B::clock, u) > 20) return false;
+    return true;
+}
+
+template <typename B>
+constexpr bool AdcsValid()
+{
+    for (const Adc &a : B::adcs) {
+        if (a.instance < 1 || a.instance > 2 || a.channel > 17 || a.sample_time > 7) return false;
+        if (!AdcPinOk(B::pins, a)) return false;
+    }
+    return true;
+}
+
+template <typename B>
+constexpr uint32_t Apb2Enable(const GpioPlan &g)
+{
+    uint32_t v = g.port_clocks | (g.imr ? bits::APB2_AFIO : 0);
+    for (const Uart &u : B::uarts)
+        if (u.instance == 1) v |= bits::APB2_USART1;
+    for (const Adc &a : B::adcs)
+        v |= a.instance == 1 ? bits::APB2_ADC1 : bits::APB2_ADC2;
+    return v;
+}
+
+template <typename B>
+constexpr uint32_t Apb1Enable()
+{
+    uint32_t v = 0;
+    for (const Uart &u : B::uarts) {
+        if (u.instance == 2) v |= bits::APB1_USART2;
+        if (u.instance == 3) v |= bits::APB1_USART3;
+    }
+    return v;
+}
+
+// ADON 뒤 기다릴 루프 횟수: tSTAB (HAL ADC_STAB_DELAY_US, 1 us) + 보정 전 ADC 클럭 2 개.
+// ADC 프리스케일러는 SystemClock_Config 몫이라 가장 느린 PCLK2/8 로 잡음. 루프 한 번은
+// 한 사이클보다 길어서 사이클 수만큼 돌면 충분하다
+template <typename B>
+constexpr uint32_t AdcStabLoops()
+{
+    return B::clock.sysclk_hz / 1000000u + 2u * 8u * (B::clock.sysclk_hz / B::clock.pclk2_hz);
+}
+
+inline void Spin(uint32_t loops)
+{
+    volatile uint32_t i = 0;
+    while (i < loops)
+        i = i + 1;
+}
+
+} // namespace detail
+
+// --- 초기화: 보드 타입 B 는 clock, pins, uarts, adcs 를 static constexpr 로 가진다 ---
+template <typename B>
+void Init()
+{
+    static_assert(detail::PinsValid(B::pins), "핀 번호/우선순위 범위 오류 또는 출력 핀에 EXTI 설정");
+    static_assert(detail::PinsUnique(B::pins), "같은 핀을 두 번 설정함");
+    static_assert(detail::ExtiUnique(B::pins), "같은 EXTI 라인(핀 번호)을 두 포트에서 씀");
+    static_assert(detail::UartsValid<B>(), "USART 번호가 없거나 TX(AF)/RX(입력) 핀 설정이 빠짐");
+    static_assert(detail::BaudsValid<B>(), "BRR 이 16 미만이거나 보레이트 오차가 2%를 넘음");
+    static_assert(detail::AdcsValid<B>(), "ADC 채널/샘플링 범위 오류 또는 채널 핀이 Analog 가 아님");
+    static_assert(B::clock.pclk2_hz <= 72000000u && B::clock.pclk1_hz <= 36000000u, "APB 클럭 한도 초과");
+
+    constexpr detail::GpioPlan g = detail::PlanGpio(B::pins);
+
+    constexpr uint32_t apb2 = detail::Apb2Enable<B>(g);
+    constexpr uint32_t apb1 = detail::Apb1Enable<B>();
+
+    // 클럭
+    reg::Write(addr::RCC_APB2ENR, reg::Read(addr::RCC_APB2ENR) | apb2);
+    if (apb1)
+        reg::Write(addr::RCC_APB1ENR, reg::Read(addr::RCC_APB1ENR) | apb1);
+
+    // GPIO: 포트당 CRL/CRH/ODR 한 번씩 (ODR 을 먼저 써서 출력이 튀지 않게)
+    for (int port = 0; port < 5; port++) {
+        if (!g.lo[port] && !g.hi[port]) continue;
+        uint32_t base = addr::GpioBase(port);
+        if (g.odr[port]) reg::Write(base + addr::GPIO_ODR, g.odr[port]);
+        if (g.lo[port]) reg::Write(base + addr::GPIO_CRL, g.crl[port]);
+        if (g.hi[port]) reg::Write(base + addr::GPIO_CRH, g.crh[port]);
+    }
+
+    // EXTI + NVIC
+    if (g.imr) {
+        for (int i = 0; i < 4; i++)
+            if (g.exticr[i]) reg::Write(addr::AFIO_EXTICR1 + 4u * i, g.exticr[i]);
+        if (g.rtsr) reg::Write(addr::EXTI_RTSR, g.rtsr);
+        if (g.ftsr) reg::Write(addr::EXTI_FTSR, g.ftsr);
+        reg::Write(addr::EXTI_IMR, g.imr);
+        for (const Pin &p : B::pins) {
+            if (p.edge == Edge::None) continue;
+            uint8_t irq = detail::ExtiIrq(p.num);
+            reg::Write8(addr::NVIC_IPR + irq, (uint8_t)(p.irq_prio << 4));
+            reg::Write(addr::NVIC_ISER + 4u * (irq / 32u), 1u << (irq % 32u));
+        }
+    }
+
+    // USART: 8N1, TX/RX
+    for (const Uart &u : B::uarts) {
+        uint32_t base = addr::UsartBase(u.instance);
+        reg::Write(base + addr::USART_BRR, detail::UartBrr(B::clock, u));
+        reg::Write(base + addr::USART_CR1, bits::USART_CR1_UE | bits::USART_CR1_TE | bits::USART_CR1_RE);
+    }
+
+    // ADC: 단일 변환, 소프트웨어 트리거, 전원 켜고 안정될 때까지 기다린 뒤 보정
+    // (HAL_ADCEx_Calibration_Start 와 같은 순서: RSTCAL -> 끝나길 기다림 -> CAL -> 끝나길 기다림)
+    for (const Adc &a : B::adcs) {
+        uint32_t base = addr::AdcBase(a.instance);
+        if (a.channel < 10)
+            reg::Write(base + addr::ADC_SMPR2, (uint32_t)a.sample_time << (3u * a.channel));
+        else
+            reg::Write(base + addr::ADC_SMPR1, (uint32_t)a.sample_time << (3u * (a.channel - 10u)));
+        reg::Write(base + addr::ADC_SQR1, 0);                 // 변환 1개
+        reg::Write(base + addr::ADC_SQR3, a.channel);
+        uint32_t cr2 = bits::ADC_CR2_ADON | bits::ADC_CR2_EXTSEL | bits::ADC_CR2_EXTTRIG |
+                       (a.channel >= 16 ? bits::ADC_CR2_TSVREFE : 0);
+        reg::Write(base + addr::ADC_CR2, cr2);
+        detail::Spin(detail::AdcStabLoops<B>());
+        reg::Write(base + addr::ADC_CR2, cr2 | bits::ADC_CR2_RSTCAL);
+        while (reg::Read(base + addr::ADC_CR2) & bits::ADC_CR2_RSTCAL) {}
+        reg::Write(base + addr::ADC_CR2, cr2 | bits::ADC_CR2_CAL);
+        while (reg::Read(base + addr::ADC_CR2) & bits::ADC_CR2_CAL) {}
+    }
+}
+
+// --- 런타임 I/O: 주소가 상수라 HAL 핸들 없이 레지스터 한 번 ---
+template <Port P, uint8_t N>
+struct Gpio {
+    static_assert(N < 16, "핀 번호는 0~15");
+    static constexpr uint32_t base = addr::GpioBase((int)P);
+
+    static void Set()    { reg::Write(base + addr::GPIO_BSRR, 1u << N); }
+    static void Reset()  { reg::Write(base + addr::GPIO_BSRR, 1u << (N + 16)); }
+    static void Toggle() { (reg::Read(base + addr::GPIO_ODR) & (1u << N)) ? Reset() : Set(); }
+    static bool Read()   { return (reg::Read(base + addr::GPIO_IDR) & (1u << N)) != 0; }
+};
+
+template <uint8_t Instance>
+struct UartPort {
+    static_assert(Instance >= 1 && Instance <= 3, "USART1~3 만 있음");
+    static constexpr uint32_t base = addr::UsartBase(Instance);
+
+    static void Put(uint8_t c)
+    {
+        while (!(reg::Read(base + addr::USART_SR) & bits::USART_SR_TXE)) {}
+        reg::Write(base + addr::USART_DR, c);
+    }
+
+    static void Write(const uint8_t *data, size_t len)
+    {
+        for (size_t i = 0; i < len; i++) Put(data[i]);
+    }
+};
+
+template <uint8_t Instance>
+struct AdcPort {
+    static_assert(Instance == 1 || Instance == 2, "ADC1, ADC2 만 있음");
+    static constexpr uint32_t base = addr::AdcBase(Instance);
+
+    static uint16_t Read()
+    {
+        reg::Write(base + addr::ADC_CR2, reg::Read(base + addr::ADC_CR2) | bits::ADC_CR2_SWSTART);
+        while (!(reg::Read(base + addr::ADC_SR) & bits::ADC_SR_EOC)) {}
+        return (uint16_t)(reg::Read(base + addr::ADC_DR) & 0x0FFFu);
+    }
+};
+
+} // namespace bsp
+
+#endif
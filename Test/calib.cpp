@@ -0,0 +1,52 @@
+// calib.cpp
+// C 펌웨어에서 부르는 보정 진입점. 럭스 테이블은 board.hpp 보정점으로 컴파일 중에 만들어져 플래시에 있다.
+#include "board.hpp"
+#include "calib.h"
+
+static_assert(cal::Valid<Board::LightGrid>(Board::light_curve),
+              "조도 보정점이 x 순으로 정렬되지 않았거나 격자 범위/ Q16 범위를 넘음");
+static_assert(Board::vdda_mv >= 2000 && Board::vdda_mv <= 3600, "VDDA 기본값 범위");
+
+static constexpr cal::Table<Board::LightGrid, Board::light_curve.size()> light_table(Board::light_curve);
+
+// VREFINT 로 잰 VDDA 범위 (2.0 ~ 3.6 V) 에 해당하는 raw
+static constexpr uint32_t kVrefRawMin = Board::vrefint_mv * 4095u / 3600u;
+static constexpr uint32_t kVrefRawMax = Board::vrefint_mv * 4095u / 2000u;
+
+// mV/count (Q16.16). 32비트 한 번 쓰기라 ISR/태스크 사이에서도 찢어지지 않음
+static volatile uint32_t mv_per_count_q16 = (uint32_t)(((uint64_t)Board::vdda_mv << 16) / 4095u);
+static uint32_t vref_raw_q4;    // VREFINT raw 의 IIR (Q4), 0 이면 아직 없음
+
+extern "C" int Calib_SetVrefint(uint16_t raw)
+{
+    if (raw < kVrefRawMin || raw > kVrefRawMax)
+        return -1;
+    uint32_t in = (uint32_t)raw << 4;
+    if (vref_raw_q4 == 0)
+        vref_raw_q4 = in;
+    else
+        vref_raw_q4 = vref_raw_q4 - (vref_raw_q4 >> 3) + (in >> 3);   // 1/8 IIR
+    // mV/count = VREFINT mV / VREFINT raw (4095 와 무관)
+    mv_per_count_q16 = (uint32_t)(((uint64_t)Board::vrefint_mv << 20) / vref_raw_q4);
+    return 0;
+}
+
+extern "C" uint32_t Calib_VddaMv(void)
+{
+    return (uint32_t)(((uint64_t)mv_per_count_q16 * 4095u + 0x8000u) >> 16);
+}
+
+extern "C" uint32_t Calib_RawToMvQ16(uint16_t raw)
+{
+    return (uint32_t)(raw & 0x0FFFu) * mv_per_count_q16;
+}
+
+extern "C" uint32_t Calib_MvToLuxQ16(uint32_t mv_q16)
+{
+    return (uint32_t)light_table(mv_q16);
+}
+
+extern "C" uint32_t Calib_RawToLuxQ16(uint16_t raw)
+{
+    return (uint32_t)light_table(Calib_RawToMvQ16(raw));
+}
@@ -0,0 +1,29 @@
+#ifndef CALIB_H
+#define CALIB_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ADC 보정: raw 12비트 -> mV (VREFINT 로 VDDA 보정) -> 럭스 (board.hpp 보정점으로 만든 테이블)
+// 값은 모두 Q16.16 부호없는 고정소수점, 변환 경로에 float 없음
+#define CALIB_Q16(v)            ((uint32_t)(v) << 16)
+#define CALIB_Q16_INT(q)        ((uint32_t)(q) >> 16)
+#define CALIB_Q16_TENTHS(q)     (((((uint32_t)(q)) & 0xFFFFu) * 10u) >> 16)   // 소수 첫째 자리 (버림)
+
+// ADC_CHANNEL_VREFINT 변환값을 넣으면 mV/count 를 갱신 (작은 IIR 로 거름).
+// VDDA 가 2.0 ~ 3.6 V 로 계산되지 않는 값은 버리고 -1
+int Calib_SetVrefint(uint16_t raw);
+uint32_t Calib_VddaMv(void);
+
+uint32_t Calib_RawToMvQ16(uint16_t raw);
+uint32_t Calib_MvToLuxQ16(uint32_t mv_q16);
+uint32_t Calib_RawToLuxQ16(uint16_t raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,113 @@
+// calib.hpp
+// ADC 보정 테이블을 컴파일 중에 만드는 부분
+//
+// 보정점(입력 mV, 출력 milli 단위)을 constexpr 배열로 주면 MakeLut 가 입력 축을 2^Shift mV 간격으로
+// 자른 균일 격자에서 구간 선형 값을 미리 계산해 Q16.16 으로 담는다. 런타임 변환은 격자 칸 하나를
+// 찾아 선형 보간만 하므로 곱셈 한 번과 시프트뿐이고 float 이 없다.
+// 보정점이 정렬돼 있지 않거나 격자가 보정 범위를 덮지 못하면 static_assert 로 빌드가 깨진다.
+#ifndef CALIB_HPP
+#define CALIB_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cal {
+
+constexpr uint32_t kQ16One = 1u << 16;
+
+// x: 입력 (mV), y: 출력의 1/1000 단위 (밀리럭스 등)
+struct Point {
+    uint32_t x;
+    uint32_t y_milli;
+};
+
+// 격자 Shift (mV 간격 = 2^Shift), 입력 범위 0 ~ Span mV
+template <uint32_t Shift, uint32_t Span>
+struct Grid {
+    static_assert(Shift >= 1 && Shift <= 12, "격자 간격은 2 ~ 4096 mV");
+    static_assert(Span % (1u << Shift) == 0, "입력 범위는 격자 간격의 배수");
+    static constexpr uint32_t shift = Shift;
+    static constexpr uint32_t span = Span;
+    static constexpr size_t size = Span / (1u << Shift) + 1;
+};
+
+namespace detail {
+
+template <size_t N>
+constexpr bool Sorted(const std::array<Point, N> &pts)
+{
+    for (size_t i = 1; i < N; i++)
+        if (pts[i].x <= pts[i - 1].x) return false;
+    return true;
+}
+
+// 보정점 사이 구간 선형, 범위 밖은 끝점 값으로 고정. 결과는 Q16.16 (반올림)
+template <size_t N>
+constexpr int32_t Eval(const std::array<Point, N> &pts, uint32_t x)
+{
+    if (x <= pts[0].x)
+        return (int32_t)(((uint64_t)pts[0].y_milli * kQ16One + 500u) / 1000u);
+    for (size_t i = 1; i < N; i++) {
+        if (x <= pts[i].x) {
+            int64_t y0 = (int64_t)pts[i - 1].y_milli * kQ16One;
+            int64_t y1 = (int64_t)pts[i].y_milli * kQ16One;
+            int64_t dx = (int64_t)(pts[i].x - pts[i - 1].x);
+            int64_t num = y0 * dx + (y1 - y0) * (int64_t)(x - pts[i - 1].x);
+            int64_t den = dx * 1000;
+            return (int32_t)((num + den / 2) / den);
+        }
+    }
+    return (int32_t)(((uint64_t)pts[N - 1].y_milli * kQ16One + 500u) / 1000u);
+}
+
+template <size_t N>
+constexpr bool FitsQ16(const std::array<Point, N> &pts)
+{
+    for (size_t i = 0; i < N; i++)
+        if (pts[i].y_milli / 1000u >= 32768u) return false;    // int32 Q16.16
+    return true;
+}
+
+} // namespace detail
+
+template <typename G, size_t N>
+constexpr std::array<int32_t, G::size> MakeLut(const std::array<Point, N> &pts)
+{
+    std::array<int32_t, G::size> lut{};
+    for (size_t i = 0; i < G::size; i++)
+        lut[i] = detail::Eval(pts, (uint32_t)(i << G::shift));
+    return lut;
+}
+
+// 보정 테이블 한 벌: 보드 설정에서 Table<Grid<...>, points> 로 선언
+template <typename G, size_t N>
+struct Table {
+    static_assert(N >= 2, "보정점은 두 개 이상");
+
+    std::array<int32_t, G::size> lut;
+
+    constexpr explicit Table(const std::array<Point, N> &pts) : lut(MakeLut<G>(pts)) {}
+
+    // 입력 Q16.16 mV -> 출력 Q16.16. 격자 밖은 마지막 칸 값
+    int32_t operator()(uint32_t x_q16) const
+    {
+        uint32_t pos = x_q16 >> G::shift;         // 격자 단위 Q16.16
+        uint32_t idx = pos >> 16;
+        if (idx >= G::size - 1)
+            return lut[G::size - 1];
+        int32_t y0 = lut[idx];
+        int32_t dy = lut[idx + 1] - y0;
+        return y0 + (int32_t)(((int64_t)dy * (int64_t)(pos & 0xFFFFu)) >> 16);
+    }
+};
+
+template <typename G, size_t N>
+constexpr bool Valid(const std::array<Point, N> &pts)
+{
+    return detail::Sorted(pts) && detail::FitsQ16(pts) && pts[N - 1].x <= G::span;
+}
+
+} // namespace cal
+
+#endif
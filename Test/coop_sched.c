@@ -0,0 +1,221 @@
+#include "main.h"
+#include "coop_sched.h"
+#include "dlog.h"
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#define COOP_TICKS_PER_US   1u
+#define COOP_LOCK()         do {} while (0)
+#define COOP_UNLOCK()       do {} while (0)
+#else
+#define COOP_TICKS_PER_US   (COOP_CPU_HZ / 1000000u)
+#define COOP_LOCK()         uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define COOP_UNLOCK()       __set_PRIMASK(primask)
+#endif
+
+typedef struct {
+    CoopJobFn fn;
+    uint64_t next_release_us;
+    CoopStats stats;
+} CoopJob;
+
+static CoopJob jobs[COOP_MAX_JOBS];
+static uint8_t job_count = 0;
+
+static volatile uint32_t pending = 0;
+static volatile uint32_t signal_stamp[32];     // 비트별 처음 올라온 시각 (틱)
+
+static uint32_t last_stamp;
+static uint32_t stamp_frac;
+static uint64_t now_us;
+
+// --- 시간 ---
+static inline uint32_t Stamp(void)
+{
+#ifdef HOST_BUILD
+    return (uint32_t)HostOs_NowUs();
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+// 메인 루프에서만 부른다 (32비트 틱 카운터를 64비트 us 로 연장)
+uint64_t Coop_NowUs(void)
+{
+    uint32_t s = Stamp();
+    uint32_t ticks = (s - last_stamp) + stamp_frac;
+    last_stamp = s;
+    now_us += ticks / COOP_TICKS_PER_US;
+    stamp_frac = ticks % COOP_TICKS_PER_US;
+    return now_us;
+}
+
+void Coop_Init(void)
+{
+#ifndef HOST_BUILD
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    job_count = 0;
+    pending = 0;
+    last_stamp = Stamp();
+    stamp_frac = 0;
+    now_us = 0;
+}
+
+int Coop_AddJob(const char *name, CoopJobFn fn, uint32_t period_us, uint32_t events)
+{
+    if (job_count >= COOP_MAX_JOBS || !fn)
+        return -1;
+    CoopJob *j = &jobs[job_count];
+    memset(j, 0, sizeof(*j));
+    j->fn = fn;
+    j->stats.name = name;
+    j->stats.period_us = period_us;
+    j->stats.events = events;
+    j->next_release_us = Coop_NowUs();     // 첫 릴리스는 바로
+    return job_count++;
+}
+
+void Coop_SetPeriod(int id, uint32_t period_us)
+{
+    if (id < 0 || id >= job_count)
+        return;
+    jobs[id].stats.period_us = period_us;
+    jobs[id].next_release_us = Coop_NowUs() + period_us;
+}
+
+void Coop_Signal(uint32_t events)
+{
+    uint32_t s = Stamp();
+    COOP_LOCK();
+    uint32_t fresh = events & ~pending;
+    while (fresh) {
+        int bit = __builtin_ctz(fresh);
+        signal_stamp[bit] = s;
+        fresh &= fresh - 1;
+    }
+    pending |= events;
+    COOP_UNLOCK();
+}
+
+// 잡이 기다리는 이벤트 중 가장 먼저 올라온 것부터 지금까지
+static uint32_t EventLateness(uint32_t events, uint32_t start_stamp)
+{
+    uint32_t worst = 0;
+    while (events) {
+        int bit = __builtin_ctz(events);
+        uint32_t d = start_stamp - signal_stamp[bit];
+        if (d > worst)
+            worst = d;
+        events &= events - 1;
+    }
+    return worst / COOP_TICKS_PER_US;
+}
+
+static void Dispatch(CoopJob *j, uint32_t late_us)
+{
+    uint32_t start = Stamp();
+    j->fn();
+    uint32_t exec_us = (Stamp() - start) / COOP_TICKS_PER_US;
+
+    CoopStats *st = &j->stats;
+    st->runs++;
+    st->exec_total_us += exec_us;
+    if (exec_us > st->exec_max_us)
+        st->exec_max_us = exec_us;
+    st->late_total_us += late_us;
+    if (late_us > st->late_max_us)
+        st->late_max_us = late_us;
+}
+
+void Coop_RunOnce(void)
+{
+    uint64_t now = Coop_NowUs();
+    uint64_t next_wake = UINT64_MAX;
+
+    for (uint8_t i = 0; i < job_count; i++) {
+        CoopJob *j = &jobs[i];
+        uint32_t mask = j->stats.events & pending;
+
+        if (mask) {
+            COOP_LOCK();
+            pending &= ~mask;
+            COOP_UNLOCK();
+            Dispatch(j, EventLateness(mask, Stamp()));
+            return;
+        }
+
+        if (j->stats.period_us == 0)
+            continue;
+        if (now >= j->next_release_us) {
+            uint32_t late_us = (uint32_t)(now - j->next_release_us);
+            // 다음 릴리스를 미래로, 그 사이 지나간 주기는 놓친 것
+            uint32_t behind = (uint32_t)(late_us / j->stats.period_us);
+            j->stats.missed += behind;
+            j->next_release_us += (uint64_t)(behind + 1) * j->stats.period_us;
+            Dispatch(j, late_us);
+            return;
+        }
+        if (j->next_release_us < next_wake)
+            next_wake = j->next_release_us;
+    }
+
+    // 할 일 없음: 다음 릴리스나 인터럽트까지 잠듦
+#ifdef HOST_BUILD
+    if (!pending)
+        HostOs_Idle(next_wake == UINT64_MAX ? 1000000u : next_wake - now);
+#else
+    // 검사와 WFI 사이에 들어온 인터럽트도 (PRIMASK 가 막고 있어도) WFI 를 깨운다
+    (void)next_wake;
+    __disable_irq();
+    if (!pending)
+        __WFI();
+    __enable_irq();
+#endif
+}
+
+void Coop_Run(void)
+{
+    for (;;)
+        Coop_RunOnce();
+}
+
+int Coop_Count(void)
+{
+    return job_count;
+}
+
+int Coop_GetStats(int id, CoopStats *out)
+{
+    if (id < 0 || id >= job_count)
+        return -1;
+    *out = jobs[id].stats;
+    return 0;
+}
+
+void Coop_ResetStats(void)
+{
+    for (uint8_t i = 0; i < job_count; i++) {
+        CoopStats *st = &jobs[i].stats;
+        st->runs = 0;
+        st->missed = 0;
+        st->exec_max_us = 0;
+        st->exec_total_us = 0;
+        st->late_max_us = 0;
+        st->late_total_us = 0;
+    }
+}
+
+int Coop_LogJob(int id)
+{
+    if (id < 0 || id >= job_count)
+        return -1;
+    const CoopStats *st = &jobs[id].stats;
+    uint32_t runs = st->runs ? st->runs : 1;
+    DLOG("JOB %u runs %lu exec %lu/%lu us late %lu/%lu us miss %lu\r\n", (unsigned)id, (unsigned long)st->runs,
+         (unsigned long)(st->exec_total_us / runs), (unsigned long)st->exec_max_us,
+         (unsigned long)(st->late_total_us / runs), (unsigned long)st->late_max_us, (unsigned long)st->missed);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#ifndef COOP_SCHED_H
+#define COOP_SCHED_H
+
+#include <stdint.h>
+
+// RTOS 없는 슈퍼루프용 협조형 스케줄러
+// - 잡은 끝까지 실행되고 (선점 없음) 등록 순서가 곧 우선순위
+// - 주기 잡: period_us 마다 릴리스, 늦어서 건너뛴 릴리스는 missed 로 센다
+// - 이벤트 잡: ISR 에서 Coop_Signal(비트) 로 깨움, 같은 비트가 여러 번 와도 한 번 실행
+// - 할 일이 없으면 __WFI (SysTick/EXTI 가 깨움)
+//
+// 시간은 타깃에서 DWT->CYCCNT, 호스트(HOST_BUILD)에서는 host_os 가상 시간
+
+#define COOP_MAX_JOBS       8
+#define COOP_CPU_HZ         72000000u
+
+typedef void (*CoopJobFn)(void);
+
+typedef struct {
+    const char *name;
+    uint32_t period_us;         // 0 이면 이벤트로만 실행
+    uint32_t events;            // 깨우는 이벤트 비트
+    uint32_t runs;
+    uint32_t missed;            // 실행 못 하고 지나간 주기 릴리스
+    uint32_t exec_max_us;
+    uint64_t exec_total_us;
+    uint32_t late_max_us;       // 릴리스(또는 이벤트 발생)부터 시작까지
+    uint64_t late_total_us;
+} CoopStats;
+
+void Coop_Init(void);
+// 반환값은 잡 id, 자리가 없으면 -1
+int Coop_AddJob(const char *name, CoopJobFn fn, uint32_t period_us, uint32_t events);
+// 주기를 바꾼다 (0 이면 주기 실행 중지), 다음 릴리스는 지금부터 period_us 뒤
+void Coop_SetPeriod(int id, uint32_t period_us);
+
+// ISR 에서 호출 가능
+void Coop_Signal(uint32_t events);
+
+// 준비된 잡 중 가장 앞의 것 하나를 실행, 없으면 다음 릴리스까지 잠든다
+void Coop_RunOnce(void);
+void Coop_Run(void) __attribute__((noreturn));
+
+uint64_t Coop_NowUs(void);
+int Coop_Count(void);
+int Coop_GetStats(int id, CoopStats *out);
+void Coop_ResetStats(void);
+// 잡 하나의 "JOB <id> runs .. exec avg/max .. late avg/max .. miss .." 를 DLOG 레코드로 (UART 를 기다리지 않음).
+// id 는 등록 순서, 없는 id 면 -1
+int Coop_LogJob(int id);
+
+#endif
@@ -0,0 +1,160 @@
+// coro.cpp
+// 코루틴 실행기 (coro.hpp): 프레임 아레나, 준비 / 타이머 목록, 잠들기
+#include "coro.hpp"
+#include "dlog.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#endif
+
+extern UART_HandleTypeDef huart1;
+
+namespace coro {
+
+// --- 프레임 아레나 ---
+alignas(std::max_align_t) static uint8_t arena[CORO_ARENA_BYTES];
+static size_t arena_used;
+static void *last_frame;        // 마지막 할당 (Spawn 이 크기를 알아내고, delete 가 되돌림)
+static size_t last_size;
+
+void *Task::promise_type::operator new(size_t size) noexcept
+{
+    size_t n = (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    if (n > sizeof(arena) - arena_used)
+        return nullptr;
+    last_frame = &arena[arena_used];
+    last_size = n;
+    arena_used += n;
+    return last_frame;
+}
+
+// Spawn 못 한 Task 가 사라질 때만 불림. 마지막 것이면 되돌리고 아니면 그냥 둔다
+void Task::promise_type::operator delete(void *p, size_t size) noexcept
+{
+    (void)size;
+    if (p == last_frame) {
+        arena_used -= last_size;
+        last_frame = nullptr;
+    }
+}
+
+size_t ArenaUsed()
+{
+    return arena_used;
+}
+
+Tick Now()
+{
+    return HAL_GetTick();
+}
+
+// --- 실행기 ---
+int Executor::Spawn(const char *name, Task &&t)
+{
+    if (!t || count_ >= CORO_MAX_TASKS)
+        return -1;
+    Task::Handle h = t.Release();
+    Slot *s = &slots_[count_];
+    *s = Slot{};
+    s->name = name;
+    s->h = h;
+    s->exec = this;
+    s->frame_bytes = (h.address() == last_frame) ? (uint16_t)last_size : 0;
+    h.promise().slot = s;
+    MakeReady(s);               // 처음 co_await 까지는 다음 Poll 에서
+    return count_++;
+}
+
+void Executor::MakeReady(Slot *s)
+{
+    CORO_LOCK();
+    s->next = nullptr;
+    if (ready_tail_)
+        ready_tail_->next = s;
+    else
+        ready_head_ = s;
+    ready_tail_ = s;
+    CORO_UNLOCK();
+}
+
+// 태스크에서만 (ISR 은 타이머를 건드리지 않음)
+void Executor::AddTimer(Slot *s, Tick wake)
+{
+    s->wake = wake;
+    Slot **p = &timers_;
+    while (*p && (int32_t)((*p)->wake - wake) <= 0)
+        p = &(*p)->next;
+    s->next = *p;
+    *p = s;
+}
+
+bool Executor::Poll()
+{
+    Tick now = Now();
+    while (timers_ && (int32_t)(now - timers_->wake) >= 0) {
+        Slot *s = timers_;
+        timers_ = s->next;
+        MakeReady(s);
+    }
+
+    // 지금 목록만 떼어서 돌린다 (도는 중에 준비된 것은 다음 Poll)
+    CORO_LOCK();
+    Slot *s = ready_head_;
+    ready_head_ = ready_tail_ = nullptr;
+    CORO_UNLOCK();
+    if (!s)
+        return false;
+    while (s) {
+        Slot *next = s->next;   // resume 안에서 다시 목록에 들어가면 next 가 바뀜
+        s->resumes++;
+        switches_++;
+        s->h.resume();
+        s = next;
+    }
+    return true;
+}
+
+void Executor::Run()
+{
+    for (;;) {
+        if (Poll())
+            continue;
+#ifdef HOST_BUILD
+        uint64_t now = HostOs_NowUs();
+        uint64_t wake = timers_ ? (uint64_t)timers_->wake * 1000u : now + 1000000u;
+        HostOs_Idle(wake > now ? wake - now : 0);
+#else
+        // 검사와 WFI 사이에 들어온 인터럽트도 (PRIMASK 가 막고 있어도) WFI 를 깨운다.
+        // 타이머는 SysTick (1 ms) 이 깨울 때마다 Poll 에서 봄
+        __disable_irq();
+        if (!ready_head_)
+            __WFI();
+        __enable_irq();
+#endif
+    }
+}
+
+void Executor::ReportNames() const
+{
+    char msg[40];
+    for (uint8_t i = 0; i < count_; i++) {
+        snprintf(msg, sizeof(msg), "CORO %u = %s\r\n", (unsigned)i, slots_[i].name);
+        HAL_UART_Transmit(&huart1, (uint8_t *)msg, strlen(msg), HAL_MAX_DELAY);
+    }
+}
+
+void Executor::Report() const
+{
+    for (uint8_t i = 0; i < count_; i++) {
+        const Slot *s = &slots_[i];
+        DLOG("CORO %u frame %u B resumes %lu done %u\r\n", (unsigned)i, (unsigned)s->frame_bytes,
+             (unsigned long)s->resumes, (unsigned)s->h.done());
+    }
+    DLOG("CORO arena %u/%u B, slots %u B, switches %lu\r\n", (unsigned)arena_used, (unsigned)sizeof(arena),
+         (unsigned)sizeof(slots_), (unsigned long)switches_);
+}
+
+} // namespace coro
@@ -0,0 +1,338 @@
+// coro.hpp
+// 스택 없는 C++20 코루틴 태스크: 태스크마다 스택을 두지 않고 한 스택 (main) 위에서 번갈아 돈다
+//
+// sys.c / FREE_RTOS.c 태스크는 거의 내내 osMessageGet / osDelay 에서 잠들어 있는데도 각자 128 워드
+// 스택 + TCB 를 갖는다. 코루틴은 잠들 때 co_await 을 건너 살아 있어야 하는 지역 변수만 프레임에
+// 남기고 스택에서 내려오므로, 태스크 하나의 몫은 프레임 (수십 바이트) + Slot 이다.
+//
+//   coro::Task SensorTask() {
+//       coro::Tick prev = coro::Now();
+//       for (;;) {
+//           co_await coro::SleepUntil(prev, 500);
+//           co_await eventQueue.Put(Read());
+//       }
+//   }
+//   coro::Task LogicTask() {
+//       for (;;) {
+//           Event e = co_await eventQueue.Get();
+//           ...
+//       }
+//   }
+//   sched.Spawn("sensor", SensorTask());
+//   sched.Run();
+//
+// - 선점 없음, 우선순위 없음: 준비된 태스크를 깨어난 순서대로 다음 co_await 까지 돌린다
+//   (coop_sched 의 잡과 같은 run-to-completion, 긴 일은 중간에 co_await coro::Yield())
+// - co_await 은 코루틴 본체에서만 된다. 부르는 보통 함수 안에서는 잠들 수 없음 (HAL 폴링 대기는 그대로 막힘)
+// - 프레임은 정적 아레나 (CORO_ARENA_BYTES) 에서 잘라 쓰고 돌려주지 않는다 (태스크는 끝나지 않는 것이 보통)
+// - 큐 넣기 TryPut 은 ISR 에서도 된다 (PRIMASK). 꺼내기와 잠들기는 태스크에서만
+// - 시간은 HAL_GetTick (ms). 할 일이 없으면 __WFI, SysTick 이 1 ms 마다 깨움
+//   (HOST_BUILD 는 host_os 가상 시간에서 다음 타이머까지 HostOs_Idle)
+//
+// 빌드: -std=c++20 (GCC 10 은 -fcoroutines 도), 타깃은 -fno-exceptions -fno-rtti
+// CORO_MAX_TASKS / CORO_ARENA_BYTES 를 바꾸면 coro.cpp 와 쓰는 쪽 모두 같은 값으로
+#ifndef CORO_HPP
+#define CORO_HPP
+
+#include "main.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef CORO_MAX_TASKS
+#define CORO_MAX_TASKS      8
+#endif
+#ifndef CORO_ARENA_BYTES
+#define CORO_ARENA_BYTES    1024
+#endif
+
+#ifdef HOST_BUILD
+#define CORO_LOCK()         do {} while (0)
+#define CORO_UNLOCK()       do {} while (0)
+#else
+#define CORO_LOCK()         uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define CORO_UNLOCK()       __set_PRIMASK(primask)
+#endif
+
+namespace coro {
+
+using Tick = uint32_t;          // ms
+
+Tick Now();
+
+class Executor;
+
+// 실행기 쪽 태스크 정보 (실행기 안 배열에 있고 프레임 밖)
+struct Slot {
+    const char *name;
+    std::coroutine_handle<> h;
+    Executor *exec;
+    Slot *next;                 // 준비 목록 또는 타이머 목록 (큐에서 잠든 동안은 어디에도 없음)
+    Tick wake;
+    uint16_t frame_bytes;       // 0 이면 모름 (Spawn 참고)
+    uint32_t resumes;
+};
+
+// 코루틴 함수의 반환형. Executor::Spawn 에 넘기기 전에는 처음 co_await 전까지도 돌지 않는다
+class Task {
+public:
+    struct promise_type {
+        Slot *slot = nullptr;
+
+        // 프레임은 아레나에서. 모자라면 nullptr -> 빈 Task (Spawn 이 -1)
+        static void *operator new(size_t size) noexcept;
+        static void operator delete(void *p, size_t size) noexcept;
+        static Task get_return_object_on_allocation_failure() noexcept { return Task(); }
+
+        Task get_return_object() noexcept { return Task(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { for (;;) {} }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    Task(Task &&o) noexcept : h_(o.h_) { o.h_ = nullptr; }
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    ~Task()
+    {
+        if (h_)
+            h_.destroy();
+    }
+
+    explicit operator bool() const { return (bool)h_; }
+    Handle Release()
+    {
+        Handle h = h_;
+        h_ = nullptr;
+        return h;
+    }
+
+private:
+    explicit Task(Handle h) : h_(h) {}
+    Handle h_;
+};
+
+// 아레나에서 쓴 바이트 (프레임 합, 정렬 포함)
+size_t ArenaUsed();
+
+class Executor {
+public:
+    // 반환값은 태스크 번호, 자리가 없거나 프레임을 못 만들었으면 -1.
+    // 프레임 크기는 Spawn("x", X()) 처럼 만들자마자 넘길 때만 알 수 있다 (아레나의 마지막 할당과 맞춰 봄)
+    int Spawn(const char *name, Task &&t);
+
+    // 때가 된 타이머를 옮기고, 지금 준비된 태스크를 한 번씩 다음 co_await 까지. 하나라도 돌렸으면 true
+    bool Poll();
+    // Poll 을 계속, 할 일이 없으면 다음 타이머 (또는 인터럽트) 까지 잠든다
+    [[noreturn]] void Run();
+
+    int Count() const { return count_; }
+    const Slot &At(int i) const { return slots_[i]; }
+    uint32_t Switches() const { return switches_; }
+    // "CORO <번호> = <이름>" 줄들. 이름은 DLOG 에 못 실어서 시작할 때 한 번 글자로 (RtStats_ReportNames 처럼)
+    void ReportNames() const;
+    // "CORO <번호> frame .. B resumes .." 레코드들과 아레나 사용량을 DLOG 로
+    void Report() const;
+
+    // 아래는 대기 객체용. MakeReady 는 ISR 에서도 된다
+    void MakeReady(Slot *s);
+    void AddTimer(Slot *s, Tick wake);
+
+private:
+    Slot slots_[CORO_MAX_TASKS] = {};
+    uint8_t count_ = 0;
+    Slot *ready_head_ = nullptr;
+    Slot *ready_tail_ = nullptr;
+    Slot *timers_ = nullptr;    // wake 순
+    uint32_t switches_ = 0;
+};
+
+// --- 대기 객체 ---
+
+// ms 뒤에 다시 준비 (0 이면 준비 목록 맨 뒤로, 다른 태스크에 차례를 넘김)
+struct Sleep {
+    Tick ms;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Task::Handle h) const noexcept
+    {
+        Slot *s = h.promise().slot;
+        if (ms == 0)
+            s->exec->MakeReady(s);
+        else
+            s->exec->AddTimer(s, Now() + ms);
+    }
+    void await_resume() const noexcept {}
+};
+
+inline Sleep Yield() { return Sleep{ 0 }; }
+
+// osDelayUntil 과 같음: prev + ms 에 깨어나고 prev 를 그만큼 옮긴다. 이미 지났으면 잠들지 않음
+struct SleepUntil {
+    Tick &prev;
+    Tick ms;
+
+    bool await_ready() const noexcept
+    {
+        prev += ms;
+        return (int32_t)(prev - Now()) <= 0;
+    }
+    void await_suspend(Task::Handle h) const noexcept
+    {
+        Slot *s = h.promise().slot;
+        s->exec->AddTimer(s, prev);
+    }
+    void await_resume() const noexcept {}
+};
+
+struct QueueStats {
+    uint32_t puts;
+    uint32_t gets;
+    uint32_t drops;             // 가득 차서 TryPut 이 버린 것
+    uint16_t max_depth;
+};
+
+// 고정 크기 큐. 잠든 쪽은 대기 객체 (코루틴 프레임 안) 를 줄로 엮어 두므로 큐에 따로 자리가 없다.
+// 잠든 꺼내는 쪽이 있으면 값은 버퍼를 거치지 않고 그 대기 객체로 바로 간다.
+template <typename T, size_t N>
+class Queue {
+    static_assert(N >= 1 && N <= 255, "큐 깊이 1 ~ 255");
+
+    struct Waiter {
+        Queue *q;
+        Slot *slot;
+        Waiter *next;
+        T value;
+    };
+
+    static void Append(Waiter *&head, Waiter *w)
+    {
+        Waiter **p = &head;
+        while (*p)
+            p = &(*p)->next;
+        *p = w;
+    }
+
+    static Waiter *PopWaiter(Waiter *&head)
+    {
+        Waiter *w = head;
+        head = w->next;
+        return w;
+    }
+
+    void Push(const T &v)
+    {
+        buf_[(head_ + count_) % N] = v;
+        count_++;
+        if (count_ > stats_.max_depth)
+            stats_.max_depth = count_;
+    }
+
+    T Pop()
+    {
+        T v = buf_[head_];
+        head_ = (uint8_t)((head_ + 1) % N);
+        count_--;
+        return v;
+    }
+
+    // 넣기: 잠든 꺼내는 쪽에 주거나 버퍼에. 가득 차면 false (잠금 안에서)
+    bool PutLocked(const T &v)
+    {
+        if (getters_) {
+            Waiter *g = PopWaiter(getters_);
+            g->value = v;
+            g->slot->exec->MakeReady(g->slot);
+        } else if (count_ < N) {
+            Push(v);
+        } else {
+            return false;
+        }
+        stats_.puts++;
+        return true;
+    }
+
+    // 꺼내기: 비어 있으면 false. 자리가 나면 잠든 넣는 쪽의 값을 버퍼에 넣고 깨운다 (잠금 안에서)
+    bool GetLocked(T &out)
+    {
+        if (count_ == 0)
+            return false;
+        out = Pop();
+        stats_.gets++;
+        if (putters_) {
+            Waiter *p = PopWaiter(putters_);
+            Push(p->value);
+            stats_.puts++;
+            p->slot->exec->MakeReady(p->slot);
+        }
+        return true;
+    }
+
+public:
+    struct GetAwaiter : Waiter {
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(Task::Handle h) noexcept
+        {
+            CORO_LOCK();
+            bool wait = !this->q->GetLocked(this->value);
+            if (wait) {
+                this->slot = h.promise().slot;
+                Append(this->q->getters_, this);
+            }
+            CORO_UNLOCK();
+            return wait;
+        }
+        T await_resume() const noexcept { return this->value; }
+    };
+
+    struct PutAwaiter : Waiter {
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(Task::Handle h) noexcept
+        {
+            CORO_LOCK();
+            bool wait = !this->q->PutLocked(this->value);
+            if (wait) {
+                this->slot = h.promise().slot;
+                Append(this->q->putters_, this);
+            }
+            CORO_UNLOCK();
+            return wait;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    // co_await q.Get(): 비어 있으면 값이 올 때까지 잠든다
+    GetAwaiter Get() { return GetAwaiter{ { this, nullptr, nullptr, T{} } }; }
+    // co_await q.Put(v): 가득 차 있으면 자리가 날 때까지 잠든다
+    PutAwaiter Put(const T &v) { return PutAwaiter{ { this, nullptr, nullptr, v } }; }
+
+    // 잠들지 않는 넣기 (osMessagePut(.., 0) 자리, ISR 에서도). 가득 차면 버리고 false
+    bool TryPut(const T &v)
+    {
+        CORO_LOCK();
+        bool ok = PutLocked(v);
+        if (!ok)
+            stats_.drops++;
+        CORO_UNLOCK();
+        return ok;
+    }
+
+    uint32_t Count() const { return count_; }
+    const QueueStats &Stats() const { return stats_; }
+
+private:
+    T buf_[N] = {};
+    uint8_t head_ = 0;
+    uint8_t count_ = 0;
+    Waiter *getters_ = nullptr;
+    Waiter *putters_ = nullptr;
+    QueueStats stats_ = {};
+};
+
+} // namespace coro
+
+#endif
@@ -0,0 +1,123 @@
+#include "main.h"
+#include "dlog.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HOST_BUILD
+#define DLOG_LOCK()         do {} while (0)
+#define DLOG_UNLOCK()       do {} while (0)
+#else
+#define DLOG_LOCK()         uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define DLOG_UNLOCK()       __set_PRIMASK(primask)
+#endif
+
+extern UART_HandleTypeDef huart1;
+
+// --- 텍스트 (예전 sprintf + 전송과 같음) ---
+void DLog_Text(const char *fmt, ...)
+{
+    char msg[64];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+    if (n > (int)sizeof(msg) - 1)
+        n = sizeof(msg) - 1;
+    if (n > 0)
+        HAL_UART_Transmit(&huart1, (uint8_t*)msg, (uint16_t)n, HAL_MAX_DELAY);
+}
+
+// --- 바이너리 ---
+// 프레임 두 개를 번갈아 씀: 한쪽에 레코드를 모으는 동안 다른 쪽을 전송 (스택에 프레임을 두지 않음)
+static uint8_t frames[2][4 + DLOG_BUF + 1];
+static uint8_t active;
+static uint8_t used;
+static volatile uint8_t flushing;
+static uint32_t dropped;
+static uint32_t tx_errors;
+
+static uint8_t Leb128(uint8_t *out, uint32_t v)
+{
+    uint8_t n = 0;
+    do {
+        uint8_t b = v & 0x7Fu;
+        v >>= 7;
+        out[n++] = v ? (uint8_t)(b | 0x80u) : b;
+    } while (v);
+    return n;
+}
+
+static int Append(const uint8_t *rec, uint8_t n)
+{
+    DLOG_LOCK();
+    int fits = used + n <= DLOG_BUF;
+    if (fits) {
+        memcpy(&frames[active][4 + used], rec, n);
+        used += n;
+    }
+    DLOG_UNLOCK();
+    return fits;
+}
+
+void DLog_Write(uint32_t id, uint8_t nargs, const uint32_t *args)
+{
+    uint8_t rec[5 * (1 + DLOG_MAX_ARGS)];
+    uint8_t n = Leb128(rec, id);
+    for (uint8_t i = 0; i < nargs && i < DLOG_MAX_ARGS; i++)
+        n += Leb128(&rec[n], args[i]);
+
+    if (Append(rec, n))
+        return;
+    // 꽉 찼으면 여기서 먼저 내보냄 (다른 쪽이 전송 중이면 버림)
+    DLog_Flush();
+    if (!Append(rec, n))
+        dropped++;
+}
+
+uint32_t DLog_Flush(void)
+{
+    uint8_t *frame = NULL;
+    uint8_t n;
+    {
+        DLOG_LOCK();
+        uint8_t busy = flushing;
+        n = used;
+        if (!busy && n) {
+            flushing = 1;
+            frame = frames[active];
+            active ^= 1;
+            used = 0;
+        }
+        DLOG_UNLOCK();
+        if (busy || n == 0)
+            return 0;
+    }
+
+    frame[0] = 0xA5;
+    frame[1] = 0x5A;
+    frame[2] = DLOG_FRAME_TYPE;
+    frame[3] = n;
+    uint8_t sum = 0;
+    for (uint16_t i = 2; i < 4u + n; i++)
+        sum += frame[i];
+    frame[4 + n] = sum;
+    HAL_StatusTypeDef st = HAL_UART_Transmit(&huart1, frame, (uint16_t)(5 + n), HAL_MAX_DELAY);
+    flushing = 0;
+    if (st != HAL_OK) {
+        // 이 프레임의 레코드는 잃음 (버퍼는 이미 다른 쪽으로 넘어감)
+        tx_errors++;
+        return 0;
+    }
+    return 5u + n;
+}
+
+uint32_t DLog_Dropped(void)
+{
+    return dropped;
+}
+
+uint32_t DLog_TxErrors(void)
+{
+    return tx_errors;
+}
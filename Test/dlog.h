@@ -0,0 +1,98 @@
+#ifndef DLOG_H
+#define DLOG_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 지연 포맷 로그: MCU 는 문자열을 만들지 않고 포맷 문자열 id 와 인자만 보낸다.
+// 포맷 문자열은 dlog_fmt 섹션에 있고 id 는 그 섹션 안 오프셋 (ld 가 만드는 __start_dlog_fmt 기준).
+// 호스트 host/dlog_decode 가 펌웨어 ELF 의 dlog_fmt 섹션으로 글자를 다시 만든다.
+//
+//   DLOG("[%02d:%02d:%02d] ADC: %lu\r\n", h, m, s, adc);
+//
+// 인자: 정수만 (32 비트 이하, 8 개까지). %s %f %p, '*' 폭은 안 됨. 음수는 5 바이트로 감.
+//
+// 링커 스크립트가 그대로면 dlog_fmt 는 고아 섹션으로 플래시에 실린다. 보드 링커 스크립트 SECTIONS 에
+//   dlog_fmt 0 (INFO) : { KEEP(*(dlog_fmt)) }
+// 를 넣으면 로드되지 않아 플래시/RAM 0 바이트 (이 트리에는 링커 스크립트가 없음). 어느 쪽이든 id 는 같다.
+//
+// 레코드: id (LEB128) | 인자마다 uint32 (LEB128). 버퍼에 모았다가 DLog_Flush 에서
+// rt_stats 와 같은 꼴의 UART 프레임 하나로:
+//   0xA5 0x5A 'L' n | n 바이트 (레코드 단위) | sum(u8, 'L' 부터 합)
+// 버퍼가 차면 DLOG 가 그 자리에서 먼저 내보낸다 (블로킹, ISR 에서 부르지 말 것).
+// 다른 태스크가 전송 중이라 못 내보내면 그 레코드는 버리고 DLog_Dropped 로 센다.
+//
+// DLOG_TEXT=1 이면 예전처럼 MCU 에서 글자를 만들어 보낸다. 호스트 빌드는 기본이 텍스트
+// (시뮬레이터들이 UART 글자를 읽음), 바이너리 확인은 -DDLOG_TEXT=0 (host/dlog_bench).
+
+#ifndef DLOG_TEXT
+#ifdef HOST_BUILD
+#define DLOG_TEXT           1
+#else
+#define DLOG_TEXT           0
+#endif
+#endif
+
+#define DLOG_FRAME_TYPE     'L'
+#define DLOG_BUF            200     // 프레임 하나의 최대 내용 바이트
+#define DLOG_MAX_ARGS       8
+
+#if DLOG_TEXT
+
+#define DLOG(fmt, ...)      DLog_Text(fmt, ##__VA_ARGS__)
+
+#else
+
+// 섹션 시작을 빼서 오프셋으로 (INFO 섹션이면 0, 로드되는 섹션이면 그 주소)
+extern const char __start_dlog_fmt[];
+#define DLOG_BASE           ((uintptr_t)__start_dlog_fmt)
+
+#define DLOG_NARGS(...)     DLOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+
+#ifdef __cplusplus
+#define DLOG_WRITE(id, ...)  DLog_WriteArgs(id, ##__VA_ARGS__)
+#else
+#define DLOG_WRITE(id, ...)  DLog_Write(id, DLOG_NARGS(__VA_ARGS__), (const uint32_t[]){ 0, ##__VA_ARGS__ } + 1)
+#endif
+
+#define DLOG(fmt, ...)                                                                      \
+    do {                                                                                    \
+        static const char dlog_fmt_[] __attribute__((section("dlog_fmt"), used, aligned(1))) = fmt; \
+        DLog_Check(fmt, ##__VA_ARGS__);                                                     \
+        DLOG_WRITE((uint32_t)((uintptr_t)dlog_fmt_ - DLOG_BASE), ##__VA_ARGS__);            \
+    } while (0)
+
+#endif
+
+// 포맷/인자 검사만 (코드 없음)
+static inline __attribute__((format(printf, 1, 2))) void DLog_Check(const char *fmt, ...)
+{
+    (void)fmt;
+}
+
+__attribute__((format(printf, 1, 2))) void DLog_Text(const char *fmt, ...);
+void DLog_Write(uint32_t id, uint8_t nargs, const uint32_t *args);
+// 모인 레코드를 UART 로 (모니터 태스크 등에서 주기적으로). 보낸 바이트 수
+uint32_t DLog_Flush(void);
+uint32_t DLog_Dropped(void);
+// 전송이 실패해 프레임째 잃은 횟수
+uint32_t DLog_TxErrors(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(__cplusplus) && !DLOG_TEXT
+template <typename... T>
+static inline void DLog_WriteArgs(uint32_t id, T... args)
+{
+    const uint32_t v[] = { 0u, (uint32_t)args... };
+    DLog_Write(id, (uint8_t)sizeof...(T), v + 1);
+}
+#endif
+
+#endif
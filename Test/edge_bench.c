@@ -0,0 +1,205 @@
+#include "main.h"
+#include "edge_bench.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#endif
+
+extern UART_HandleTypeDef huart1;
+
+static uint16_t hist[EDGE_BENCH_BUCKETS];
+static EdgeBenchStats stats;
+static uint32_t target_edges;
+static uint32_t mean_gap;
+static uint32_t rng = 12345;
+static uint32_t edge_stamp;
+static volatile uint8_t armed = 0;
+static uint8_t pin_high = 0;
+static volatile uint8_t running = 0;
+
+static inline uint32_t Stamp(void)
+{
+#ifdef HOST_BUILD
+    return (uint32_t)(HostOs_NowUs() * (EDGE_BENCH_CPU_HZ / 1000000u));
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+static uint32_t NextGapUs(void)
+{
+    rng = rng * 1103515245u + 12345u;
+    uint32_t gap = mean_gap / 2 + (rng >> 8) % (mean_gap ? mean_gap : 1);
+    return gap > EDGE_BENCH_LOW_US ? gap - EDGE_BENCH_LOW_US : 1;
+}
+
+// 타이머 한 번: 내려가 있으면 상승 에지를 내고, 올라가 있으면 내려 둔다. 반환값은 다음까지 us
+static uint32_t Tick(void)
+{
+    if (pin_high) {
+        HAL_GPIO_WritePin(GPIOB, GPIO_PIN_0, GPIO_PIN_RESET);
+        pin_high = 0;
+        return EDGE_BENCH_LOW_US;
+    }
+
+    if (armed) {
+        stats.missed++;
+        armed = 0;
+    }
+    if (stats.edges >= target_edges) {
+        running = 0;
+        return 0;
+    }
+
+    stats.edges++;
+    armed = 1;
+    edge_stamp = Stamp();
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_0, GPIO_PIN_SET);
+    pin_high = 1;
+#ifdef HOST_BUILD
+    // 루프백 선 대신: PB0 → PA0 → EXTI0
+    host_gpioa.IDR |= GPIO_PIN_0;
+    HAL_GPIO_EXTI_Callback(GPIO_PIN_0);
+    host_gpioa.IDR &= ~(uint32_t)GPIO_PIN_0;
+#endif
+    return NextGapUs();
+}
+
+#ifdef HOST_BUILD
+static void HostTimerIrq(uint64_t now_us, void *ctx)
+{
+    (void)ctx;
+    uint32_t next = Tick();
+    if (running)
+        HostOs_RaiseIrq(now_us + next, HostTimerIrq, NULL);
+}
+#else
+void TIM2_IRQHandler(void)
+{
+    TIM2->SR = ~TIM_SR_UIF;
+    uint32_t next = Tick();
+    if (running)
+        TIM2->ARR = next - 1;       // ARPE=0 이라 바로 적용, 카운터는 방금 0 으로 돌아옴
+    else
+        TIM2->CR1 &= ~TIM_CR1_CEN;
+}
+#endif
+
+void EdgeBench_Start(uint32_t count, uint32_t mean_gap_us)
+{
+    memset(hist, 0, sizeof(hist));
+    memset(&stats, 0, sizeof(stats));
+    stats.min_cycles = UINT32_MAX;
+    target_edges = count;
+    mean_gap = mean_gap_us;
+    armed = 0;
+    pin_high = 0;
+    running = 1;
+
+#ifdef HOST_BUILD
+    HostOs_RaiseIrq(HostOs_NowUs() + NextGapUs(), HostTimerIrq, NULL);
+#else
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // PB0: 루프백 출력 (PA0 에 연결)
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_0, GPIO_PIN_RESET);
+    GPIO_InitStruct.Pin = GPIO_PIN_0;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+    // TIM2: 1 MHz 카운트, 업데이트 인터럽트 (APB1 x2 = 72 MHz)
+    __HAL_RCC_TIM2_CLK_ENABLE();
+    TIM2->CR1 = 0;
+    TIM2->PSC = EDGE_BENCH_CPU_HZ / 1000000u - 1;
+    TIM2->ARR = NextGapUs() - 1;
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->SR = 0;
+    TIM2->DIER = TIM_DIER_UIE;
+    HAL_NVIC_SetPriority(TIM2_IRQn, 15, 0);     // 측정 대상 경로보다 낮게
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+    TIM2->CR1 = TIM_CR1_CEN;
+#endif
+}
+
+void EdgeBench_MarkOutput(void)
+{
+    uint32_t now = Stamp();
+    if (!armed)
+        return;
+    armed = 0;
+
+    uint32_t d = now - edge_stamp;
+    stats.outputs++;
+    stats.total_cycles += d;
+    if (d < stats.min_cycles) stats.min_cycles = d;
+    if (d > stats.max_cycles) stats.max_cycles = d;
+    uint32_t b = d / EDGE_BENCH_BUCKET_CYCLES;
+    if (b < EDGE_BENCH_BUCKETS) {
+        if (hist[b] < UINT16_MAX) hist[b]++;
+    } else {
+        stats.overflow++;
+    }
+}
+
+int EdgeBench_Done(void)
+{
+    return target_edges && !running;
+}
+
+void EdgeBench_GetStats(EdgeBenchStats *out)
+{
+    *out = stats;
+}
+
+uint32_t EdgeBench_Percentile(uint32_t p)
+{
+    if (stats.outputs == 0)
+        return 0;
+    uint32_t want = (stats.outputs * p + 99) / 100;
+    uint32_t seen = 0;
+    for (uint32_t b = 0; b < EDGE_BENCH_BUCKETS; b++) {
+        seen += hist[b];
+        if (seen >= want) {
+            uint32_t top = (b + 1) * EDGE_BENCH_BUCKET_CYCLES;
+            return top < stats.max_cycles ? top : stats.max_cycles;
+        }
+    }
+    return stats.max_cycles;
+}
+
+static uint32_t CyclesToNs(uint32_t cycles)
+{
+    return (uint32_t)((uint64_t)cycles * 1000u / (EDGE_BENCH_CPU_HZ / 1000000u));
+}
+
+void EdgeBench_Report(void)
+{
+    char msg[96];
+    uint32_t p50 = EdgeBench_Percentile(50);
+    uint32_t p99 = EdgeBench_Percentile(99);
+
+    snprintf(msg, sizeof(msg), "EDGE n %lu out %lu miss %lu  min/p50/p99/max %lu/%lu/%lu/%lu cyc\r\n",
+             (unsigned long)stats.edges, (unsigned long)stats.outputs, (unsigned long)stats.missed,
+             (unsigned long)(stats.outputs ? stats.min_cycles : 0), (unsigned long)p50,
+             (unsigned long)p99, (unsigned long)stats.max_cycles);
+    HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
+    snprintf(msg, sizeof(msg), "EDGE p99 %lu ns  max %lu ns  overflow %lu\r\n",
+             (unsigned long)CyclesToNs(p99), (unsigned long)CyclesToNs(stats.max_cycles),
+             (unsigned long)stats.overflow);
+    HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
+
+    for (uint32_t b = 0; b < EDGE_BENCH_BUCKETS; b++) {
+        if (!hist[b])
+            continue;
+        snprintf(msg, sizeof(msg), "EDGE %4lu-%4lu cyc %5u\r\n",
+                 (unsigned long)(b * EDGE_BENCH_BUCKET_CYCLES),
+                 (unsigned long)((b + 1) * EDGE_BENCH_BUCKET_CYCLES - 1), hist[b]);
+        HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
+    }
+}
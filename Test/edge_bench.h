@@ -0,0 +1,41 @@
+#ifndef EDGE_BENCH_H
+#define EDGE_BENCH_H
+
+#include <stdint.h>
+
+// 버튼 경로 반응 시간 측정 (루프백)
+// 타깃: PB0 출력을 PA0(EXTI0) 에 선으로 연결하고, TIM2 인터럽트(가장 낮은 우선순위)가
+//       임의 간격으로 PB0 에 상승 에지를 낸다. 에지를 낸 시각부터 응답 핸들러가 출력을
+//       바꾼 시각(EdgeBench_MarkOutput)까지를 DWT 사이클로 잰다.
+// 호스트(HOST_BUILD): 같은 코드가 host_os 인터럽트로 에지를 내고 EXTI 콜백을 직접 부른다.
+//       가상 시간을 EDGE_BENCH_CPU_HZ 사이클로 환산하므로 분해능은 1 us.
+//
+// 메인 루프를 건드리지 않으려고 히스토그램은 고정 크기 (버킷 하나 = EDGE_BENCH_BUCKET_CYCLES)
+
+#define EDGE_BENCH_CPU_HZ           72000000u
+#define EDGE_BENCH_BUCKETS          256
+#define EDGE_BENCH_BUCKET_CYCLES    8       // 256 x 8 = 2048 사이클 (28 us) 까지, 그 위는 overflow
+#define EDGE_BENCH_LOW_US           50      // 다음 상승 에지 전에 내려 두는 시간
+
+typedef struct {
+    uint32_t edges;
+    uint32_t outputs;
+    uint32_t missed;            // 다음 에지까지 출력이 안 나온 것
+    uint32_t overflow;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} EdgeBenchStats;
+
+// count 개의 에지를 평균 mean_gap_us 간격(0.5~1.5 배)으로 낸다
+void EdgeBench_Start(uint32_t count, uint32_t mean_gap_us);
+// 응답 출력을 바꾼 직후에 부른다 (ISR 에서)
+void EdgeBench_MarkOutput(void);
+int EdgeBench_Done(void);
+void EdgeBench_GetStats(EdgeBenchStats *out);
+// p 는 0~100, 결과는 사이클 (버킷 상한, 최대값을 넘지 않음)
+uint32_t EdgeBench_Percentile(uint32_t p);
+// "EDGE n .. min/p50/p99/max .. cyc" 요약과 0 이 아닌 버킷을 UART 로
+void EdgeBench_Report(void);
+
+#endif
@@ -0,0 +1,80 @@
+#include "main.h"
+#include "fast_path.h"
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#endif
+
+static FastPathFn actions[FAST_PATH_MAX_ACTIONS];
+static uint8_t action_count = 0;
+static volatile uint32_t posted = 0;
+
+#ifdef HOST_BUILD
+static void HostPendSv(uint64_t now_us, void *ctx)
+{
+    (void)now_us;
+    (void)ctx;
+    FastPath_Handler();
+}
+#endif
+
+void FastPath_Init(void)
+{
+    action_count = 0;
+    posted = 0;
+#ifndef HOST_BUILD
+    HAL_NVIC_SetPriority(PendSV_IRQn, FAST_PATH_PRIORITY, 0);
+#endif
+}
+
+int FastPath_Register(FastPathFn fn)
+{
+    if (action_count >= FAST_PATH_MAX_ACTIONS || !fn)
+        return -1;
+    actions[action_count] = fn;
+    return action_count++;
+}
+
+void FastPath_Post(int id)
+{
+    if (id < 0 || id >= action_count)
+        return;
+#ifdef HOST_BUILD
+    // 호스트 인터럽트는 서로 선점하지 않으므로 지금 ISR 바로 다음 차례로
+    if (!posted)
+        HostOs_RaiseIrq(HostOs_NowUs(), HostPendSv, NULL);
+    posted |= 1u << id;
+#else
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    posted |= 1u << id;
+    __set_PRIMASK(primask);
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+#endif
+}
+
+void FastPath_Handler(void)
+{
+    uint32_t bits;
+#ifdef HOST_BUILD
+    bits = posted;
+    posted = 0;
+#else
+    __disable_irq();
+    bits = posted;
+    posted = 0;
+    __enable_irq();
+#endif
+    while (bits) {
+        int id = __builtin_ctz(bits);
+        actions[id]();
+        bits &= bits - 1;
+    }
+}
+
+#ifndef HOST_BUILD
+void PendSV_Handler(void)
+{
+    FastPath_Handler();
+}
+#endif
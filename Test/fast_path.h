@@ -0,0 +1,26 @@
+#ifndef FAST_PATH_H
+#define FAST_PATH_H
+
+#include <stdint.h>
+
+// 인터럽트 지연 처리 경로 (RTOS 없는 펌웨어용)
+// EXTI 같은 ISR 은 FastPath_Post 로 액션만 걸고 바로 빠진다. 걸린 액션은 PendSV 에서
+// EXTI 바로 아래 우선순위로 실행되므로 메인 루프의 잡(OLED 전송 등)이 얼마나 길든
+// 수 us 안에 출력이 나간다. 느린 후속 처리(UART 보고)는 액션에서 Coop_Signal 로 넘긴다.
+//
+// PendSV 를 쓰므로 FreeRTOS 펌웨어(sys.c, FREE_RTOS.c)에는 쓰지 않는다.
+
+#define FAST_PATH_MAX_ACTIONS   8
+#define FAST_PATH_PRIORITY      2       // EXTI0(1) 보다 낮고, SysTick/TIM 보다 높게
+
+typedef void (*FastPathFn)(void);
+
+void FastPath_Init(void);
+// 반환값은 액션 id, 자리가 없으면 -1
+int FastPath_Register(FastPathFn fn);
+// ISR 에서 호출, 같은 액션이 실행 전에 여러 번 걸리면 한 번만 실행
+void FastPath_Post(int id);
+// 타깃에서는 PendSV_Handler 가 부른다
+void FastPath_Handler(void);
+
+#endif
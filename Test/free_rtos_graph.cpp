@@ -0,0 +1,47 @@
+// free_rtos_graph.cpp
+// FREE_RTOS.c 의 태스크 / 큐 그래프. 스택 크기는 타깃과 같은 바이너리 DLOG (-DDLOG_TEXT=0) 로 잰
+// host/stack_size 권장값, 바꾼 뒤에는 타깃 StackMon 리포트로 다시 확인
+#include "task_graph.hpp"
+#include "free_rtos_graph.h"
+
+extern "C" {
+void StartLedTask(void const *argument);
+void StartUartTask(void const *argument);
+void StartAdcTask(void const *argument);
+void StartMonitorTask(void const *argument);
+}
+
+namespace {
+
+using tg::Use;
+
+// adcQueue: 100 ms 샘플을 UART 가 1 초마다 다 꺼내므로 1 초치(10 개)보다 깊게
+constexpr tg::Graph<4, 1, 2> kFreeRtosGraph = {
+    {{
+        { "led",     StartLedTask,     osPriorityLow,          64 },
+        { "uart",    StartUartTask,    osPriorityNormal,       80 },
+        { "adc",     StartAdcTask,     osPriorityAboveNormal,  64 },
+        { "monitor", StartMonitorTask, osPriorityIdle,        352 },   // 시작할 때 이름 줄의 snprintf / vsnprintf
+    }},
+    {{
+        { "adcQueue", 16, sizeof(uint16_t) },
+    }},
+    {{
+        { "adc",  Use::Put, "adcQueue" },
+        { "uart", Use::Get, "adcQueue" },
+    }},
+};
+
+static_assert(tg::StageIndex(kFreeRtosGraph, "led") == FRT_TASK_LED &&
+              tg::StageIndex(kFreeRtosGraph, "uart") == FRT_TASK_UART &&
+              tg::StageIndex(kFreeRtosGraph, "adc") == FRT_TASK_ADC &&
+              tg::StageIndex(kFreeRtosGraph, "monitor") == FRT_TASK_MONITOR &&
+              kFreeRtosGraph.stages.size() == FRT_TASK_COUNT,
+              "free_rtos_graph.h 태스크 번호가 그래프 순서와 다름");
+static_assert(tg::QueueIndex(kFreeRtosGraph, "adcQueue") == FRT_QUEUE_ADC &&
+              kFreeRtosGraph.queues.size() == FRT_QUEUE_COUNT,
+              "free_rtos_graph.h 큐 번호가 그래프 순서와 다름");
+
+} // namespace
+
+TASK_GRAPH_EXPORT(kFreeRtosGraph)
@@ -0,0 +1,21 @@
+#ifndef FREE_RTOS_GRAPH_H
+#define FREE_RTOS_GRAPH_H
+
+#include "task_graph.h"
+
+// FREE_RTOS.c 의 태스크 / 큐 번호 (free_rtos_graph.cpp 그래프에 적은 순서, static_assert 로 맞춤)
+//   adc -> adcQueue -> uart, led / monitor 는 큐 없음
+enum {
+  FRT_TASK_LED,
+  FRT_TASK_UART,
+  FRT_TASK_ADC,
+  FRT_TASK_MONITOR,
+  FRT_TASK_COUNT
+};
+
+enum {
+  FRT_QUEUE_ADC,
+  FRT_QUEUE_COUNT
+};
+
+#endif
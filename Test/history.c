@@ -0,0 +1,268 @@
+#include "main.h"
+#include "history.h"
+#include <string.h>
+
+extern UART_HandleTypeDef huart1;
+
+static HistoryBlock blocks[HISTORY_BLOCKS];
+static uint16_t block_bits[HISTORY_BLOCKS];     // 블록마다 data 에 쓴 비트
+static uint8_t head;                // 쓰고 있는 블록
+static uint8_t nblocks;             // 쓰고 있는 것 포함
+static uint16_t pend[HISTORY_GROUP];    // 아직 묶지 않은 원값
+static uint8_t npend;
+static uint16_t prev;               // 블록에 들어간 마지막 샘플
+static uint32_t total;
+static uint32_t dump_seq;
+static uint8_t dumping;
+static uint8_t frame[4 + HISTORY_BLOCK_BYTES + 1];
+
+void History_Init(void)
+{
+    memset(blocks, 0, sizeof(blocks));
+    memset(block_bits, 0, sizeof(block_bits));
+    head = nblocks = npend = 0;
+    prev = 0;
+    total = 0;
+    dumping = 0;
+}
+
+static uint8_t Tail(void)
+{
+    return (uint8_t)((head + HISTORY_BLOCKS - (nblocks - 1)) % HISTORY_BLOCKS);
+}
+
+static HistoryBlock *At(uint8_t k)      // k 번째로 오래된 블록
+{
+    return &blocks[(Tail() + k) % HISTORY_BLOCKS];
+}
+
+// --- 비트 (LSB 부터, w <= 13 이라 바이트 세 개 안에 들어감) ---
+static void PutBits(uint8_t *data, uint16_t pos, uint16_t v, uint8_t w)
+{
+    uint32_t x = (uint32_t)v << (pos & 7);
+    uint16_t i = pos >> 3;
+    data[i] |= (uint8_t)x;
+    if ((pos & 7) + w > 8)
+        data[i + 1] |= (uint8_t)(x >> 8);
+    if ((pos & 7) + w > 16)
+        data[i + 2] |= (uint8_t)(x >> 16);
+}
+
+static uint16_t GetBits(const uint8_t *data, uint32_t bytes, uint32_t pos, uint8_t w)
+{
+    uint32_t i = pos >> 3;
+    uint32_t x = data[i];
+    if (i + 1 < bytes) x |= (uint32_t)data[i + 1] << 8;
+    if (i + 2 < bytes) x |= (uint32_t)data[i + 2] << 16;
+    return (uint16_t)((x >> (pos & 7)) & ((1u << w) - 1u));
+}
+
+static void OpenBlock(uint32_t seq, uint16_t first)
+{
+    if (nblocks == 0) {
+        head = 0;
+        nblocks = 1;
+    } else {
+        head = (uint8_t)((head + 1) % HISTORY_BLOCKS);
+        if (nblocks < HISTORY_BLOCKS)
+            nblocks++;              // 다 차면 가장 오래된 블록을 덮음
+    }
+    HistoryBlock *b = &blocks[head];
+    memset(b->data, 0, sizeof(b->data));
+    b->seq = seq;
+    b->first = first;
+    b->count = 1;
+    block_bits[head] = 0;
+    prev = first;
+}
+
+static void WriteGroup(void)
+{
+    uint16_t zz[HISTORY_GROUP];
+    uint16_t any = 0;
+    uint16_t p = prev;
+    for (uint8_t i = 0; i < HISTORY_GROUP; i++) {
+        int32_t d = (int32_t)pend[i] - (int32_t)p;
+        zz[i] = (uint16_t)(((uint32_t)d << 1) ^ (uint32_t)(d >> 31));
+        any |= zz[i];
+        p = pend[i];
+    }
+    uint8_t w = 0;
+    while (any >> w)
+        w++;
+
+    uint16_t need = 4u + HISTORY_GROUP * w;
+    if (block_bits[head] + need > HISTORY_DATA_BITS) {
+        // 블록이 참: 묶음 첫 샘플로 새 블록을 열고 나머지 7 개는 다시 기다림
+        OpenBlock(total - HISTORY_GROUP, pend[0]);
+        memmove(pend, pend + 1, (HISTORY_GROUP - 1) * sizeof(pend[0]));
+        npend = HISTORY_GROUP - 1;
+        return;
+    }
+    HistoryBlock *b = &blocks[head];
+    uint16_t pos = block_bits[head];
+    PutBits(b->data, pos, w, 4);
+    pos += 4;
+    if (w) {
+        for (uint8_t i = 0; i < HISTORY_GROUP; i++, pos += w)
+            PutBits(b->data, pos, zz[i], w);
+    }
+    block_bits[head] = pos;
+    b->count += HISTORY_GROUP;
+    prev = pend[HISTORY_GROUP - 1];
+    npend = 0;
+}
+
+void History_Append(uint16_t sample)
+{
+    sample &= 0x0FFFu;
+    if (nblocks == 0) {
+        OpenBlock(total++, sample);
+        return;
+    }
+    pend[npend++] = sample;
+    total++;
+    if (npend == HISTORY_GROUP)
+        WriteGroup();
+}
+
+// 블록 data 를 풀어서 skip 번째 샘플부터 max 개까지 out 에. 깨졌으면 그때까지 푼 수
+static uint32_t Decode(const uint8_t *data, uint32_t bytes, uint16_t first, uint16_t count,
+                       uint32_t skip, uint16_t *out, uint32_t max)
+{
+    uint32_t n = 0;
+    if (skip == 0 && max > 0)
+        out[n++] = first;
+    uint16_t v = first;
+    uint32_t pos = 0, limit = bytes * 8u;
+    uint32_t idx = 1;
+    while (idx < count && n < max) {
+        if (pos + 4 > limit)
+            break;
+        uint8_t w = (uint8_t)GetBits(data, bytes, pos, 4);
+        pos += 4;
+        if (w > 13 || pos + HISTORY_GROUP * w > limit)
+            break;
+        if (idx + HISTORY_GROUP <= skip) {
+            // 건너뛸 묶음도 값은 따라가야 함
+            for (uint8_t i = 0; i < HISTORY_GROUP; i++, pos += w) {
+                uint16_t z = w ? GetBits(data, bytes, pos, w) : 0;
+                v = (uint16_t)(v + ((z >> 1) ^ -(int16_t)(z & 1)));
+            }
+            idx += HISTORY_GROUP;
+            continue;
+        }
+        for (uint8_t i = 0; i < HISTORY_GROUP; i++, pos += w, idx++) {
+            uint16_t z = w ? GetBits(data, bytes, pos, w) : 0;
+            v = (uint16_t)(v + ((z >> 1) ^ -(int16_t)(z & 1)));
+            if (idx >= skip && n < max)
+                out[n++] = v & 0x0FFFu;
+        }
+    }
+    return n;
+}
+
+uint32_t History_Read(uint32_t seq, uint16_t *out, uint32_t max, uint32_t *first_seq)
+{
+    if (nblocks == 0 || max == 0)
+        return 0;
+    uint32_t oldest = At(0)->seq;
+    if (seq < oldest)
+        seq = oldest;
+    if (first_seq)
+        *first_seq = seq;
+    if (seq >= total)
+        return 0;
+
+    // seq 가 들어 있는 블록: 시작 번호가 seq 이하인 마지막 블록
+    uint8_t lo = 0, hi = nblocks - 1;
+    while (lo < hi) {
+        uint8_t mid = (uint8_t)((lo + hi + 1) / 2);
+        if (At(mid)->seq <= seq)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    uint32_t n = 0;
+    for (uint8_t k = lo; k < nblocks && n < max; k++) {
+        const HistoryBlock *b = At(k);
+        uint32_t want = seq + n;
+        if (want >= b->seq + b->count)
+            continue;
+        n += Decode(b->data, sizeof(b->data), b->first, b->count, want - b->seq, out + n, max - n);
+    }
+    // 아직 묶지 않은 끝부분
+    uint32_t pend_seq = blocks[head].seq + blocks[head].count;
+    for (uint8_t i = 0; i < npend && n < max; i++)
+        if (pend_seq + i >= seq + n)
+            out[n++] = pend[i];
+    return n;
+}
+
+uint32_t History_ReadLast(uint16_t *out, uint32_t n)
+{
+    return History_Read(total > n ? total - n : 0, out, n, NULL);
+}
+
+void History_GetStats(HistoryStats *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->total = total;
+    if (nblocks == 0)
+        return;
+    out->oldest = At(0)->seq;
+    out->stored = total - out->oldest;
+    out->blocks = nblocks;
+    for (uint8_t k = 0; k < nblocks; k++)
+        out->bytes += HISTORY_HEADER_BYTES + (block_bits[(Tail() + k) % HISTORY_BLOCKS] + 7u) / 8u;
+}
+
+void History_DumpStart(void)
+{
+    dump_seq = 0;
+    dumping = nblocks > 0;
+}
+
+uint32_t History_DumpStep(void)
+{
+    if (!dumping)
+        return 0;
+    // 아직 안 보낸 가장 오래된 블록 (덤프 중에 덮였으면 남은 것부터)
+    uint8_t k = 0;
+    while (k < nblocks && At(k)->seq < dump_seq)
+        k++;
+    if (k >= nblocks) {
+        dumping = 0;
+        return 0;
+    }
+    uint8_t idx = (uint8_t)((Tail() + k) % HISTORY_BLOCKS);
+    const HistoryBlock *b = &blocks[idx];
+    uint8_t n = (uint8_t)(HISTORY_HEADER_BYTES + (block_bits[idx] + 7u) / 8u);
+    frame[0] = 0xA5;
+    frame[1] = 0x5A;
+    frame[2] = HISTORY_FRAME_TYPE;
+    frame[3] = n;
+    memcpy(&frame[4], b, n);
+    uint8_t sum = 0;
+    for (uint16_t i = 2; i < 4u + n; i++)
+        sum += frame[i];
+    frame[4 + n] = sum;
+    HAL_UART_Transmit(&huart1, frame, (uint16_t)(5 + n), HAL_MAX_DELAY);
+    dump_seq = b->seq + b->count;
+    if (idx == head)
+        dumping = 0;            // 쓰고 있는 블록까지 보냈으면 끝
+    return 5u + n;
+}
+
+uint32_t History_DecodeBlock(const uint8_t *blk, uint32_t len, uint16_t *out, uint32_t max)
+{
+    if (len < HISTORY_HEADER_BYTES || len > HISTORY_BLOCK_BYTES)
+        return 0;
+    uint16_t first = (uint16_t)(blk[4] | blk[5] << 8);
+    uint16_t count = (uint16_t)(blk[6] | blk[7] << 8);
+    if (count == 0 || (count - 1u) % HISTORY_GROUP != 0)
+        return 0;
+    uint32_t n = Decode(blk + HISTORY_HEADER_BYTES, len - HISTORY_HEADER_BYTES, first, count, 0, out, max);
+    return n == count || n == max ? n : 0;
+}
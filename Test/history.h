@@ -0,0 +1,67 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 12 비트 샘플 기록을 RAM 에 압축해서 남긴다 (델타 + 비트 묶음)
+//
+// 블록 (HISTORY_BLOCK_BYTES, 메모리 모양 그대로 UART 로 보냄, 리틀 엔디언):
+//   seq(u32, 첫 샘플 번호) | first(u16, 첫 샘플 원값) | count(u16) | data
+//   data = 8 샘플 묶음의 연속 (LSB 부터): width(4 비트) | 8 x zigzag(앞 샘플과의 차) width 비트
+// 천천히 바뀌는 조도는 차가 몇 LSB 라 묶음당 4 + 8 x 3 비트 정도 (샘플당 3.5 비트),
+// 값이 그대로면 width 0 (샘플당 0.5 비트), 계단은 그 묶음만 13 비트.
+//
+// - History_Append: O(1). 8 개가 모일 때까지 원값으로 들고 있다가 한 묶음으로 씀,
+//   블록이 차면 다음 블록으로 (다 쓰면 가장 오래된 블록을 덮음)
+// - History_Read: 번호로 블록을 이분 탐색하고 그 블록 처음부터 풀어서 복사
+// - 덤프: History_DumpStart 뒤 History_DumpStep 마다 블록 하나를 프레임으로
+//     0xA5 0x5A 'H' n | 블록 앞 n 바이트 (헤더 + 쓴 data) | sum(u8, 'H' 부터 합)
+//   아직 묶음이 안 된 마지막 7 개 이하는 다음 덤프에 나감
+// 잠금 없음: Append / Read / Dump 는 같은 태스크(잡)에서 부를 것.
+
+#define HISTORY_BLOCK_BYTES     128
+#define HISTORY_BLOCKS          32          // 4 KB
+#define HISTORY_HEADER_BYTES    8
+#define HISTORY_DATA_BITS       ((HISTORY_BLOCK_BYTES - HISTORY_HEADER_BYTES) * 8)
+#define HISTORY_GROUP           8
+#define HISTORY_FRAME_TYPE      'H'
+
+typedef struct {
+    uint32_t seq;
+    uint16_t first;
+    uint16_t count;
+    uint8_t data[HISTORY_BLOCK_BYTES - HISTORY_HEADER_BYTES];
+} HistoryBlock;
+
+typedef struct {
+    uint32_t total;             // 지금까지 넣은 샘플 수 (다음 번호)
+    uint32_t oldest;            // 남아 있는 가장 오래된 번호
+    uint32_t stored;            // 남아 있는 샘플 수
+    uint32_t bytes;             // 블록에 쓴 바이트 (헤더 포함)
+    uint32_t blocks;            // 쓰고 있는 블록 수
+} HistoryStats;
+
+void History_Init(void);
+void History_Append(uint16_t sample);
+// seq 부터 최대 max 개를 out 에 (없어진 앞부분은 건너뜀), 반환값은 복사한 수. *first_seq 는 out[0] 의 번호
+uint32_t History_Read(uint32_t seq, uint16_t *out, uint32_t max, uint32_t *first_seq);
+// 가장 최근 n 개 (OLED 그래프 등), 반환값은 복사한 수
+uint32_t History_ReadLast(uint16_t *out, uint32_t n);
+void History_GetStats(HistoryStats *out);
+
+void History_DumpStart(void);
+// 블록 하나 전송, 더 보낼 게 없으면 0
+uint32_t History_DumpStep(void);
+
+// 블록 (덤프 프레임 내용) 하나를 풀기, 반환값은 푼 샘플 수 (깨졌으면 0). 호스트 디코더도 씀
+uint32_t History_DecodeBlock(const uint8_t *blk, uint32_t len, uint16_t *out, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
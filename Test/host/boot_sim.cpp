@@ -0,0 +1,109 @@
+// boot_sim.cpp
+// sub.c 슈퍼루프를 host_os 시뮬레이터에서 돌려 부팅 타임라인과 boot-to-first-sample 을 잰다
+//
+// 빌드 (원래 순차 초기화와 비교하려면 sub.c 대신 sub_1.c):
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host -Dmain=firmware_main
+//       Test/sub.c Test/boot_prof.c Test/coop_sched.c Test/fast_path.c Test/oled_text.c
+//       Test/oled_async.c Test/i2c_bus.c Test/dlog.c Test/history.c Test/oled_spark.c Test/rt_stats.c
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/calib.cpp Test/board.cpp Test/host/bsp_host.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//       Test/host/ssd1306_host.c
+//   g++ -O2 -std=c++17 -I Test/host Test/host/boot_sim.cpp *.o -pthread -o boot_sim
+// 사용: ./boot_sim [-s 가상초] [-q]
+//
+// first sample 은 펌웨어 쪽 표시와 상관없이 첫 ADC 변환 시작 시각으로 잰다 (sub_1.c 도 같은 기준).
+#include "host_os.h"
+#include "main.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" int firmware_main(void);
+
+struct BootTrace {
+    bool quiet = false;
+    uint64_t first_adc_us = 0;
+    uint64_t adc_reads = 0;
+    uint64_t first_i2c_us = 0;
+    uint64_t last_i2c_us = 0;
+    uint64_t i2c_bytes = 0;
+    uint64_t i2c_writes = 0;
+    uint64_t uart_bytes = 0;
+    uint64_t banner_us = 0;
+    char line[128];
+    size_t line_len = 0;
+};
+
+static uint16_t Adc(uint64_t now_us, void *ctx)
+{
+    BootTrace *t = (BootTrace*)ctx;
+    if (t->adc_reads++ == 0)
+        t->first_adc_us = now_us;
+    return (uint16_t)(2048 + (now_us / 1000) % 1024);
+}
+
+static void Uart(uint64_t now_us, const uint8_t *data, uint16_t len, void *ctx)
+{
+    BootTrace *t = (BootTrace*)ctx;
+    t->uart_bytes += len;
+    for (uint16_t i = 0; i < len; i++) {
+        char c = (char)data[i];
+        if (c == '\n' || t->line_len == sizeof(t->line) - 1) {
+            t->line[t->line_len] = '\0';
+            if (t->line_len && t->line[t->line_len - 1] == '\r')
+                t->line[--t->line_len] = '\0';
+            if (!t->banner_us && strstr(t->line, "System Initialized"))
+                t->banner_us = now_us;
+            if (!t->quiet)
+                printf("%10.3f ms  %s\n", now_us / 1000.0, t->line);
+            t->line_len = 0;
+        } else if (c) {
+            t->line[t->line_len++] = c;
+        }
+    }
+}
+
+static void I2c(uint64_t now_us, uint16_t, const uint8_t *, uint16_t len, void *ctx)
+{
+    BootTrace *t = (BootTrace*)ctx;
+    if (!t->i2c_writes++)
+        t->first_i2c_us = now_us;
+    t->last_i2c_us = now_us;
+    t->i2c_bytes += len;
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 2;
+    BootTrace trace;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:q")) != -1) {
+        switch (opt) {
+            case 's': seconds = atof(optarg); break;
+            case 'q': trace.quiet = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-s sec] [-q]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    HostOs_SetAdc(Adc, &trace);
+    HostOs_SetUart(Uart, &trace);
+    HostOs_SetI2c(I2c, &trace);
+    HostOs_Run(firmware_main, (uint64_t)(seconds * 1e6));
+
+    printf("-- boot-to-first-sample  %10.3f ms\n", trace.first_adc_us / 1000.0);
+    if (trace.banner_us)
+        printf("-- boot-to-banner        %10.3f ms\n", trace.banner_us / 1000.0);
+    if (trace.i2c_writes)
+        printf("-- i2c %llu writes, %llu bytes, %.3f ~ %.3f ms\n",
+               (unsigned long long)trace.i2c_writes, (unsigned long long)trace.i2c_bytes,
+               trace.first_i2c_us / 1000.0, trace.last_i2c_us / 1000.0);
+    printf("-- %llu samples, %llu uart bytes in %.1f s\n",
+           (unsigned long long)trace.adc_reads, (unsigned long long)trace.uart_bytes, seconds);
+    return 0;
+}
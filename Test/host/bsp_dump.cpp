@@ -0,0 +1,46 @@
+// bsp_dump.cpp
+// Board_Init() 가 어떤 레지스터를 어떤 순서로 쓰는지 출력 (HAL MX_*_Init 과 비교용)
+//
+// 빌드:
+//   g++ -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host
+//       Test/host/bsp_dump.cpp Test/host/bsp_host.cpp Test/board.cpp -o bsp_dump
+#include "board.h"
+#include "bsp.hpp"
+
+#include <cstdio>
+
+static const char *Name(uint32_t a)
+{
+    static char buf[32];
+    struct { uint32_t base; const char *name; } periph[] = {
+        { bsp::addr::NVIC_IPR, "NVIC_IPR" }, { bsp::addr::NVIC_ISER, "NVIC_ISER" },
+        { bsp::addr::RCC, "RCC" },
+        { bsp::addr::GpioBase(0), "GPIOA" }, { bsp::addr::GpioBase(1), "GPIOB" },
+        { bsp::addr::GpioBase(2), "GPIOC" },
+        { 0x40010000, "AFIO" }, { bsp::addr::EXTI, "EXTI" },
+        { bsp::addr::UsartBase(1), "USART1" }, { bsp::addr::UsartBase(2), "USART2" },
+        { bsp::addr::AdcBase(1), "ADC1" }, { bsp::addr::AdcBase(2), "ADC2" },
+    };
+    for (auto &p : periph) {
+        if (a >= p.base && a < p.base + 0x400) {
+            snprintf(buf, sizeof(buf), "%s+0x%02X", p.name, (unsigned)(a - p.base));
+            return buf;
+        }
+    }
+    snprintf(buf, sizeof(buf), "0x%08X", (unsigned)a);
+    return buf;
+}
+
+int main()
+{
+    Board_Init();
+
+    size_t writes = 0, reads = 0;
+    for (const bsp::reg::Access &a : bsp::reg::Log()) {
+        printf("%s %-16s %s0x%08X\n", a.write ? "W" : "R", Name(a.addr),
+               a.width == 1 ? "(8) " : "", (unsigned)a.value);
+        (a.write ? writes : reads)++;
+    }
+    printf("-- %zu writes, %zu reads\n", writes, reads);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// bsp_host.cpp
+// bsp.hpp 의 호스트 백엔드: 레지스터 쓰기를 순서대로 기록하고, 읽기는 마지막 쓴 값 또는 리셋값을 돌려준다
+// 상태 비트 몇 개(USART TXE, ADC EOC, ADC RSTCAL / CAL 자동 클리어)는 펌웨어가 멈추지 않게 흉내낸다.
+#include "bsp.hpp"
+
+#include <unordered_map>
+
+namespace bsp {
+namespace reg {
+
+static std::vector<Access> log_;
+static std::unordered_map<uint32_t, uint32_t> regs_;
+
+static bool IsGpioCr(uint32_t a)
+{
+    return a >= addr::GPIOA && a < addr::GpioBase(5) &&
+           ((a - addr::GPIOA) % addr::GPIO_STRIDE == addr::GPIO_CRL ||
+            (a - addr::GPIOA) % addr::GPIO_STRIDE == addr::GPIO_CRH);
+}
+
+static uint32_t ResetValue(uint32_t a)
+{
+    if (IsGpioCr(a)) return 0x44444444;
+    for (int n = 1; n <= 3; n++)
+        if (a == addr::UsartBase(n) + addr::USART_SR) return 0xC0;     // TXE | TC
+    return 0;
+}
+
+void Write(uint32_t a, uint32_t value)
+{
+    log_.push_back({ a, value, 4, true });
+    for (int n = 1; n <= 2; n++) {
+        uint32_t base = addr::AdcBase(n);
+        if (a == base + addr::ADC_CR2) {
+            value &= ~(bits::ADC_CR2_CAL | bits::ADC_CR2_RSTCAL);  // 보정 / 보정 초기화는 바로 끝난 것으로
+            if (value & bits::ADC_CR2_SWSTART) {
+                value &= ~bits::ADC_CR2_SWSTART;
+                regs_[base + addr::ADC_SR] |= bits::ADC_SR_EOC;
+            }
+        }
+    }
+    regs_[a] = value;
+}
+
+void Write8(uint32_t a, uint8_t value)
+{
+    log_.push_back({ a, value, 1, true });
+    uint32_t word = a & ~3u;
+    uint32_t shift = (a & 3u) * 8u;
+    uint32_t cur = regs_.count(word) ? regs_[word] : ResetValue(word);
+    regs_[word] = (cur & ~(0xFFu << shift)) | ((uint32_t)value << shift);
+}
+
+uint32_t Read(uint32_t a)
+{
+    auto it = regs_.find(a);
+    uint32_t v = it != regs_.end() ? it->second : ResetValue(a);
+    log_.push_back({ a, v, 4, false });
+    return v;
+}
+
+const std::vector<Access> &Log()
+{
+    return log_;
+}
+
+void ClearLog()
+{
+    log_.clear();
+}
+
+void Preset(uint32_t a, uint32_t value)
+{
+    regs_[a] = value;
+}
+
+} // namespace reg
+} // namespace bsp
@@ -0,0 +1,137 @@
+// calib_bench.cpp
+// calib.cpp 정확도 검사와 처리량 비교
+//
+// 정확도: VDDA 를 2.0 ~ 3.6 V 로 바꿔가며 VREFINT raw 를 흉내내 넣고, raw 0~4095 전부에 대해
+//   - mV: 고정소수점 결과와 raw * VDDA / 4095 (double) 의 차이, VREFINT 보정 없이 3.3 V 로 가정했을 때와 비교
+//   - 럭스: 테이블 보간과 보정점 구간 선형 (double) 의 차이 (격자 간격 때문에 생기는 오차)
+//   허용치를 넘으면 종료 코드 1
+// 처리량: raw -> 럭스 한 번에 걸리는 시간, float 보간(구간 탐색)과 비교
+//
+// 빌드:
+//   g++ -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host
+//       Test/host/calib_bench.cpp Test/calib.cpp -o calib_bench
+#include "board.hpp"
+#include "calib.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// 허용치: mV 는 VREFINT 양자화(±0.5 count ≈ 0.04%) 몫, 럭스는 풀스케일 대비
+static const double kMvTolMv = 2.0;
+static const double kLuxTolFullScale = 0.01;
+
+// 보정점 구간 선형 (기준값)
+static double RefLux(double mv)
+{
+    const auto &p = Board::light_curve;
+    if (mv <= p[0].x)
+        return p[0].y_milli / 1000.0;
+    for (size_t i = 1; i < p.size(); i++) {
+        if (mv <= p[i].x) {
+            double t = (mv - p[i - 1].x) / (double)(p[i].x - p[i - 1].x);
+            return (p[i - 1].y_milli + t * ((double)p[i].y_milli - p[i - 1].y_milli)) / 1000.0;
+        }
+    }
+    return p[p.size() - 1].y_milli / 1000.0;
+}
+
+// 비교용: float 로 매번 구간을 찾아 보간하는 흔한 구현
+static float FloatLux(uint16_t raw, float vdda_mv)
+{
+    static float xs[Board::light_curve.size()], ys[Board::light_curve.size()];
+    static bool init = false;
+    if (!init) {
+        for (size_t i = 0; i < Board::light_curve.size(); i++) {
+            xs[i] = (float)Board::light_curve[i].x;
+            ys[i] = Board::light_curve[i].y_milli / 1000.0f;
+        }
+        init = true;
+    }
+    float mv = raw * vdda_mv / 4095.0f;
+    const size_t n = Board::light_curve.size();
+    if (mv <= xs[0]) return ys[0];
+    for (size_t i = 1; i < n; i++)
+        if (mv <= xs[i])
+            return ys[i - 1] + (mv - xs[i - 1]) * (ys[i] - ys[i - 1]) / (xs[i] - xs[i - 1]);
+    return ys[n - 1];
+}
+
+static double Q16(uint32_t q) { return q / 65536.0; }
+
+int main()
+{
+    int failed = 0;
+
+    printf("%-6s %6s %12s %12s %12s %9s\n", "VDDA", "vref", "mV err max", "no-vref err", "lux err max", "@mV");
+    const double full_scale = Board::light_curve[Board::light_curve.size() - 1].y_milli / 1000.0;
+    for (double vdda = 2000; vdda <= 3600; vdda += 200) {
+        // VREFINT 는 실제 변환처럼 반올림된 값, IIR 이 자리잡도록 여러 번
+        uint16_t vref = (uint16_t)lround(Board::vrefint_mv * 4095.0 / vdda);
+        for (int i = 0; i < 64; i++)
+            Calib_SetVrefint(vref);
+
+        double mv_err = 0, nominal_err = 0, lux_err = 0, lux_err_at = 0;
+        for (uint32_t raw = 0; raw < 4096; raw++) {
+            double mv = raw * vdda / 4095.0;
+            double got_mv = Q16(Calib_RawToMvQ16((uint16_t)raw));
+            mv_err = std::fmax(mv_err, std::fabs(got_mv - mv));
+            nominal_err = std::fmax(nominal_err, std::fabs(raw * (double)Board::vdda_mv / 4095.0 - mv));
+
+            // 럭스 오차는 mV 오차와 분리해서 테이블 자체만 본다
+            double lux = Q16(Calib_MvToLuxQ16(Calib_RawToMvQ16((uint16_t)raw)));
+            double err = std::fabs(lux - RefLux(got_mv));
+            if (err > lux_err) {
+                lux_err = err;
+                lux_err_at = got_mv;
+            }
+        }
+        bool ok = mv_err <= kMvTolMv && lux_err <= kLuxTolFullScale * full_scale;
+        failed |= !ok;
+        printf("%4.0fmV %6u %9.3f mV %9.1f mV %8.2f lx %7.0f %s\n", vdda, vref, mv_err, nominal_err,
+               lux_err, lux_err_at, ok ? "" : "FAIL");
+    }
+
+    // 보정점 위에서는 테이블이 보정값을 거의 그대로 내야 함 (격자 위의 점만)
+    Calib_SetVrefint((uint16_t)lround(Board::vrefint_mv * 4095.0 / Board::vdda_mv));
+    for (const cal::Point &p : Board::light_curve) {
+        if (p.x % (1u << Board::LightGrid::shift) != 0)
+            continue;
+        double got = Q16(Calib_MvToLuxQ16(CALIB_Q16(p.x)));
+        if (std::fabs(got - p.y_milli / 1000.0) > 0.001) {
+            printf("grid point %u mV: %.4f lx, expected %.3f\n", p.x, got, p.y_milli / 1000.0);
+            failed = 1;
+        }
+    }
+
+    // --- 처리량 ---
+    const int rounds = 2000;
+    std::vector<uint16_t> raws(4096);
+    for (uint32_t i = 0; i < raws.size(); i++)
+        raws[i] = (uint16_t)((i * 2654435761u) >> 20);      // 순서를 섞어 분기 예측을 덜 타게
+
+    volatile uint32_t sink_q = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (uint16_t raw : raws)
+            sink_q = sink_q + Calib_RawToLuxQ16(raw);
+    auto t1 = std::chrono::steady_clock::now();
+
+    volatile float sink_f = 0;
+    for (int r = 0; r < rounds; r++)
+        for (uint16_t raw : raws)
+            sink_f = sink_f + FloatLux(raw, (float)Board::vdda_mv);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double n = (double)rounds * raws.size();
+    double q_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    double f_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / n;
+    printf("raw->lux: fixed LUT %.2f ns/op, float search %.2f ns/op (x%.1f)\n", q_ns, f_ns, f_ns / q_ns);
+    printf("table: %zu entries, %zu bytes flash\n", Board::LightGrid::size,
+           Board::LightGrid::size * sizeof(int32_t));
+
+    (void)sink_q;
+    (void)sink_f;
+    return failed;
+}
@@ -0,0 +1,121 @@
+// cmsis_os.h (호스트용)
+// sys.c / FREE_RTOS.c / maung.c 가 쓰는 CMSIS-RTOS v1 API 만 흉내낸 것
+// 구현은 host_os.c (가상 시간 + 우선순위 스케줄러)
+#ifndef CMSIS_OS_H
+#define CMSIS_OS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define configCHECK_FOR_STACK_OVERFLOW  0
+#define osWaitForever                   0xFFFFFFFFu
+
+typedef enum {
+    osPriorityIdle          = -3,
+    osPriorityLow           = -2,
+    osPriorityBelowNormal   = -1,
+    osPriorityNormal        =  0,
+    osPriorityAboveNormal   = +1,
+    osPriorityHigh          = +2,
+    osPriorityRealtime      = +3,
+    osPriorityError         = 0x84
+} osPriority;
+
+typedef enum {
+    osOK                    = 0,
+    osEventSignal           = 0x08,
+    osEventMessage          = 0x10,
+    osEventMail             = 0x20,
+    osEventTimeout          = 0x40,
+    osErrorParameter        = 0x80,
+    osErrorResource         = 0x81,
+    osErrorTimeoutResource  = 0xC1,
+    osErrorISR              = 0x82,
+    osErrorValue            = 0x86,
+    osErrorNoMemory         = 0x85,
+    osErrorOS               = 0xFF
+} osStatus;
+
+typedef void (*os_pthread)(void const *argument);
+
+typedef struct HostTask *osThreadId;
+typedef struct HostQueue *osMessageQId;
+
+// 정적 생성 (configSUPPORT_STATIC_ALLOCATION): STM32Cube cmsis_os.h 와 같은 필드.
+// 제어 블록 크기는 Cortex-M3 의 StaticTask_t / StaticQueue_t 정도, 호스트에서는 쓰지 않음
+#define configSUPPORT_STATIC_ALLOCATION 1
+typedef struct { uint32_t reserved[24]; } osStaticThreadDef_t;
+typedef struct { uint32_t reserved[20]; } osStaticMessageQDef_t;
+
+typedef struct os_thread_def {
+    const char *name;
+    os_pthread pthread;
+    osPriority tpriority;
+    uint32_t instances;
+    uint32_t stacksize;     // 워드 단위 (FreeRTOS 포트와 동일)
+    uint32_t *buffer;       // 둘 다 있으면 정적 생성
+    osStaticThreadDef_t *controlblock;
+} osThreadDef_t;
+
+typedef struct os_messageQ_def {
+    uint32_t queue_sz;
+    uint32_t item_sz;
+    uint8_t *buffer;
+    osStaticMessageQDef_t *controlblock;
+} osMessageQDef_t;
+
+typedef struct {
+    osStatus status;
+    union {
+        uint32_t v;
+        void *p;
+        int32_t signals;
+    } value;
+    union {
+        osMessageQId message_id;
+    } def;
+} osEvent;
+
+#define osThreadDef(name, thread, priority, instances, stacksz)  \
+    const osThreadDef_t os_thread_def_##name =                  \
+    { #name, (thread), (priority), (instances), (stacksz) }
+#define osThread(name)  &os_thread_def_##name
+#define osThreadStaticDef(name, thread, priority, instances, stacksz, buffer, control)  \
+    const osThreadDef_t os_thread_def_##name =                                        \
+    { #name, (thread), (priority), (instances), (stacksz), (buffer), (control) }
+
+#define osMessageQDef(name, queue_sz, type)                      \
+    const osMessageQDef_t os_messageQ_def_##name =              \
+    { (queue_sz), sizeof(type) }
+#define osMessageQStaticDef(name, queue_sz, type, buffer, control)  \
+    const osMessageQDef_t os_messageQ_def_##name =                  \
+    { (queue_sz), sizeof(type), (buffer), (control) }
+#define osMessageQ(name)  &os_messageQ_def_##name
+
+osStatus osKernelStart(void);
+uint32_t osKernelSysTick(void);
+
+osThreadId osThreadCreate(const osThreadDef_t *thread_def, void *argument);
+osThreadId osThreadGetId(void);
+osStatus osDelay(uint32_t millisec);
+osStatus osDelayUntil(uint32_t *PreviousWakeTime, uint32_t millisec);
+
+osMessageQId osMessageCreate(const osMessageQDef_t *queue_def, osThreadId thread_id);
+osStatus osMessagePut(osMessageQId queue_id, uint32_t info, uint32_t millisec);
+osEvent osMessageGet(osMessageQId queue_id, uint32_t millisec);
+// FREE_RTOS.c 에서 쓰는 형태 (값을 꺼내지 않고 복사만)
+osStatus osMessagePeek(osMessageQId queue_id, void *buf, uint32_t millisec);
+
+// FreeRTOS 네이티브 API 중 쓰는 것
+typedef void *TaskHandle_t;
+typedef unsigned long UBaseType_t;
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
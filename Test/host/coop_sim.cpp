@@ -0,0 +1,160 @@
+// coop_sim.cpp
+// 슈퍼루프 펌웨어(sub.c)에 버튼 인터럽트를 넣어 가며 돌리고
+// 버튼 → LED(PC13) 반응 지연 분포와 잡별 실행 시간 / 지연 통계를 출력
+//
+// 빌드 (예전 while(1) + HAL_Delay(500) 구조와 비교하려면 sub.c 대신 sub_1.c, coop_sched.c 는 빼도 됨):
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host -Dmain=firmware_main
+//       Test/sub.c Test/boot_prof.c Test/coop_sched.c Test/fast_path.c Test/oled_text.c
+//       Test/oled_async.c Test/i2c_bus.c Test/dlog.c Test/history.c Test/oled_spark.c Test/rt_stats.c
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/calib.cpp Test/board.cpp Test/host/bsp_host.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//       Test/host/ssd1306_host.c
+//   g++ -O2 -std=c++17 -I Test -I Test/host Test/host/coop_sim.cpp *.o -pthread -o coop_sim
+// 사용: ./coop_sim [-s 가상초] [-p 평균 버튼 간격 ms, 0 이면 안 누름] [-v] [-u]
+//
+// sub.c 를 -DEDGE_BENCH 로 빌드하면 펌웨어의 루프백 측정(edge_bench.c)도 함께 돌고
+// 10 초마다 나오는 EDGE 리포트를 -u 로 볼 수 있다 (edge_bench.c, fast_path.c 도 링크).
+#include "host_os.h"
+#include "main.h"
+extern "C" {
+#include "coop_sched.h"
+}
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+extern "C" int firmware_main(void);
+
+// sub_1.c 처럼 스케줄러가 없는 펌웨어와도 링크되도록
+extern "C" int Coop_Count(void) __attribute__((weak));
+extern "C" int Coop_GetStats(int id, CoopStats *out) __attribute__((weak));
+
+struct ButtonSim {
+    uint32_t mean_gap_us;
+    uint32_t rng = 12345;
+    std::deque<uint64_t> waiting;       // 아직 LED 가 반응하지 않은 누름 시각
+    std::vector<uint32_t> latency_us;
+    uint64_t presses = 0;
+    uint64_t lost = 0;                  // 반응 전에 다음 누름이 겹쳐 합쳐진 것
+    bool verbose = false;
+};
+
+static uint32_t NextGap(ButtonSim *b)
+{
+    b->rng = b->rng * 1103515245u + 12345u;
+    // 평균의 0.5 ~ 1.5 배, 반응 시간 측정이 겹치지 않게 최소 20 ms
+    uint32_t gap = b->mean_gap_us / 2 + (b->rng >> 8) % b->mean_gap_us;
+    return std::max<uint32_t>(gap, 20000);
+}
+
+static void ButtonIrq(uint64_t now_us, void *ctx)
+{
+    ButtonSim *b = (ButtonSim*)ctx;
+    b->presses++;
+    b->waiting.push_back(now_us);
+    host_gpioa.IDR |= GPIO_PIN_0;
+    HAL_GPIO_EXTI_Callback(GPIO_PIN_0);
+    host_gpioa.IDR &= ~(uint32_t)GPIO_PIN_0;
+    HostOs_RaiseIrq(now_us + NextGap(b), ButtonIrq, b);
+}
+
+static void Gpio(uint64_t now_us, char port, uint16_t pin, int, void *ctx)
+{
+    ButtonSim *b = (ButtonSim*)ctx;
+    if (port != 'C' || pin != GPIO_PIN_13 || b->waiting.empty())
+        return;
+    // 한 번의 토글이 그때까지 쌓인 누름을 모두 처리한 것
+    uint64_t first = b->waiting.front();
+    b->latency_us.push_back((uint32_t)(now_us - first));
+    b->lost += b->waiting.size() - 1;
+    b->waiting.clear();
+    if (b->verbose)
+        printf("%10.3f ms  button -> led %8.3f ms\n", now_us / 1000.0, (now_us - first) / 1000.0);
+}
+
+// -u 면 펌웨어 UART 출력을 줄 단위로 보여줌 (-DEDGE_BENCH 빌드의 EDGE 리포트 등)
+struct UartEcho {
+    bool on = false;
+    std::string line;
+};
+
+static void Uart(uint64_t now_us, const uint8_t *data, uint16_t len, void *ctx)
+{
+    UartEcho *u = (UartEcho*)ctx;
+    if (!u->on)
+        return;
+    for (uint16_t i = 0; i < len; i++) {
+        char c = (char)data[i];
+        if (c == '\n') {
+            printf("%10.3f ms  %s\n", now_us / 1000.0, u->line.c_str());
+            u->line.clear();
+        } else if (c != '\r') {
+            u->line += c;
+        }
+    }
+}
+
+static uint32_t Percentile(std::vector<uint32_t> v, double p)
+{
+    if (v.empty()) return 0;
+    size_t k = (size_t)(p * (v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 30;
+    ButtonSim button;
+    button.mean_gap_us = 300000;
+    UartEcho echo;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:p:vu")) != -1) {
+        switch (opt) {
+            case 's': seconds = atof(optarg); break;
+            case 'p': button.mean_gap_us = (uint32_t)(atof(optarg) * 1000); break;
+            case 'v': button.verbose = true; break;
+            case 'u': echo.on = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-s sec] [-p mean_gap_ms] [-v] [-u]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    HostOs_SetUart(Uart, &echo);
+    HostOs_SetGpio(Gpio, &button);
+    if (button.mean_gap_us)
+        HostOs_RaiseIrq(NextGap(&button), ButtonIrq, &button);
+    HostOs_Run(firmware_main, (uint64_t)(seconds * 1e6));
+
+    const std::vector<uint32_t> &lat = button.latency_us;
+    printf("button -> led: %llu presses, %zu handled, %llu merged\n",
+           (unsigned long long)button.presses, lat.size(), (unsigned long long)button.lost);
+    if (!lat.empty()) {
+        printf("  p50 %9.3f ms  p90 %9.3f ms  p99 %9.3f ms  max %9.3f ms\n",
+               Percentile(lat, 0.50) / 1000.0, Percentile(lat, 0.90) / 1000.0,
+               Percentile(lat, 0.99) / 1000.0, *std::max_element(lat.begin(), lat.end()) / 1000.0);
+    }
+
+    if (!Coop_Count || !Coop_GetStats)
+        return 0;
+    printf("%-8s %8s %8s %10s %10s %10s %10s %7s\n",
+           "job", "period", "runs", "exec avg", "exec max", "late avg", "late max", "missed");
+    for (int i = 0; i < Coop_Count(); i++) {
+        CoopStats st;
+        Coop_GetStats(i, &st);
+        uint32_t runs = st.runs ? st.runs : 1;
+        printf("%-8s %6.1fms %8u %8lluus %8uus %8lluus %8uus %7u\n",
+               st.name, st.period_us / 1000.0, st.runs,
+               (unsigned long long)(st.exec_total_us / runs), st.exec_max_us,
+               (unsigned long long)(st.late_total_us / runs), st.late_max_us, st.missed);
+    }
+    return 0;
+}
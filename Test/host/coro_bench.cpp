@@ -0,0 +1,350 @@
+// coro_bench.cpp
+// 코루틴 태스크 (coro.hpp) 와 host_os 스레드 비교: 태스크당 RAM, 전환 비용
+//
+// 1. 전환 비용 (벽시계 ns / 전환, -r 번 재서 중앙값)
+//    - 코루틴 ping-pong: 두 태스크가 큐 두 개로 값을 주고받음 (왕복 = 전환 2 번)
+//    - 코루틴 사슬: -n 개 태스크가 깊이 1 큐로 토큰을 넘김 (태스크 수가 늘어도 전환 비용이 같은지)
+//    - 스레드 ping-pong: host_os 태스크 둘 + osMessagePut / osMessageGet. pthread 조건변수 전환이라
+//      타깃 PendSV 값이 아님 (micro_bench 의 큐 항목과 같이 비교 방향만 볼 것)
+// 2. sys_coro.cpp 펌웨어를 가상 -t 초: "Sensor:" 줄 수, 5 초마다 나오는 CORO 리포트의 프레임 크기,
+//    네 태스크가 같이 쓰는 main 스택의 최대 사용량 (0xA5 로 칠한 pthread 스택, host_os 와 같은 환산).
+//    호스트는 DLOG 가 텍스트라 vsnprintf 가 스택 대부분 (타깃은 바이너리 DLOG)
+// 3. RAM 표: 스레드 = 스택 워드 x 4 + TCB (osStaticThreadDef_t), 코루틴 = 프레임 + Slot.
+//    프레임 / Slot 은 호스트 (64 비트 포인터) 크기라 타깃에서는 이보다 작다.
+//    코루틴 쪽은 프레임만이 아니라 같이 쓰는 main 스택 최대치도 내야 하므로 네 태스크로 아끼는 양은
+//    스레드 합계 - (프레임 합계 + 공유 스택). 스택을 많이 쓰는 vsnprintf 하나가 공유 스택을 정해서
+//    태스크가 적으면 차이가 작고, 태스크가 늘수록 (사슬 줄) 벌어진다. 공유 스택 최대치에는 main 의
+//    Board_Init 도 들어가는데 호스트는 bsp_host 레지스터 모델이라 타깃보다 깊다 (약 350 B).
+//    스레드 스택은 sys_graph.cpp 값 (바이너리 DLOG 로 잰 stack_size 권장값), 공유 스택은 텍스트 DLOG 로
+//    잰 것이라 아끼는 양은 작게 나온 쪽이다
+//
+// 빌드 (CORO_MAX_TASKS / CORO_ARENA_BYTES 는 coro.cpp, sys_coro.cpp 와 같은 값으로):
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host
+//       Test/sys_pipeline.c Test/rules.c Test/sensor_rec.c Test/dlog.c
+//   g++ -c -O2 -std=c++20 -fshort-enums -DHOST_BUILD -DCORO_MAX_TASKS=40 -DCORO_ARENA_BYTES=16384
+//       -I Test -I Test/host -Dmain=firmware_main Test/sys_coro.cpp Test/coro.cpp Test/calib.cpp
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/board.cpp Test/host/bsp_host.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++20 -fshort-enums -DHOST_BUILD -DCORO_MAX_TASKS=40 -DCORO_ARENA_BYTES=16384
+//       -I Test -I Test/host Test/host/coro_bench.cpp *.o -pthread -Wl,-z,now -o coro_bench
+// 사용: ./coro_bench [-n 사슬 태스크 수 (32)] [-p 왕복 수 (200000)] [-r 반복 (5)] [-t 가상초 (12)]
+#include "host_os.h"
+#include "main.h"
+#include "cmsis_os.h"
+#include "coro.hpp"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+int firmware_main(void);
+
+#define MAX_CHAIN           (CORO_MAX_TASKS - 2)
+#define STACK_BYTES         (256 * 1024)
+#define STACK_PAINT         0xA5
+
+// sys_graph.cpp 의 스택 크기 (워드), sys_coro.cpp 태스크 순서
+static const struct { const char *name; uint32_t stack_words; } kSysThreads[] = {
+    { "sensor", 80 }, { "logic", 96 }, { "display", 96 }, { "monitor", 368 },
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double NsSince(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+}
+
+static double Median(std::vector<double> v)
+{
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+// --- 코루틴 ping-pong ---
+static coro::Queue<uint32_t, 1> ping_q, pong_q;
+static bool ping_done;
+
+static coro::Task Ping(uint32_t rounds)
+{
+    for (uint32_t i = 0; i < rounds; i++) {
+        co_await ping_q.Put(i);
+        (void)co_await pong_q.Get();
+    }
+    ping_done = true;
+}
+
+static coro::Task Pong()
+{
+    for (;;) {
+        uint32_t v = co_await ping_q.Get();
+        co_await pong_q.Put(v);
+    }
+}
+
+// --- 코루틴 사슬: chain_q[0] -> 0 -> chain_q[1] -> 1 ... -> chain_q[n] ---
+static coro::Queue<uint32_t, 1> chain_q[MAX_CHAIN + 1];
+static uint32_t chain_bad;
+
+static coro::Task Link(coro::Queue<uint32_t, 1> *in, coro::Queue<uint32_t, 1> *out)
+{
+    for (;;) {
+        uint32_t v = co_await in->Get();
+        co_await out->Put(v + 1);
+    }
+}
+
+static coro::Task Driver(uint32_t n, uint32_t *rounds, bool *stop)
+{
+    for (uint32_t r = 0; !*stop; r++) {
+        co_await chain_q[0].Put(r);
+        uint32_t v = co_await chain_q[n].Get();
+        chain_bad += (v != r + n);
+        (*rounds)++;
+    }
+}
+
+// --- 스레드 ping-pong (host_os) ---
+static osMessageQId th_ping, th_pong;
+static uint32_t th_rounds;
+static Clock::time_point th_t0;
+static double th_ns;
+
+static void ThreadPing(void const *arg)
+{
+    (void)arg;
+    th_t0 = Clock::now();
+    for (uint32_t i = 0; i < th_rounds; i++) {
+        osMessagePut(th_ping, i, osWaitForever);
+        osMessageGet(th_pong, osWaitForever);
+    }
+    th_ns = NsSince(th_t0);
+    osDelay(osWaitForever);     // 둘 다 잠들면 커널이 멈추고 HostOs_Run 이 돌아옴
+}
+
+static void ThreadPong(void const *arg)
+{
+    (void)arg;
+    for (;;) {
+        osEvent e = osMessageGet(th_ping, osWaitForever);
+        osMessagePut(th_pong, e.value.v, osWaitForever);
+    }
+}
+
+osThreadDef(ping, ThreadPing, osPriorityNormal, 0, 128);
+osThreadDef(pong, ThreadPong, osPriorityAboveNormal, 0, 128);   // 넣자마자 선점해서 꺼냄
+osMessageQDef(th_ping_q, 1, uint32_t);
+osMessageQDef(th_pong_q, 1, uint32_t);
+
+static int ThreadMain(void)
+{
+    th_ping = osMessageCreate(osMessageQ(th_ping_q), NULL);
+    th_pong = osMessageCreate(osMessageQ(th_pong_q), NULL);
+    osThreadCreate(osThread(ping), NULL);
+    osThreadCreate(osThread(pong), NULL);
+    osKernelStart();
+    return 0;
+}
+
+// --- sys_coro 펌웨어 ---
+struct CoroLine {
+    unsigned frame;
+    unsigned long resumes;
+};
+
+static std::string uart_line;
+static uint32_t sensor_lines;
+static std::map<unsigned, std::string> coro_names;
+static std::map<std::string, CoroLine> coro_tasks;
+
+static void UartSink(uint64_t, const uint8_t *data, uint16_t len, void *)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        if (data[i] != '\n') {
+            uart_line += (char)data[i];
+            continue;
+        }
+        // 텍스트 줄 앞에 줄바꿈 없는 바이너리 프레임 (SensorRec / DLog) 이 붙어 있을 수 있음
+        // 이름은 시작할 때 "CORO <번호> = <이름>", 리포트는 번호로
+        char name[16];
+        unsigned id, frame;
+        unsigned long resumes;
+        size_t at = uart_line.find("CORO ");
+        if (uart_line.find("Sensor:") != std::string::npos)
+            sensor_lines++;
+        else if (at != std::string::npos && sscanf(uart_line.c_str() + at, "CORO %u = %15s", &id, name) == 2)
+            coro_names[id] = name;
+        else if (at != std::string::npos &&
+                 sscanf(uart_line.c_str() + at, "CORO %u frame %u B resumes %lu", &id, &frame, &resumes) == 3 &&
+                 coro_names.count(id))
+            coro_tasks[coro_names[id]] = { frame, resumes };
+        uart_line.clear();
+    }
+}
+
+static uint64_t fw_us;
+
+static void *FirmwareThread(void *)
+{
+    HostOs_Run(firmware_main, fw_us);
+    return nullptr;
+}
+
+static void *EmptyThread(void *)
+{
+    return nullptr;
+}
+
+// 칠한 스택에서 fn 을 돌리고 쓴 바이트 (아래쪽부터 칠이 남은 만큼이 여유분)
+static size_t RunOnPaintedStack(void *(*fn)(void *))
+{
+    uint8_t *stack = nullptr;
+    if (posix_memalign((void **)&stack, 4096, STACK_BYTES) != 0)
+        exit(1);
+    memset(stack, STACK_PAINT, STACK_BYTES);
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, STACK_BYTES);
+    pthread_t th;
+    pthread_create(&th, &attr, fn, nullptr);
+    pthread_join(th, nullptr);
+    pthread_attr_destroy(&attr);
+    size_t untouched = 0;
+    while (untouched < STACK_BYTES && stack[untouched] == STACK_PAINT)
+        untouched++;
+    free(stack);
+    return STACK_BYTES - untouched;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t chain = 32, rounds = 200000, reps = 5, seconds = 12;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:p:r:t:")) != -1) {
+        switch (opt) {
+            case 'n': chain = (uint32_t)atoi(optarg); break;
+            case 'p': rounds = (uint32_t)atoi(optarg); break;
+            case 'r': reps = (uint32_t)atoi(optarg); break;
+            case 't': seconds = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-n chain] [-p rounds] [-r reps] [-t seconds]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (chain < 1 || chain > MAX_CHAIN || rounds < 1 || reps < 1) {
+        fprintf(stderr, "-n 1..%d, -p >= 1, -r >= 1\n", MAX_CHAIN);
+        return 2;
+    }
+    int fails = 0;
+
+    // 1. 전환 비용
+    static coro::Executor pp;
+    pp.Spawn("pong", Pong());
+    std::vector<double> pp_ns;
+    for (uint32_t r = 0; r < reps; r++) {
+        ping_done = false;
+        uint32_t sw0 = pp.Switches();
+        // 끝난 Ping 은 프레임을 두고 Slot 만 차지하므로 반복마다 새로 (CORO_MAX_TASKS 안에서)
+        if (pp.Spawn("ping", Ping(rounds)) < 0) {
+            fprintf(stderr, "ping: 자리 없음 (-r 을 줄이거나 CORO_MAX_TASKS)\n");
+            return 2;
+        }
+        auto t0 = Clock::now();
+        while (!ping_done)
+            pp.Poll();
+        pp_ns.push_back(NsSince(t0) / (pp.Switches() - sw0));
+    }
+    unsigned ping_frame = pp.At(1).frame_bytes, pong_frame = pp.At(0).frame_bytes;
+
+    static coro::Executor ch;
+    for (uint32_t i = 0; i < chain; i++)
+        if (ch.Spawn("link", Link(&chain_q[i], &chain_q[i + 1])) < 0) {
+            fprintf(stderr, "사슬: 자리 / 아레나 모자람 (CORO_MAX_TASKS, CORO_ARENA_BYTES)\n");
+            return 2;
+        }
+    uint32_t chain_rounds = 0;
+    bool chain_stop = false;
+    ch.Spawn("driver", Driver(chain, &chain_rounds, &chain_stop));
+    std::vector<double> ch_ns;
+    uint32_t per_rep = std::max<uint32_t>(rounds / chain, 1);
+    for (uint32_t r = 0; r < reps; r++) {
+        uint32_t sw0 = ch.Switches(), target = chain_rounds + per_rep;
+        auto t0 = Clock::now();
+        while (chain_rounds < target)
+            ch.Poll();
+        ch_ns.push_back(NsSince(t0) / (ch.Switches() - sw0));
+    }
+    unsigned link_frame = ch.At(0).frame_bytes;
+    if (chain_bad) {
+        printf("chain: %u wrong tokens\n", (unsigned)chain_bad);
+        fails++;
+    }
+
+    th_rounds = rounds;
+    HostOs_Run(ThreadMain, 1000000u);
+    uint64_t th_switches = 0;
+    for (int i = 0; i < HostOs_TaskCount(); i++) {
+        HostTaskInfo ti;
+        HostOs_GetTaskInfo(i, &ti);
+        th_switches += ti.runs;
+    }
+    double th_per = th_switches ? th_ns / (double)th_switches : 0;
+
+    printf("switch cost (host wall clock, median of %u)\n", (unsigned)reps);
+    printf("  %-26s %8.1f ns/switch  (%u round trips)\n", "coroutine ping-pong", Median(pp_ns), (unsigned)rounds);
+    printf("  %-26s %8.1f ns/switch  (%u tasks, %u round trips)\n", "coroutine chain", Median(ch_ns),
+           (unsigned)chain, (unsigned)per_rep);
+    printf("  %-26s %8.1f ns/switch  (pthread handoff, %llu switches)\n", "host_os thread ping-pong", th_per,
+           (unsigned long long)th_switches);
+    if (th_per > 0)
+        printf("  thread / coroutine        %8.1fx\n", th_per / Median(pp_ns));
+
+    // 2. sys_coro 펌웨어
+    HostOs_SetUart(UartSink, nullptr);
+    fw_us = (uint64_t)seconds * 1000000u;
+    size_t baseline = RunOnPaintedStack(EmptyThread);
+    size_t used = RunOnPaintedStack(FirmwareThread);
+    size_t shared = (size_t)((double)(used > baseline ? used - baseline : 0) * HOST_STACK_SCALE);
+    printf("\nsys_coro.cpp, %u s virtual: %u Sensor lines (expect ~%u)\n", (unsigned)seconds,
+           (unsigned)sensor_lines, (unsigned)(seconds * 2));
+    if (sensor_lines == 0 || coro_tasks.empty()) {
+        printf("no Sensor lines or CORO report\n");
+        fails++;
+    }
+
+    // 3. RAM
+    const unsigned tcb = (unsigned)sizeof(osStaticThreadDef_t);
+    const unsigned slot = (unsigned)sizeof(coro::Slot);
+    printf("\nRAM per task (thread = stack + TCB %u B, coroutine = frame + Slot %u B; host frame/Slot sizes)\n",
+           tcb, slot);
+    printf("  %-10s %12s %12s %10s\n", "task", "thread B", "coroutine B", "resumes");
+    unsigned th_total = 0, co_total = 0;
+    for (const auto &t : kSysThreads) {
+        unsigned th = t.stack_words * 4u + tcb;
+        auto it = coro_tasks.find(t.name);
+        unsigned co = it != coro_tasks.end() ? it->second.frame + slot : 0;
+        th_total += th;
+        co_total += co;
+        printf("  %-10s %12u %12u %10lu\n", t.name, th, co, it != coro_tasks.end() ? it->second.resumes : 0ul);
+    }
+    printf("  %-10s %12u %12u\n", "total", th_total, co_total);
+    printf("  shared main stack peak (x%.1f host scale): %u B\n", HOST_STACK_SCALE, (unsigned)shared);
+    long saved = (long)th_total - (long)(co_total + shared);
+    printf("  %zu tasks: threads %u B vs coroutines %u B + shared stack %u B = %u B, saves %ld B\n",
+           sizeof(kSysThreads) / sizeof(kSysThreads[0]), th_total, co_total, (unsigned)shared,
+           co_total + (unsigned)shared, saved);
+    printf("  bench frames: ping %u B, pong %u B, chain link %u B\n", ping_frame, pong_frame, link_frame);
+    printf("  %u tasks: threads %u B (128 words each) vs coroutines %u B (chain links) + one shared stack\n",
+           (unsigned)chain, (unsigned)chain * (512u + tcb), (unsigned)chain * (link_frame + slot));
+
+    printf("%s\n", fails ? "FAILED" : "ok");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,189 @@
+// dlog_bench.cpp
+// dlog.h 바이너리 로그 확인: sub.c / sys.c / FREE_RTOS.c 의 로그 줄을 실제 주기대로 한 시간어치 흘려서
+//   - UART 바이트: 예전 텍스트 vs 'L' 프레임 (펌웨어별, 1 초 묶음)
+//   - 호출 비용: DLOG vs sprintf (호스트 ns, TSC 사이클) - 줄마다
+//   - 왕복: -w 로 UART 캡처, -e 로 예상 텍스트를 쓰면 dlog_decode 로 이 실행 파일의 ELF 를 써서
+//     다시 만든 글자가 같은지 비교할 수 있음
+//
+// 빌드:
+//   gcc -c -O2 -DHOST_BUILD -DDLOG_TEXT=0 -I Test -I Test/host Test/dlog.c
+//   g++ -O2 -std=c++17 -DHOST_BUILD -DDLOG_TEXT=0 -I Test -I Test/host Test/host/dlog_bench.cpp dlog.o -o dlog_bench
+// 사용:
+//   ./dlog_bench [-s 초] [-w cap.bin] [-e expected.txt]
+//   ./dlog_decode dlog_bench cap.bin | cmp - expected.txt
+#include "main.h"
+#include "dlog.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+// --- UART: 캡처만 ---
+static std::vector<uint8_t> uart;
+static bool capture = true;
+
+extern "C" {
+UART_HandleTypeDef huart1;
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)huart;
+    (void)Timeout;
+    if (capture)
+        uart.insert(uart.end(), pData, pData + Size);
+    return HAL_OK;
+}
+}
+
+static std::string expected;
+
+// 같은 줄을 DLOG 로 보내고 예전 텍스트도 만들어 둠 (인자를 두 번 평가하므로 부작용 없는 값만)
+#define LOG(fmt, ...)                                               \
+    do {                                                            \
+        DLOG(fmt, ##__VA_ARGS__);                                   \
+        char text_[96];                                             \
+        snprintf(text_, sizeof(text_), fmt, ##__VA_ARGS__);         \
+        expected += text_;                                          \
+    } while (0)
+
+static uint32_t rng = 1;
+static uint32_t Rand() { rng = rng * 1103515245u + 12345u; return rng >> 8; }
+static uint32_t Adc(uint32_t t_ms) { return (2000 + (t_ms / 37) % 900 + Rand() % 40) & 0x0FFF; }
+
+// --- 펌웨어별 로그 흐름 (시각 ms 순, 1 초마다 DLog_Flush) ---
+static void RunSub(uint32_t seconds)
+{
+    uint32_t next_button = 7000;
+    for (uint32_t t = 0; t < seconds * 1000; t += 500) {
+        if (t == 500)
+            LOG("System Initialized\r\n");
+        if (t >= next_button) {
+            LOG("Button Pressed!\r\n");
+            next_button += 3000 + Rand() % 10000;
+        }
+        unsigned long adc_val = Adc(t);
+        uint32_t s = 12 * 3600 + t / 1000;
+        if (t >= 1000)      // RTC 가 뜬 뒤
+            LOG("[%02d:%02d:%02d] ADC: %lu\r\n", (int)(s / 3600 % 24), (int)(s / 60 % 60), (int)(s % 60), adc_val);
+        else
+            LOG("ADC: %lu\r\n", adc_val);
+        if (t % 1000 == 500)
+            DLog_Flush();
+    }
+    DLog_Flush();
+}
+
+static void RunSys(uint32_t seconds)
+{
+    for (uint32_t t = 0; t < seconds * 1000; t += 500) {
+        unsigned value = Adc(t);
+        LOG("Sensor: %u\r\n", value);
+        if (t % 1000 == 500)
+            DLog_Flush();
+    }
+    DLog_Flush();
+}
+
+static void RunFreeRtos(uint32_t seconds)
+{
+    for (uint32_t t = 0; t < seconds * 1000; t += 1000) {
+        unsigned adc_val = Adc(t);
+        LOG("ADC: %u\r\n", adc_val);
+        DLog_Flush();
+    }
+}
+
+// --- 호출 비용 ---
+static inline uint64_t Tsc()
+{
+#ifdef HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static volatile uint32_t sink;
+
+template <typename F>
+static void Cost(const char *name, F fn)
+{
+    const uint32_t n = 2000000;
+    for (uint32_t i = 0; i < n / 10; i++) fn(i);
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t c0 = Tsc();
+    for (uint32_t i = 0; i < n; i++) fn(i);
+    uint64_t c1 = Tsc();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+    printf("  %-28s %8.1f ns %8.1f cycles\n", name, ns, (double)(c1 - c0) / n);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = 3600;
+    const char *cap_path = nullptr, *exp_path = nullptr;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:w:e:")) != -1) {
+        switch (opt) {
+            case 's': seconds = (uint32_t)atoi(optarg); break;
+            case 'w': cap_path = optarg; break;
+            case 'e': exp_path = optarg; break;
+            default:
+                fprintf(stderr, "usage: %s [-s seconds] [-w cap.bin] [-e expected.txt]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    printf("UART bytes for %u s of logging (text vs 'L' frames flushed every 1 s)\n", seconds);
+    struct { const char *name; void (*run)(uint32_t); } fw[] = {
+        { "sub.c", RunSub }, { "sys.c", RunSys }, { "FREE_RTOS.c", RunFreeRtos },
+    };
+    for (auto &f : fw) {
+        size_t u0 = uart.size(), e0 = expected.size();
+        f.run(seconds);
+        size_t bin = uart.size() - u0, text = expected.size() - e0;
+        printf("  %-12s text %8zu  binary %8zu  x%.2f  (%.0f -> %.0f bit/s)\n", f.name, text, bin,
+               (double)text / bin, text * 10.0 / seconds, bin * 10.0 / seconds);
+    }
+    printf("  dropped %u\n", DLog_Dropped());
+
+    if (cap_path) {
+        FILE *f = fopen(cap_path, "wb");
+        if (!f || fwrite(uart.data(), 1, uart.size(), f) != uart.size()) {
+            fprintf(stderr, "%s: 쓸 수 없음\n", cap_path);
+            return 2;
+        }
+        fclose(f);
+    }
+    if (exp_path) {
+        FILE *f = fopen(exp_path, "wb");
+        if (!f || fwrite(expected.data(), 1, expected.size(), f) != expected.size()) {
+            fprintf(stderr, "%s: 쓸 수 없음\n", exp_path);
+            return 2;
+        }
+        fclose(f);
+    }
+
+    // 호출 비용: 버퍼가 차면 DLog_Flush 까지 포함 (캡처는 끔)
+    capture = false;
+    char buf[64];
+    printf("per call (host)\n");
+    Cost("DLOG Sensor: %u", [](uint32_t i) { DLOG("Sensor: %u\r\n", i & 0xFFF); });
+    Cost("sprintf Sensor: %u", [&buf](uint32_t i) { sink += sprintf(buf, "Sensor: %u\r\n", i & 0xFFF); });
+    Cost("DLOG [hh:mm:ss] ADC: %lu", [](uint32_t i) {
+        DLOG("[%02d:%02d:%02d] ADC: %lu\r\n", (int)(i % 24), (int)(i % 60), (int)(i % 59), (unsigned long)(i & 0xFFF));
+    });
+    Cost("sprintf [hh:mm:ss] ADC: %lu", [&buf](uint32_t i) {
+        sink += sprintf(buf, "[%02d:%02d:%02d] ADC: %lu\r\n", (int)(i % 24), (int)(i % 60), (int)(i % 59),
+                        (unsigned long)(i & 0xFFF));
+    });
+    return 0;
+}
@@ -0,0 +1,124 @@
+// dlog_decode.cpp
+// dlog.h 바이너리 로그('L' 프레임)를 펌웨어 ELF 의 dlog_fmt 섹션으로 다시 글자로 만든다.
+// UART 스트림에 섞인 일반 텍스트는 그대로, 다른 바이너리 프레임(rt_stats 'R', sensor_rec 'S')은 건너뜀.
+// ELF 읽기와 레코드 풀기는 uart_scan.hpp (ingest / mqtt_gw 가 -e 로 직접 풀 때와 같은 코드).
+//
+// 빌드: g++ -O2 -std=c++17 -I Test Test/host/dlog_decode.cpp -o dlog_decode
+// 사용: ./dlog_decode firmware.elf [capture.bin]      (파일이 없으면 stdin, 시리얼 장치도 됨)
+//       -s  끝에 통계 (stderr): 프레임/레코드, 체크섬 오류, 받은 바이트 대비 글자 바이트
+#include "uart_scan.hpp"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static std::vector<char> fmt_section;
+
+// --- 레코드 풀기 ---
+struct Stats {
+    uint64_t in_bytes, text_out, frames, records, bad_sum, bad_record, other_frames;
+};
+static Stats st;
+
+static void DecodeFrame(const uint8_t *p, const uint8_t *end)
+{
+    std::string text;
+    bool bad;
+    st.records += DlogRenderFrame(fmt_section, p, end, text, bad);
+    if (bad) {
+        st.bad_record++;
+        text += "<dlog?>\n";
+    }
+    fwrite(text.data(), 1, text.size(), stdout);
+    st.text_out += text.size();
+}
+
+// 버퍼 앞부분을 처리하고 남길 바이트 수를 돌려줌 (프레임이 덜 온 경우)
+static size_t Process(std::vector<uint8_t> &buf, bool eof)
+{
+    size_t i = 0;
+    while (i < buf.size()) {
+        if (buf[i] == 0xA5) {
+            if (buf.size() - i < 4 && !eof) break;
+            if (buf.size() - i >= 4 && buf[i + 1] == 0x5A) {
+                uint8_t type = buf[i + 2], n = buf[i + 3];
+                size_t size = FrameBytes(type, n);
+                if (buf.size() - i < size) {
+                    if (!eof) break;
+                    i = buf.size();
+                    continue;
+                }
+                if (type == DLOG_FRAME_TYPE) {
+                    if (FrameSumOk(&buf[i], size)) {
+                        st.frames++;
+                        DecodeFrame(&buf[i + 4], &buf[i + 4 + n]);
+                    } else {
+                        st.bad_sum++;
+                    }
+                } else {
+                    st.other_frames++;
+                }
+                i += size;
+                continue;
+            }
+        }
+        putchar(buf[i++]);
+        st.text_out++;
+    }
+    fflush(stdout);
+    return buf.size() - i;
+}
+
+int main(int argc, char **argv)
+{
+    bool stats = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "s")) != -1) {
+        if (opt == 's') {
+            stats = true;
+        } else {
+            fprintf(stderr, "usage: %s [-s] firmware.elf [capture.bin]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "usage: %s [-s] firmware.elf [capture.bin]\n", argv[0]);
+        return 2;
+    }
+    if (!DlogLoadElf(argv[optind], fmt_section)) {
+        DlogLoadError(argv[optind]);
+        return 2;
+    }
+    FILE *in = optind + 1 < argc ? fopen(argv[optind + 1], "rb") : stdin;
+    if (!in) {
+        fprintf(stderr, "%s: 읽을 수 없음\n", argv[optind + 1]);
+        return 2;
+    }
+
+    std::vector<uint8_t> buf;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+        buf.insert(buf.end(), chunk, chunk + n);
+        st.in_bytes += n;
+        size_t keep = Process(buf, false);
+        buf.erase(buf.begin(), buf.end() - (long)keep);
+    }
+    Process(buf, true);
+    if (in != stdin)
+        fclose(in);
+
+    if (stats) {
+        fprintf(stderr, "frames %llu, records %llu, bad sum %llu, bad record %llu, other frames %llu\n",
+                (unsigned long long)st.frames, (unsigned long long)st.records, (unsigned long long)st.bad_sum,
+                (unsigned long long)st.bad_record, (unsigned long long)st.other_frames);
+        fprintf(stderr, "in %llu bytes -> text %llu bytes (x%.2f)\n", (unsigned long long)st.in_bytes,
+                (unsigned long long)st.text_out, st.in_bytes ? (double)st.text_out / st.in_bytes : 0.0);
+    }
+    return st.bad_sum || st.bad_record ? 1 : 0;
+}
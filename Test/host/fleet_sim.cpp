@@ -0,0 +1,506 @@
+// fleet_sim.cpp
+// sys.c 의 Sensor -> Logic -> Display 파이프라인을 가상 보드 N개로 돌리는 호스트 부하 발생기
+// 텔레메트리/MQTT 백엔드를 보드 랙 없이 부하 테스트하기 위한 용도
+//
+// Logic / Display 는 펌웨어와 같은 sys_pipeline.c 단계 (보드마다 규칙 엔진 하나, 기본 규칙표),
+// "Sensor:" 줄도 펌웨어처럼 DLOG -> dlog.c -> HAL_UART_Transmit 으로 나온 글자를 워커 버퍼에 받는다.
+// ADC 만 보드별 파형으로 바꾼다. 지연은 주기 릴리스 (샘플 시각) 에서 그 줄이 싱크에 쓰일 때까지.
+//
+// 빌드:
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/sys_pipeline.c Test/rules.c Test/sensor_rec.c Test/dlog.c
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -I Test Test/calib.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/host/fleet_sim.cpp *.o -pthread -o fleet_sim
+// 사용: ./fleet_sim -n 4000 -t 0 -s 10 -p 500 [-o out.txt | -b 127.0.0.1:1883]
+//   -n 보드 수, -t 워커 수(0 = 코어 수), -s 실행 시간(초)
+//   -p 샘플 주기(ms, sys.c 는 SYS_SENSOR_PERIOD_MS), 0 이면 쉬지 않고 최대 부하
+//   -o 공유 파일 싱크, -b TCP 로 로컬 브로커/게이트웨이에 라인 전송 (기본: 카운트만)
+#include "host_os.h"
+#include "main.h"
+#include "sys_pipeline.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static uint64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+}
+
+// --- 지연 히스토그램 (1/4 옥타브 로그 버킷, 보드당 고정 크기) ---
+struct LatencyHist {
+    static constexpr int kBuckets = 128;
+    uint32_t bucket[kBuckets] = {0};
+    uint64_t count = 0;
+    uint64_t max_ns = 0;
+
+    static int Index(uint64_t ns)
+    {
+        if (ns < 16) return (int)ns;
+        int msb = 63 - __builtin_clzll(ns);
+        int sub = (int)((ns >> (msb - 2)) & 3);
+        int idx = 16 + (msb - 4) * 4 + sub;
+        return idx < kBuckets ? idx : kBuckets - 1;
+    }
+
+    static uint64_t Upper(int idx)
+    {
+        if (idx < 16) return (uint64_t)idx;
+        int msb = (idx - 16) / 4 + 4;
+        int sub = (idx - 16) % 4;
+        return ((uint64_t)(4 + sub + 1) << (msb - 2)) - 1;
+    }
+
+    void Add(uint64_t ns)
+    {
+        bucket[Index(ns)]++;
+        count++;
+        if (ns > max_ns) max_ns = ns;
+    }
+
+    void Merge(const LatencyHist &o)
+    {
+        for (int i = 0; i < kBuckets; i++) bucket[i] += o.bucket[i];
+        count += o.count;
+        max_ns = std::max(max_ns, o.max_ns);
+    }
+
+    uint64_t Percentile(double p) const
+    {
+        if (count == 0) return 0;
+        uint64_t want = (uint64_t)std::ceil(p * (double)count);
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; i++) {
+            seen += bucket[i];
+            if (seen >= want) return std::min(Upper(i), max_ns);
+        }
+        return max_ns;
+    }
+};
+
+// --- 보드별 ADC 파형 (sine / square / ramp + 노이즈) ---
+struct Waveform {
+    int kind;
+    double base, amp, period_s, phase;
+    uint32_t rng;
+
+    uint16_t Sample(double t)
+    {
+        double x = std::fmod(t / period_s + phase, 1.0);
+        double v;
+        switch (kind) {
+            case 0:  v = std::sin(2.0 * M_PI * x); break;
+            case 1:  v = x < 0.5 ? 1.0 : -1.0;     break;
+            default: v = 2.0 * x - 1.0;            break;
+        }
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        int noise = (int)(rng % 33) - 16;
+        int adc = (int)(base + amp * v) + noise;
+        return (uint16_t)std::clamp(adc, 0, 4095);
+    }
+};
+
+// --- 가상 보드: sys_graph.cpp 와 같은 크기의 큐 두 개 ---
+template <int N>
+struct EventQueue {
+    Event q[N];
+    uint8_t head = 0, count = 0;
+    uint64_t drops = 0;
+
+    bool Put(Event e)
+    {
+        if (count == N) { drops++; return false; }   // osMessagePut(.., 0) 이면 그냥 버려짐
+        q[(head + count) % N] = e;
+        count++;
+        return true;
+    }
+
+    bool Get(Event *e)
+    {
+        if (count == 0) return false;
+        *e = q[head];
+        head = (head + 1) % N;
+        count--;
+        return true;
+    }
+};
+
+struct Board {
+    uint32_t id;
+    Waveform wf;
+    EventQueue<SYS_EVENT_QUEUE_LEN> events;       // Sensor -> Logic
+    EventQueue<SYS_DISPLAY_QUEUE_LEN> display;    // Logic -> Display
+    RulesEngine rules;
+    bool led_on = false;
+    uint64_t msgs = 0;
+    LatencyHist lat;
+};
+
+// --- 공유 싱크: 워커별 버퍼에 모았다가 한 번에 내보냄 ---
+class Sink {
+public:
+    virtual ~Sink() {}
+    virtual void Write(const char *buf, size_t len) = 0;
+};
+
+class NullSink : public Sink {
+public:
+    void Write(const char *, size_t) override {}
+};
+
+class FileSink : public Sink {
+public:
+    explicit FileSink(FILE *fp) : fp_(fp) {}
+    ~FileSink() override { if (fp_) fclose(fp_); }
+    void Write(const char *buf, size_t len) override
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        fwrite(buf, 1, len, fp_);
+    }
+private:
+    FILE *fp_;
+    std::mutex mu_;
+};
+
+class TcpSink : public Sink {
+public:
+    explicit TcpSink(int fd) : fd_(fd) {}
+    ~TcpSink() override { close(fd_); }
+    void Write(const char *buf, size_t len) override
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        while (len > 0) {
+            ssize_t n = send(fd_, buf, len, MSG_NOSIGNAL);
+            if (n <= 0) return;
+            buf += n;
+            len -= (size_t)n;
+        }
+    }
+private:
+    int fd_;
+    std::mutex mu_;
+};
+
+static Sink *OpenTcpSink(const std::string &hostport)
+{
+    size_t colon = hostport.rfind(':');
+    if (colon == std::string::npos) return nullptr;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)atoi(hostport.c_str() + colon + 1));
+    if (inet_pton(AF_INET, hostport.substr(0, colon).c_str(), &addr.sin_addr) != 1) return nullptr;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return nullptr;
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); return nullptr; }
+    return new TcpSink(fd);
+}
+
+// --- work-stealing 풀: 워커마다 deque, 자기 것은 뒤에서, 훔칠 때는 앞에서 ---
+struct Job {
+    uint32_t board;
+    uint32_t round;         // 몇 번째 주기의 일인지 (남은 수를 그 주기 몫에서 뺌)
+};
+
+struct WorkerQueue {
+    std::mutex mu;
+    std::deque<Job> jobs;
+};
+
+struct Fleet {
+    std::vector<Board> boards;
+    std::vector<WorkerQueue> wq;
+    Sink *sink;
+    uint64_t t0_ns = 0;
+
+    std::mutex round_mu;
+    std::condition_variable round_cv;
+    uint32_t round = 0;
+    bool stop = false;
+    std::condition_variable done_cv;
+
+    // 주기별 남은 보드 수와 릴리스 시각. 앞 주기가 끝나야 다음 주기를 내므로 짝/홀 두 칸이면 된다
+    std::atomic<uint32_t> remaining[2] = {};
+    uint64_t release_ns[2] = {};
+
+    std::atomic<uint64_t> steals{0};
+};
+
+// 지금 워커가 돌리는 보드와 출력 버퍼 (규칙 출력, UART 훅이 여기로)
+static thread_local Board *cur_board;
+static thread_local std::string *cur_out;
+
+// 펌웨어의 SysPipe_RuleLed 자리 (PC13)
+static void BoardLed(uint8_t on)
+{
+    cur_board->led_on = on != 0;
+}
+
+// HAL_UART_Transmit -> host_os 훅: 워커 버퍼로
+static void UartOut(uint64_t now_us, const uint8_t *data, uint16_t len, void *ctx)
+{
+    (void)now_us;
+    (void)ctx;
+    cur_out->append((const char*)data, len);
+}
+
+// dlog.c 가 쓰는 핸들 (BaudRate 0 이라 host_hal 이 전송 시간을 흉내내지 않음)
+extern "C" UART_HandleTypeDef huart1;
+UART_HandleTypeDef huart1;
+
+// sys.c 태스크 한 주기: SensorTask 가 넣고, 우선순위 순서대로 (Logic > Sensor > Display) 큐가 빌 때까지.
+// 쓴 "Sensor:" 줄 수를 돌려줌
+static uint32_t StepBoard(Board &b, double t, uint32_t now_ms)
+{
+    cur_board = &b;
+
+    // SensorTask: ADC 대신 파형
+    b.events.Put(Event{ EVENT_SENSOR_READ, b.wf.Sample(t) });
+
+    // LogicTask
+    Event e, out;
+    while (b.events.Get(&e)) {
+        if (SysPipe_Logic(&b.rules, &e, now_ms, &out))
+            b.display.Put(out);
+    }
+
+    // DisplayTask
+    uint32_t lines = 0;
+    while (b.display.Get(&e)) {
+        SysPipe_Display(&e);
+        lines++;
+    }
+    b.msgs += lines;
+    return lines;
+}
+
+static bool PopJob(Fleet &f, size_t self, Job *job)
+{
+    {
+        WorkerQueue &q = f.wq[self];
+        std::lock_guard<std::mutex> lock(q.mu);
+        if (!q.jobs.empty()) {
+            *job = q.jobs.back();
+            q.jobs.pop_back();
+            return true;
+        }
+    }
+    size_t n = f.wq.size();
+    for (size_t k = 1; k < n; k++) {
+        WorkerQueue &v = f.wq[(self + k) % n];
+        std::lock_guard<std::mutex> lock(v.mu);
+        if (!v.jobs.empty()) {
+            *job = v.jobs.front();
+            v.jobs.pop_front();
+            f.steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void Worker(Fleet &f, size_t self)
+{
+    std::string out;
+    out.reserve(32 * 1024);
+    cur_out = &out;
+    std::vector<Board*> pending;    // out 에 있는 줄마다 그 보드 (싱크에 쓴 뒤 지연을 더함)
+    uint32_t batch_round = 0, batch_jobs = 0;
+    uint32_t seen_round = 0;
+
+    // 모은 줄을 싱크에 쓰고 지연을 잰 다음, 이 묶음의 보드 수를 그 주기 몫에서 뺀다.
+    // 보드 히스토그램은 빼기 전에 건드려야 다음 주기의 다른 워커와 겹치지 않음
+    auto finish = [&] {
+        if (!out.empty()) {
+            f.sink->Write(out.data(), out.size());
+            out.clear();
+        }
+        uint64_t now = NowNs();
+        uint64_t release = f.release_ns[batch_round & 1];
+        for (Board *b : pending)
+            b->lat.Add(now - release);
+        pending.clear();
+        if (batch_jobs && f.remaining[batch_round & 1].fetch_sub(batch_jobs) == batch_jobs) {
+            std::lock_guard<std::mutex> lock(f.round_mu);
+            f.done_cv.notify_all();
+        }
+        batch_jobs = 0;
+    };
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(f.round_mu);
+            f.round_cv.wait(lock, [&] { return f.stop || f.round != seen_round; });
+            if (f.stop) break;
+            seen_round = f.round;
+        }
+        Job job;
+        while (PopJob(f, self, &job)) {
+            if (batch_jobs && job.round != batch_round)
+                finish();
+            batch_round = job.round;
+            uint64_t since = f.release_ns[job.round & 1] - f.t0_ns;
+            Board &b = f.boards[job.board];
+            uint32_t lines = StepBoard(b, (double)since * 1e-9, (uint32_t)(since / 1000000u));
+            pending.insert(pending.end(), lines, &b);
+            batch_jobs++;
+            if (out.size() > 16 * 1024)
+                finish();
+        }
+        finish();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t nboards = 1000;
+    unsigned nthreads = 0;
+    double seconds = 5;
+    int period_ms = SYS_SENSOR_PERIOD_MS;
+    const char *out_path = nullptr;
+    const char *broker = nullptr;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:s:p:o:b:")) != -1) {
+        switch (opt) {
+            case 'n': nboards = (uint32_t)atoi(optarg); break;
+            case 't': nthreads = (unsigned)atoi(optarg); break;
+            case 's': seconds = atof(optarg); break;
+            case 'p': period_ms = atoi(optarg); break;
+            case 'o': out_path = optarg; break;
+            case 'b': broker = optarg; break;
+            default:
+                fprintf(stderr, "usage: %s [-n boards] [-t threads] [-s sec] [-p period_ms] [-o file | -b host:port]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (nthreads == 0) nthreads = std::max(1u, std::thread::hardware_concurrency());
+
+    Fleet f;
+    if (broker) {
+        f.sink = OpenTcpSink(broker);
+        if (!f.sink) { fprintf(stderr, "broker %s 접속 실패\n", broker); return 1; }
+    } else if (out_path) {
+        FILE *fp = fopen(out_path, "wb");
+        if (!fp) { perror(out_path); return 1; }
+        f.sink = new FileSink(fp);
+    } else {
+        f.sink = new NullSink();
+    }
+
+    f.boards.resize(nboards);
+    for (uint32_t i = 0; i < nboards; i++) {
+        Board &b = f.boards[i];
+        b.id = i;
+        b.wf.kind = (int)(i % 3);
+        b.wf.base = 1000 + (i * 37) % 2000;
+        b.wf.amp = 200 + (i * 53) % 1200;
+        b.wf.period_s = 5.0 + (i % 17);
+        b.wf.phase = (double)(i % 100) / 100.0;
+        b.wf.rng = 0x9E3779B9u ^ (i * 2654435761u);
+        SysPipe_InitRules(&b.rules, BoardLed);
+    }
+    f.wq = std::vector<WorkerQueue>(nthreads);
+    HostOs_SetUart(UartOut, nullptr);
+    f.t0_ns = NowNs();
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < nthreads; i++)
+        threads.emplace_back(Worker, std::ref(f), (size_t)i);
+
+    uint64_t start = NowNs();
+    uint64_t end = start + (uint64_t)(seconds * 1e9);
+    uint64_t rounds = 0, overruns = 0;
+    uint64_t next_release = start;
+
+    while (NowNs() < end) {
+        // 한 주기 분량: 남은 수와 릴리스 시각을 먼저 세우고, 보드를 워커 큐에 고르게 뿌린 뒤 깨움
+        // (앞 주기 일을 끝낸 워커가 깨우기 전에 새 일을 집어 가도 세어 둔 몫에서 빠짐)
+        uint32_t r = (uint32_t)rounds + 1;
+        f.remaining[r & 1] = nboards;
+        f.release_ns[r & 1] = NowNs();
+        for (uint32_t i = 0; i < nboards; i++) {
+            WorkerQueue &q = f.wq[i % nthreads];
+            std::lock_guard<std::mutex> lock(q.mu);
+            q.jobs.push_back(Job{ i, r });
+        }
+        {
+            std::unique_lock<std::mutex> lock(f.round_mu);
+            f.round = r;
+            f.round_cv.notify_all();
+            f.done_cv.wait(lock, [&] { return f.remaining[r & 1].load() == 0; });
+        }
+        rounds++;
+
+        if (period_ms > 0) {
+            next_release += (uint64_t)period_ms * 1000000ull;
+            uint64_t now = NowNs();
+            if (now > next_release) {
+                overruns++;                   // 한 주기 안에 보드 전체를 못 돌림
+                next_release = now;
+            } else {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(next_release - now));
+            }
+        }
+    }
+    double elapsed = (double)(NowNs() - start) * 1e-9;
+
+    {
+        std::lock_guard<std::mutex> lock(f.round_mu);
+        f.stop = true;
+        f.round_cv.notify_all();
+    }
+    for (auto &t : threads) t.join();
+    delete f.sink;
+
+    // --- 결과 ---
+    LatencyHist all;
+    uint64_t msgs = 0, drops = 0, leds = 0;
+    std::vector<uint64_t> board_p99;
+    board_p99.reserve(nboards);
+    for (const Board &b : f.boards) {
+        all.Merge(b.lat);
+        msgs += b.msgs;
+        drops += b.events.drops + b.display.drops;
+        leds += b.led_on;
+        board_p99.push_back(b.lat.Percentile(0.99));
+    }
+    std::sort(board_p99.begin(), board_p99.end());
+
+    printf("boards      : %u (workers %u, steals %llu)\n", nboards, nthreads,
+           (unsigned long long)f.steals.load());
+    printf("rounds      : %llu in %.2f s (overruns %llu)\n",
+           (unsigned long long)rounds, elapsed, (unsigned long long)overruns);
+    printf("messages    : %llu (%.0f msg/s), drops %llu, LED on %llu\n",
+           (unsigned long long)msgs, (double)msgs / elapsed,
+           (unsigned long long)drops, (unsigned long long)leds);
+    printf("latency ns  : (release -> sink write) p50 %llu  p90 %llu  p99 %llu  max %llu\n",
+           (unsigned long long)all.Percentile(0.50), (unsigned long long)all.Percentile(0.90),
+           (unsigned long long)all.Percentile(0.99), (unsigned long long)all.max_ns);
+    if (!board_p99.empty()) {
+        printf("board p99 ns: best %llu  median %llu  worst %llu\n",
+               (unsigned long long)board_p99.front(),
+               (unsigned long long)board_p99[board_p99.size() / 2],
+               (unsigned long long)board_p99.back());
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+// flush_sim.cpp
+// OLED 전송 방식 비교: 블로킹 SSD1306_UpdateScreen vs oled_async (이중 버퍼 + DMA)
+// I2C 100 kHz / 400 kHz 에서 5 Hz 로 프레임을 그리고, 프레임마다 CPU 가 전송에 묶인 시간,
+// 화면에 다 나가기까지 걸린 시간, 버스로 나간 바이트를 잰다.
+//
+// 빌드:
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/oled_text.c Test/oled_async.c
+//       Test/i2c_bus.c Test/dlog.c
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/ssd1306_host.c Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -I Test -I Test/host Test/host/flush_sim.cpp *.o -pthread -o flush_sim
+// 사용: ./flush_sim [-n 프레임] [-p 주기 ms]
+//
+// 시나리오: text = sub.c 처럼 두 줄 중 몇 글자만 바뀜, full = 매 프레임 화면 전체 반전
+// 설정마다 fork 해서 시뮬레이터 상태를 새로 시작한다.
+#include "host_os.h"
+#include "main.h"
+#include "ssd1306.h"
+extern "C" {
+#include "oled_text.h"
+#include "oled_async.h"
+#include "i2c_bus.h"
+}
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+
+extern "C" I2C_HandleTypeDef hi2c1;
+extern "C" UART_HandleTypeDef huart1;
+I2C_HandleTypeDef hi2c1;
+UART_HandleTypeDef huart1;
+
+extern "C" void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2cBus_TxDone(hi2c);
+}
+
+struct Config {
+    uint32_t hz;
+    bool async;
+    bool full;
+    uint32_t frames;
+    uint32_t period_us;
+};
+
+struct Result {
+    uint64_t frames = 0;
+    uint64_t blocked_us = 0;
+    uint64_t max_blocked_us = 0;
+    uint64_t latency_us = 0;
+    uint64_t max_latency_us = 0;
+    uint64_t i2c_bytes = 0;
+    uint64_t skipped = 0;
+};
+
+static Config cfg;
+static Result res;
+
+static void CountI2c(uint64_t, uint16_t, const uint8_t *, uint16_t len, void *)
+{
+    res.i2c_bytes += len;
+}
+
+static void WaitUntil(uint64_t t)
+{
+    while (HostOs_NowUs() < t)
+        HostOs_Idle(t - HostOs_NowUs());
+}
+
+static int Entry(void)
+{
+    static uint8_t cache[OLED_TEXT_CACHE_BYTES(7, 10)];
+    static OledFont font;
+    static OledTextSlot s1, s2;
+
+    hi2c1.Init.ClockSpeed = cfg.hz;
+    HAL_I2C_Init(&hi2c1);
+    SSD1306_Init();
+    OledText_InitFont(&font, &Font_7x10, cache);
+    OledText_InitSlot(&s1, &font, 0, 0);
+    OledText_InitSlot(&s2, &font, 0, 2);
+    I2cBus_Init(&hi2c1);
+    OledAsync_Init();
+    res.i2c_bytes = 0;
+
+    uint64_t next = HostOs_NowUs();
+    for (uint32_t f = 0; f < cfg.frames; f++) {
+        WaitUntil(next);
+        next += cfg.period_us;
+
+        char l1[24], l2[24];
+        snprintf(l1, sizeof(l1), "ADC: %4u", 2000 + (f * 37) % 100);
+        snprintf(l2, sizeof(l2), "Time: 12:%02u:%02u", (f / 300) % 60, (f / 5) % 60);
+        if (cfg.full)
+            SSD1306_ToggleInvert();
+        OledText_Draw(&s1, l1);
+        OledText_Draw(&s2, l2);
+
+        uint64_t t0 = HostOs_NowUs();
+        if (cfg.async) {
+            if (OledAsync_Flush() < 0)
+                res.skipped++;
+        } else {
+            SSD1306_UpdateScreen();
+        }
+        uint64_t blocked = HostOs_NowUs() - t0;
+        res.blocked_us += blocked;
+        if (blocked > res.max_blocked_us) res.max_blocked_us = blocked;
+        res.frames++;
+
+        if (cfg.async) {
+            // 완료 시각은 다음 프레임 전에 stats 로 확인 (그 사이 CPU 는 다른 일을 할 수 있음)
+            WaitUntil(next - 1);
+            OledAsyncStats st;
+            OledAsync_GetStats(&st);
+            res.latency_us += OledAsync_Busy() ? cfg.period_us : st.last_flush_us;
+        } else {
+            res.latency_us += blocked;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = 100;
+    uint32_t period_ms = 200;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:p:")) != -1) {
+        switch (opt) {
+            case 'n': frames = (uint32_t)atoi(optarg); break;
+            case 'p': period_ms = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-n frames] [-p period_ms]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    printf("%-5s %-9s %-8s %12s %12s %12s %10s %8s\n",
+           "scene", "bus", "flush", "cpu avg", "cpu max", "on panel", "B/frame", "skipped");
+    for (int full = 0; full <= 1; full++) {
+        for (uint32_t hz : { 100000u, 400000u }) {
+            for (int async = 0; async <= 1; async++) {
+                fflush(stdout);
+                pid_t pid = fork();
+                if (pid == 0) {
+                    cfg = { hz, async != 0, full != 0, frames, period_ms * 1000u };
+                    HostOs_SetI2c(CountI2c, nullptr);
+                    HostOs_Run(Entry, (uint64_t)(frames + 1) * cfg.period_us + 1000000u);
+                    double n = res.frames ? (double)res.frames : 1.0;
+                    printf("%-5s %6u kHz %-8s %10.3fms %10.3fms %10.3fms %10.0f %8llu\n",
+                           full ? "full" : "text", hz / 1000, async ? "async" : "blocking",
+                           res.blocked_us / n / 1000.0, res.max_blocked_us / 1000.0,
+                           res.latency_us / n / 1000.0, res.i2c_bytes / n,
+                           (unsigned long long)res.skipped);
+                    fflush(stdout);
+                    _exit(0);
+                }
+                waitpid(pid, nullptr, 0);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+// fonts.h (호스트용)
+// tm_stm32 SSD1306 라이브러리와 같은 형식: 글자당 FontHeight 개의 uint16_t 행, 왼쪽 픽셀이 MSB
+#ifndef FONTS_H
+#define FONTS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint8_t FontWidth;
+    uint8_t FontHeight;
+    const uint16_t *data;
+} FontDef_t;
+
+extern FontDef_t Font_7x10;
+extern FontDef_t Font_11x18;
+extern FontDef_t Font_16x26;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,177 @@
+// graph_check.cpp
+// 태스크 / 큐 그래프 (task_graph.hpp) 확인
+//
+// 1. 실행: 펌웨어 하나를 그래프 TU 와 함께 host_os 에서 돌리고, 만들어진 태스크 / 큐가 그래프 그대로인지,
+//    모두 정적 저장소로 만들어졌는지 (힙 0), 큐마다 넣은 것이 다 꺼내졌는지 (드롭 0, 꺼낸 수 > 0) 본다.
+//    틀리면 종료 코드 1.
+// 2. 빌드가 깨져야 하는 그래프: -DGRAPH_BAD=n 이면 잘못된 그래프를 만들고 그 static_assert 로 멈춘다.
+//    1 = 두 태스크가 한 큐를 꺼냄 (maung.c, 예전 sys.c),  2 = Peek 만 하는 큐 (예전 FREE_RTOS.c),
+//    3 = 넣는 쪽 없는 큐,  4 = 순환,  5 = 없는 이름,  6 = 스택이 너무 작음,  7 = 이름 겹침,  8 = 8 바이트 항목
+//
+// 빌드 (sys.c, FREE_RTOS.c 는 sys.c / sys_graph.cpp 자리에 FREE_RTOS.c / free_rtos_graph.cpp):
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host -Dmain=firmware_main
+//       Test/sys.c Test/sys_pipeline.c Test/stack_mon.c Test/rt_stats.c Test/rules.c Test/sensor_rec.c Test/dlog.c Test/periodic.c
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/calib.cpp Test/board.cpp Test/host/bsp_host.cpp Test/pwm_fade.cpp
+//   g++ -c -O2 -std=c++17 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/sys_graph.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -fshort-enums -I Test -I Test/host Test/host/graph_check.cpp *.o -pthread -o graph_check
+// 잘못된 그래프가 다 막히는지:
+//   for n in 1 2 3 4 5 6 7 8; do g++ -std=c++17 -fsyntax-only -DGRAPH_BAD=$n -I Test -I Test/host
+//       Test/host/graph_check.cpp 2>&1 | grep -m1 'static assertion' || echo "GRAPH_BAD=$n 빌드됨 (틀림)"; done
+// 사용: ./graph_check [-t 초]
+#include "host_os.h"
+#include "task_graph.h"
+
+#ifdef GRAPH_BAD
+#include "task_graph.hpp"
+
+static void A(void const *) {}
+static void B(void const *) {}
+static void C(void const *) {}
+
+namespace {
+
+using tg::Use;
+
+#if GRAPH_BAD == 1
+constexpr tg::Graph<3, 1, 4> kBad = {
+    {{ { "sensor", A, osPriorityNormal, 128 }, { "logic", B, osPriorityAboveNormal, 128 },
+       { "display", C, osPriorityBelowNormal, 128 } }},
+    {{ { "eventQueue", 16, 4 } }},
+    {{ { "sensor", Use::Put, "eventQueue" }, { "logic", Use::Get, "eventQueue" },
+       { "logic", Use::Put, "eventQueue" }, { "display", Use::Get, "eventQueue" } }},
+};
+#elif GRAPH_BAD == 2
+constexpr tg::Graph<2, 1, 2> kBad = {
+    {{ { "adc", A, osPriorityAboveNormal, 128 }, { "uart", B, osPriorityNormal, 128 } }},
+    {{ { "adcQueue", 8, 2 } }},
+    {{ { "adc", Use::Put, "adcQueue" }, { "uart", Use::Peek, "adcQueue" } }},
+};
+#elif GRAPH_BAD == 3
+constexpr tg::Graph<2, 1, 1> kBad = {
+    {{ { "a", A, osPriorityNormal, 128 }, { "b", B, osPriorityNormal, 128 } }},
+    {{ { "q", 8, 4 } }},
+    {{ { "b", Use::Get, "q" } }},
+};
+#elif GRAPH_BAD == 4
+constexpr tg::Graph<2, 2, 4> kBad = {
+    {{ { "a", A, osPriorityNormal, 128 }, { "b", B, osPriorityNormal, 128 } }},
+    {{ { "ab", 8, 4 }, { "ba", 8, 4 } }},
+    {{ { "a", Use::Put, "ab" }, { "b", Use::Get, "ab" }, { "b", Use::Put, "ba" }, { "a", Use::Get, "ba" } }},
+};
+#elif GRAPH_BAD == 5
+constexpr tg::Graph<2, 1, 2> kBad = {
+    {{ { "a", A, osPriorityNormal, 128 }, { "b", B, osPriorityNormal, 128 } }},
+    {{ { "q", 8, 4 } }},
+    {{ { "a", Use::Put, "q" }, { "c", Use::Get, "q" } }},
+};
+#elif GRAPH_BAD == 6
+constexpr tg::Graph<2, 1, 2> kBad = {
+    {{ { "a", A, osPriorityNormal, 32 }, { "b", B, osPriorityNormal, 128 } }},
+    {{ { "q", 8, 4 } }},
+    {{ { "a", Use::Put, "q" }, { "b", Use::Get, "q" } }},
+};
+#elif GRAPH_BAD == 7
+constexpr tg::Graph<2, 1, 2> kBad = {
+    {{ { "a", A, osPriorityNormal, 128 }, { "a", B, osPriorityNormal, 128 } }},
+    {{ { "q", 8, 4 } }},
+    {{ { "a", Use::Put, "q" }, { "a", Use::Get, "q" } }},
+};
+#elif GRAPH_BAD == 8
+constexpr tg::Graph<2, 1, 2> kBad = {
+    {{ { "a", A, osPriorityNormal, 128 }, { "b", B, osPriorityNormal, 128 } }},
+    {{ { "q", 8, 8 } }},
+    {{ { "a", Use::Put, "q" }, { "b", Use::Get, "q" } }},
+};
+#endif
+
+} // namespace
+
+TASK_GRAPH_EXPORT(kBad)
+
+#else
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" int firmware_main(void);
+
+// UART 는 버리고 바이트만 셈 (텍스트 줄과 바이너리 프레임이 섞여 있음)
+static uint64_t uart_bytes;
+
+static void UartSink(uint64_t, const uint8_t *, uint16_t len, void *)
+{
+    uart_bytes += len;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = 30;
+    int opt;
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        switch (opt) {
+            case 't': seconds = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-t seconds]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    HostOs_SetUart(UartSink, nullptr);
+    HostOs_Run(firmware_main, (uint64_t)seconds * 1000000u);
+
+    int fails = 0;
+    uint32_t stack_bytes = 0;
+    printf("%u s virtual, graph static storage %u bytes (stacks + TCB + queue buffers + queue CB), heap 0\n\n",
+           (unsigned)seconds, (unsigned)TaskGraph_StaticBytes());
+    printf("%-10s %5s %6s %7s %7s\n", "task", "prio", "stack", "runs", "static");
+    for (uint32_t i = 0; i < TaskGraph_TaskCount(); i++) {
+        HostTaskInfo ti;
+        int idx = -1;
+        for (int k = 0; k < HostOs_TaskCount(); k++) {
+            HostOs_GetTaskInfo(k, &ti);
+            if (strcmp(ti.name, TaskGraph_TaskName(i)) == 0) {
+                idx = k;
+                break;
+            }
+        }
+        if (idx < 0) {
+            printf("%-10s not created\n", TaskGraph_TaskName(i));
+            fails++;
+            continue;
+        }
+        stack_bytes += ti.stack_words * 4u;
+        printf("%-10s %5d %6u %7u %7s\n", ti.name, ti.priority, (unsigned)ti.stack_words, (unsigned)ti.runs,
+               ti.static_alloc ? "yes" : "NO");
+        fails += !ti.static_alloc || ti.stack_words != TaskGraph_StackWords(i) || ti.runs == 0;
+    }
+    printf("\n%-14s %5s %4s %8s %8s %6s %9s %7s\n", "queue", "depth", "item", "puts", "gets", "drops", "max depth",
+           "static");
+    for (uint32_t i = 0; i < TaskGraph_QueueCount(); i++) {
+        HostQueueInfo qi;
+        // 그래프 큐가 host_os 에 만든 순서대로 들어감 (펌웨어는 그래프 밖에서 큐를 만들지 않음)
+        if (HostOs_GetQueueInfo((int)i, &qi) != 0) {
+            printf("%-14s not created\n", TaskGraph_QueueName(i));
+            fails++;
+            continue;
+        }
+        bool drained = qi.gets > 0 && qi.puts - qi.gets <= qi.capacity;
+        printf("%-14s %5u %4u %8llu %8llu %6llu %9u %7s%s\n", TaskGraph_QueueName(i), (unsigned)qi.capacity,
+               (unsigned)qi.item_sz, (unsigned long long)qi.puts, (unsigned long long)qi.gets,
+               (unsigned long long)qi.drops, (unsigned)qi.max_depth, qi.static_alloc ? "yes" : "NO",
+               drained ? "" : "  NOT DRAINED");
+        fails += !qi.static_alloc || !drained || qi.drops != 0;
+    }
+    if (HostOs_QueueCount() != (int)TaskGraph_QueueCount()) {
+        printf("queues outside the graph: %d\n", HostOs_QueueCount() - (int)TaskGraph_QueueCount());
+        fails++;
+    }
+    printf("\nstacks %u bytes of %u static, uart %llu bytes\n%s\n", (unsigned)stack_bytes,
+           (unsigned)TaskGraph_StaticBytes(), (unsigned long long)uart_bytes, fails ? "FAILED" : "ok");
+    return fails ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,317 @@
+// history_bench.cpp
+// history.h 압축 기록 확인: 데이터마다
+//   - 샘플당 비트, 압축률 (12 비트 원값 대비), 4 KB 에 들어가는 시간 (1 초 간격 기준)
+//   - 되읽기 / 덤프 프레임 왕복이 원래 값과 같은지
+//   - 속도: Append, 범위 읽기 (임의 위치 64 개), ReadLast(128) (호스트 ns / 샘플)
+//
+// 데이터: 인자로 준 파일 (.srec 의 ADC 레코드, 또는 "ADC: %u" / "Sensor: %u" / "[hh:mm:ss] ADC: %lu"
+// 줄이 있는 UART 텍스트 로그). 없으면 합성 조도 (느린 낮 곡선 + 구름 + 잡음 몇 가지)
+//
+// 빌드:
+//   gcc -c -O2 -DHOST_BUILD -I Test -I Test/host Test/history.c
+//   g++ -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/host/history_bench.cpp history.o -o history_bench
+// 사용:
+//   ./history_bench [-n 샘플 수] [rec.srec | log.txt]...
+//   ./history_bench -x capture.bin        보드 UART 캡처의 'H' 덤프 프레임을 "seq,value" CSV 로
+#include "main.h"
+#include "history.h"
+#include "sensor_rec.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// --- UART: 덤프 프레임 캡처 ---
+static std::vector<uint8_t> uart;
+
+extern "C" {
+UART_HandleTypeDef huart1;
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)huart;
+    (void)Timeout;
+    uart.insert(uart.end(), pData, pData + Size);
+    return HAL_OK;
+}
+}
+
+struct DataSet {
+    std::string name;
+    std::vector<uint16_t> v;
+};
+
+static uint32_t rng = 1;
+static uint32_t Rand() { rng = rng * 1103515245u + 12345u; return rng >> 8; }
+
+// 1 초 간격 조도: 12 시간 주기 낮 곡선, 가끔 구름 (몇십 초 동안 30 % 어두움), 조명 켜고 끄기 계단
+static DataSet Synthetic(const char *name, uint32_t n, int noise, bool clouds, bool lamp)
+{
+    DataSet d{ name, {} };
+    rng = 12345;
+    uint32_t cloud_until = 0, lamp_toggle = 1800;
+    bool lamp_on = false;
+    for (uint32_t t = 0; t < n; t++) {
+        double v = 1800 + 1400 * sin(2 * M_PI * t / 43200.0);
+        if (clouds) {
+            if (t >= cloud_until && Rand() % 300 == 0)
+                cloud_until = t + 20 + Rand() % 120;
+            if (t < cloud_until)
+                v *= 0.7;
+        }
+        if (lamp) {
+            if (t >= lamp_toggle) {
+                lamp_on = !lamp_on;
+                lamp_toggle = t + 600 + Rand() % 3600;
+            }
+            if (lamp_on)
+                v += 600;
+        }
+        if (noise)
+            v += (int)(Rand() % (2 * noise + 1)) - noise;
+        d.v.push_back((uint16_t)std::min(4095.0, std::max(0.0, v)));
+    }
+    return d;
+}
+
+static bool ReadFile(const char *path, std::vector<uint8_t> &out)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+static bool GetLeb(const uint8_t *&p, const uint8_t *end, uint32_t &v)
+{
+    v = 0;
+    for (int shift = 0; p < end && shift < 35; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7Fu) << shift;
+        if (!(b & 0x80u))
+            return true;
+    }
+    return false;
+}
+
+static bool LoadData(const char *path, DataSet &d)
+{
+    std::vector<uint8_t> buf;
+    if (!ReadFile(path, buf))
+        return false;
+    d.name = path;
+    if (buf.size() >= SREC_FILE_HEADER && memcmp(buf.data(), SREC_MAGIC, 4) == 0) {
+        const uint8_t *p = buf.data() + SREC_FILE_HEADER, *end = buf.data() + buf.size();
+        while (p < end) {
+            uint8_t type = *p++;
+            uint32_t dt;
+            if (!GetLeb(p, end, dt))
+                break;
+            if (type == SREC_ADC) {
+                if (end - p < 3) break;
+                if (p[0] == 1)
+                    d.v.push_back((uint16_t)((p[1] | p[2] << 8) & 0x0FFF));
+                p += 3;
+            } else if (type == SREC_GPIO_IN || type == SREC_GPIO_OUT) {
+                p += 3;
+            } else if (type != SREC_GAP) {
+                break;
+            }
+        }
+        return true;
+    }
+    std::string line;
+    for (uint8_t c : buf) {
+        if (c != '\n') {
+            line += (char)c;
+            continue;
+        }
+        unsigned v;
+        size_t at;
+        if ((at = line.find("ADC: ")) != std::string::npos && sscanf(line.c_str() + at, "ADC: %u", &v) == 1)
+            d.v.push_back((uint16_t)(v & 0x0FFF));
+        else if ((at = line.find("Sensor: ")) != std::string::npos && sscanf(line.c_str() + at, "Sensor: %u", &v) == 1)
+            d.v.push_back((uint16_t)(v & 0x0FFF));
+        line.clear();
+    }
+    return true;
+}
+
+// 'H' 프레임을 모두 풀어 (seq, value) 로
+static size_t DecodeFrames(const std::vector<uint8_t> &buf, std::vector<std::pair<uint32_t, uint16_t>> &out,
+                           size_t *bad)
+{
+    size_t frames = 0;
+    uint16_t tmp[HISTORY_BLOCK_BYTES * 8];
+    for (size_t i = 0; i + 4 <= buf.size();) {
+        if (buf[i] != 0xA5 || buf[i + 1] != 0x5A) {
+            i++;
+            continue;
+        }
+        uint8_t type = buf[i + 2], n = buf[i + 3];
+        size_t size = type == 'R' ? 4 + 4 + (size_t)n * 10 + 1 : 4 + (size_t)n + 1;
+        if (i + size > buf.size())
+            break;
+        if (type == HISTORY_FRAME_TYPE) {
+            uint8_t sum = 0;
+            for (size_t k = i + 2; k < i + 4 + n; k++)
+                sum += buf[k];
+            uint32_t got = sum == buf[i + 4 + n] ? History_DecodeBlock(&buf[i + 4], n, tmp, sizeof(tmp) / 2) : 0;
+            if (got == 0) {
+                (*bad)++;
+            } else {
+                const uint8_t *b = &buf[i + 4];
+                uint32_t seq = (uint32_t)b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+                for (uint32_t k = 0; k < got; k++)
+                    out.push_back({ seq + k, tmp[k] });
+                frames++;
+            }
+        }
+        i += size;
+    }
+    return frames;
+}
+
+static volatile uint32_t sink;
+
+template <typename F>
+static double NsPer(uint64_t units, F fn)
+{
+    fn();       // 데우기
+    int reps = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double ns;
+    do {
+        fn();
+        reps++;
+        ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    } while (ns < 2e8);
+    return ns / ((double)reps * (double)units);
+}
+
+static bool Run(const DataSet &d)
+{
+    if (d.v.size() < 2) {
+        printf("%-22s too few samples\n", d.name.c_str());
+        return true;
+    }
+    History_Init();
+    for (uint16_t v : d.v)
+        History_Append(v);
+    HistoryStats st;
+    History_GetStats(&st);
+    double bits = st.bytes * 8.0 / st.stored;
+    double hours = HISTORY_BLOCKS * HISTORY_BLOCK_BYTES * 8.0 / bits / 3600.0;
+
+    // 되읽기: 남은 것 전부
+    std::vector<uint16_t> back(st.stored);
+    uint32_t first = 0;
+    uint32_t got = History_Read(0, back.data(), st.stored, &first);
+    bool ok = got == st.stored && first == st.oldest;
+    for (uint32_t i = 0; ok && i < got; i++)
+        ok = back[i] == d.v[first + i];
+
+    // 덤프 왕복 (묶이지 않은 끝부분은 빠짐)
+    uart.clear();
+    History_DumpStart();
+    while (History_DumpStep()) {}
+    std::vector<std::pair<uint32_t, uint16_t>> dumped;
+    size_t bad = 0;
+    DecodeFrames(uart, dumped, &bad);
+    bool dump_ok = bad == 0 && !dumped.empty() && dumped.front().first == st.oldest &&
+                   st.total - (dumped.back().first + 1) < HISTORY_GROUP;
+    for (size_t i = 0; dump_ok && i < dumped.size(); i++)
+        dump_ok = dumped[i].first == st.oldest + i && dumped[i].second == d.v[dumped[i].first];
+
+    // 속도
+    double append_ns = NsPer(d.v.size(), [&] {
+        History_Init();
+        for (uint16_t v : d.v)
+            History_Append(v);
+    });
+    const uint32_t kRange = 64, kReads = 1000;
+    uint16_t out[128];
+    std::vector<uint32_t> starts;
+    rng = 99;
+    for (uint32_t i = 0; i < kReads; i++)
+        starts.push_back(st.oldest + Rand() % (st.stored > kRange ? st.stored - kRange : 1));
+    double range_ns = NsPer((uint64_t)kReads * kRange, [&] {
+        for (uint32_t s : starts)
+            sink += History_Read(s, out, kRange, nullptr);
+    });
+    double last_ns = NsPer(128, [&] { sink += History_ReadLast(out, 128); });
+
+    printf("%-22s %8zu %8u %6.2f %6.2fx %6.1f h %-6s %-6s %7.1f %7.1f %7.1f\n", d.name.c_str(), d.v.size(),
+           (unsigned)st.stored, bits, 12.0 / bits, hours, ok ? "ok" : "BAD", dump_ok ? "ok" : "BAD", append_ns,
+           range_ns, last_ns);
+    return ok && dump_ok;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t n = 8 * 3600;
+    const char *extract = nullptr;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:x:")) != -1) {
+        switch (opt) {
+            case 'n': n = (uint32_t)atoi(optarg); break;
+            case 'x': extract = optarg; break;
+            default:
+                fprintf(stderr, "usage: %s [-n samples] [rec.srec|log.txt]...\n       %s -x capture.bin\n",
+                        argv[0], argv[0]);
+                return 2;
+        }
+    }
+
+    if (extract) {
+        std::vector<uint8_t> buf;
+        if (!ReadFile(extract, buf)) {
+            fprintf(stderr, "%s: 읽을 수 없음\n", extract);
+            return 2;
+        }
+        std::vector<std::pair<uint32_t, uint16_t>> out;
+        size_t bad = 0;
+        size_t frames = DecodeFrames(buf, out, &bad);
+        printf("seq,value\n");
+        for (auto &s : out)
+            printf("%u,%u\n", (unsigned)s.first, (unsigned)s.second);
+        fprintf(stderr, "%zu frames, %zu samples, %zu bad\n", frames, out.size(), bad);
+        return bad ? 1 : 0;
+    }
+
+    std::vector<DataSet> sets;
+    for (int i = optind; i < argc; i++) {
+        DataSet d;
+        if (!LoadData(argv[i], d)) {
+            fprintf(stderr, "%s: 읽을 수 없음\n", argv[i]);
+            return 2;
+        }
+        sets.push_back(d);
+    }
+    if (sets.empty()) {
+        sets.push_back(Synthetic("flat (noise 1)", n, 1, false, false));
+        sets.push_back(Synthetic("daylight (noise 2)", n, 2, false, false));
+        sets.push_back(Synthetic("daylight+clouds", n, 2, true, false));
+        sets.push_back(Synthetic("clouds+lamp (noise 4)", n, 4, true, true));
+        sets.push_back(Synthetic("noisy (noise 16)", n, 16, true, false));
+    }
+
+    printf("%d x %d B blocks (%d B), groups of %d, 1 s per sample for the hours column\n", HISTORY_BLOCKS,
+           HISTORY_BLOCK_BYTES, HISTORY_BLOCKS * HISTORY_BLOCK_BYTES, HISTORY_GROUP);
+    printf("%-22s %8s %8s %6s %7s %8s %-6s %-6s %7s %7s %7s\n", "data", "samples", "kept", "bit/s", "ratio",
+           "fits", "read", "dump", "app ns", "rng ns", "last ns");
+    bool ok = true;
+    for (const DataSet &d : sets)
+        ok &= Run(d);
+    return ok ? 0 : 1;
+}
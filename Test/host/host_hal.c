@@ -0,0 +1,383 @@
+// host_hal.c
+// STM32 HAL 호스트 구현: 초기화는 (클럭 / RTC 기동 시간 말고는) 아무것도 안 하고, ADC/UART/GPIO/I2C 는 host_os 훅으로 보낸다
+// 블로킹 API 는 실제로 걸리는 시간만큼 가상 시간을 소모한다
+#include "main.h"
+#include "host_os.h"
+
+#define ADC_CONVERSION_US   7       // (71.5 + 12.5) 사이클 @ 12 MHz
+#define RTC_INIT_US         2000    // 초기화 모드 진입 + RSF 동기화
+#define RTC_WRITE_US        100     // RTOFF 대기 (설정 레지스터 쓰기마다)
+#define HSE_STARTUP_US      2000    // 8 MHz 크리스털 기동 (데이터시트 tSU(HSE) 전형값)
+#define PLL_LOCK_US         200     // PLL 락 + SYSCLK 전환
+
+GPIO_TypeDef host_gpioa = { 'A', 0, 0 };
+GPIO_TypeDef host_gpiob = { 'B', 0, 0 };
+GPIO_TypeDef host_gpioc = { 'C', 0, 0 };
+
+HAL_StatusTypeDef HAL_Init(void) { return HAL_OK; }
+
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(HostOs_NowUs() / 1000u);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    HostOs_Sleep(Delay);
+}
+
+// sys.c / FREE_RTOS.c / sub.c 는 선언만 하고 정의가 없다 (maung.c 는 자기 것을 씀).
+// 어느 쪽이든 HSE + PLL 을 켜는 시간은 든다
+__attribute__((weak)) void SystemClock_Config(void)
+{
+    HostOs_Busy(HSE_STARTUP_US + PLL_LOCK_US);
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+    (void)RCC_OscInitStruct;
+    HostOs_Busy(HSE_STARTUP_US + PLL_LOCK_US);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+    (void)RCC_ClkInitStruct;
+    (void)FLatency;
+    return HAL_OK;
+}
+
+// --- GPIO ---
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (PinState == GPIO_PIN_SET) GPIOx->ODR |= GPIO_Pin;
+    else GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    HostOs_GpioOut(GPIOx->name, GPIO_Pin, PinState == GPIO_PIN_SET);
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    GPIOx->ODR ^= GPIO_Pin;
+    HostOs_GpioOut(GPIOx->name, GPIO_Pin, (GPIOx->ODR & GPIO_Pin) != 0);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+// --- ADC: 변환은 즉시 끝나고 값은 훅에서 가져옴 (VREFINT 채널은 HostOs_SetVdda 로 정해짐) ---
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc)
+{
+    (void)hadc;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig)
+{
+    hadc->channel = sConfig->Channel;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->channel == ADC_CHANNEL_VREFINT)
+        hadc->value = HostOs_ReadVrefint();
+    else
+        hadc->value = HostOs_ReadAdc() & 0x0FFFu;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc)
+{
+    (void)hadc;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout)
+{
+    (void)hadc;
+    (void)Timeout;
+    HostOs_Busy(ADC_CONVERSION_US);
+    return HAL_OK;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc)
+{
+    return hadc->value;
+}
+
+// --- UART ---
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+    return HAL_OK;
+}
+
+// 8N1 = 바이트당 10비트
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    HostOs_UartOut(pData, Size);
+    if (huart->Init.BaudRate)
+        HostOs_Busy((uint64_t)Size * 10u * 1000000u / huart->Init.BaudRate);
+    return HAL_OK;
+}
+
+// --- UART 수신: HostOs_UartIn 으로 넣은 바이트를 한 번에 하나씩 인터럽트로 ---
+#define UART_RX_FIFO            4096
+
+static uint8_t rx_fifo[UART_RX_FIFO];
+static uint32_t rx_head, rx_tail;           // 쓸 자리 / 읽을 자리 (계속 증가)
+static int rx_scheduled;                    // 다음 바이트 인터럽트가 예약됨
+static UART_HandleTypeDef *rx_huart;        // Receive_IT 로 받는 중인 핸들
+static uint32_t rx_byte_us = 87;            // 바이트 간격, 받는 핸들의 보율로 갱신 (기본 115200)
+
+static void UartRxByte(uint64_t now_us, void *ctx)
+{
+    (void)ctx;
+    uint8_t b = rx_fifo[rx_tail++ % UART_RX_FIFO];
+    UART_HandleTypeDef *huart = rx_huart;
+    if (huart && huart->RxXferCount) {
+        *huart->pRxBuffPtr++ = b;
+        if (--huart->RxXferCount == 0) {
+            rx_huart = NULL;                // 콜백에서 다시 걸 수 있게 먼저 풀어 둠
+            HAL_UART_RxCpltCallback(huart);
+        }
+    }
+    rx_scheduled = rx_tail != rx_head && HostOs_RaiseIrq(now_us + rx_byte_us, UartRxByte, NULL) == 0;
+}
+
+int HostOs_UartIn(uint64_t at_us, const uint8_t *data, uint16_t len)
+{
+    if (rx_head - rx_tail + len > UART_RX_FIFO)
+        return -1;
+    for (uint16_t i = 0; i < len; i++)
+        rx_fifo[rx_head++ % UART_RX_FIFO] = data[i];
+    if (!rx_scheduled && len) {
+        uint64_t now = HostOs_NowUs();
+        rx_scheduled = HostOs_RaiseIrq((at_us > now ? at_us : now) + rx_byte_us, UartRxByte, NULL) == 0;
+    }
+    return 0;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    if (rx_huart)
+        return HAL_BUSY;
+    if (!pData || Size == 0)
+        return HAL_ERROR;
+    huart->pRxBuffPtr = pData;
+    huart->RxXferCount = Size;
+    if (huart->Init.BaudRate)
+        rx_byte_us = 10u * 1000000u / huart->Init.BaudRate;
+    rx_huart = huart;
+    return HAL_OK;
+}
+
+__attribute__((weak)) void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+// --- I2C: 주소 바이트 포함, 바이트당 9비트 (ACK) ---
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+    hi2c->State = HAL_I2C_STATE_READY;
+    return HAL_OK;
+}
+
+static int I2cInFlight(I2C_HandleTypeDef *hi2c)
+{
+    return hi2c->State == HAL_I2C_STATE_BUSY_TX || hi2c->State == HAL_I2C_STATE_BUSY_RX;
+}
+
+static uint64_t I2cUs(I2C_HandleTypeDef *hi2c, uint32_t bytes)
+{
+    uint32_t hz = hi2c->Init.ClockSpeed ? hi2c->Init.ClockSpeed : 100000u;
+    return (uint64_t)bytes * 9u * 1000000u / hz;
+}
+
+static void I2cBusy(I2C_HandleTypeDef *hi2c, uint32_t bytes)
+{
+    HostOs_Busy(I2cUs(hi2c, bytes));
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    if (I2cInFlight(hi2c))
+        return HAL_BUSY;
+    HostOs_I2cOut(DevAddress, pData, Size);
+    I2cBusy(hi2c, Size + 1u);
+    return HAL_OK;
+}
+
+static void I2cDmaDone(uint64_t now_us, void *ctx)
+{
+    (void)now_us;
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef*)ctx;
+    HAL_I2C_StateTypeDef was = hi2c->State;
+    hi2c->State = HAL_I2C_STATE_READY;
+    if (was == HAL_I2C_STATE_BUSY_RX)
+        HAL_I2C_MemRxCpltCallback(hi2c);
+    else
+        HAL_I2C_MasterTxCpltCallback(hi2c);
+}
+
+static void I2cDmaNack(uint64_t now_us, void *ctx)
+{
+    (void)now_us;
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef*)ctx;
+    hi2c->State = HAL_I2C_STATE_READY;
+    HAL_I2C_ErrorCallback(hi2c);
+}
+
+// 바이트는 시작할 때 훅으로 보내고, 완료 인터럽트는 버스 시간 뒤에
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+    if (I2cInFlight(hi2c))
+        return HAL_BUSY;
+    hi2c->State = HAL_I2C_STATE_BUSY_TX;
+    HostOs_I2cOut(DevAddress, pData, Size);
+    HostOs_RaiseIrq(HostOs_NowUs() + I2cUs(hi2c, Size + 1u), I2cDmaDone, hi2c);
+    return HAL_OK;
+}
+
+// 주소+W, 레지스터, 재시작 주소+R, 데이터 (데이터는 시작할 때 장치 모델에서 받아 둠)
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+    (void)MemAddSize;
+    if (I2cInFlight(hi2c))
+        return HAL_BUSY;
+    hi2c->State = HAL_I2C_STATE_BUSY_RX;
+    int nack = HostOs_I2cIn(DevAddress, (uint8_t)MemAddress, pData, Size);
+    HostOs_RaiseIrq(HostOs_NowUs() + I2cUs(hi2c, nack ? 1u : Size + 3u), nack ? I2cDmaNack : I2cDmaDone, hi2c);
+    return HAL_OK;
+}
+
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c)
+{
+    return hi2c->State;
+}
+
+__attribute__((weak)) void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    (void)hi2c;
+}
+
+__attribute__((weak)) void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    (void)hi2c;
+}
+
+__attribute__((weak)) void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    (void)hi2c;
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout)
+{
+    (void)DevAddress;
+    (void)Trials;
+    (void)Timeout;
+    I2cBusy(hi2c, 1);
+    return HAL_OK;
+}
+
+// --- RTC: 설정한 시각에서 가상 시간만큼 흐름 ---
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef *hrtc)
+{
+    hrtc->offset_s = 0;
+    HostOs_Busy(RTC_INIT_US);
+    return HAL_OK;
+}
+
+static int64_t RtcNow(RTC_HandleTypeDef *hrtc)
+{
+    return (int64_t)(HostOs_NowUs() / 1000000u) + hrtc->offset_s;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format)
+{
+    (void)Format;
+    int64_t day = RtcNow(hrtc) / 86400;
+    int64_t want = day * 86400 + sTime->Hours * 3600 + sTime->Minutes * 60 + sTime->Seconds;
+    hrtc->offset_s += want - RtcNow(hrtc);
+    HostOs_Busy(RTC_WRITE_US);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format)
+{
+    (void)Format;
+    int64_t s = RtcNow(hrtc) % 86400;
+    sTime->Hours = (uint8_t)(s / 3600);
+    sTime->Minutes = (uint8_t)((s / 60) % 60);
+    sTime->Seconds = (uint8_t)(s % 60);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format)
+{
+    (void)hrtc;
+    (void)sDate;
+    (void)Format;
+    HostOs_Busy(RTC_WRITE_US);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format)
+{
+    (void)hrtc;
+    (void)Format;
+    sDate->WeekDay = RTC_WEEKDAY_MONDAY;
+    sDate->Month = RTC_MONTH_JUNE;
+    sDate->Date = 30;
+    sDate->Year = 25;
+    return HAL_OK;
+}
+
+// --- TIM ---
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim)
+{
+    (void)htim;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel)
+{
+    htim->ccr[Channel >> 2] = sConfig->Pulse;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    (void)htim;
+    (void)Channel;
+    return HAL_OK;
+}
+
+// --- NVIC / EXTI ---
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    (void)IRQn;
+    (void)PreemptPriority;
+    (void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    (void)IRQn;
+}
+
+__attribute__((weak)) void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    (void)GPIO_Pin;
+}
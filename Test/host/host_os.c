@@ -0,0 +1,655 @@
+// host_os.c
+// CMSIS-RTOS v1 (FreeRTOS 포트) 동작을 호스트에서 흉내내는 시뮬레이터
+// 태스크마다 pthread 를 만들지만 lock 을 쥔 "현재 태스크" 하나만 실행된다.
+// 블록되면 준비된 태스크 중 우선순위가 가장 높은 것으로 넘기고,
+// 아무도 준비되지 않으면 가장 빨리 깨어날 태스크의 시각으로 가상 시간을 건너뛴다.
+#include "cmsis_os.h"
+#include "host_os.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STACK_PAINT         0xA5
+#define HOST_STACK_BYTES    (256 * 1024)
+
+typedef enum {
+    TASK_READY,
+    TASK_BLOCKED,
+    TASK_DONE
+} TaskState;
+
+typedef enum {
+    WAIT_NONE,
+    WAIT_DELAY,
+    WAIT_QUEUE_GET,
+    WAIT_QUEUE_PUT
+} WaitKind;
+
+struct HostQueue {
+    uint32_t *buf;
+    uint32_t capacity;
+    uint32_t item_sz;
+    uint32_t head;
+    uint32_t count;
+    HostQueueInfo info;
+};
+
+struct HostTask {
+    pthread_t thread;
+    pthread_cond_t cv;
+    const char *name;
+    os_pthread fn;
+    void const *arg;
+    int priority;
+    uint32_t stack_words;
+    uint8_t *stack;
+    TaskState state;
+    WaitKind wait;
+    struct HostQueue *wait_queue;
+    uint64_t wake_us;           // UINT64_MAX 이면 타임아웃 없음
+    int timed_out;
+    uint64_t ready_seq;
+    uint32_t runs;
+    uint64_t busy_us;
+    uint64_t job_us;            // 지난 블록 뒤로 쓴 CPU 시간
+    uint32_t max_job_us;
+    int static_alloc;
+};
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t main_cv = PTHREAD_COND_INITIALIZER;
+
+static struct HostTask tasks[HOST_OS_MAX_TASKS];
+static int task_count;
+static struct HostQueue queues[HOST_OS_MAX_QUEUES];
+static int queue_count;
+
+static struct HostTask *current;
+static int kernel_running;
+static int stopped;
+static uint64_t now_us;
+static uint64_t end_us;
+static uint64_t seq;
+static size_t stack_baseline;
+static jmp_buf stop_jmp;
+
+static HostAdcFn adc_fn;
+static void *adc_ctx;
+static HostUartFn uart_fn;
+static void *uart_ctx;
+static HostGpioFn gpio_fn;
+static void *gpio_ctx;
+static HostI2cFn i2c_fn;
+static void *i2c_ctx;
+static HostI2cReadFn i2c_read_fn;
+static void *i2c_read_ctx;
+static uint16_t vdda_mv = 3300;
+
+struct HostIrq {
+    uint64_t at_us;
+    HostIrqFn fn;
+    void *ctx;
+};
+static struct HostIrq irqs[HOST_OS_MAX_IRQS];
+static int irq_count;
+static int in_irq;              // 인터럽트 fn 실행 중: 선점/블록하지 않음
+
+// --- 훅 ---
+void HostOs_SetAdc(HostAdcFn fn, void *ctx)   { adc_fn = fn;  adc_ctx = ctx; }
+void HostOs_SetUart(HostUartFn fn, void *ctx) { uart_fn = fn; uart_ctx = ctx; }
+void HostOs_SetGpio(HostGpioFn fn, void *ctx) { gpio_fn = fn; gpio_ctx = ctx; }
+void HostOs_SetI2c(HostI2cFn fn, void *ctx)   { i2c_fn = fn;  i2c_ctx = ctx; }
+void HostOs_SetI2cRead(HostI2cReadFn fn, void *ctx) { i2c_read_fn = fn; i2c_read_ctx = ctx; }
+void HostOs_SetVdda(uint16_t mv) { vdda_mv = mv; }
+
+uint64_t HostOs_NowUs(void) { return now_us; }
+
+uint16_t HostOs_ReadAdc(void)
+{
+    return adc_fn ? adc_fn(now_us, adc_ctx) : 0;
+}
+
+// VREFINT 1.20 V 를 VDDA 기준으로 변환한 값 (반올림)
+uint16_t HostOs_ReadVrefint(void)
+{
+    return (uint16_t)((1200u * 4095u + vdda_mv / 2u) / vdda_mv);
+}
+
+void HostOs_UartOut(const uint8_t *data, uint16_t len)
+{
+    if (uart_fn) uart_fn(now_us, data, len, uart_ctx);
+    else fwrite(data, 1, len, stdout);
+}
+
+void HostOs_GpioOut(char port, uint16_t pin, int state)
+{
+    if (gpio_fn) gpio_fn(now_us, port, pin, state, gpio_ctx);
+}
+
+void HostOs_I2cOut(uint16_t addr, const uint8_t *data, uint16_t len)
+{
+    if (i2c_fn) i2c_fn(now_us, addr, data, len, i2c_ctx);
+}
+
+// 장치 모델이 없으면 0 으로 채우고 ACK
+int HostOs_I2cIn(uint16_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (i2c_read_fn) return i2c_read_fn(now_us, addr, reg, buf, len, i2c_read_ctx);
+    memset(buf, 0, len);
+    return 0;
+}
+
+// --- 스케줄러 (lock 을 쥔 상태에서만 호출) ---
+static int NextIrq(void);
+static void FireIrq(int i);
+
+static void MakeReady(struct HostTask *t, int timed_out)
+{
+    t->state = TASK_READY;
+    t->wait = WAIT_NONE;
+    t->wait_queue = NULL;
+    t->timed_out = timed_out;
+    t->ready_seq = seq++;
+}
+
+static struct HostTask *PickNext(void)
+{
+    for (;;) {
+        struct HostTask *best = NULL;
+        uint64_t earliest = UINT64_MAX;
+        for (int i = 0; i < task_count; i++) {
+            struct HostTask *t = &tasks[i];
+            if (t->state == TASK_READY) {
+                if (!best || t->priority > best->priority ||
+                    (t->priority == best->priority && t->ready_seq < best->ready_seq))
+                    best = t;
+            } else if (t->state == TASK_BLOCKED && t->wake_us < earliest) {
+                earliest = t->wake_us;
+            }
+        }
+        if (best) return best;
+
+        // 태스크가 깨기 전에 예약된 인터럽트가 있으면 먼저 (그 안에서 태스크가 준비될 수 있음)
+        int irq = NextIrq();
+        if (irq >= 0 && irqs[irq].at_us <= earliest && irqs[irq].at_us <= end_us) {
+            FireIrq(irq);
+            continue;
+        }
+        if (earliest == UINT64_MAX || earliest > end_us) return NULL;
+
+        // 아무도 준비되지 않음: 다음 깨어날 시각으로 이동
+        now_us = earliest;
+        for (int i = 0; i < task_count; i++) {
+            struct HostTask *t = &tasks[i];
+            if (t->state == TASK_BLOCKED && t->wake_us <= now_us)
+                MakeReady(t, t->wait != WAIT_DELAY);
+        }
+    }
+}
+
+// rt_stats.c 가 링크되면 그쪽 것이 쓰임
+__attribute__((weak)) void HostOs_TraceSwitch(void *from, void *to)
+{
+    (void)from;
+    (void)to;
+}
+
+static void SwitchTo(struct HostTask *next)
+{
+    HostOs_TraceSwitch(current, next);
+    current = next;
+    if (next) {
+        next->runs++;
+        pthread_cond_signal(&next->cv);
+    } else {
+        stopped = 1;
+        pthread_cond_signal(&main_cv);
+    }
+}
+
+static void WaitTurn(struct HostTask *self)
+{
+    while (current != self)
+        pthread_cond_wait(&self->cv, &lock);
+}
+
+static void BlockUntil(struct HostTask *self, WaitKind wait, struct HostQueue *q, uint64_t wake_us)
+{
+    if (self->job_us > self->max_job_us)
+        self->max_job_us = (uint32_t)self->job_us;
+    self->job_us = 0;
+    self->state = TASK_BLOCKED;
+    self->wait = wait;
+    self->wait_queue = q;
+    self->timed_out = 0;
+    self->wake_us = wake_us;
+
+    struct HostTask *next = PickNext();
+    if (next != self) {
+        SwitchTo(next);
+        WaitTurn(self);
+    }
+}
+
+static void Block(struct HostTask *self, WaitKind wait, struct HostQueue *q, uint32_t millisec)
+{
+    BlockUntil(self, wait, q, (millisec == osWaitForever) ? UINT64_MAX : now_us + (uint64_t)millisec * 1000u);
+}
+
+// 더 높은 우선순위 태스크가 준비됐으면 선점당한다 (FreeRTOS 와 같이 즉시)
+static void MaybeYield(struct HostTask *self)
+{
+    if (!self || in_irq) return;
+    for (int i = 0; i < task_count; i++) {
+        if (tasks[i].state == TASK_READY && &tasks[i] != self && tasks[i].priority > self->priority) {
+            MakeReady(self, 0);
+            SwitchTo(PickNext());
+            WaitTurn(self);
+            return;
+        }
+    }
+}
+
+static void WakeWaiter(struct HostQueue *q, WaitKind wait)
+{
+    struct HostTask *best = NULL;
+    for (int i = 0; i < task_count; i++) {
+        struct HostTask *t = &tasks[i];
+        if (t->state == TASK_BLOCKED && t->wait == wait && t->wait_queue == q) {
+            if (!best || t->priority > best->priority) best = t;
+        }
+    }
+    if (best) MakeReady(best, 0);
+}
+
+static void *TaskEntry(void *p)
+{
+    struct HostTask *self = (struct HostTask*)p;
+
+    pthread_mutex_lock(&lock);
+    WaitTurn(self);
+    pthread_mutex_unlock(&lock);
+
+    self->fn(self->arg);
+
+    pthread_mutex_lock(&lock);
+    self->state = TASK_DONE;
+    SwitchTo(PickNext());
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+static void *BaselineEntry(void *p)
+{
+    (void)p;
+    return NULL;
+}
+
+static size_t StackUsed(const uint8_t *stack)
+{
+    // 스택은 높은 주소에서 낮은 주소로 자라므로 아래쪽부터 칠이 남아있는 만큼이 여유분
+    size_t untouched = 0;
+    while (untouched < HOST_STACK_BYTES && stack[untouched] == STACK_PAINT)
+        untouched++;
+    return HOST_STACK_BYTES - untouched;
+}
+
+static uint8_t *NewPaintedStack(pthread_attr_t *attr)
+{
+    uint8_t *stack = NULL;
+    if (posix_memalign((void**)&stack, 4096, HOST_STACK_BYTES) != 0) {
+        fprintf(stderr, "host_os: 스택 할당 실패\n");
+        exit(1);
+    }
+    memset(stack, STACK_PAINT, HOST_STACK_BYTES);
+    pthread_attr_init(attr);
+    pthread_attr_setstack(attr, stack, HOST_STACK_BYTES);
+    return stack;
+}
+
+// glibc 는 지정한 스택 꼭대기에 TLS/스레드 정보를 두므로 빈 스레드 사용량을 기준값으로 뺀다
+static void MeasureBaseline(void)
+{
+    pthread_attr_t attr;
+    pthread_t th;
+    uint8_t *stack = NewPaintedStack(&attr);
+    pthread_create(&th, &attr, BaselineEntry, NULL);
+    pthread_join(th, NULL);
+    pthread_attr_destroy(&attr);
+    stack_baseline = StackUsed(stack);
+    free(stack);
+}
+
+// --- CMSIS-RTOS API ---
+osThreadId osThreadCreate(const osThreadDef_t *thread_def, void *argument)
+{
+    if (task_count == HOST_OS_MAX_TASKS) return NULL;
+    if (stack_baseline == 0) MeasureBaseline();
+
+    struct HostTask *t = &tasks[task_count++];
+    memset(t, 0, sizeof(*t));
+    t->name = thread_def->name;
+    t->fn = thread_def->pthread;
+    t->arg = argument;
+    t->priority = thread_def->tpriority;
+    t->stack_words = thread_def->stacksize;
+    t->static_alloc = thread_def->buffer && thread_def->controlblock;
+    pthread_cond_init(&t->cv, NULL);
+
+    pthread_mutex_lock(&lock);
+    MakeReady(t, 0);
+    pthread_mutex_unlock(&lock);
+
+    pthread_attr_t attr;
+    t->stack = NewPaintedStack(&attr);
+    pthread_create(&t->thread, &attr, TaskEntry, t);
+    pthread_attr_destroy(&attr);
+
+    pthread_mutex_lock(&lock);
+    MaybeYield(current);        // 커널 시작 뒤 태스크에서 만든 경우
+    pthread_mutex_unlock(&lock);
+    return t;
+}
+
+osThreadId osThreadGetId(void)
+{
+    return current;
+}
+
+osStatus osKernelStart(void)
+{
+    pthread_mutex_lock(&lock);
+    kernel_running = 1;
+    stopped = 0;
+    SwitchTo(PickNext());
+    while (!stopped)
+        pthread_cond_wait(&main_cv, &lock);
+    kernel_running = 0;
+    pthread_mutex_unlock(&lock);
+
+    // 펌웨어 main 의 while (1) {} 로 돌아가지 않도록 HostOs_Run 으로 바로 복귀
+    longjmp(stop_jmp, 1);
+    return osOK;
+}
+
+uint32_t osKernelSysTick(void)
+{
+    return (uint32_t)(now_us / 1000u);
+}
+
+// 가장 이른 예약 인터럽트, 없으면 -1
+static int NextIrq(void)
+{
+    int best = -1;
+    for (int i = 0; i < irq_count; i++) {
+        if (best < 0 || irqs[i].at_us < irqs[best].at_us)
+            best = i;
+    }
+    return best;
+}
+
+// 예약된 인터럽트 i 를 제 시각에 실행 (lock 을 놓고 부르므로 ISR 에서 HAL/osMessagePut 호출 가능)
+static void FireIrq(int i)
+{
+    struct HostIrq irq = irqs[i];
+    irqs[i] = irqs[--irq_count];
+    if (irq.at_us > now_us)
+        now_us = irq.at_us;
+    in_irq++;
+    pthread_mutex_unlock(&lock);
+    irq.fn(now_us, irq.ctx);
+    pthread_mutex_lock(&lock);
+    in_irq--;
+}
+
+// target 까지의 인터럽트를 모두 실행
+static void FireIrqsUntil(uint64_t target)
+{
+    for (;;) {
+        int i = NextIrq();
+        if (i < 0 || irqs[i].at_us > target || irqs[i].at_us > end_us)
+            break;
+        FireIrq(i);
+    }
+}
+
+// 커널 밖(슈퍼루프, 초기화)에서 시간만 흐르는 경우, 끝나면 HostOs_Run 으로 복귀
+static void AdvanceBare(uint64_t us)
+{
+    uint64_t target = now_us + us;
+    FireIrqsUntil(target);
+    now_us = target;
+    if (now_us >= end_us) {
+        pthread_mutex_unlock(&lock);
+        longjmp(stop_jmp, 1);
+    }
+}
+
+osStatus osDelay(uint32_t millisec)
+{
+    pthread_mutex_lock(&lock);
+    if (current && kernel_running) {
+        Block(current, WAIT_DELAY, NULL, millisec);
+    } else {
+        AdvanceBare((uint64_t)millisec * 1000u);
+    }
+    pthread_mutex_unlock(&lock);
+    return osOK;
+}
+
+// vTaskDelayUntil 과 같음: *prev + millisec 틱 경계에서 깨어남, 이미 지났으면 바로 돌아옴
+osStatus osDelayUntil(uint32_t *prev, uint32_t millisec)
+{
+    if (!prev) return osErrorParameter;
+    pthread_mutex_lock(&lock);
+    uint32_t tick = (uint32_t)(now_us / 1000u);
+    uint32_t wake = *prev + millisec;
+    *prev = wake;
+    int32_t ahead = (int32_t)(wake - tick);
+    if (ahead > 0) {
+        uint64_t wake_us = (now_us - now_us % 1000u) + (uint64_t)ahead * 1000u;
+        if (current && kernel_running)
+            BlockUntil(current, WAIT_DELAY, NULL, wake_us);
+        else
+            AdvanceBare(wake_us - now_us);
+    }
+    pthread_mutex_unlock(&lock);
+    return osOK;
+}
+
+void HostOs_Sleep(uint32_t ms)
+{
+    osDelay(ms);
+}
+
+void HostOs_Busy(uint64_t us)
+{
+    pthread_mutex_lock(&lock);
+    if (current && kernel_running) {
+        uint64_t target = now_us + us;
+        if (!in_irq) {
+            current->busy_us += us;
+            current->job_us += us;
+            FireIrqsUntil(target);
+        }
+        now_us = target;
+        for (int i = 0; i < task_count; i++) {
+            struct HostTask *t = &tasks[i];
+            if (t->state == TASK_BLOCKED && t->wake_us <= now_us)
+                MakeReady(t, t->wait != WAIT_DELAY);
+        }
+        MaybeYield(current);
+    } else {
+        AdvanceBare(us);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+int HostOs_RaiseIrq(uint64_t at_us, HostIrqFn fn, void *ctx)
+{
+    pthread_mutex_lock(&lock);
+    int ok = irq_count < HOST_OS_MAX_IRQS;
+    if (ok)
+        irqs[irq_count++] = (struct HostIrq){ at_us, fn, ctx };
+    pthread_mutex_unlock(&lock);
+    return ok ? 0 : -1;
+}
+
+void HostOs_Idle(uint64_t max_us)
+{
+    pthread_mutex_lock(&lock);
+    int i = NextIrq();
+    if (i >= 0 && irqs[i].at_us < now_us + max_us)
+        max_us = irqs[i].at_us > now_us ? irqs[i].at_us - now_us : 0;
+    AdvanceBare(max_us);
+    pthread_mutex_unlock(&lock);
+}
+
+osMessageQId osMessageCreate(const osMessageQDef_t *queue_def, osThreadId thread_id)
+{
+    (void)thread_id;
+    if (queue_count == HOST_OS_MAX_QUEUES) return NULL;
+    struct HostQueue *q = &queues[queue_count++];
+    memset(q, 0, sizeof(*q));
+    q->capacity = queue_def->queue_sz;
+    q->item_sz = queue_def->item_sz;
+    q->buf = (uint32_t*)calloc(q->capacity, sizeof(uint32_t));
+    q->info.capacity = q->capacity;
+    q->info.item_sz = q->item_sz;
+    q->info.static_alloc = queue_def->buffer && queue_def->controlblock;
+    return q;
+}
+
+osStatus osMessagePut(osMessageQId q, uint32_t info, uint32_t millisec)
+{
+    if (!q) return osErrorParameter;
+    pthread_mutex_lock(&lock);
+    while (q->count == q->capacity) {
+        if (millisec == 0 || !current) {
+            q->info.drops++;
+            pthread_mutex_unlock(&lock);
+            return osErrorResource;
+        }
+        Block(current, WAIT_QUEUE_PUT, q, millisec);
+        if (current->timed_out) {
+            q->info.drops++;
+            pthread_mutex_unlock(&lock);
+            return osErrorTimeoutResource;
+        }
+    }
+    q->buf[(q->head + q->count) % q->capacity] = info;
+    q->count++;
+    q->info.puts++;
+    if (q->count > q->info.max_depth) q->info.max_depth = q->count;
+    WakeWaiter(q, WAIT_QUEUE_GET);
+    MaybeYield(current);
+    pthread_mutex_unlock(&lock);
+    return osOK;
+}
+
+// 메시지가 올 때까지 기다림, pop 이 0 이면 꺼내지 않고 들여다보기만 한다
+static int WaitMessage(struct HostQueue *q, uint32_t millisec, int pop, uint32_t *out)
+{
+    while (q->count == 0) {
+        if (millisec == 0 || !current) return 0;
+        Block(current, WAIT_QUEUE_GET, q, millisec);
+        if (current->timed_out) return 0;
+    }
+    *out = q->buf[q->head];
+    if (pop) {
+        q->head = (q->head + 1) % q->capacity;
+        q->count--;
+        q->info.gets++;
+        WakeWaiter(q, WAIT_QUEUE_PUT);
+        MaybeYield(current);
+    }
+    return 1;
+}
+
+osEvent osMessageGet(osMessageQId q, uint32_t millisec)
+{
+    osEvent evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.def.message_id = q;
+    if (!q) {
+        evt.status = osErrorParameter;
+        return evt;
+    }
+    pthread_mutex_lock(&lock);
+    if (WaitMessage(q, millisec, 1, &evt.value.v))
+        evt.status = osEventMessage;
+    else
+        evt.status = millisec == 0 ? osOK : osEventTimeout;
+    pthread_mutex_unlock(&lock);
+    return evt;
+}
+
+osStatus osMessagePeek(osMessageQId q, void *buf, uint32_t millisec)
+{
+    uint32_t v;
+    if (!q || !buf) return osErrorParameter;
+    pthread_mutex_lock(&lock);
+    int ok = WaitMessage(q, millisec, 0, &v);
+    pthread_mutex_unlock(&lock);
+    if (!ok) return osEventTimeout;
+    memcpy(buf, &v, q->item_sz < sizeof(v) ? q->item_sz : sizeof(v));
+    return osOK;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask)
+{
+    struct HostTask *t = xTask ? (struct HostTask*)xTask : current;
+    if (!t) return 0;
+    size_t used = StackUsed(t->stack);
+    used = used > stack_baseline ? used - stack_baseline : 0;
+    uint32_t used_words = (uint32_t)((double)used * HOST_STACK_SCALE / 4.0 + 0.999);
+    return used_words >= t->stack_words ? 0 : t->stack_words - used_words;
+}
+
+// --- 시뮬레이터 API ---
+int HostOs_Run(int (*entry)(void), uint64_t duration_us)
+{
+    end_us = now_us + duration_us;
+    if (setjmp(stop_jmp) == 0) {
+        entry();
+        return -1;          // 시간이 다 되기 전에 entry 가 끝난 경우
+    }
+    return 0;
+}
+
+int HostOs_TaskCount(void)
+{
+    return task_count;
+}
+
+int HostOs_GetTaskInfo(int index, HostTaskInfo *out)
+{
+    if (index < 0 || index >= task_count) return -1;
+    struct HostTask *t = &tasks[index];
+    size_t used = StackUsed(t->stack);
+    out->name = t->name;
+    out->priority = t->priority;
+    out->stack_words = t->stack_words;
+    out->stack_used_bytes = used > stack_baseline ? used - stack_baseline : 0;
+    out->runs = t->runs;
+    out->busy_us = t->busy_us;
+    out->max_job_us = t->max_job_us;
+    out->static_alloc = t->static_alloc;
+    return 0;
+}
+
+int HostOs_QueueCount(void)
+{
+    return queue_count;
+}
+
+int HostOs_GetQueueInfo(int index, HostQueueInfo *out)
+{
+    if (index < 0 || index >= queue_count) return -1;
+    *out = queues[index].info;
+    return 0;
+}
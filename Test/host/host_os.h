@@ -0,0 +1,104 @@
+// host_os.h
+// 펌웨어 소스(sys.c, FREE_RTOS.c, maung.c)를 수정 없이 호스트에서 돌리기 위한 시뮬레이터 API
+//
+// - 태스크 하나당 pthread 하나, 한 번에 하나만 실행 (우선순위 + 가상 시간)
+// - osDelay / osDelayUntil / 큐 타임아웃은 가상 시간으로 진행하므로 결과가 매번 같음
+// - 태스크 스택은 0xA5 로 칠해 두고 high-water 를 잴 수 있음
+//
+// 빌드 예 (타깃과 같은 enum 크기를 위해 -fshort-enums 필수, sys.c 의 Event 가 4바이트여야 함):
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test/host -Dmain=firmware_main Test/sys.c
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+// 스택을 잴 때는 -Wl,-z,now 로 링크 (지연 바인딩이 처음 부른 태스크 스택을 수 KB 씀)
+#ifndef HOST_OS_H
+#define HOST_OS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_OS_MAX_TASKS   16
+#define HOST_OS_MAX_QUEUES  8
+#define HOST_OS_MAX_IRQS    16
+
+// 64비트 호스트 스택 사용량을 32비트 Cortex-M 으로 대략 환산하는 비율
+#define HOST_STACK_SCALE    0.5
+
+typedef uint16_t (*HostAdcFn)(uint64_t now_us, void *ctx);
+typedef void (*HostUartFn)(uint64_t now_us, const uint8_t *data, uint16_t len, void *ctx);
+typedef void (*HostGpioFn)(uint64_t now_us, char port, uint16_t pin, int state, void *ctx);
+typedef void (*HostI2cFn)(uint64_t now_us, uint16_t addr, const uint8_t *data, uint16_t len, void *ctx);
+typedef void (*HostIrqFn)(uint64_t now_us, void *ctx);
+// I2C 레지스터 읽기에 응답할 장치 모델, 0 이 아니면 NACK
+typedef int (*HostI2cReadFn)(uint64_t now_us, uint16_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *ctx);
+
+typedef struct {
+    const char *name;
+    int priority;
+    uint32_t stack_words;       // osThreadDef 에 선언된 크기
+    size_t stack_used_bytes;    // 호스트에서 측정한 최대 사용량 (TLS 등 기본분 제외)
+    uint32_t runs;              // 스케줄러가 이 태스크로 전환한 횟수
+    uint64_t busy_us;           // HostOs_Busy 로 쓴 가상 CPU 시간 (HAL 대기: 변환, 전송 등)
+    uint32_t max_job_us;        // 블록에서 다음 블록까지 쓴 CPU 시간의 최대 (측정 WCET)
+    int static_alloc;           // osThreadDef_t 에 buffer / controlblock 이 있었음
+} HostTaskInfo;
+
+typedef struct {
+    uint32_t capacity;
+    uint32_t item_sz;
+    uint32_t max_depth;
+    uint64_t puts;
+    uint64_t gets;
+    uint64_t drops;             // 타임아웃으로 실패한 osMessagePut
+    int static_alloc;           // osMessageQDef_t 에 buffer / controlblock 이 있었음
+} HostQueueInfo;
+
+void HostOs_SetAdc(HostAdcFn fn, void *ctx);
+void HostOs_SetUart(HostUartFn fn, void *ctx);
+void HostOs_SetGpio(HostGpioFn fn, void *ctx);
+void HostOs_SetI2c(HostI2cFn fn, void *ctx);
+void HostOs_SetI2cRead(HostI2cReadFn fn, void *ctx);
+// 보드 VDDA (기본 3300 mV): ADC_CHANNEL_VREFINT 변환값이 이걸로 정해짐
+void HostOs_SetVdda(uint16_t mv);
+// 보드로 들어오는 UART 바이트: at_us 부터 (앞에 넣은 게 남았으면 그 뒤로) 보율 간격으로 한 바이트씩
+// HAL_UART_Receive_IT 버퍼로. 받는 중이 아닐 때 온 바이트는 버림 (오버런). 자리가 없으면 -1 (host_hal.c)
+int HostOs_UartIn(uint64_t at_us, const uint8_t *data, uint16_t len);
+
+// entry(보통 -Dmain=firmware_main 으로 바꾼 펌웨어 main)를 실행하고
+// 가상 시간 duration_us 가 지나면 돌아온다 (RTOS 는 osKernelStart 이후,
+// sub.c 같은 슈퍼루프는 HAL_Delay / 전송 대기 중에 시간이 넘으면 빠져나옴)
+int HostOs_Run(int (*entry)(void), uint64_t duration_us);
+
+uint64_t HostOs_NowUs(void);
+
+// at_us 에 fn 을 인터럽트처럼 한 번 실행 (fn 안에서 다음 것을 다시 예약할 수 있음)
+// 시간이 흐르는 지점(Busy/Delay/Idle, 커널에서는 모든 태스크가 잠든 사이)에서 끼어든다.
+// fn 안에서는 osMessagePut(.., 0) 처럼 ISR 에서 되는 것만 부를 것 (선점은 fn 이 끝난 뒤)
+int HostOs_RaiseIrq(uint64_t at_us, HostIrqFn fn, void *ctx);
+// __WFI 대용: 다음 예약 인터럽트가 올 때까지 또는 최대 max_us 동안 잠든다
+void HostOs_Idle(uint64_t max_us);
+
+int HostOs_TaskCount(void);
+int HostOs_GetTaskInfo(int index, HostTaskInfo *out);
+int HostOs_QueueCount(void);
+int HostOs_GetQueueInfo(int index, HostQueueInfo *out);
+
+// host_hal.c 에서 쓰는 내부 훅
+uint16_t HostOs_ReadAdc(void);
+uint16_t HostOs_ReadVrefint(void);
+void HostOs_UartOut(const uint8_t *data, uint16_t len);
+void HostOs_GpioOut(char port, uint16_t pin, int state);
+void HostOs_I2cOut(uint16_t addr, const uint8_t *data, uint16_t len);
+int HostOs_I2cIn(uint16_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+void HostOs_Sleep(uint32_t ms);
+// CPU 가 바쁘게 기다리는 시간 (블로킹 전송 등), 끝나면 그 사이 깨어난 상위 태스크로 선점
+void HostOs_Busy(uint64_t us);
+void HostOs_TraceSwitch(void *from, void *to);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,248 @@
+// i2c_bus_sim.cpp
+// 공유 I2C 버스 모델: 화면 전체를 쉬지 않고 보내는 디스플레이와 10 ms 마다 6 바이트를 읽는
+// 센서를 한 버스에 두고, 센서 읽기 지연(넣은 뒤 끝날 때까지)의 분포와 버스 사용률을 본다.
+// 패널 모델이 SSD1306 페이지 주소 모드 명령/데이터를 해석해서 조각으로 나눈 데이터가
+// 제자리에 들어갔는지도 확인한다.
+//
+// 트리에 실제 센서는 없으므로 센서는 MPU6050 모양(0x68, reg 0x3B 에서 6 바이트)의 가짜 장치.
+//
+// 빌드:
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/i2c_bus.c Test/dlog.c
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -I Test -I Test/host Test/host/i2c_bus_sim.cpp *.o -pthread -o i2c_bus_sim
+// 사용: ./i2c_bus_sim [-s 가상초]
+//
+// 설정(버스 속도 x 스케줄링)마다 fork 해서 시뮬레이터 상태를 새로 시작한다.
+#include "host_os.h"
+#include "main.h"
+extern "C" {
+#include "i2c_bus.h"
+}
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+UART_HandleTypeDef huart1;
+static I2C_HandleTypeDef hi2c;
+
+static const uint16_t kPanelAddr = 0x78;
+static const uint16_t kSensorAddr = 0xD0;        // 0x68 << 1
+static const uint32_t kSensorPeriodUs = 10000;
+static const uint32_t kFramePeriodUs = 40000;
+
+extern "C" void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *h) { I2cBus_TxDone(h); }
+extern "C" void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *h)    { I2cBus_RxDone(h); }
+extern "C" void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *h)        { I2cBus_Error(h); }
+
+struct Mode {
+    const char *name;
+    uint8_t sensor_prio;
+    uint16_t chunk;
+};
+
+static Mode mode;
+static uint32_t rng = 7;
+
+// --- 패널 모델 (페이지 주소 모드) ---
+static uint8_t panel[8][128];
+static uint8_t panel_page, panel_col;
+
+static void PanelWrite(uint64_t, uint16_t addr, const uint8_t *d, uint16_t len, void *)
+{
+    if (addr != kPanelAddr || len == 0)
+        return;
+    if (d[0] == 0x00) {
+        for (uint16_t i = 1; i < len; i++) {
+            uint8_t c = d[i];
+            if (c >= 0xB0 && c <= 0xB7)
+                panel_page = c & 7;
+            else if (c <= 0x0F)
+                panel_col = (uint8_t)((panel_col & 0xF0) | c);
+            else if (c <= 0x1F)
+                panel_col = (uint8_t)((panel_col & 0x0F) | ((c & 0x0F) << 4));
+        }
+    } else if (d[0] == 0x40) {
+        for (uint16_t i = 1; i < len; i++) {
+            panel[panel_page][panel_col & 127] = d[i];
+            panel_col = (uint8_t)((panel_col + 1) & 127);
+        }
+    }
+}
+
+static int SensorRead(uint64_t now_us, uint16_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *)
+{
+    if (addr != kSensorAddr)
+        return -1;
+    for (uint16_t i = 0; i < len; i++)
+        buf[i] = (uint8_t)(reg + i + now_us);
+    return 0;
+}
+
+// --- 디스플레이: 페이지마다 명령 + 데이터 트랜잭션, 한 프레임(16 개)을 한꺼번에 넣음 ---
+static uint8_t frame_cmd[8][4];
+static uint8_t frame_data[8][1 + 128];
+static I2cTxn disp_txn[16];
+static int disp_left;
+static uint32_t frames_done, frames_bad, frame_no;
+
+// 프레임이 끝날 때마다 패널 모델과 비교
+static void DispDone(I2cTxn *, int)
+{
+    if (--disp_left != 0)
+        return;
+    frames_done++;
+    for (int p = 0; p < 8; p++) {
+        if (memcmp(panel[p], &frame_data[p][1], 128) != 0) {
+            frames_bad++;
+            break;
+        }
+    }
+}
+
+static void StartFrame(uint64_t now_us, void *)
+{
+    if (disp_left == 0) {
+        frame_no++;
+        for (int p = 0; p < 8; p++) {
+            frame_cmd[p][0] = 0x00;
+            frame_cmd[p][1] = (uint8_t)(0xB0 + p);
+            frame_cmd[p][2] = 0x00;
+            frame_cmd[p][3] = 0x10;
+            frame_data[p][0] = 0x40;
+            for (int x = 0; x < 128; x++)
+                frame_data[p][1 + x] = (uint8_t)(frame_no * 31 + p * 7 + x);
+
+            I2cTxn *c = &disp_txn[p * 2];
+            I2cTxn *d = &disp_txn[p * 2 + 1];
+            memset(c, 0, sizeof(*c));
+            memset(d, 0, sizeof(*d));
+            c->addr = d->addr = kPanelAddr;
+            c->prio = d->prio = 3;
+            c->done = d->done = DispDone;
+            c->tx = frame_cmd[p];
+            c->tx_len = sizeof(frame_cmd[p]);
+            d->tx = frame_data[p];
+            d->tx_len = sizeof(frame_data[p]);
+            d->chunk = mode.chunk;
+            d->flags = mode.chunk ? I2C_TXN_REPEAT_FIRST : 0;
+        }
+        disp_left = 16;
+        for (I2cTxn &t : disp_txn)
+            I2cBus_Submit(&t);
+    }
+    HostOs_RaiseIrq(now_us + kFramePeriodUs, StartFrame, nullptr);
+}
+
+// --- 센서 ---
+static uint8_t sensor_rx[6];
+static I2cTxn sensor_txn;
+static uint64_t sensor_submit;
+static bool sensor_pending;
+static std::vector<uint32_t> sensor_lat;
+static uint32_t sensor_overrun;
+
+static void SensorDone(I2cTxn *, int)
+{
+    sensor_lat.push_back((uint32_t)(HostOs_NowUs() - sensor_submit));
+    sensor_pending = false;
+}
+
+static void SensorTick(uint64_t now_us, void *)
+{
+    if (sensor_pending) {
+        sensor_overrun++;
+    } else {
+        memset(&sensor_txn, 0, sizeof(sensor_txn));
+        sensor_txn.addr = kSensorAddr;
+        sensor_txn.prio = mode.sensor_prio;
+        sensor_txn.reg = 0x3B;
+        sensor_txn.rx = sensor_rx;
+        sensor_txn.rx_len = sizeof(sensor_rx);
+        sensor_txn.done = SensorDone;
+        sensor_submit = now_us;
+        sensor_pending = true;
+        I2cBus_Submit(&sensor_txn);
+    }
+    // 디스플레이 프레임과 위상이 고정되지 않도록 ±0.5 ms 흔듦
+    rng = rng * 1103515245u + 12345u;
+    HostOs_RaiseIrq(now_us + kSensorPeriodUs - 500 + (rng >> 8) % 1000, SensorTick, nullptr);
+}
+
+static int Entry(void)
+{
+    I2cBus_Init(&hi2c);
+    HostOs_RaiseIrq(HostOs_NowUs(), StartFrame, nullptr);
+    HostOs_RaiseIrq(HostOs_NowUs() + 1234, SensorTick, nullptr);
+    for (;;)
+        HostOs_Idle(1000000);
+}
+
+static uint32_t Pct(std::vector<uint32_t> v, double p)
+{
+    if (v.empty())
+        return 0;
+    size_t k = (size_t)(p * (double)(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + (long)k, v.end());
+    return v[k];
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 10;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:")) != -1) {
+        switch (opt) {
+            case 's': seconds = atof(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-s sec]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    const Mode modes[] = {
+        { "fifo",         3, 0 },   // 센서도 같은 큐, 나누지 않음 (HAL 을 바로 부르는 것과 같음)
+        { "prio",         0, 0 },
+        { "prio+chunk32", 0, 32 },
+        { "prio+chunk16", 0, 16 },
+    };
+    int failed = 0;
+    printf("%-8s %-13s %7s %8s %8s %8s %7s %7s %8s %s\n", "bus", "schedule", "reads",
+           "p50 us", "p99 us", "max us", "util", "frames", "overrun", "panel");
+    for (uint32_t hz : { 100000u, 400000u }) {
+        for (const Mode &m : modes) {
+            fflush(stdout);
+            pid_t pid = fork();
+            if (pid == 0) {
+                mode = m;
+                hi2c.Init.ClockSpeed = hz;
+                HAL_I2C_Init(&hi2c);
+                HostOs_SetI2c(PanelWrite, nullptr);
+                HostOs_SetI2cRead(SensorRead, nullptr);
+                HostOs_Run(Entry, (uint64_t)(seconds * 1e6));
+
+                I2cBusStats st;
+                I2cBus_CloseWindow();
+                I2cBus_GetStats(&st);
+                uint32_t max = sensor_lat.empty() ? 0 : *std::max_element(sensor_lat.begin(), sensor_lat.end());
+                printf("%4u kHz %-13s %7zu %8u %8u %8u %5u.%u%% %7u %8u %s\n",
+                       (unsigned)(hz / 1000), m.name, sensor_lat.size(),
+                       (unsigned)Pct(sensor_lat, 0.5), (unsigned)Pct(sensor_lat, 0.99), (unsigned)max,
+                       st.util_permille / 10u, st.util_permille % 10u, (unsigned)frames_done,
+                       (unsigned)sensor_overrun, frames_bad ? "CORRUPT" : "ok");
+                fflush(stdout);
+                _exit(frames_bad ? 1 : 0);
+            }
+            int status = 0;
+            waitpid(pid, &status, 0);
+            failed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+        }
+    }
+    return failed;
+}
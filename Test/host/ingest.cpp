@@ -0,0 +1,848 @@
+// ingest.cpp
+// 여러 보드의 UART 출력(시리얼 장치 / pty / 파일)을 epoll 하나로 받아서 줄을 풀고
+// mmap 한 열 단위(columnar) 시계열 파일에 붙인다.
+//
+// 푸는 줄과 프레임은 uart_scan.hpp (mqtt_gw 와 같은 스캐너): "ADC: %u", "Sensor: %u",
+// "[hh:mm:ss] ADC: %lu" (보드 시각은 clock 열에 초로). 타깃 펌웨어는 기본이 바이너리 로그('L' 프레임)라
+// -e 로 그 펌웨어 ELF 를 주면 dlog_fmt 섹션으로 글자 줄로 되돌려서 똑같이 푼다. -e 가 없으면 'L' 은
+// 건너뛰고 끝에 센 수를 알려 준다 (DLOG_TEXT=1 빌드, 또는 dlog_decode 를 앞에 둔 파이프면 필요 없음).
+// 다른 글자 줄은 other 로 세기만 하고 'R' / 'S' / 'H' 프레임은 길이만큼 건너뛴다.
+//
+// 파일 (리틀 엔디언, 헤더 + 청크):
+//   헤더 4 KB: magic "DSMTS1" | chunk_rows | streams | rows (커밋된 행) | chunks | created_us
+//   스트림 이름 표: 헤더 뒤 64 바이트 x 1024
+//   청크마다 chunk_rows 행을 열별로: t_us(i64) | value(u32) | clock(u32, 없으면 ~0) | stream(u16) | kind(u8)
+// 청크가 차면 파일을 늘리고 다음 청크만 새로 매핑한다 (앞 데이터를 옮기지 않음).
+// 읽는 쪽은 헤더의 rows 까지만 믿는다 (epoll 한 번 돌 때마다 커밋).
+// t_us 는 호스트가 읽은 시각이라 한 번의 read 로 온 줄들은 같은 값.
+//
+// 빌드: g++ -O2 -std=c++17 -I Test Test/host/ingest.cpp -o ingest
+// 사용:
+//   ./ingest -o data.ts [-e firmware.elf] /dev/ttyUSB0 /dev/ttyUSB1 capture.bin ...
+//       (Ctrl-C 로 끝, 파일 입력은 먼저 한 번에)
+//       -B 보오율 (tty 면 raw 로 설정, 기본 115200)
+//       -e 'L' 프레임을 풀 펌웨어 ELF (보드마다 같은 펌웨어). 없으면
+//          ./dlog_decode firmware.elf /dev/ttyUSB0 | ./ingest -o data.ts /dev/stdin
+//   ./ingest -q data.ts          스트림별 요약
+//   ./ingest -x data.ts          CSV (t_us,stream,kind,clock,value)
+//   ./ingest -b 64 [-s 초] [-w 쓰는 프로세스] [-o data.ts]
+//       보드 대신 pty 64 개에 쉬지 않고 줄을 써서 처리량을 재고, 쓴 레코드 수와 맞는지 확인.
+//       스캐너와 sscanf 의 메모리 안 파싱 속도도 같이 출력.
+#include "uart_scan.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static int64_t WallUs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// --- 파일 형식 ---
+static const char *KindName(uint8_t k) { return k == KIND_ADC ? "adc" : k == KIND_SENSOR ? "sensor" : "?"; }
+
+static const char kMagic[8] = { 'D', 'S', 'M', 'T', 'S', '1', 0, 0 };
+static const uint32_t kChunkRows = 65536;
+static const uint32_t kMaxStreams = 1024;
+static const uint32_t kNameBytes = 64;
+static const size_t kHeaderBytes = 4096 + (size_t)kMaxStreams * kNameBytes;
+static const size_t kRowBytes = 8 + 4 + 4 + 2 + 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t chunk_rows;
+    uint32_t streams;
+    uint64_t rows;
+    uint64_t chunks;
+    int64_t created_us;
+};
+
+static size_t ChunkBytes(uint32_t rows) { return (size_t)rows * kRowBytes; }
+
+// 청크 안 열 위치
+struct Columns {
+    int64_t *t_us;
+    uint32_t *value;
+    uint32_t *clock;
+    uint16_t *stream;
+    uint8_t *kind;
+};
+
+static Columns ColumnsOf(uint8_t *chunk, uint32_t rows)
+{
+    Columns c;
+    c.t_us = (int64_t*)chunk;
+    c.value = (uint32_t*)(chunk + (size_t)rows * 8);
+    c.clock = (uint32_t*)(chunk + (size_t)rows * 12);
+    c.stream = (uint16_t*)(chunk + (size_t)rows * 16);
+    c.kind = chunk + (size_t)rows * 18;
+    return c;
+}
+
+class TsWriter {
+public:
+    bool Open(const char *path)
+    {
+        fd_ = open(path, O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0)
+            return false;
+        struct stat sb;
+        fstat(fd_, &sb);
+        bool fresh = sb.st_size < (off_t)kHeaderBytes;
+        if (fresh && ftruncate(fd_, (off_t)kHeaderBytes) != 0)
+            return false;
+        void *h = mmap(nullptr, kHeaderBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (h == MAP_FAILED)
+            return false;
+        hdr_ = (FileHeader*)h;
+        if (fresh) {
+            memcpy(hdr_->magic, kMagic, sizeof(kMagic));
+            hdr_->chunk_rows = kChunkRows;
+            hdr_->created_us = WallUs();
+        } else if (memcmp(hdr_->magic, kMagic, sizeof(kMagic)) != 0 || hdr_->chunk_rows == 0) {
+            fprintf(stderr, "%s: not an ingest file\n", path);
+            return false;
+        }
+        // 이어쓰기: 커밋된 행 뒤부터 (마지막 청크에서)
+        rows_ = hdr_->rows;
+        idx_ = hdr_->chunk_rows;
+        if (rows_ % hdr_->chunk_rows != 0 && !MapChunk(rows_ / hdr_->chunk_rows))
+            return false;
+        if (rows_ % hdr_->chunk_rows != 0)
+            idx_ = (uint32_t)(rows_ % hdr_->chunk_rows);
+        return true;
+    }
+
+    // 이름이 이미 있으면 그 번호
+    int AddStream(const char *name)
+    {
+        char *names = (char*)hdr_ + 4096;
+        for (uint32_t i = 0; i < hdr_->streams; i++)
+            if (strncmp(names + i * kNameBytes, name, kNameBytes - 1) == 0)
+                return (int)i;
+        if (hdr_->streams >= kMaxStreams)
+            return -1;
+        char *dst = names + hdr_->streams * kNameBytes;
+        strncpy(dst, name, kNameBytes - 1);
+        dst[kNameBytes - 1] = '\0';
+        return (int)hdr_->streams++;
+    }
+
+    inline bool Append(uint16_t stream, uint8_t kind, uint32_t clock, uint32_t value, int64_t t_us)
+    {
+        if (idx_ == hdr_->chunk_rows && !MapChunk(rows_ / hdr_->chunk_rows))
+            return false;
+        col_.t_us[idx_] = t_us;
+        col_.value[idx_] = value;
+        col_.clock[idx_] = clock;
+        col_.stream[idx_] = stream;
+        col_.kind[idx_] = kind;
+        idx_++;
+        rows_++;
+        return true;
+    }
+
+    void Commit()
+    {
+        __atomic_store_n(&hdr_->rows, rows_, __ATOMIC_RELEASE);
+    }
+
+    void Close()
+    {
+        if (!hdr_)
+            return;
+        Commit();
+        if (chunk_)
+            munmap(chunk_, ChunkBytes(hdr_->chunk_rows));
+        msync(hdr_, kHeaderBytes, MS_SYNC);
+        munmap(hdr_, kHeaderBytes);
+        close(fd_);
+        hdr_ = nullptr;
+    }
+
+    uint64_t Rows() const { return rows_; }
+
+private:
+    bool MapChunk(uint64_t c)
+    {
+        size_t bytes = ChunkBytes(hdr_->chunk_rows);
+        if (chunk_)
+            munmap(chunk_, bytes);      // 다 쓴 청크는 커널이 알아서 내려씀
+        chunk_ = nullptr;
+        off_t off = (off_t)(kHeaderBytes + c * bytes);
+        if (c >= hdr_->chunks) {
+            if (ftruncate(fd_, off + (off_t)bytes) != 0)
+                return false;
+            hdr_->chunks = c + 1;
+        }
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, off);
+        if (p == MAP_FAILED)
+            return false;
+        chunk_ = (uint8_t*)p;
+        col_ = ColumnsOf(chunk_, hdr_->chunk_rows);
+        idx_ = 0;
+        return true;
+    }
+
+    int fd_ = -1;
+    FileHeader *hdr_ = nullptr;
+    uint8_t *chunk_ = nullptr;
+    Columns col_ = {};
+    uint32_t idx_ = 0;
+    uint64_t rows_ = 0;
+};
+
+// --- 스트림 ---
+static const size_t kBufBytes = 65536;
+
+struct Stream {
+    std::string name;
+    int fd = -1;
+    uint16_t id = 0;
+    bool discard = false;           // 너무 긴 줄: 다음 '\n' 까지 버림
+    size_t len = 0;
+    std::vector<char> buf;
+    std::string text;               // 'L' 프레임을 푼 글자
+    ScanCounts scan;
+    uint64_t bytes = 0, samples = 0, other = 0, overlong = 0;
+};
+
+struct Totals {
+    ScanCounts scan;
+    uint64_t bytes = 0, samples = 0, other = 0, overlong = 0, reads = 0;
+};
+
+static TsWriter writer;
+static bool have_writer;
+static std::vector<char> dlog_fmt;  // -e, 비었으면 'L' 은 건너뜀
+static Totals tot;
+static volatile sig_atomic_t stop_flag;
+
+// 버퍼 안의 완성된 레코드를 모두 처리하고 남은 조각을 앞으로
+static void Consume(Stream &s, int64_t t_us)
+{
+    char *b = s.buf.data();
+    size_t pos = 0;
+    if (s.discard) {
+        const char *nl = (const char*)memchr(b, '\n', s.len);
+        pos = nl ? (size_t)(nl - b) + 1 : s.len;
+        s.discard = !nl;
+    }
+    pos += ScanUart(b + pos, s.len - pos, dlog_fmt, s.text, s.scan, [&](const char *p, const char *end) {
+        uint8_t kind;
+        uint32_t clock, value;
+        if (ParseLine(p, end, kind, clock, value)) {
+            s.samples++;
+            if (have_writer)
+                writer.Append(s.id, kind, clock, value, t_us);
+        } else {
+            s.other++;
+        }
+    });
+    if (pos > 0) {
+        memmove(b, b + pos, s.len - pos);
+        s.len -= pos;
+    }
+    if (s.len == kBufBytes) {
+        // 한 줄이 버퍼보다 김
+        s.overlong++;
+        s.len = 0;
+        s.discard = true;
+    }
+}
+
+// 한 번 읽기. 닫혔으면 false
+static bool ReadOnce(Stream &s, int64_t t_us)
+{
+    ssize_t n = read(s.fd, s.buf.data() + s.len, kBufBytes - s.len);
+    if (n > 0) {
+        s.len += (size_t)n;
+        s.bytes += (uint64_t)n;
+        tot.reads++;
+        Consume(s, t_us);
+        return true;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EINTR))
+        return true;
+    return false;       // 0 = 끝, EIO = pty 반대쪽이 닫힘 / 장치가 빠짐
+}
+
+static void AddTotals(const Stream &s)
+{
+    tot.bytes += s.bytes;
+    tot.samples += s.samples;
+    tot.other += s.other;
+    tot.scan.frames += s.scan.frames;
+    tot.scan.dlog += s.scan.dlog;
+    tot.scan.dlog_skipped += s.scan.dlog_skipped;
+    tot.scan.bad += s.scan.bad;
+    tot.overlong += s.overlong;
+}
+
+static bool SetRaw(int fd, speed_t baud)
+{
+    termios tio;
+    if (tcgetattr(fd, &tio) != 0)
+        return false;
+    cfmakeraw(&tio);
+    if (baud)
+        cfsetspeed(&tio, baud);
+    tio.c_cflag |= CLOCAL | CREAD;
+    return tcsetattr(fd, TCSANOW, &tio) == 0;
+}
+
+static speed_t BaudFlag(long baud)
+{
+    switch (baud) {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default: return 0;
+    }
+}
+
+static std::vector<Stream*> streams;
+
+static Stream *NewStream(const std::string &name, int fd)
+{
+    Stream *s = new Stream;
+    s->name = name;
+    s->fd = fd;
+    s->buf.resize(kBufBytes);
+    if (have_writer) {
+        int id = writer.AddStream(name.c_str());
+        if (id < 0) {
+            fprintf(stderr, "%s: too many streams in file\n", name.c_str());
+            delete s;
+            return nullptr;
+        }
+        s->id = (uint16_t)id;
+    }
+    streams.push_back(s);
+    return s;
+}
+
+// 일반 파일은 epoll 에 못 넣으므로 처음에 한 번에
+static void ImportFile(Stream &s)
+{
+    int64_t t = WallUs();
+    while (ReadOnce(s, t)) {}
+    writer.Commit();
+    close(s.fd);
+    s.fd = -1;
+}
+
+// epoll 루프: 스트림이 다 닫히거나 stop_flag 또는 done() 이 참이면 끝
+template <typename Done>
+static void RunLoop(int ep, size_t open_streams, Done done)
+{
+    std::vector<epoll_event> ev(256);
+    while (open_streams > 0 && !stop_flag && !done()) {
+        int n = epoll_wait(ep, ev.data(), (int)ev.size(), 100);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            break;
+        }
+        int64_t t = WallUs();
+        for (int i = 0; i < n; i++) {
+            Stream *s = (Stream*)ev[i].data.ptr;
+            // 준비된 스트림마다 한 번씩만 읽어서 바쁜 보드가 다른 보드를 굶기지 않게
+            if (!ReadOnce(*s, t)) {
+                epoll_ctl(ep, EPOLL_CTL_DEL, s->fd, nullptr);
+                close(s->fd);
+                s->fd = -1;
+                open_streams--;
+            }
+        }
+        if (have_writer)
+            writer.Commit();
+    }
+}
+
+static void OnSignal(int) { stop_flag = 1; }
+
+// --- 파일 읽기 (-q / -x) ---
+static int Query(const char *path, bool csv)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return 1;
+    }
+    struct stat sb;
+    fstat(fd, &sb);
+    if (sb.st_size < (off_t)kHeaderBytes) {
+        fprintf(stderr, "%s: too short\n", path);
+        return 1;
+    }
+    void *m = mmap(nullptr, (size_t)sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (m == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    const uint8_t *base = (const uint8_t*)m;
+    const FileHeader *h = (const FileHeader*)base;
+    if (memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 || h->chunk_rows == 0) {
+        fprintf(stderr, "%s: not an ingest file\n", path);
+        return 1;
+    }
+    uint64_t rows = __atomic_load_n(&h->rows, __ATOMIC_ACQUIRE);
+    size_t cb = ChunkBytes(h->chunk_rows);
+    if (kHeaderBytes + ((rows + h->chunk_rows - 1) / h->chunk_rows) * cb > (size_t)sb.st_size) {
+        fprintf(stderr, "%s: truncated\n", path);
+        return 1;
+    }
+    const char *names = (const char*)base + 4096;
+
+    struct Sum {
+        uint64_t n[3] = {};
+        uint32_t lo = UINT32_MAX, hi = 0;
+        double total = 0;
+        int64_t first = 0, last = 0;
+    };
+    std::vector<Sum> sums(h->streams);
+    if (csv)
+        printf("t_us,stream,kind,clock,value\n");
+    for (uint64_t r = 0; r < rows; r++) {
+        uint64_t c = r / h->chunk_rows;
+        uint32_t i = (uint32_t)(r % h->chunk_rows);
+        Columns col = ColumnsOf((uint8_t*)base + kHeaderBytes + c * cb, h->chunk_rows);
+        uint16_t s = col.stream[i];
+        if (csv) {
+            if (col.clock[i] == kNoClock)
+                printf("%lld,%u,%s,,%u\n", (long long)col.t_us[i], s, KindName(col.kind[i]), col.value[i]);
+            else
+                printf("%lld,%u,%s,%u,%u\n", (long long)col.t_us[i], s, KindName(col.kind[i]), col.clock[i],
+                       col.value[i]);
+            continue;
+        }
+        if (s >= sums.size())
+            continue;
+        Sum &m2 = sums[s];
+        if (m2.n[1] + m2.n[2] == 0)
+            m2.first = col.t_us[i];
+        m2.last = col.t_us[i];
+        m2.n[col.kind[i] < 3 ? col.kind[i] : 0]++;
+        m2.lo = std::min(m2.lo, col.value[i]);
+        m2.hi = std::max(m2.hi, col.value[i]);
+        m2.total += col.value[i];
+    }
+    if (!csv) {
+        printf("%llu rows in %llu chunks (%u rows each), %u streams\n", (unsigned long long)rows,
+               (unsigned long long)h->chunks, h->chunk_rows, h->streams);
+        printf("%-4s %-28s %10s %10s %6s %6s %8s %10s\n", "id", "stream", "adc", "sensor", "min", "max", "avg",
+               "span s");
+        for (uint32_t s = 0; s < h->streams; s++) {
+            const Sum &m2 = sums[s];
+            uint64_t n = m2.n[1] + m2.n[2];
+            printf("%-4u %-28.28s %10llu %10llu %6u %6u %8.1f %10.1f\n", s, names + s * kNameBytes,
+                   (unsigned long long)m2.n[1], (unsigned long long)m2.n[2], n ? m2.lo : 0, n ? m2.hi : 0,
+                   n ? m2.total / (double)n : 0.0, (m2.last - m2.first) / 1e6);
+        }
+    }
+    munmap(m, (size_t)sb.st_size);
+    close(fd);
+    return 0;
+}
+
+// --- 벤치: pty 를 보드 대신 ---
+// 보드 하나가 내는 모양을 섞은 버퍼 (sys.c / FREE_RTOS.c / sub.c 의 줄과 가끔 바이너리 프레임)
+static std::string MakeBoardText(uint32_t board, std::vector<uint32_t> &rec_end)
+{
+    std::string t;
+    uint32_t rng = board * 2654435761u + 1;
+    auto rnd = [&] { rng = rng * 1103515245u + 12345u; return rng >> 8; };
+    char line[64];
+    for (uint32_t i = 0; t.size() < 60000; i++) {
+        uint32_t v = 1500 + rnd() % 1000;
+        uint32_t r = rnd() % 100;
+        int n;
+        if (r < 40)
+            n = snprintf(line, sizeof(line), "ADC: %u\r\n", v);
+        else if (r < 75)
+            n = snprintf(line, sizeof(line), "Sensor: %u\r\n", v);
+        else if (r < 97)
+            n = snprintf(line, sizeof(line), "[%02u:%02u:%02u] ADC: %u\r\n", (i / 3600) % 24, (i / 60) % 60, i % 60, v);
+        else if (r < 99)
+            n = snprintf(line, sizeof(line), "Button Pressed!\r\n");
+        else {
+            // dlog 'L' 프레임 모양 (내용에 '\n' 이 섞여도 길이로 건너뛰는지)
+            uint8_t f[4 + 12 + 1] = { 0xA5, 0x5A, 'L', 12 };
+            uint8_t sum = 'L' + 12;
+            for (int k = 0; k < 12; k++) {
+                f[4 + k] = (uint8_t)(k == 5 ? '\n' : rnd());
+                sum = (uint8_t)(sum + f[4 + k]);
+            }
+            f[16] = sum;
+            t.append((const char*)f, sizeof(f));
+            rec_end.push_back((uint32_t)t.size());
+            continue;
+        }
+        t.append(line, (size_t)n);
+        rec_end.push_back((uint32_t)t.size());
+    }
+    return t;
+}
+
+struct BenchBoard {
+    int master = -1;
+    int slave = -1;
+    std::string text;
+    std::vector<uint32_t> rec_end;
+};
+
+// 쓰는 프로세스: 맡은 pty 에 버퍼를 돌려가며 deadline 까지 씀, 끝나면 보드별 레코드 수를 pipe 로
+static void Writer(std::vector<BenchBoard> &boards, size_t first, size_t step, double seconds, int report_fd,
+                   int quit_fd)
+{
+    std::vector<size_t> mine;
+    for (size_t i = first; i < boards.size(); i += step)
+        mine.push_back(i);
+    std::vector<uint64_t> cycles(boards.size()), off(boards.size());
+    for (size_t i : mine)
+        fcntl(boards[i].master, F_SETFL, O_NONBLOCK);
+    int ep = epoll_create1(0);
+    for (size_t i : mine) {
+        epoll_event e = {};
+        e.events = EPOLLOUT;
+        e.data.u64 = i;
+        epoll_ctl(ep, EPOLL_CTL_ADD, boards[i].master, &e);
+    }
+    auto end = Clock::now() + std::chrono::duration<double>(seconds);
+    std::vector<epoll_event> ev(256);
+    while (Clock::now() < end) {
+        int n = epoll_wait(ep, ev.data(), (int)ev.size(), 50);
+        for (int k = 0; k < n; k++) {
+            size_t i = ev[k].data.u64;
+            BenchBoard &b = boards[i];
+            ssize_t w = write(b.master, b.text.data() + off[i], b.text.size() - off[i]);
+            if (w <= 0)
+                continue;
+            off[i] += (size_t)w;
+            if (off[i] == b.text.size()) {
+                off[i] = 0;
+                cycles[i]++;
+            }
+        }
+    }
+    // 레코드 중간에서 멈춘 보드는 그 레코드 끝까지 마저 씀 (블로킹)
+    for (size_t i : mine) {
+        BenchBoard &b = boards[i];
+        fcntl(b.master, F_SETFL, 0);
+        auto it = std::lower_bound(b.rec_end.begin(), b.rec_end.end(), (uint32_t)off[i]);
+        size_t stop = it == b.rec_end.end() ? b.text.size() : *it;
+        while (off[i] < stop) {
+            ssize_t w = write(b.master, b.text.data() + off[i], stop - off[i]);
+            if (w <= 0)
+                break;
+            off[i] += (size_t)w;
+        }
+        uint64_t recs = cycles[i] * b.rec_end.size() +
+                        (uint64_t)(std::upper_bound(b.rec_end.begin(), b.rec_end.end(), (uint32_t)off[i]) -
+                                   b.rec_end.begin());
+        uint64_t msg[2] = { i, recs };
+        if (write(report_fd, msg, sizeof(msg)) != (ssize_t)sizeof(msg))
+            break;
+    }
+    close(report_fd);
+    char c;
+    if (read(quit_fd, &c, 1) < 0) {}     // 읽는 쪽이 다 받을 때까지 pty 를 열어 둠
+    _exit(0);
+}
+
+// 메모리 안에서 줄 파싱만: 스캐너 vs sscanf (예전 스크립트 방식)
+static void ParseBench(const std::string &text)
+{
+    std::vector<std::pair<const char*, const char*>> lines;
+    const char *p = text.data(), *end = p + text.size();
+    while (p < end) {
+        const char *nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!nl) break;
+        lines.emplace_back(p, nl);
+        p = nl + 1;
+    }
+    const int reps = 200;
+    uint64_t sink = 0;
+    auto t0 = Clock::now();
+    for (int r = 0; r < reps; r++)
+        for (auto &l : lines) {
+            uint8_t k;
+            uint32_t c, v;
+            if (ParseLine(l.first, l.second, k, c, v)) sink += v + k;
+        }
+    auto t1 = Clock::now();
+    char tmp[128];
+    for (int r = 0; r < reps / 10; r++)
+        for (auto &l : lines) {
+            size_t n = std::min((size_t)(l.second - l.first), sizeof(tmp) - 1);
+            memcpy(tmp, l.first, n);
+            tmp[n] = '\0';
+            unsigned h, m, s, v;
+            if (sscanf(tmp, "[%u:%u:%u] ADC: %u", &h, &m, &s, &v) == 4 || sscanf(tmp, "ADC: %u", &v) == 1 ||
+                sscanf(tmp, "Sensor: %u", &v) == 1)
+                sink += v;
+        }
+    auto t2 = Clock::now();
+    double a = std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)reps * lines.size());
+    double b = std::chrono::duration<double, std::nano>(t2 - t1).count() / ((double)(reps / 10) * lines.size());
+    printf("parse only: scanner %.1f ns/line (%.0f M lines/s), sscanf %.1f ns/line (x%.1f) [%llu]\n", a, 1000.0 / a,
+           b, b / a, (unsigned long long)(sink & 1));
+}
+
+static int Bench(uint32_t nboards, double seconds, uint32_t nwriters, const char *out)
+{
+    std::vector<BenchBoard> boards(nboards);
+    for (uint32_t i = 0; i < nboards; i++) {
+        BenchBoard &b = boards[i];
+        b.master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (b.master < 0 || grantpt(b.master) != 0 || unlockpt(b.master) != 0) {
+            perror("posix_openpt");
+            return 1;
+        }
+        b.slave = open(ptsname(b.master), O_RDONLY | O_NONBLOCK | O_NOCTTY);
+        if (b.slave < 0 || !SetRaw(b.slave, 0)) {
+            perror("pty slave");
+            return 1;
+        }
+        b.text = MakeBoardText(i, b.rec_end);
+    }
+    ParseBench(boards[0].text);
+
+    std::string path = out ? out : "/tmp/ingest_bench.ts";
+    if (!out)
+        unlink(path.c_str());
+    if (!writer.Open(path.c_str())) {
+        perror(path.c_str());
+        return 1;
+    }
+    have_writer = true;
+    uint64_t rows0 = writer.Rows();
+
+    int report[2], quit[2];
+    if (pipe(report) != 0 || pipe(quit) != 0)
+        return 1;
+    nwriters = std::max(1u, std::min(nwriters, nboards));
+    std::vector<pid_t> pids;
+    for (uint32_t w = 0; w < nwriters; w++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(report[0]);
+            close(quit[1]);
+            for (BenchBoard &b : boards) close(b.slave);
+            Writer(boards, w, nwriters, seconds, report[1], quit[0]);
+        }
+        pids.push_back(pid);
+    }
+    close(report[1]);
+    close(quit[0]);
+    for (BenchBoard &b : boards) close(b.master);
+    fcntl(report[0], F_SETFL, O_NONBLOCK);
+
+    int ep = epoll_create1(0);
+    for (uint32_t i = 0; i < nboards; i++) {
+        Stream *s = NewStream("pty" + std::to_string(i), boards[i].slave);
+        epoll_event e = {};
+        e.events = EPOLLIN;
+        e.data.ptr = s;
+        epoll_ctl(ep, EPOLL_CTL_ADD, s->fd, &e);
+    }
+
+    // 쓰는 쪽이 끝나고 보낸 수만큼 다 받으면 끝
+    std::vector<int64_t> expect(nboards, -1);
+    uint32_t reported = 0;
+    auto last_progress = Clock::now();
+    uint64_t last_recs = 0;
+    auto done = [&] {
+        uint64_t msg[2];
+        while (read(report[0], msg, sizeof(msg)) == (ssize_t)sizeof(msg)) {
+            expect[msg[0]] = (int64_t)msg[1];
+            reported++;
+        }
+        if (reported < nboards)
+            return false;
+        uint64_t recs = 0;
+        bool all = true;
+        for (uint32_t i = 0; i < nboards; i++) {
+            const Stream *s = streams[i];
+            uint64_t got = s->samples + s->other + s->scan.frames;
+            recs += got;
+            all = all && (int64_t)got >= expect[i];
+        }
+        if (recs != last_recs) {
+            last_recs = recs;
+            last_progress = Clock::now();
+        }
+        return all || Clock::now() - last_progress > std::chrono::seconds(2);
+    };
+    auto t0 = Clock::now();
+    RunLoop(ep, nboards, done);
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    if (write(quit[1], "q", 1) < 0) {}
+    close(quit[1]);
+    for (pid_t p : pids)
+        waitpid(p, nullptr, 0);
+
+    uint64_t mismatched = 0;
+    for (uint32_t i = 0; i < nboards; i++) {
+        Stream *s = streams[i];
+        AddTotals(*s);
+        if ((int64_t)(s->samples + s->other + s->scan.frames) != expect[i])
+            mismatched++;
+        if (s->fd >= 0)
+            close(s->fd);
+    }
+    writer.Close();
+
+    uint64_t lines = tot.samples + tot.other;
+    printf("%u ptys, %u writer procs, %.2f s: %llu lines (%llu samples, %llu other), %llu frames, %.1f MB\n",
+           nboards, nwriters, secs, (unsigned long long)lines, (unsigned long long)tot.samples,
+           (unsigned long long)tot.other, (unsigned long long)tot.scan.frames, tot.bytes / 1e6);
+    printf("  %.2f M lines/s, %.1f MB/s, %.0f B/read, %llu rows -> %s (%.1f B/row on disk)\n", lines / secs / 1e6,
+           tot.bytes / secs / 1e6, tot.reads ? (double)tot.bytes / (double)tot.reads : 0.0,
+           (unsigned long long)(writer.Rows() - rows0), path.c_str(), (double)kRowBytes);
+    printf("  records vs written: %s (%llu of %u boards differ)\n", mismatched ? "MISMATCH" : "ok",
+           (unsigned long long)mismatched, nboards);
+    return mismatched ? 2 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *out = nullptr;
+    long baud = 115200;
+    uint32_t bench = 0, nwriters = 4;
+    double seconds = 5;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:B:e:q:x:b:s:w:")) != -1) {
+        switch (opt) {
+            case 'o': out = optarg; break;
+            case 'B': baud = atol(optarg); break;
+            case 'e':
+                if (!DlogLoadElf(optarg, dlog_fmt)) {
+                    DlogLoadError(optarg);
+                    return 1;
+                }
+                break;
+            case 'q': return Query(optarg, false);
+            case 'x': return Query(optarg, true);
+            case 'b': bench = (uint32_t)atoi(optarg); break;
+            case 's': seconds = atof(optarg); break;
+            case 'w': nwriters = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr,
+                        "usage: %s -o file.ts [-B baud] [-e firmware.elf] input...\n"
+                        "       %s -q file.ts | -x file.ts\n"
+                        "       %s -b boards [-s sec] [-w writers] [-o file.ts]\n",
+                        argv[0], argv[0], argv[0]);
+                return 1;
+        }
+    }
+    signal(SIGPIPE, SIG_IGN);
+    if (bench) {
+        if (bench > kMaxStreams) {
+            fprintf(stderr, "at most %u boards\n", kMaxStreams);
+            return 1;
+        }
+        return Bench(bench, seconds, nwriters, out);
+    }
+    if (!out || optind >= argc) {
+        fprintf(stderr, "need -o file.ts and at least one input\n");
+        return 1;
+    }
+    speed_t speed = BaudFlag(baud);
+    if (!speed) {
+        fprintf(stderr, "unsupported baud %ld\n", baud);
+        return 1;
+    }
+    if (!writer.Open(out)) {
+        perror(out);
+        return 1;
+    }
+    have_writer = true;
+
+    struct sigaction sa = {};
+    sa.sa_handler = OnSignal;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    int ep = epoll_create1(0);
+    size_t live = 0;
+    auto t0 = Clock::now();
+    for (int i = optind; i < argc; i++) {
+        int fd = open(argv[i], O_RDONLY | O_NONBLOCK | O_NOCTTY);
+        if (fd < 0) {
+            perror(argv[i]);
+            continue;
+        }
+        Stream *s = NewStream(argv[i], fd);
+        if (!s) {
+            close(fd);
+            continue;
+        }
+        struct stat sb;
+        fstat(fd, &sb);
+        if (S_ISREG(sb.st_mode)) {
+            ImportFile(*s);
+            continue;
+        }
+        if (isatty(fd) && !SetRaw(fd, speed))
+            fprintf(stderr, "%s: cannot set raw %ld baud\n", argv[i], baud);
+        epoll_event e = {};
+        e.events = EPOLLIN;
+        e.data.ptr = s;
+        if (epoll_ctl(ep, EPOLL_CTL_ADD, fd, &e) != 0) {
+            perror(argv[i]);
+            close(fd);
+            s->fd = -1;
+            continue;
+        }
+        live++;
+    }
+    RunLoop(ep, live, [] { return false; });
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    for (Stream *s : streams) {
+        AddTotals(*s);
+        fprintf(stderr, "%-28s %10llu samples %8llu other %6llu frames (%llu dlog, %llu bad) %llu overlong\n",
+                s->name.c_str(), (unsigned long long)s->samples, (unsigned long long)s->other,
+                (unsigned long long)s->scan.frames, (unsigned long long)s->scan.dlog,
+                (unsigned long long)s->scan.bad, (unsigned long long)s->overlong);
+        if (s->fd >= 0)
+            close(s->fd);
+    }
+    fprintf(stderr, "%llu samples, %.1f MB in %.2f s -> %s (%llu rows)\n", (unsigned long long)tot.samples,
+            tot.bytes / 1e6, secs, out, (unsigned long long)writer.Rows());
+    if (tot.scan.dlog_skipped)
+        fprintf(stderr, "%llu 'L' frames skipped: give -e firmware.elf or pipe through dlog_decode\n",
+                (unsigned long long)tot.scan.dlog_skipped);
+    writer.Close();
+    return 0;
+}
@@ -0,0 +1,328 @@
+// main.h (호스트용)
+// STM32 HAL 중 sys.c / FREE_RTOS.c / maung.c / sub.c 가 쓰는 부분만 정의
+// 구현은 host_hal.c, 입력(ADC)과 출력(UART, GPIO, I2C)은 host_os.h 의 훅으로 연결
+// 전송이 걸리는 시간(UART 보레이트, I2C 클럭)은 가상 시간으로 소모된다
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    HAL_OK      = 0x00,
+    HAL_ERROR   = 0x01,
+    HAL_BUSY    = 0x02,
+    HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY   0xFFFFFFFFu
+#define ENABLE          1
+#define DISABLE         0
+
+// --- GPIO ---
+typedef struct {
+    char name;              // 'A', 'B', 'C' ...
+    uint32_t ODR;
+    uint32_t IDR;
+} GPIO_TypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+extern GPIO_TypeDef host_gpioa, host_gpiob, host_gpioc;
+#define GPIOA   (&host_gpioa)
+#define GPIOB   (&host_gpiob)
+#define GPIOC   (&host_gpioc)
+
+#define GPIO_PIN_0      ((uint16_t)0x0001)
+#define GPIO_PIN_1      ((uint16_t)0x0002)
+#define GPIO_PIN_2      ((uint16_t)0x0004)
+#define GPIO_PIN_3      ((uint16_t)0x0008)
+#define GPIO_PIN_5      ((uint16_t)0x0020)
+#define GPIO_PIN_6      ((uint16_t)0x0040)
+#define GPIO_PIN_13     ((uint16_t)0x2000)
+
+#define GPIO_MODE_INPUT         0x00u
+#define GPIO_MODE_OUTPUT_PP     0x01u
+#define GPIO_MODE_AF_PP         0x02u
+#define GPIO_MODE_IT_RISING     0x10110000u
+#define GPIO_MODE_IT_FALLING    0x10210000u
+#define GPIO_NOPULL             0x00u
+#define GPIO_SPEED_FREQ_LOW     0x02u
+#define GPIO_SPEED_FREQ_VERY_HIGH 0x03u
+
+// --- ADC ---
+typedef struct {
+    uint32_t DataAlign;
+    uint32_t ScanConvMode;
+    uint32_t ContinuousConvMode;
+    uint32_t NbrOfConversion;
+    uint32_t DiscontinuousConvMode;
+} ADC_InitTypeDef;
+
+typedef struct {
+    void *Instance;
+    ADC_InitTypeDef Init;
+    uint32_t channel;
+    uint32_t value;
+} ADC_HandleTypeDef;
+
+typedef struct {
+    uint32_t Channel;
+    uint32_t Rank;
+    uint32_t SamplingTime;
+} ADC_ChannelConfTypeDef;
+
+#define ADC1                        ((void*)0x40012400)
+#define ADC_SCAN_DISABLE            0x00u
+#define ADC_DATAALIGN_RIGHT         0x00u
+#define ADC_CHANNEL_1               0x01u
+#define ADC_CHANNEL_VREFINT         0x11u
+#define ADC_SAMPLETIME_71CYCLES_5   0x06u
+#define ADC_SAMPLETIME_239CYCLES_5  0x07u
+
+// --- UART ---
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+} UART_InitTypeDef;
+
+typedef struct {
+    void *Instance;
+    UART_InitTypeDef Init;
+    uint8_t *pRxBuffPtr;        // HAL_UART_Receive_IT: 다음 바이트 자리 / 남은 바이트
+    uint16_t RxXferCount;
+} UART_HandleTypeDef;
+
+#define USART1                  ((void*)0x40013800)
+#define UART_WORDLENGTH_8B      0x00u
+#define UART_STOPBITS_1         0x00u
+#define UART_PARITY_NONE        0x00u
+#define UART_MODE_TX_RX         0x0Cu
+
+// --- RCC (maung.c 의 SystemClock_Config 용) ---
+typedef struct {
+    uint32_t PLLState;
+    uint32_t PLLSource;
+    uint32_t PLLMUL;
+} RCC_PLLInitTypeDef;
+
+typedef struct {
+    uint32_t OscillatorType;
+    uint32_t HSEState;
+    RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct {
+    uint32_t ClockType;
+    uint32_t SYSCLKSource;
+    uint32_t AHBCLKDivider;
+    uint32_t APB1CLKDivider;
+    uint32_t APB2CLKDivider;
+} RCC_ClkInitTypeDef;
+
+#define RCC_OSCILLATORTYPE_HSE  0x01u
+#define RCC_HSE_ON              0x01u
+#define RCC_PLL_ON              0x02u
+#define RCC_PLLSOURCE_HSE       0x01u
+#define RCC_PLL_MUL9            0x07u
+#define RCC_CLOCKTYPE_SYSCLK    0x01u
+#define RCC_CLOCKTYPE_HCLK      0x02u
+#define RCC_CLOCKTYPE_PCLK1     0x04u
+#define RCC_CLOCKTYPE_PCLK2     0x08u
+#define RCC_SYSCLKSOURCE_PLLCLK 0x02u
+#define RCC_SYSCLK_DIV1         0x00u
+#define RCC_HCLK_DIV1           0x00u
+#define RCC_HCLK_DIV2           0x04u
+#define FLASH_LATENCY_2         0x02u
+
+// --- I2C ---
+typedef struct {
+    uint32_t ClockSpeed;
+    uint32_t DutyCycle;
+    uint32_t OwnAddress1;
+    uint32_t AddressingMode;
+    uint32_t DualAddressMode;
+} I2C_InitTypeDef;
+
+typedef enum {
+    HAL_I2C_STATE_RESET     = 0x00,
+    HAL_I2C_STATE_READY     = 0x20,
+    HAL_I2C_STATE_BUSY_TX   = 0x21,
+    HAL_I2C_STATE_BUSY_RX   = 0x22
+} HAL_I2C_StateTypeDef;
+
+typedef struct {
+    void *Instance;
+    I2C_InitTypeDef Init;
+    volatile HAL_I2C_StateTypeDef State;
+} I2C_HandleTypeDef;
+
+#define I2C1                        ((void*)0x40005400)
+#define I2C_DUTYCYCLE_2             0x00u
+#define I2C_ADDRESSINGMODE_7BIT     0x4000u
+#define I2C_DUALADDRESS_DISABLE     0x00u
+#define I2C_MEMADD_SIZE_8BIT        0x01u
+
+// --- RTC ---
+typedef struct {
+    uint32_t AsynchPrediv;
+    uint32_t OutPut;
+} RTC_InitTypeDef;
+
+typedef struct {
+    void *Instance;
+    RTC_InitTypeDef Init;
+    int64_t offset_s;           // 설정한 시각 - 가상 시간
+} RTC_HandleTypeDef;
+
+typedef struct {
+    uint8_t Hours;
+    uint8_t Minutes;
+    uint8_t Seconds;
+} RTC_TimeTypeDef;
+
+typedef struct {
+    uint8_t WeekDay;
+    uint8_t Month;
+    uint8_t Date;
+    uint8_t Year;
+} RTC_DateTypeDef;
+
+#define RTC                         ((void*)0x40002800)
+#define RTC_AUTO_1_SECOND           0xFFFFFFFFu
+#define RTC_OUTPUTSOURCE_NONE       0x00u
+#define RTC_FORMAT_BIN              0x00u
+#define RTC_WEEKDAY_MONDAY          0x01u
+#define RTC_MONTH_JUNE              0x06u
+
+// --- TIM ---
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    void *Instance;
+    TIM_Base_InitTypeDef Init;
+    uint32_t ccr[4];
+} TIM_HandleTypeDef;
+
+typedef struct {
+    uint32_t OCMode;
+    uint32_t Pulse;
+    uint32_t OCPolarity;
+} TIM_OC_InitTypeDef;
+
+#define TIM2                        ((void*)0x40000000)
+#define TIM3                        ((void*)0x40000400)
+#define TIM_COUNTERMODE_UP          0x00u
+#define TIM_CLOCKDIVISION_DIV1      0x00u
+#define TIM_OCMODE_PWM1             0x60u
+#define TIM_OCPOLARITY_HIGH         0x00u
+#define TIM_CHANNEL_1               0x00u
+#define TIM_CHANNEL_2               0x04u
+#define TIM_CHANNEL_3               0x08u
+#define TIM_CHANNEL_4               0x0Cu
+
+#define __HAL_TIM_SET_COMPARE(h, ch, v)  ((h)->ccr[(ch) >> 2] = (v))
+#define __HAL_TIM_GET_COMPARE(h, ch)     ((h)->ccr[(ch) >> 2])
+
+// --- NVIC ---
+typedef enum {
+    EXTI0_IRQn      = 6,
+    EXTI1_IRQn      = 7,
+    DMA1_Channel6_IRQn = 16,
+    DMA1_Channel7_IRQn = 17,
+    TIM2_IRQn       = 28,
+    TIM3_IRQn       = 29,
+    I2C1_EV_IRQn    = 31,
+    I2C1_ER_IRQn    = 32,
+    USART1_IRQn     = 37
+} IRQn_Type;
+
+#define __HAL_RCC_ADC1_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_USART1_CLK_ENABLE()   ((void)0)
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_I2C1_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_DMA1_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_TIM3_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_RTC_ENABLE()          ((void)0)
+
+HAL_StatusTypeDef HAL_Init(void);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void SystemClock_Config(void);
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig);
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc);
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+// 수신 바이트는 HostOs_UartIn 으로 넣고, Size 바이트가 차면 HAL_UART_RxCpltCallback 이 인터럽트로 불림
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout);
+// DMA 전송은 바로 돌아오고, 버스 시간이 지나면 HAL_I2C_MasterTxCpltCallback 이 인터럽트로 불림
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef *hrtc);
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
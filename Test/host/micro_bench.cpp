@@ -0,0 +1,322 @@
+// micro_bench.cpp
+// 샘플마다 도는 연산들의 호스트 마이크로벤치 (sys.c / sub.c 핫 패스)
+//
+//   send_event      sys.c SendEvent + 꺼내기 (eventQueue, sys_graph.cpp 와 같은 크기)
+//   queue_put_get   osMessagePut / osMessageGet 한 쌍 (빈 큐, 대기 없음)
+//   queue_fill16    16 개 넣고 16 개 꺼내기 (큐가 차는 경우, 항목당)
+//   sprintf_*       sys.c DisplayTask / sub.c Job_Log, Job_Oled 의 sprintf 각각
+//   servo_pulse     sub.c Job_Adc 의 500 + adc * 2000 / 4095
+//   logic_switch    sys.c LogicTask 한 번 (SysPipe_Logic: 규칙 평가 두 번 + 럭스 변환, 그리고 SendEvent)
+//
+// 연산마다 반복 횟수를 한 번에 ~20 ms 가 되게 맞춘 뒤 여러 번 재서 중앙값을 쓴다.
+// ns/op 는 호스트 시간, cycles/op 는 x86 TSC (고정 주파수 기준 사이클, 코어 클럭과 다를 수 있음,
+// TSC 가 없으면 -1). 큐 연산은 host_os 의 pthread mutex 비용이라 타깃 FreeRTOS 값이 아님:
+// 절대값보다 변경 전후 비교용.
+//
+// 결과는 CSV (-o), 이전 결과(-b)와 비교해 중앙값이 -t % 넘게 느려진 항목이 있으면 종료 코드 1
+//   name,iters,ns_per_op,ns_min,ns_max,cycles_per_op
+//
+// 빌드:
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host -Dmain=firmware_main
+//       Test/sys.c Test/sys_pipeline.c Test/stack_mon.c Test/rt_stats.c Test/rules.c Test/sensor_rec.c Test/dlog.c Test/periodic.c
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/calib.cpp Test/board.cpp Test/host/bsp_host.cpp Test/pwm_fade.cpp
+//   g++ -c -O2 -std=c++17 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/sys_graph.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/host/micro_bench.cpp *.o -pthread -o micro_bench
+// 사용: ./micro_bench [-o out.csv] [-b baseline.csv] [-t 10] [-r 15] [-f 이름일부]
+#include "host_os.h"
+#include "main.h"
+#include "cmsis_os.h"
+#include "calib.h"
+#include "rules.h"
+#include "sys_pipeline.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+// sys.c 쪽 (EventType 은 -fshort-enums 로 1 바이트)
+extern "C" {
+extern osMessageQId eventQueueHandle;
+extern osMessageQId displayQueueHandle;
+void SendEvent(EventType type, uint16_t value);
+}
+
+static inline void Keep(const void *p)
+{
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+static inline uint64_t Tsc()
+{
+#ifdef HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// --- 입력: 조도처럼 천천히 흔들리는 ADC 값 ---
+static std::vector<uint16_t> adc_values;
+
+static void MakeInputs()
+{
+    uint32_t rng = 1;
+    int32_t v = 2000;
+    adc_values.resize(4096);
+    for (uint16_t &x : adc_values) {
+        rng = rng * 1103515245u + 12345u;
+        v += (int32_t)((rng >> 16) % 61) - 30;
+        v = v < 0 ? 0 : v > 4095 ? 4095 : v;
+        x = (uint16_t)v;
+    }
+}
+
+// --- 벤치 본체: 한 번 부르면 op 를 n 번 ---
+struct Bench {
+    const char *name;
+    std::function<void(uint32_t n)> run;
+};
+
+static char buf[64];
+static volatile uint32_t sink;
+
+static void DrainEventQueue()
+{
+    osEvent e;
+    while ((e = osMessageGet(eventQueueHandle, 0)).status == osEventMessage)
+        sink += e.value.v;
+    while ((e = osMessageGet(displayQueueHandle, 0)).status == osEventMessage)
+        sink += e.value.v;
+}
+
+// sys.c LogicTask 한 번 (osMessageGet 으로 받은 뒤 부분: sys_pipeline.c 단계 + SendEvent)
+static void LogicStep(EventType type, uint16_t value, uint32_t now)
+{
+    Event in = { type, value };
+    Event out;
+    if (SysPipe_Logic(Rules_Default(), &in, now, &out))
+        SendEvent(out.type, out.value);
+}
+
+static void LedOut(uint8_t arg) { sink += arg; }
+
+static std::vector<Bench> MakeBenches()
+{
+    static osMessageQDef(bench, 16, uint32_t);
+    static osMessageQId q = osMessageCreate(osMessageQ(bench), NULL);
+    const uint32_t mask = (uint32_t)adc_values.size() - 1;
+
+    return {
+        { "send_event", [mask](uint32_t n) {
+            for (uint32_t i = 0; i < n; i++) {
+                SendEvent(EVENT_SENSOR_READ, adc_values[i & mask]);
+                sink += osMessageGet(eventQueueHandle, 0).value.v;
+            }
+        } },
+        { "queue_put_get", [mask](uint32_t n) {
+            for (uint32_t i = 0; i < n; i++) {
+                osMessagePut(q, adc_values[i & mask], 0);
+                sink += osMessageGet(q, 0).value.v;
+            }
+        } },
+        { "queue_fill16", [mask](uint32_t n) {
+            for (uint32_t i = 0; i < n; i += 16) {
+                for (uint32_t k = 0; k < 16; k++)
+                    osMessagePut(q, adc_values[(i + k) & mask], 0);
+                for (uint32_t k = 0; k < 16; k++)
+                    sink += osMessageGet(q, 0).value.v;
+            }
+        } },
+        { "sprintf_sensor", [mask](uint32_t n) {
+            for (uint32_t i = 0; i < n; i++) {
+                sprintf(buf, "Sensor: %u\r\n", adc_values[i & mask]);
+                Keep(buf);
+            }
+        } },
+        { "sprintf_log", [mask](uint32_t n) {
+            for (uint32_t i = 0; i < n; i++) {
+                unsigned long adc = adc_values[i & mask];
+                int s = (int)(i % 86400);
+                sprintf(buf, "[%02d:%02d:%02d] ADC: %lu\r\n", s / 3600, (s / 60) % 60, s % 60, adc);
+                Keep(buf);
+            }
+        } },
+        { "sprintf_oled", [mask](uint32_t n) {
+            // Job_Oled 의 세 줄 (op 하나 = 세 줄)
+            for (uint32_t i = 0; i < n; i++) {
+                unsigned long adc = adc_values[i & mask];
+                int s = (int)(i % 86400);
+                uint32_t lux = Calib_RawToLuxQ16((uint16_t)adc);
+                sprintf(buf, "ADC: %4lu", adc);
+                Keep(buf);
+                sprintf(buf, "Time: %02d:%02d:%02d", s / 3600, (s / 60) % 60, s % 60);
+                Keep(buf);
+                sprintf(buf, "Lux: %4lu.%lu", (unsigned long)CALIB_Q16_INT(lux),
+                        (unsigned long)CALIB_Q16_TENTHS(lux));
+                Keep(buf);
+            }
+        } },
+        { "servo_pulse", [mask](uint32_t n) {
+            // sub.c Job_Adc: uint32_t pulse = 500 + (adc_val * 2000 / 4095);
+            for (uint32_t i = 0; i < n; i++) {
+                volatile uint32_t adc_val = adc_values[i & mask];
+                uint32_t pulse = 500 + (adc_val * 2000 / 4095);
+                sink = pulse;
+            }
+        } },
+        { "logic_switch", [mask](uint32_t n) {
+            for (uint32_t i = 0; i < n; i++) {
+                LogicStep(EVENT_SENSOR_READ, adc_values[i & mask], i * 500);
+                sink += osMessageGet(displayQueueHandle, 0).value.v;
+            }
+        } },
+    };
+}
+
+// --- 측정 ---
+struct Result {
+    std::string name;
+    uint32_t iters;
+    double ns, ns_min, ns_max, cycles;
+};
+
+static Result Measure(const Bench &b, int repeats)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 한 번에 20 ms 쯤 되게 반복 횟수 맞추기
+    uint32_t n = 64;
+    for (;;) {
+        auto t0 = Clock::now();
+        b.run(n);
+        double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (secs > 0.02 || n >= (1u << 28))
+            break;
+        n = secs < 0.002 ? n * 8 : (uint32_t)std::min<double>((double)n * 0.02 / secs + 1, 1u << 28);
+    }
+    n = (n + 15) & ~15u;
+
+    std::vector<double> ns(repeats), cyc(repeats);
+    for (int r = 0; r < repeats; r++) {
+        auto t0 = Clock::now();
+        uint64_t c0 = Tsc();
+        b.run(n);
+        uint64_t c1 = Tsc();
+        ns[r] = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / n;
+        cyc[r] = (double)(c1 - c0) / n;
+    }
+    std::vector<double> sorted = ns;
+    std::sort(sorted.begin(), sorted.end());
+    std::sort(cyc.begin(), cyc.end());
+    Result res = { b.name, n, sorted[repeats / 2], sorted.front(), sorted.back(), cyc[repeats / 2] };
+#ifndef HAVE_TSC
+    res.cycles = -1;
+#endif
+    return res;
+}
+
+static std::map<std::string, double> ReadBaseline(const char *path)
+{
+    std::map<std::string, double> out;
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "%s: 읽을 수 없음\n", path);
+        exit(2);
+    }
+    char line[256], name[64];
+    unsigned iters;
+    double ns;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%63[^,],%u,%lf", name, &iters, &ns) == 3)
+            out[name] = ns;
+    }
+    fclose(f);
+    return out;
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = nullptr, *baseline = nullptr, *filter = nullptr;
+    double threshold = 10.0;
+    int repeats = 15;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:b:t:r:f:")) != -1) {
+        switch (opt) {
+            case 'o': out_path = optarg; break;
+            case 'b': baseline = optarg; break;
+            case 't': threshold = atof(optarg); break;
+            case 'r': repeats = std::max(1, atoi(optarg)); break;
+            case 'f': filter = optarg; break;
+            default:
+                fprintf(stderr, "usage: %s [-o out.csv] [-b baseline.csv] [-t pct] [-r repeats] [-f name]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    // sys.c main 과 같은 준비 (태스크 없이 큐와 규칙만)
+    MakeInputs();
+    // 큐는 sys_graph.cpp 와 같은 크기로 따로 (TaskGraph_Create 는 태스크까지 만듦)
+    osMessageQDef(eventQueue, SYS_EVENT_QUEUE_LEN, uint32_t);
+    osMessageQDef(displayQueue, SYS_DISPLAY_QUEUE_LEN, uint32_t);
+    eventQueueHandle = osMessageCreate(osMessageQ(eventQueue), NULL);
+    displayQueueHandle = osMessageCreate(osMessageQ(displayQueue), NULL);
+    Calib_SetVrefint(1489);     // 3.3 V 근처
+    SysPipe_InitRules(Rules_Default(), LedOut);
+
+    std::vector<Result> results;
+    printf("%-16s %10s %10s %10s %10s %10s\n", "op", "iters", "ns/op", "min", "max", "cycles/op");
+    for (const Bench &b : MakeBenches()) {
+        if (filter && !strstr(b.name, filter))
+            continue;
+        Result r = Measure(b, repeats);
+        DrainEventQueue();
+        printf("%-16s %10u %10.2f %10.2f %10.2f %10.1f\n", r.name.c_str(), r.iters, r.ns, r.ns_min, r.ns_max,
+               r.cycles);
+        results.push_back(r);
+    }
+
+    if (out_path) {
+        FILE *f = fopen(out_path, "w");
+        if (!f) {
+            fprintf(stderr, "%s: 쓸 수 없음\n", out_path);
+            return 2;
+        }
+        fprintf(f, "name,iters,ns_per_op,ns_min,ns_max,cycles_per_op\n");
+        for (const Result &r : results)
+            fprintf(f, "%s,%u,%.3f,%.3f,%.3f,%.1f\n", r.name.c_str(), r.iters, r.ns, r.ns_min, r.ns_max, r.cycles);
+        fclose(f);
+    }
+
+    int regressions = 0;
+    if (baseline) {
+        std::map<std::string, double> base = ReadBaseline(baseline);
+        printf("\nvs %s (threshold +%.0f%%)\n", baseline, threshold);
+        for (const Result &r : results) {
+            auto it = base.find(r.name);
+            if (it == base.end() || it->second <= 0) {
+                printf("%-16s %10s\n", r.name.c_str(), "new");
+                continue;
+            }
+            double pct = (r.ns / it->second - 1.0) * 100.0;
+            bool bad = pct > threshold;
+            regressions += bad;
+            printf("%-16s %10.2f -> %8.2f ns %+7.1f%%%s\n", r.name.c_str(), it->second, r.ns, pct,
+                   bad ? "  REGRESSION" : "");
+        }
+    }
+    (void)sink;
+    return regressions ? 1 : 0;
+}
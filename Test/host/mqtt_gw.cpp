@@ -0,0 +1,1194 @@
+// mqtt_gw.cpp
+// 보드 UART 텔레메트리와 명령을 MQTT 로 올리는 게이트웨이 (MQTT 3.1.1, 라이브러리 없이 소켓 직접)
+//
+// 입력 (epoll 하나):
+//   보드: 시리얼 장치 / pty / fifo. "ADC: %u", "Sensor: %u", "[hh:mm:ss] ADC: %lu" 줄을 풀어서
+//         dsm/em/adc/NN, dsm/em/sensor/NN 로 (NN = 입력 순서, 01 부터. 00 은 ai.py 에서 '전체').
+//         스캐너는 uart_scan.hpp (ingest 와 같은 것). 타깃 펌웨어의 바이너리 로그('L' 프레임)는
+//         -e 로 준 펌웨어 ELF 의 dlog_fmt 섹션으로 글자 줄로 되돌려서 푼다. -e 가 없으면 건너뛰고
+//         끝에 센 수를 알림 (DLOG_TEXT=1 빌드, 또는 dlog_decode 를 앞에 둔 파이프면 필요 없음)
+//   명령: -c fifo (또는 - 는 stdin) 의 "led/00 50" 같은 줄 → dsm/em/led/00 에 "50"
+//         (ai.py 의 cmqtt.publish(TOPIC_IOT_ACTION_LED_ALL, option) 과 같은 토픽/내용, 묶지 않고 먼저 보냄)
+//
+// 보내기:
+//   - 묶음: 토픽마다 샘플을 -B 개 또는 -L ms 까지 모아 PUBLISH 하나로 (내용은 줄마다 "t_ms value")
+//   - QoS 1 창: PUBACK 을 기다리지 않고 -W 개까지 내보냄. 여러 PUBLISH 를 send 한 번에
+//   - 다시 접속: 끊기면 100 ms 부터 두 배씩 5 s 까지 기다렸다가. PUBACK 못 받은 건 DUP 로 다시 보냄
+//     (clean session 이라 브로커 쪽 상태는 없음: 적어도 한 번 전달, 중복은 받는 쪽이 t_ms 로 거름)
+//   - 디스크 넘침: 메모리 큐(-Q 메시지)가 차거나 이미 넘친 게 있으면 링 파일(-D, 최대 -M 바이트)로.
+//     파일이 차면 가장 오래된 것부터 버림. 순서는 메모리 → 파일 → 새 것 그대로 유지되고,
+//     파일은 머리(head/tail)를 같이 적어서 게이트웨이를 다시 띄워도 이어서 보낸다 (fsync 는 안 함)
+//
+// 빌드: g++ -O2 -std=c++17 -I Test Test/host/mqtt_gw.cpp -pthread -o mqtt_gw
+// 사용:
+//   ./mqtt_gw -b 127.0.0.1:1883 [-B 50] [-L 20] [-W 32] [-Q 1024] [-D spill.bin] [-M 16777216]
+//             [-e firmware.elf] [-c cmd.fifo] /dev/ttyUSB0 /dev/ttyUSB1 ...
+//       -e 없이 바이너리 로그 보드를 붙이려면
+//          mkfifo b1; ./dlog_decode firmware.elf /dev/ttyUSB0 > b1 & ./mqtt_gw ... b1
+//   ./mqtt_gw -T [-n 보드] [-R 보드당 줄/s] [-s 초] [-r 브로커 RTT ms]
+//       로컬 브로커 흉내(스레드)와 파이프 보드로 설정별 처리량 / 발행 지연(가장 오래된 샘플 → PUBACK)
+//       백분위 / 넘침 / 버림 / 중복 / 빠짐을 잰다. 브로커는 받은 값을 보드별로 세어서 확인.
+#include "uart_scan.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+static int64_t WallMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// --- 메시지 / 넘침 파일 ---
+struct Msg {
+    std::string topic;
+    std::string payload;
+    int64_t t0_us = 0;          // 가장 오래된 샘플을 읽은 시각 (지연 측정)
+    uint32_t samples = 0;       // 0 이면 명령
+};
+
+// 바이트 링: 레코드 = len(u32) | topic_len(u8) topic | t0_us(i64) | samples(u32) | payload, 끝에서 감김
+// head / tail 은 계속 느는 바이트 번호 (위치 = 번호 % cap)
+class SpillFile {
+public:
+    bool Open(const char *path, uint64_t max_bytes)
+    {
+        fd_ = open(path, O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0)
+            return false;
+        cap_ = std::max<uint64_t>(max_bytes, 4096);
+        Header h = {};
+        if (pread(fd_, &h, sizeof(h), 0) == (ssize_t)sizeof(h) && h.magic == kMagic && h.cap == cap_ &&
+            h.head - h.tail <= cap_) {
+            hdr_ = h;           // 지난번에 못 보낸 것부터 이어서
+        } else {
+            hdr_ = {};
+            hdr_.magic = kMagic;
+            hdr_.cap = cap_;
+            if (ftruncate(fd_, (off_t)(kData + cap_)) != 0)
+                return false;
+            SaveHeader();
+        }
+        return true;
+    }
+
+    bool Enabled() const { return fd_ >= 0; }
+    uint64_t Count() const { return hdr_.count; }
+    uint64_t Bytes() const { return hdr_.head - hdr_.tail; }
+
+    // 자리가 없으면 오래된 것부터 버림, 버린 샘플 수를 더함
+    bool Push(const Msg &m, uint64_t &dropped_msgs, uint64_t &dropped_samples)
+    {
+        uint32_t body = (uint32_t)(1 + m.topic.size() + 8 + 4 + m.payload.size());
+        if (4 + body > cap_ || m.topic.size() > 255)
+            return false;
+        while (cap_ - Bytes() < 4 + body) {
+            uint32_t len, samples;
+            ReadAt(hdr_.tail, &len, 4);
+            uint8_t tl;
+            ReadAt(hdr_.tail + 4, &tl, 1);
+            ReadAt(hdr_.tail + 4 + 1 + tl + 8, &samples, 4);
+            hdr_.tail += 4 + len;
+            hdr_.count--;
+            dropped_msgs++;
+            dropped_samples += samples;
+        }
+        std::string rec = Record(m, body);
+        WriteAt(hdr_.head, rec.data(), rec.size());
+        hdr_.head += rec.size();
+        hdr_.count++;
+        SaveHeader();
+        return true;
+    }
+
+    // 맨 앞(다음에 나갈 자리)에 끼움. 끝낼 때 메모리에 남은 걸 순서대로 돌려놓는 데 씀. 자리 없으면 false
+    bool PushFront(const Msg &m)
+    {
+        uint32_t body = (uint32_t)(1 + m.topic.size() + 8 + 4 + m.payload.size());
+        if (cap_ - Bytes() < 4 + body || m.topic.size() > 255)
+            return false;
+        std::string rec = Record(m, body);
+        hdr_.tail -= rec.size();
+        WriteAt(hdr_.tail, rec.data(), rec.size());
+        hdr_.count++;
+        SaveHeader();
+        return true;
+    }
+
+    bool Pop(Msg &m)
+    {
+        if (hdr_.count == 0)
+            return false;
+        uint32_t len;
+        ReadAt(hdr_.tail, &len, 4);
+        std::string rec(len, '\0');
+        ReadAt(hdr_.tail + 4, &rec[0], len);
+        uint8_t tl = (uint8_t)rec[0];
+        m.topic.assign(rec, 1, tl);
+        memcpy(&m.t0_us, rec.data() + 1 + tl, 8);
+        memcpy(&m.samples, rec.data() + 1 + tl + 8, 4);
+        m.payload.assign(rec, 1 + tl + 12, std::string::npos);
+        hdr_.tail += 4 + len;
+        hdr_.count--;
+        SaveHeader();
+        return true;
+    }
+
+private:
+    static const uint64_t kMagic = 0x314C4C4950534744ull;     // "DGSPILL1"
+    static const uint64_t kData = 4096;
+    struct Header {
+        uint64_t magic, cap, head, tail, count;
+    };
+
+    static std::string Record(const Msg &m, uint32_t body)
+    {
+        std::string rec;
+        rec.reserve(4 + body);
+        rec.append((const char*)&body, 4);
+        rec.push_back((char)m.topic.size());
+        rec += m.topic;
+        rec.append((const char*)&m.t0_us, 8);
+        rec.append((const char*)&m.samples, 4);
+        rec += m.payload;
+        return rec;
+    }
+
+    void SaveHeader()
+    {
+        if (pwrite(fd_, &hdr_, sizeof(hdr_), 0) != (ssize_t)sizeof(hdr_))
+            perror("spill header");
+    }
+
+    void WriteAt(uint64_t pos, const void *buf, size_t n)
+    {
+        uint64_t off = pos % cap_;
+        size_t first = (size_t)std::min<uint64_t>(n, cap_ - off);
+        if (pwrite(fd_, buf, first, (off_t)(kData + off)) != (ssize_t)first ||
+            (n > first && pwrite(fd_, (const char*)buf + first, n - first, (off_t)kData) != (ssize_t)(n - first)))
+            perror("spill write");
+    }
+
+    void ReadAt(uint64_t pos, void *buf, size_t n)
+    {
+        uint64_t off = pos % cap_;
+        size_t first = (size_t)std::min<uint64_t>(n, cap_ - off);
+        if (pread(fd_, buf, first, (off_t)(kData + off)) != (ssize_t)first ||
+            (n > first && pread(fd_, (char*)buf + first, n - first, (off_t)kData) != (ssize_t)(n - first)))
+            perror("spill read");
+    }
+
+    int fd_ = -1;
+    uint64_t cap_ = 0;
+    Header hdr_ = {};
+};
+
+// --- MQTT 패킷 ---
+static void PutLen(std::string &o, size_t n)
+{
+    do {
+        uint8_t b = n % 128;
+        n /= 128;
+        o.push_back((char)(n ? b | 0x80 : b));
+    } while (n);
+}
+
+static void PutStr(std::string &o, const std::string &s)
+{
+    o.push_back((char)(s.size() >> 8));
+    o.push_back((char)(s.size() & 0xFF));
+    o += s;
+}
+
+static void PutPublish(std::string &o, const Msg &m, uint16_t pid, bool dup)
+{
+    o.push_back((char)(0x32 | (dup ? 0x08 : 0)));      // QoS 1
+    PutLen(o, 2 + m.topic.size() + 2 + m.payload.size());
+    PutStr(o, m.topic);
+    o.push_back((char)(pid >> 8));
+    o.push_back((char)(pid & 0xFF));
+    o += m.payload;
+}
+
+// 버퍼 맨 앞의 완성된 패킷: 0 = 아직 모자람, -1 = 깨짐, 아니면 패킷 전체 길이
+static long PacketLen(const char *p, size_t avail, size_t &hdr)
+{
+    size_t n = 0, mult = 1;
+    for (size_t i = 1; i < avail && i <= 4; i++) {
+        n += (size_t)((uint8_t)p[i] & 0x7F) * mult;
+        mult *= 128;
+        if (!((uint8_t)p[i] & 0x80)) {
+            hdr = i + 1;
+            return avail >= hdr + n ? (long)(hdr + n) : 0;
+        }
+    }
+    return avail > 5 ? -1 : 0;
+}
+
+// --- 게이트웨이 ---
+static std::vector<char> dlog_fmt;      // -e, 비었으면 'L' 은 건너뜀
+
+struct GwConfig {
+    std::string broker = "127.0.0.1:1883";
+    std::string client_id = "dsm-gw";
+    uint32_t batch = 50;
+    uint32_t linger_ms = 20;
+    uint32_t window = 32;
+    uint32_t mem_queue = 1024;
+    uint32_t keepalive_s = 30;
+    std::string spill_path;
+    uint64_t spill_max = 16u << 20;
+};
+
+struct GwStats {
+    uint64_t samples_in = 0, other_lines = 0, commands = 0;
+    ScanCounts scan;                        // 보드 입력의 바이너리 프레임
+    uint64_t published = 0, acked = 0, acked_samples = 0, resent = 0;
+    uint64_t spilled = 0, dropped_msgs = 0, dropped_samples = 0, connects = 0, disconnects = 0;
+    std::vector<uint32_t> latency_us;       // 가장 오래된 샘플 → PUBACK
+};
+
+class Gateway {
+public:
+    explicit Gateway(const GwConfig &c) : cfg_(c) {}
+
+    bool Init()
+    {
+        ep_ = epoll_create1(0);
+        if (!cfg_.spill_path.empty() && !spill_.Open(cfg_.spill_path.c_str(), cfg_.spill_max)) {
+            perror(cfg_.spill_path.c_str());
+            return false;
+        }
+        size_t colon = cfg_.broker.rfind(':');
+        if (colon == std::string::npos)
+            return false;
+        addr_.sin_family = AF_INET;
+        addr_.sin_port = htons((uint16_t)atoi(cfg_.broker.c_str() + colon + 1));
+        return inet_pton(AF_INET, cfg_.broker.substr(0, colon).c_str(), &addr_.sin_addr) == 1;
+    }
+
+    // 보드 입력 (번호는 01 부터 붙는 순서), 명령 입력
+    void AddBoard(int fd) { AddInput(fd, (int)boards_++ + 1); }
+    void AddCommands(int fd) { AddInput(fd, 0); }
+
+    // 한 바퀴: 입력 / 소켓 / 시간
+    void Poll(int max_wait_ms)
+    {
+        int64_t now = NowUs();
+        int wait = max_wait_ms;
+        if (!batches_.empty())
+            wait = std::min(wait, (int)cfg_.linger_ms / 2 + 1);
+        if (!files_.empty() && mem_.size() < cfg_.mem_queue / 2 && spill_.Count() == 0)
+            wait = 0;
+        if (state_ == DOWN)
+            wait = std::min(wait, (int)std::max<int64_t>(0, (retry_at_ - now) / 1000));
+        epoll_event ev[64];
+        int n = epoll_wait(ep_, ev, 64, wait);
+        now = NowUs();
+        for (int i = 0; i < n; i++) {
+            if (ev[i].data.ptr == (void*)this)
+                OnSocket(ev[i].events, now);
+            else
+                OnInput(*(Input*)ev[i].data.ptr, now);
+        }
+        ReadFiles(now);
+        FlushBatches(now, false);
+        Tick(now);
+        Pump();
+    }
+
+    // 보낼 게 남았는지 (묶음 / 메모리 / 파일 / 창)
+    bool Idle() const
+    {
+        return batches_.empty() && mem_.empty() && spill_.Count() == 0 && inflight_.empty() && out_.empty();
+    }
+    void FlushAll() { FlushBatches(NowUs(), true); }
+
+    // 끝낼 때: 창과 메모리 큐에 남은 걸 넘침 파일 앞에 순서대로 돌려놓음. 못 넣은 메시지 수
+    size_t Stash()
+    {
+        size_t lost = 0;
+        for (auto it = mem_.rbegin(); it != mem_.rend(); ++it)
+            lost += spill_.Enabled() && spill_.PushFront(*it) ? 0 : 1;
+        for (auto it = inflight_.rbegin(); it != inflight_.rend(); ++it)
+            lost += spill_.Enabled() && spill_.PushFront(it->msg) ? 0 : 1;
+        mem_.clear();
+        inflight_.clear();
+        resend_ = 0;
+        return lost;
+    }
+    bool Connected() const { return state_ == UP; }
+    size_t OpenInputs() const { return open_inputs_; }
+    GwStats &Stats() { return st_; }
+
+private:
+    enum State { DOWN, CONNECTING, WAIT_CONNACK, UP };
+
+    struct Input {
+        int fd;
+        int board;              // 0 = 명령
+        std::string buf;
+        std::string text;       // 'L' 프레임을 푼 글자
+    };
+
+    struct Batch {
+        std::string payload;
+        uint32_t samples = 0;
+        int64_t t0_us = 0;
+    };
+
+    struct Inflight {
+        uint16_t pid;
+        Msg msg;
+    };
+
+    void AddInput(int fd, int board)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        Input *in = new Input{ fd, board, {}, {} };
+        epoll_event e = {};
+        e.events = EPOLLIN;
+        e.data.ptr = in;
+        if (epoll_ctl(ep_, EPOLL_CTL_ADD, fd, &e) != 0)
+            files_.push_back(in);       // 보통 파일 (epoll 불가): Poll 이 큐에 자리 있을 때 조금씩 읽음
+        open_inputs_++;
+    }
+
+    // 보통 파일은 큐가 반 넘게 차 있으면 기다림 (한 번에 다 읽어서 버리지 않게)
+    void ReadFiles(int64_t now)
+    {
+        for (size_t i = 0; i < files_.size();) {
+            while (mem_.size() < cfg_.mem_queue / 2 && spill_.Count() == 0 && OnInput(*files_[i], now)) {}
+            if (files_[i]->fd < 0) {
+                delete files_[i];
+                files_.erase(files_.begin() + (long)i);
+            } else {
+                i++;
+            }
+        }
+    }
+
+    // 닫히면 false (epoll 입력은 여기서 지우고, 파일 입력은 fd 만 -1 로)
+    bool OnInput(Input &in, int64_t now)
+    {
+        char tmp[16384];
+        ssize_t n = read(in.fd, tmp, sizeof(tmp));
+        if (n <= 0) {
+            if (n < 0 && (errno == EAGAIN || errno == EINTR))
+                return false;
+            bool polled = std::find(files_.begin(), files_.end(), &in) == files_.end();
+            if (polled)
+                epoll_ctl(ep_, EPOLL_CTL_DEL, in.fd, nullptr);
+            close(in.fd);
+            in.fd = -1;
+            open_inputs_--;
+            if (polled)
+                delete &in;
+            return false;
+        }
+        in.buf.append(tmp, (size_t)n);
+        size_t pos;
+        if (in.board == 0) {
+            pos = 0;
+            for (;;) {
+                size_t nl = in.buf.find('\n', pos);
+                if (nl == std::string::npos)
+                    break;
+                OnCommand(in.buf.data() + pos, in.buf.data() + nl);
+                pos = nl + 1;
+            }
+        } else {
+            pos = ScanUart(in.buf.data(), in.buf.size(), dlog_fmt, in.text, st_.scan,
+                           [&](const char *p, const char *end) { OnLine(in.board, p, end, now); });
+        }
+        in.buf.erase(0, pos);
+        if (in.buf.size() > 4096)
+            in.buf.clear();     // 줄 끝이 안 오는 쓰레기
+        return true;
+    }
+
+    void OnLine(int board, const char *p, const char *end, int64_t now)
+    {
+        uint8_t kind;
+        uint32_t clock, value;
+        if (!ParseLine(p, end, kind, clock, value)) {
+            st_.other_lines++;
+            return;
+        }
+        st_.samples_in++;
+        char topic[48];
+        snprintf(topic, sizeof(topic), "dsm/em/%s/%02d", kind == KIND_ADC ? "adc" : "sensor", board);
+        Batch &b = batches_[topic];
+        if (b.samples == 0)
+            b.t0_us = now;
+        char line[40];
+        int n = snprintf(line, sizeof(line), "%lld %u\n", (long long)WallMs(), value);
+        b.payload.append(line, (size_t)n);
+        if (++b.samples >= cfg_.batch) {
+            Enqueue(Msg{ topic, std::move(b.payload), b.t0_us, b.samples }, false);
+            batches_.erase(topic);
+        }
+    }
+
+    // "led/00 50" → dsm/em/led/00 "50"
+    void OnCommand(const char *p, const char *end)
+    {
+        if (end > p && end[-1] == '\r')
+            end--;
+        const char *sp = (const char*)memchr(p, ' ', (size_t)(end - p));
+        if (!sp || sp == p)
+            return;
+        st_.commands++;
+        Enqueue(Msg{ "dsm/em/" + std::string(p, sp), std::string(sp + 1, end), NowUs(), 0 }, true);
+    }
+
+    void FlushBatches(int64_t now, bool all)
+    {
+        for (auto it = batches_.begin(); it != batches_.end();) {
+            if (all || now - it->second.t0_us >= (int64_t)cfg_.linger_ms * 1000) {
+                Enqueue(Msg{ it->first, std::move(it->second.payload), it->second.t0_us, it->second.samples }, false);
+                it = batches_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void Enqueue(Msg &&m, bool urgent)
+    {
+        if (urgent) {
+            mem_.push_front(std::move(m));      // 명령은 텔레메트리 앞으로 (창이 차 있어도 다음 차례)
+            return;
+        }
+        if (spill_.Enabled() && (spill_.Count() > 0 || mem_.size() >= cfg_.mem_queue)) {
+            if (spill_.Push(m, st_.dropped_msgs, st_.dropped_samples))
+                st_.spilled++;
+            return;
+        }
+        if (mem_.size() >= cfg_.mem_queue) {
+            // 넘침 파일이 없으면 메모리에서 가장 오래된 텔레메트리를 버림 (앞에 선 명령은 남김)
+            auto old = std::find_if(mem_.begin(), mem_.end(), [](const Msg &q) { return q.samples > 0; });
+            if (old != mem_.end()) {
+                st_.dropped_msgs++;
+                st_.dropped_samples += old->samples;
+                mem_.erase(old);
+            }
+        }
+        mem_.push_back(std::move(m));
+    }
+
+    // --- 연결 ---
+    void Connect(int64_t now)
+    {
+        sock_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        int one = 1;
+        setsockopt(sock_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        int r = connect(sock_, (sockaddr*)&addr_, sizeof(addr_));
+        if (r != 0 && errno != EINPROGRESS) {
+            Drop(now);
+            return;
+        }
+        state_ = CONNECTING;
+        epoll_event e = {};
+        e.events = EPOLLIN | EPOLLOUT;
+        e.data.ptr = this;
+        epoll_ctl(ep_, EPOLL_CTL_ADD, sock_, &e);
+        conn_start_ = now;
+    }
+
+    void SendConnect()
+    {
+        std::string v;
+        PutStr(v, "MQTT");
+        v.push_back(4);                         // 3.1.1
+        v.push_back(0x02);                      // clean session
+        v.push_back((char)(cfg_.keepalive_s >> 8));
+        v.push_back((char)(cfg_.keepalive_s & 0xFF));
+        PutStr(v, cfg_.client_id);
+        out_.push_back(0x10);
+        PutLen(out_, v.size());
+        out_ += v;
+        state_ = WAIT_CONNACK;
+        WriteOut();
+    }
+
+    // 끊김: 창에 있던 건 다시 보낼 차례로, 기다렸다가 다시 접속
+    void Drop(int64_t now)
+    {
+        if (sock_ >= 0) {
+            epoll_ctl(ep_, EPOLL_CTL_DEL, sock_, nullptr);
+            close(sock_);
+            sock_ = -1;
+            if (state_ == UP)
+                st_.disconnects++;
+        }
+        state_ = DOWN;
+        out_.clear();
+        in_.clear();
+        resend_ = inflight_.size();
+        retry_at_ = now + backoff_us_;
+        backoff_us_ = std::min<int64_t>(backoff_us_ * 2, 5000000);
+    }
+
+    void Tick(int64_t now)
+    {
+        if (state_ == DOWN && now >= retry_at_)
+            Connect(now);
+        else if ((state_ == CONNECTING || state_ == WAIT_CONNACK) && now - conn_start_ > 3000000)
+            Drop(now);
+        else if (state_ == UP) {
+            int64_t ka = (int64_t)cfg_.keepalive_s * 1000000;
+            if (ping_sent_ && now - ping_sent_ > ka)
+                Drop(now);
+            else if (!ping_sent_ && now - last_tx_ > ka / 2) {
+                out_.push_back((char)0xC0);
+                out_.push_back(0);
+                ping_sent_ = now;
+                WriteOut();
+            }
+        }
+    }
+
+    void OnSocket(uint32_t events, int64_t now)
+    {
+        if (state_ == CONNECTING) {
+            int err = 0;
+            socklen_t len = sizeof(err);
+            getsockopt(sock_, SOL_SOCKET, SO_ERROR, &err, &len);
+            if (err || (events & (EPOLLERR | EPOLLHUP))) {
+                Drop(now);
+                return;
+            }
+            SendConnect();
+            return;
+        }
+        if (events & EPOLLIN) {
+            char tmp[16384];
+            for (;;) {
+                ssize_t n = recv(sock_, tmp, sizeof(tmp), 0);
+                if (n > 0) {
+                    in_.append(tmp, (size_t)n);
+                    continue;
+                }
+                if (n < 0 && (errno == EAGAIN || errno == EINTR))
+                    break;
+                Drop(now);
+                return;
+            }
+            if (!ParseIn(now))
+                return;
+        }
+        if (events & (EPOLLERR | EPOLLHUP)) {
+            Drop(now);
+            return;
+        }
+        if ((events & EPOLLOUT) && !out_.empty())
+            WriteOut();
+    }
+
+    bool ParseIn(int64_t now)
+    {
+        size_t pos = 0;
+        while (pos < in_.size()) {
+            size_t hdr = 0;
+            long len = PacketLen(in_.data() + pos, in_.size() - pos, hdr);
+            if (len < 0) {
+                Drop(now);
+                return false;
+            }
+            if (len == 0)
+                break;
+            uint8_t type = (uint8_t)in_[pos] >> 4;
+            const uint8_t *body = (const uint8_t*)in_.data() + pos + hdr;
+            if (type == 2) {                    // CONNACK
+                if (len - (long)hdr < 2 || body[1] != 0) {
+                    fprintf(stderr, "broker refused (%d)\n", len - (long)hdr >= 2 ? body[1] : -1);
+                    Drop(now);
+                    return false;
+                }
+                state_ = UP;
+                st_.connects++;
+                backoff_us_ = 100000;
+                ping_sent_ = 0;
+            } else if (type == 4 && len - (long)hdr >= 2) {     // PUBACK
+                OnPuback((uint16_t)(body[0] << 8 | body[1]), now);
+            } else if (type == 13) {            // PINGRESP
+                ping_sent_ = 0;
+            }
+            pos += (size_t)len;
+        }
+        in_.erase(0, pos);
+        return true;
+    }
+
+    void OnPuback(uint16_t pid, int64_t now)
+    {
+        // 보통 맨 앞, 창이 작으니 앞에서부터 찾음
+        for (auto it = inflight_.begin(); it != inflight_.end(); ++it) {
+            if (it->pid != pid)
+                continue;
+            st_.acked++;
+            st_.acked_samples += it->msg.samples;
+            st_.latency_us.push_back((uint32_t)std::min<int64_t>(now - it->msg.t0_us, UINT32_MAX));
+            size_t idx = (size_t)(it - inflight_.begin());
+            inflight_.erase(it);
+            if (idx < resend_)
+                resend_--;
+            return;
+        }
+    }
+
+    uint16_t NextPid()
+    {
+        for (;;) {
+            if (++pid_ == 0)
+                pid_ = 1;
+            bool used = false;
+            for (const Inflight &f : inflight_)
+                used = used || f.pid == pid_;
+            if (!used)
+                return pid_;
+        }
+    }
+
+    // 창이 허락하는 만큼 PUBLISH 를 out_ 에 모아서 한 번에 보냄
+    void Pump()
+    {
+        if (state_ != UP)
+            return;
+        // 끊기기 전에 창에 있던 것부터 DUP 으로
+        for (size_t i = inflight_.size() - resend_; resend_ > 0; i++, resend_--) {
+            PutPublish(out_, inflight_[i].msg, inflight_[i].pid, true);
+            st_.resent++;
+        }
+        while (inflight_.size() < cfg_.window && out_.size() < (1u << 20)) {
+            if (mem_.empty()) {
+                Msg m;
+                if (!spill_.Enabled() || !spill_.Pop(m))
+                    break;
+                mem_.push_back(std::move(m));
+            }
+            Inflight f{ NextPid(), std::move(mem_.front()) };
+            mem_.pop_front();
+            PutPublish(out_, f.msg, f.pid, false);
+            st_.published++;
+            inflight_.push_back(std::move(f));
+        }
+        // 메모리에 자리가 나면 파일에서 채움 (순서 유지)
+        while (spill_.Enabled() && spill_.Count() > 0 && mem_.size() < cfg_.mem_queue / 2) {
+            Msg m;
+            spill_.Pop(m);
+            mem_.push_back(std::move(m));
+        }
+        if (!out_.empty())
+            WriteOut();
+    }
+
+    void WriteOut()
+    {
+        while (!out_.empty()) {
+            ssize_t n = send(sock_, out_.data(), out_.size(), MSG_NOSIGNAL);
+            if (n > 0) {
+                out_.erase(0, (size_t)n);
+                last_tx_ = NowUs();
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EINTR))
+                break;
+            Drop(NowUs());
+            return;
+        }
+        epoll_event e = {};
+        e.events = EPOLLIN | (out_.empty() ? 0u : (uint32_t)EPOLLOUT);
+        e.data.ptr = this;
+        epoll_ctl(ep_, EPOLL_CTL_MOD, sock_, &e);
+    }
+
+    GwConfig cfg_;
+    GwStats st_;
+    int ep_ = -1;
+    sockaddr_in addr_ = {};
+    int sock_ = -1;
+    State state_ = DOWN;
+    int64_t retry_at_ = 0, backoff_us_ = 100000, conn_start_ = 0, last_tx_ = 0, ping_sent_ = 0;
+    std::string out_, in_;
+    std::map<std::string, Batch> batches_;
+    std::deque<Msg> mem_;
+    std::deque<Inflight> inflight_;
+    std::vector<Input*> files_;
+    size_t resend_ = 0;             // inflight_ 뒤쪽 몇 개를 DUP 로 다시 보내야 하는지
+    uint16_t pid_ = 0;
+    SpillFile spill_;
+    uint32_t boards_ = 0;
+    size_t open_inputs_ = 0;
+};
+
+// --- 벤치: 브로커 흉내 ---
+struct BrokerSim {
+    int listen_fd = -1;
+    uint16_t port = 0;
+    int64_t rtt_us = 5000;
+    std::atomic<int64_t> down_from{ 0 }, down_until{ 0 };   // 이 사이에는 연결을 끊고 안 받음
+    std::atomic<bool> quit{ false };
+
+    std::mutex mu;
+    std::map<std::string, std::vector<uint8_t>> seen;      // 토픽 → 값마다 받은 횟수
+    std::map<std::string, std::vector<std::string>> commands;
+    uint64_t publishes = 0, dup_flags = 0;
+
+    bool Start()
+    {
+        listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in a = {};
+        a.sin_family = AF_INET;
+        a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        int one = 1;
+        setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (bind(listen_fd, (sockaddr*)&a, sizeof(a)) != 0 || listen(listen_fd, 4) != 0)
+            return false;
+        socklen_t len = sizeof(a);
+        getsockname(listen_fd, (sockaddr*)&a, &len);
+        port = ntohs(a.sin_port);
+        fcntl(listen_fd, F_SETFL, O_NONBLOCK);
+        return true;
+    }
+
+    bool Down(int64_t now) const { return now >= down_from && now < down_until; }
+
+    void Record(const std::string &topic, const uint8_t *p, size_t n)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        publishes++;
+        if (topic.compare(0, 7, "dsm/em/") == 0 && topic.find("/led") != std::string::npos) {
+            commands[topic].emplace_back((const char*)p, n);
+            return;
+        }
+        // 줄마다 "t_ms value", value 는 벤치 보드의 일련번호
+        std::vector<uint8_t> &v = seen[topic];
+        const char *s = (const char*)p, *end = s + n;
+        while (s < end) {
+            const char *nl = (const char*)memchr(s, '\n', (size_t)(end - s));
+            if (!nl) nl = end;
+            const char *sp = (const char*)memchr(s, ' ', (size_t)(nl - s));
+            if (sp) {
+                uint32_t seq = (uint32_t)strtoul(sp + 1, nullptr, 10);
+                if (seq >= v.size()) v.resize(seq + 1);
+                if (v[seq] < 255) v[seq]++;
+            }
+            s = nl + 1;
+        }
+    }
+
+    void Run()
+    {
+        int conn = -1;
+        std::string in;
+        std::deque<std::pair<int64_t, std::string>> acks;      // RTT 흉내: 받은 뒤 rtt 에 PUBACK
+        while (!quit) {
+            int64_t now = NowUs();
+            if (conn >= 0 && Down(now)) {
+                close(conn);
+                conn = -1;
+                acks.clear();
+            }
+            int c = accept(listen_fd, nullptr, nullptr);
+            if (c >= 0) {
+                if (Down(now) || conn >= 0) {
+                    close(c);           // 장애 중 (또는 이미 연결 있음)
+                } else {
+                    conn = c;
+                    fcntl(conn, F_SETFL, O_NONBLOCK);
+                    int one = 1;
+                    setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                    in.clear();
+                }
+            }
+            if (conn >= 0) {
+                char tmp[65536];
+                ssize_t n = recv(conn, tmp, sizeof(tmp), 0);
+                if (n > 0) {
+                    in.append(tmp, (size_t)n);
+                } else if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+                    close(conn);
+                    conn = -1;
+                    acks.clear();
+                    continue;
+                }
+                size_t pos = 0;
+                for (;;) {
+                    size_t hdr = 0;
+                    long len = PacketLen(in.data() + pos, in.size() - pos, hdr);
+                    if (len <= 0)
+                        break;
+                    uint8_t b0 = (uint8_t)in[pos];
+                    const uint8_t *body = (const uint8_t*)in.data() + pos + hdr;
+                    size_t blen = (size_t)len - hdr;
+                    std::string reply;
+                    if ((b0 >> 4) == 1) {
+                        reply = std::string("\x20\x02\x00\x00", 4);
+                    } else if ((b0 >> 4) == 3 && blen >= 2) {
+                        size_t tl = (size_t)(body[0] << 8 | body[1]);
+                        std::string topic((const char*)body + 2, tl);
+                        size_t off = 2 + tl;
+                        uint8_t qos = (b0 >> 1) & 3;
+                        if (b0 & 0x08) {
+                            std::lock_guard<std::mutex> lock(mu);
+                            dup_flags++;
+                        }
+                        if (qos > 0) {
+                            reply = std::string("\x40\x02", 2);
+                            reply.push_back((char)body[off]);
+                            reply.push_back((char)body[off + 1]);
+                            off += 2;
+                        }
+                        Record(topic, body + off, blen - off);
+                    } else if ((b0 >> 4) == 12) {
+                        reply = std::string("\xD0\x00", 2);
+                    }
+                    if (!reply.empty())
+                        acks.emplace_back(now + ((b0 >> 4) == 3 ? rtt_us : 0), reply);
+                    pos += (size_t)len;
+                }
+                in.erase(0, pos);
+                std::string out;
+                while (!acks.empty() && acks.front().first <= now) {
+                    out += acks.front().second;
+                    acks.pop_front();
+                }
+                if (!out.empty() && send(conn, out.data(), out.size(), MSG_NOSIGNAL) < 0) {
+                    close(conn);
+                    conn = -1;
+                    acks.clear();
+                }
+            }
+            usleep(100);
+        }
+        if (conn >= 0)
+            close(conn);
+    }
+};
+
+// --- 벤치 ---
+struct Scenario {
+    const char *name;
+    uint32_t batch, linger_ms, window, mem_queue;
+    uint64_t spill_max;             // 0 = 파일 없음
+    double outage_at, outage_s;     // 장애 시작 / 길이 (초, 0 이면 없음)
+};
+
+struct BenchOpts {
+    uint32_t boards = 50;
+    uint32_t rate = 200;            // 보드당 줄/s, 0 = 최대
+    double seconds = 4;
+    int64_t rtt_us = 5000;
+};
+
+static uint32_t Pct(std::vector<uint32_t> &v, double q)
+{
+    if (v.empty())
+        return 0;
+    size_t k = (size_t)(q * (double)(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + (long)k, v.end());
+    return v[k];
+}
+
+static void RunScenario(const Scenario &sc, const BenchOpts &o)
+{
+    BrokerSim broker;
+    broker.rtt_us = o.rtt_us;
+    if (!broker.Start()) {
+        perror("broker");
+        return;
+    }
+    std::thread bt([&] { broker.Run(); });
+
+    GwConfig cfg;
+    cfg.broker = "127.0.0.1:" + std::to_string(broker.port);
+    cfg.batch = sc.batch;
+    cfg.linger_ms = sc.linger_ms;
+    cfg.window = sc.window;
+    cfg.mem_queue = sc.mem_queue;
+    if (sc.spill_max) {
+        cfg.spill_path = "/tmp/mqtt_gw_bench.spill";
+        unlink(cfg.spill_path.c_str());
+        cfg.spill_max = sc.spill_max;
+    }
+    Gateway gw(cfg);
+    if (!gw.Init()) {
+        fprintf(stderr, "gateway init failed\n");
+        broker.quit = true;
+        bt.join();
+        return;
+    }
+
+    // 보드 흉내: 파이프마다 일련번호 (짝수 보드는 sys.c 꼴, 홀수는 sub.c 의 시각 붙은 꼴)
+    std::vector<int> wfd(o.boards);
+    for (uint32_t i = 0; i < o.boards; i++) {
+        int p[2];
+        if (pipe(p) != 0)
+            return;
+        gw.AddBoard(p[0]);
+        wfd[i] = p[1];
+    }
+    int cmd[2];
+    if (pipe(cmd) != 0)
+        return;
+    gw.AddCommands(cmd[0]);
+
+    std::atomic<uint64_t> written{ 0 };
+    int64_t t0 = NowUs();
+    if (sc.outage_s > 0) {
+        broker.down_from = t0 + (int64_t)(sc.outage_at * 1e6);
+        broker.down_until = broker.down_from + (int64_t)(sc.outage_s * 1e6);
+    }
+    std::thread gen([&] {
+        std::vector<uint32_t> seq(o.boards);
+        char line[48];
+        int64_t end = t0 + (int64_t)(o.seconds * 1e6);
+        uint64_t tick = 0;
+        for (int64_t now = NowUs(); now < end; now = NowUs(), tick++) {
+            for (uint32_t b = 0; b < o.boards; b++) {
+                // 정해진 속도면 지금까지 나왔어야 할 만큼, 최대면 한 번에 64 줄
+                uint64_t due = o.rate ? (uint64_t)((now - t0) * (double)o.rate / 1e6) + 1 : seq[b] + 64;
+                std::string chunk;
+                while (seq[b] < due) {
+                    int n = (b & 1) ? snprintf(line, sizeof(line), "[12:%02u:%02u] ADC: %u\r\n", (seq[b] / 60) % 60,
+                                               seq[b] % 60, seq[b])
+                                    : snprintf(line, sizeof(line), "Sensor: %u\r\n", seq[b]);
+                    chunk.append(line, (size_t)n);
+                    seq[b]++;
+                }
+                if (!chunk.empty() && write(wfd[b], chunk.data(), chunk.size()) != (ssize_t)chunk.size())
+                    perror("board pipe");
+            }
+            if (tick % 500 == 0 && write(cmd[1], "led/00 50\n", 10) < 0) {}
+            if (o.rate)
+                usleep(1000);
+        }
+        uint64_t total = 0;
+        for (uint32_t s : seq)
+            total += s;
+        written = total;
+        for (int fd : wfd)
+            close(fd);
+        close(cmd[1]);
+    });
+
+    // 입력이 다 닫히면 남은 묶음을 내보내고 다 보낼 때까지 (최대 30 s)
+    while (gw.OpenInputs() > 0)
+        gw.Poll(5);
+    gen.join();
+    gw.FlushAll();
+    int64_t drain_deadline = NowUs() + 30000000;
+    while (!gw.Idle() && NowUs() < drain_deadline)
+        gw.Poll(5);
+    double total_s = (NowUs() - t0) / 1e6;
+    broker.quit = true;
+    bt.join();
+
+    // 브로커가 받은 값 확인
+    uint64_t unique = 0, dups = 0, missing = 0, commands = 0;
+    {
+        std::lock_guard<std::mutex> lock(broker.mu);
+        for (auto &kv : broker.seen) {
+            for (uint8_t c : kv.second) {
+                if (c) unique++;
+                else missing++;
+                if (c > 1) dups += c - 1u;
+            }
+        }
+        for (auto &kv : broker.commands)
+            commands += kv.second.size();
+    }
+    uint64_t total = written.load();
+    // 끝 부분에 아예 안 온 값도 빠짐
+    missing = total - unique;
+
+    GwStats &st = gw.Stats();
+    double samples_s = (double)st.acked_samples / total_s;
+    double msgs_s = (double)st.acked / total_s;
+    printf("%-18s %9.0f %8.0f %7u %7u %7u %8u %8llu %8llu %6llu %8llu %6llu %4llu %s\n", sc.name, samples_s, msgs_s,
+           Pct(st.latency_us, 0.5) / 1000, Pct(st.latency_us, 0.99) / 1000, Pct(st.latency_us, 0.999) / 1000,
+           Pct(st.latency_us, 1.0) / 1000, (unsigned long long)st.spilled, (unsigned long long)st.dropped_samples,
+           (unsigned long long)dups, (unsigned long long)missing, (unsigned long long)st.resent,
+           (unsigned long long)commands,
+           !gw.Idle() ? "NOT DRAINED" : missing == st.dropped_samples ? "ok" : "LOST");
+    unlink("/tmp/mqtt_gw_bench.spill");
+}
+
+static void Bench(const BenchOpts &o)
+{
+    printf("%u boards x %u lines/s for %.0f s, broker RTT %lld ms%s\n", o.boards, o.rate, o.seconds,
+           (long long)(o.rtt_us / 1000), o.rate ? "" : " (boards write flat out)");
+    printf("%-18s %9s %8s %7s %7s %7s %8s %8s %8s %6s %8s %6s %4s %s\n", "config", "samples/s", "msgs/s", "p50 ms",
+           "p99", "p99.9", "max", "spilled", "dropped", "dups", "missing", "resent", "cmds", "check");
+    // 이름, 묶음, linger ms, 창, 메모리 큐, 파일 최대, 장애 시작 / 길이
+    const Scenario scenarios[] = {
+        { "1 msg, window 1", 1, 0, 1, 1024, 0, 0, 0 },       // ai.py 처럼 하나 보내고 기다림
+        { "1 msg, window 64", 1, 0, 64, 1024, 0, 0, 0 },
+        { "batch 50/20ms, w16", 50, 20, 16, 1024, 0, 0, 0 },
+        { "+ 2 s outage, spill", 50, 20, 16, 64, 64u << 20, o.seconds / 3, 2.0 },
+        { "+ outage, 16 KB disk", 50, 20, 16, 64, 16u << 10, o.seconds / 3, 2.0 },
+    };
+    for (const Scenario &sc : scenarios) {
+        fflush(stdout);
+        RunScenario(sc, o);
+    }
+}
+
+static volatile sig_atomic_t stop_flag;
+static void OnSignal(int) { stop_flag = 1; }
+
+static bool SetRaw(int fd)
+{
+    termios tio;
+    if (tcgetattr(fd, &tio) != 0)
+        return false;
+    cfmakeraw(&tio);
+    cfsetspeed(&tio, B115200);
+    tio.c_cflag |= CLOCAL | CREAD;
+    return tcsetattr(fd, TCSANOW, &tio) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    GwConfig cfg;
+    BenchOpts bo;
+    bool bench = false;
+    const char *cmd_path = nullptr;
+    int opt;
+    while ((opt = getopt(argc, argv, "b:i:B:L:W:Q:D:M:k:e:c:Tn:R:s:r:")) != -1) {
+        switch (opt) {
+            case 'b': cfg.broker = optarg; break;
+            case 'i': cfg.client_id = optarg; break;
+            case 'B': cfg.batch = (uint32_t)std::max(1, atoi(optarg)); break;
+            case 'L': cfg.linger_ms = (uint32_t)atoi(optarg); break;
+            case 'W': cfg.window = (uint32_t)std::max(1, atoi(optarg)); break;
+            case 'Q': cfg.mem_queue = (uint32_t)std::max(1, atoi(optarg)); break;
+            case 'D': cfg.spill_path = optarg; break;
+            case 'M': cfg.spill_max = strtoull(optarg, nullptr, 0); break;
+            case 'k': cfg.keepalive_s = (uint32_t)std::max(1, atoi(optarg)); break;
+            case 'e':
+                if (!DlogLoadElf(optarg, dlog_fmt)) {
+                    DlogLoadError(optarg);
+                    return 1;
+                }
+                break;
+            case 'c': cmd_path = optarg; break;
+            case 'T': bench = true; break;
+            case 'n': bo.boards = (uint32_t)atoi(optarg); break;
+            case 'R': bo.rate = (uint32_t)atoi(optarg); break;
+            case 's': bo.seconds = atof(optarg); break;
+            case 'r': bo.rtt_us = (int64_t)(atof(optarg) * 1000); break;
+            default:
+                fprintf(stderr,
+                        "usage: %s [-b host:port] [-B batch] [-L linger_ms] [-W window] [-Q mem_msgs]\n"
+                        "          [-D spill_file] [-M spill_bytes] [-e firmware.elf] [-c cmd_fifo|-] board_dev...\n"
+                        "       %s -T [-n boards] [-R lines_per_s] [-s sec] [-r rtt_ms]\n",
+                        argv[0], argv[0]);
+                return 1;
+        }
+    }
+    signal(SIGPIPE, SIG_IGN);
+    if (bench) {
+        if (bo.boards == 0 || bo.boards > 99) {
+            fprintf(stderr, "boards must be 1..99\n");
+            return 1;
+        }
+        Bench(bo);
+        return 0;
+    }
+    if (optind >= argc && !cmd_path) {
+        fprintf(stderr, "need at least one board input or -c\n");
+        return 1;
+    }
+
+    Gateway gw(cfg);
+    if (!gw.Init()) {
+        fprintf(stderr, "bad broker address or spill file\n");
+        return 1;
+    }
+    for (int i = optind; i < argc; i++) {
+        int fd = open(argv[i], O_RDONLY | O_NONBLOCK | O_NOCTTY);
+        if (fd < 0) {
+            perror(argv[i]);
+            return 1;
+        }
+        if (isatty(fd))
+            SetRaw(fd);
+        gw.AddBoard(fd);
+        fprintf(stderr, "board %02d: %s\n", i - optind + 1, argv[i]);
+    }
+    if (cmd_path) {
+        // fifo 는 쓰는 쪽이 닫았다 다시 열어도 끊기지 않게 읽기/쓰기로 엶
+        int fd = strcmp(cmd_path, "-") == 0 ? dup(0) : open(cmd_path, O_RDWR | O_NONBLOCK);
+        if (fd < 0) {
+            perror(cmd_path);
+            return 1;
+        }
+        gw.AddCommands(fd);
+    }
+
+    struct sigaction sa = {};
+    sa.sa_handler = OnSignal;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+    int64_t last_report = NowUs();
+    while (!stop_flag && gw.OpenInputs() > 0) {
+        gw.Poll(100);
+        if (NowUs() - last_report > 10000000) {
+            last_report = NowUs();
+            GwStats &st = gw.Stats();
+            fprintf(stderr, "%s in %llu acked %llu msgs %llu samples, spilled %llu dropped %llu, p99 %u ms\n",
+                    gw.Connected() ? "up" : "DOWN", (unsigned long long)st.samples_in, (unsigned long long)st.acked,
+                    (unsigned long long)st.acked_samples, (unsigned long long)st.spilled,
+                    (unsigned long long)st.dropped_samples, Pct(st.latency_us, 0.99) / 1000);
+            st.latency_us.clear();
+        }
+    }
+    // 끝낼 때 모은 건 내보내고 잠깐 PUBACK 을 기다림. 못 보낸 건 넘침 파일로 (다음에 띄우면 이어서)
+    gw.FlushAll();
+    int64_t deadline = NowUs() + 2000000;
+    while (!gw.Idle() && gw.Connected() && NowUs() < deadline)
+        gw.Poll(10);
+    size_t lost = gw.Stash();
+    if (lost)
+        fprintf(stderr, "%zu unsent messages dropped%s\n", lost, cfg.spill_path.empty() ? " (no -D)" : "");
+    const ScanCounts &sc = gw.Stats().scan;
+    if (sc.bad)
+        fprintf(stderr, "%llu bad 'L' frames\n", (unsigned long long)sc.bad);
+    if (sc.dlog_skipped)
+        fprintf(stderr, "%llu 'L' frames skipped: give -e firmware.elf or pipe through dlog_decode\n",
+                (unsigned long long)sc.dlog_skipped);
+    return 0;
+}
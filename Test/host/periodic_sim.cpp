@@ -0,0 +1,181 @@
+// periodic_sim.cpp
+// 주기 태스크 지터 / 마감 확인: 펌웨어 위에 더 높은 우선순위의 부하 태스크(임의 길이의 CPU 점유)를
+// 얹고 부하를 올려가며
+//   - ADC 샘플 시각: 간격 최소/최대, 이상적인 격자에서 벗어난 정도 (p99/최대), 누적 밀림
+//   - periodic.h 로 잰 태스크별 실행 / 마감 초과 / 건너뜀 / 지터 / 응답 시간
+// 을 본다. 예전 osDelay 판(FREE_RTOS_1.c)과 비교하면 osDelay 는 주기가 실행 시간만큼 밀려서
+// 부하와 상관없이 샘플이 격자에서 멀어지고, osDelayUntil 은 부하가 마감을 넘길 때만 흔들린다.
+//
+// 빌드 (펌웨어 하나씩, sys.c 는 sys_pipeline / sensor_rec / calib / rules / pwm_fade 와 sys_graph.cpp 도 같이):
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host -Dmain=firmware_main Test/FREE_RTOS.c
+//       Test/periodic.c Test/dlog.c Test/stack_mon.c Test/rt_stats.c
+//   g++ -c -O2 -std=c++17 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/free_rtos_graph.cpp
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/board.cpp Test/host/bsp_host.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/host/periodic_sim.cpp *.o -pthread -o periodic_sim
+// 사용: ./periodic_sim [-s 가상초] [-p 샘플 주기 ms] [-b 평균 점유 ms]
+//   (-p 는 FREE_RTOS.c 100, sys.c 500)
+//   ./periodic_sim -w     부하 없이 돌려 태스크별 측정 WCET 를 host/rta 의 -w 인자로 출력
+//
+// 부하마다 fork 해서 시뮬레이터 상태를 새로 시작한다. 가상 시간이라 결과는 매번 같다.
+#include "host_os.h"
+#include "main.h"
+#include "cmsis_os.h"
+#include "periodic.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <vector>
+
+extern "C" int firmware_main(void);
+
+static uint32_t load_pct;
+static uint32_t burst_ms = 8;
+static uint32_t rng = 12345;
+static std::vector<uint64_t> samples;
+
+static uint32_t Rand() { rng = rng * 1103515245u + 12345u; return rng >> 8; }
+
+static uint16_t Adc(uint64_t now_us, void *)
+{
+    samples.push_back(now_us);
+    return (uint16_t)(1500 + (now_us / 1000) % 1000);
+}
+
+static void QuietUart(uint64_t, const uint8_t *, uint16_t, void *) {}
+
+// 부하: 평균 burst_ms 의 지수 분포 점유 (10 배에서 자름) 뒤 쉬어서 평균 사용률이 load_pct 가 되게
+static void HogTask(void const *)
+{
+    for (;;) {
+        double u = (Rand() % 65535 + 1) / 65536.0;
+        uint32_t busy_us = (uint32_t)std::min(-std::log(u) * burst_ms * 1000.0, burst_ms * 10000.0) + 1;
+        HostOs_Busy(busy_us);
+        uint32_t idle_ms = (uint32_t)((uint64_t)busy_us * (100 - load_pct) / load_pct / 1000u);
+        osDelay(idle_ms ? idle_ms : 1);
+    }
+}
+
+static int Entry(void)
+{
+    if (load_pct > 0) {
+        osThreadDef(hogTask, HogTask, osPriorityHigh, 0, 128);
+        osThreadCreate(osThread(hogTask), NULL);
+    }
+    return firmware_main();
+}
+
+struct SampleStats {
+    uint32_t min_gap_us, max_gap_us;
+    uint32_t phase_p99_us, phase_max_us;
+    int64_t drift_ms;           // 마지막 샘플이 첫 샘플 기준 격자에서 밀린 양
+};
+
+// 첫 샘플을 기준으로 period 격자에 대한 위상 오차
+static SampleStats Analyze(const std::vector<uint64_t> &t, uint32_t period_us)
+{
+    SampleStats s = {};
+    if (t.size() < 2)
+        return s;
+    s.min_gap_us = UINT32_MAX;
+    std::vector<uint32_t> phase;
+    for (size_t i = 1; i < t.size(); i++) {
+        uint32_t gap = (uint32_t)(t[i] - t[i - 1]);
+        s.min_gap_us = std::min(s.min_gap_us, gap);
+        s.max_gap_us = std::max(s.max_gap_us, gap);
+        uint64_t d = t[i] - t[0];
+        uint64_t k = (d + period_us / 2) / period_us;
+        phase.push_back((uint32_t)std::llabs((int64_t)d - (int64_t)(k * period_us)));
+    }
+    s.drift_ms = ((int64_t)(t.back() - t[0]) - (int64_t)(t.size() - 1) * period_us) / 1000;
+    std::sort(phase.begin(), phase.end());
+    s.phase_p99_us = phase[(size_t)(0.99 * (double)(phase.size() - 1))];
+    s.phase_max_us = phase.back();
+    return s;
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 60;
+    uint32_t period_ms = 100;
+    bool wcet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:p:b:w")) != -1) {
+        switch (opt) {
+            case 's': seconds = atof(optarg); break;
+            case 'w': wcet = true; break;
+            case 'p': period_ms = (uint32_t)atoi(optarg); break;
+            case 'b': burst_ms = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-s sec] [-p sample_period_ms] [-b burst_ms] [-w]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (period_ms == 0 || burst_ms == 0) {
+        fprintf(stderr, "period / burst must be > 0\n");
+        return 1;
+    }
+
+    if (wcet) {
+        // 가상 시간의 CPU 는 HAL 대기(변환, 전송)만 셈: 계산 시간은 host/micro_bench 로 따로 더할 것
+        HostOs_SetAdc(Adc, nullptr);
+        HostOs_SetUart(QuietUart, nullptr);
+        HostOs_Run(Entry, (uint64_t)(seconds * 1e6));
+        for (int i = 0; i < HostOs_TaskCount(); i++) {
+            HostTaskInfo ti;
+            HostOs_GetTaskInfo(i, &ti);
+            printf("%s-w %s=%u", i ? " " : "", ti.name, (unsigned)ti.max_job_us);
+        }
+        printf("\n");
+        return 0;
+    }
+
+    printf("%.0f s, sample period %u ms, hog bursts mean %u ms (max %u) above all firmware tasks\n", seconds,
+           (unsigned)period_ms, (unsigned)burst_ms, (unsigned)(10 * burst_ms));
+    printf("%5s %7s %7s %15s %17s %9s | %-8s %6s %5s %5s %15s %15s\n", "load", "samples", "expect",
+           "gap min/max ms", "phase p99/max us", "drift ms", "task", "runs", "miss", "skip",
+           "jitter p99/max", "resp p99/max");
+    for (uint32_t load : { 0u, 20u, 40u, 60u, 70u, 80u, 90u }) {
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            load_pct = load;
+            HostOs_SetAdc(Adc, nullptr);
+            HostOs_SetUart(QuietUart, nullptr);
+            HostOs_Run(Entry, (uint64_t)(seconds * 1e6));
+
+            SampleStats s = Analyze(samples, period_ms * 1000u);
+            char head[96];
+            int w = snprintf(head, sizeof(head), "%4u%% %7zu %7u %7.1f/%-7.1f %8u/%-8u %9lld |", (unsigned)load,
+                             samples.size(), (unsigned)(seconds * 1000 / period_ms), s.min_gap_us / 1000.0,
+                             s.max_gap_us / 1000.0, (unsigned)s.phase_p99_us, (unsigned)s.phase_max_us,
+                             (long long)s.drift_ms);
+            if (Periodic_Count() == 0)
+                printf("%s (no periodic tasks)\n", head);
+            for (int i = 0; i < Periodic_Count(); i++) {
+                PeriodicTask p;
+                Periodic_Get(i, &p);
+                uint32_t jit = std::min(Periodic_Percentile(p.jitter_hist, 990), p.jitter_max_us);
+                uint32_t resp = std::min(Periodic_Percentile(p.resp_hist, 990), p.resp_max_us);
+                printf("%*s %-8s %6u %5u %5u %7u/%-7u %7u/%u\n", w, i ? "|" : head, p.name, (unsigned)p.runs,
+                       (unsigned)p.misses, (unsigned)p.skipped, (unsigned)jit, (unsigned)p.jitter_max_us,
+                       (unsigned)resp, (unsigned)p.resp_max_us);
+            }
+            fflush(stdout);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            fprintf(stderr, "load %u%%: child failed\n", (unsigned)load);
+            return 1;
+        }
+    }
+    return 0;
+}
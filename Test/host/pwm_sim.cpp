@@ -0,0 +1,327 @@
+// pwm_sim.cpp
+// LED 밝기 엔진 (pwm_fade) 확인: bsp::reg 를 bsp_host.cpp 대신 여기서 구현해서 TIM1 + DMA1 채널 5 를 흉내낸다.
+//   - 타이머: PWM 주기마다 오버플로, 반복 카운터가 0 이면 갱신 이벤트 (RCR 다시 읽음, CCR 프리로드 -> 출력,
+//     UDE 면 DMA 요청). EGR.UG 는 바로 갱신 이벤트
+//   - DMA: 요청 하나에 DCR 의 DBL+1 개 하프워드를 CMAR 에서 DMAR (= CCR DBA..) 로, CNDTR 감소.
+//     0 이 되면 TCIF, TCIE 면 그 자리에서 PwmFade_DmaIrq (NVIC 흉내)
+// PWM 주기마다 실제로 나가는 CCR 을 기록해서 검사한다.
+//   1. 감마 테이블: 곡선마다 서로 다른 CCR 개수, 이웃 단계 사이 L* 차이의 최대값, 1 단계의 L*
+//      (main.c 의 adc_value / 16 같은 선형 256 단계와 비교)
+//   2. 페이드 시간: 50 ms ~ 40 s 를 0 -> 999 로, 고른 RCR / 단계 수 / 실제 걸린 시간, 밝기가 거꾸로 가지 않는지
+//   3. 페이드 동안 CPU 레지스터 접근과 인터럽트 (IRQ 안/밖), 같은 페이드를 타이머 인터럽트로 했을 때와 비교
+//   4. 페이드 중 다른 목표로 바꾸기 / PwmFade_Set: 출력이 튀지 않고 이어지는지, PwmFade_Level 이 출력과 맞는지
+// 하나라도 틀리면 종료 코드 1
+//
+// 빌드:
+//   g++ -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/host/pwm_sim.cpp Test/pwm_fade.cpp -o pwm_sim
+// 사용: ./pwm_sim
+#include "board.hpp"
+#include "pwm_fade.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kTim = bsp::addr::TIM1;
+constexpr uint32_t kDma = bsp::addr::DmaChannel(Board::led_pwm.dma_channel);
+constexpr auto kLut = led::MakeGamma<PWM_FADE_LEVELS, Board::led_pwm.arr>(Board::led_curve, Board::led_gamma_x100);
+const double kPeriodUs = (Board::led_pwm.arr + 1) * 1e6 / Board::led_pwm.timer_hz;
+
+using Duty = std::array<uint16_t, 4>;
+
+struct Model {
+    std::unordered_map<uint32_t, uint32_t> regs;
+    Duty preload{}, shadow{};
+    uint32_t rep = 0;           // 반복 카운터
+    uint32_t isr = 0;           // DMA1_ISR
+    uint32_t dma_idx = 0;       // 채널 5 메모리 주소 카운터 (하프워드)
+    bool in_irq = false;
+    uint32_t cpu_access = 0, irq_access = 0, irqs = 0, dma_writes = 0;
+    std::vector<Duty> out;      // PWM 주기마다 나간 CCR
+} m;
+
+uint32_t Reg(uint32_t a)
+{
+    auto it = m.regs.find(a);
+    return it != m.regs.end() ? it->second : 0;
+}
+
+int CcrIndex(uint32_t a)
+{
+    if (a < kTim + bsp::addr::TIM_CCR1 || a > kTim + bsp::addr::TIM_CCR1 + 12 || (a & 3))
+        return -1;
+    return (int)((a - kTim - bsp::addr::TIM_CCR1) / 4);
+}
+
+// CMAR 은 32비트라 호스트 포인터의 위쪽 절반은 같은 실행 파일 안의 정적 변수에서 가져온다
+const uint16_t *Mem(uint32_t cmar)
+{
+    static int anchor;
+    uintptr_t hi = (uintptr_t)&anchor & ~(uintptr_t)0xFFFFFFFFu;
+    return reinterpret_cast<const uint16_t *>(hi | cmar);
+}
+
+void Burst()
+{
+    uint32_t ccr = Reg(kDma + bsp::addr::DMA_CCR);
+    uint32_t cnt = Reg(kDma + bsp::addr::DMA_CNDTR);
+    if (!(ccr & bsp::bits::DMA_CCR_EN) || cnt == 0)
+        return;
+    uint32_t dcr = Reg(kTim + bsp::addr::TIM_DCR);
+    uint32_t dba = dcr & 31u, dbl = ((dcr >> 8) & 31u) + 1;
+    const uint16_t *mem = Mem(Reg(kDma + bsp::addr::DMA_CMAR));
+    for (uint32_t k = 0; k < dbl && cnt > 0; k++, cnt--) {
+        int i = CcrIndex(kTim + (dba + k) * 4);
+        if (i >= 0)
+            m.preload[(size_t)i] = mem[m.dma_idx];
+        m.dma_idx++;
+        m.dma_writes++;
+    }
+    m.regs[kDma + bsp::addr::DMA_CNDTR] = cnt;
+    if (cnt == 0) {
+        m.isr |= bsp::bits::DmaTcif(Board::led_pwm.dma_channel) | 1u << (4 * (Board::led_pwm.dma_channel - 1));
+        if (ccr & bsp::bits::DMA_CCR_TCIE) {
+            m.in_irq = true;
+            m.irqs++;
+            PwmFade_DmaIrq();
+            m.in_irq = false;
+        }
+    }
+}
+
+void Update()
+{
+    m.shadow = m.preload;
+    m.rep = Reg(kTim + bsp::addr::TIM_RCR) & 0xFFu;
+    if (Reg(kTim + bsp::addr::TIM_DIER) & bsp::bits::TIM_DIER_UDE)
+        Burst();
+}
+
+// PWM 주기 n 개
+void Run(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        m.out.push_back(m.shadow);
+        if (!(Reg(kTim + bsp::addr::TIM_CR1) & bsp::bits::TIM_CR1_CEN))
+            continue;
+        if (m.rep == 0)
+            Update();
+        else
+            m.rep--;
+    }
+}
+
+void Count()
+{
+    if (m.in_irq)
+        m.irq_access++;
+    else
+        m.cpu_access++;
+}
+
+double Lstar(uint16_t ccr)
+{
+    double y = ccr / (double)Board::led_pwm.arr;
+    return y <= 0.008856 ? 903.3 * y : 116 * std::cbrt(y) - 16;
+}
+
+template <size_t N>
+void GammaRow(const char *name, const std::array<uint16_t, N> &lut)
+{
+    double worst = 0;
+    uint32_t at = 0;
+    for (size_t i = 1; i < N; i++) {
+        double d = Lstar(lut[i]) - Lstar(lut[i - 1]);
+        if (d > worst) {
+            worst = d;
+            at = (uint32_t)i;
+        }
+    }
+    printf("  %-22s %6u %8u %10.2f (at %3u) %9.2f\n", name, (unsigned)N, (unsigned)led::GammaDistinct(lut), worst,
+           (unsigned)at, Lstar(lut[1]));
+}
+
+uint32_t fails;
+
+void Check(bool ok, const char *what)
+{
+    if (!ok) {
+        printf("  FAIL: %s\n", what);
+        fails++;
+    }
+}
+
+// 주기 기록 [from, to) 에서 이웃 주기 사이 L* 차이 최대 (모든 채널)
+double MaxJump(size_t from, size_t to)
+{
+    double worst = 0;
+    for (size_t i = std::max<size_t>(from, 1); i < to; i++)
+        for (int c = 0; c < 4; c++)
+            worst = std::max(worst, std::fabs(Lstar(m.out[i][(size_t)c]) - Lstar(m.out[i - 1][(size_t)c])));
+    return worst;
+}
+
+const uint16_t kAll[4] = { 0, 0, 0, 0 };
+
+} // namespace
+
+namespace bsp {
+namespace reg {
+
+void Write(uint32_t a, uint32_t value)
+{
+    Count();
+    if (a == kTim + addr::TIM_EGR) {
+        if (value & bits::TIM_EGR_UG)
+            Update();
+        return;
+    }
+    if (a == addr::DMA1 + addr::DMA_IFCR) {
+        m.isr &= ~value;
+        return;
+    }
+    if (a == kDma + addr::DMA_CCR && !(Reg(a) & bits::DMA_CCR_EN) && (value & bits::DMA_CCR_EN))
+        m.dma_idx = 0;
+    int i = CcrIndex(a);
+    if (i >= 0)
+        m.preload[(size_t)i] = (uint16_t)value;
+    m.regs[a] = value;
+}
+
+void Write8(uint32_t a, uint8_t value)
+{
+    Count();
+    m.regs[a] = value;
+}
+
+uint32_t Read(uint32_t a)
+{
+    Count();
+    if (a == addr::DMA1 + addr::DMA_ISR)
+        return m.isr;
+    int i = CcrIndex(a);
+    if (i >= 0)
+        return m.preload[(size_t)i];
+    return Reg(a);
+}
+
+} // namespace reg
+} // namespace bsp
+
+int main()
+{
+    printf("TIM1 ARR %u, PWM %.0f Hz (%.1f us), %d levels\n", (unsigned)Board::led_pwm.arr, 1e6 / kPeriodUs,
+           kPeriodUs, PWM_FADE_LEVELS);
+
+    printf("\n1. gamma table (L* 0~100, lower max step = smoother)\n");
+    printf("  %-22s %6s %8s %21s %9s\n", "curve", "levels", "distinct", "max dL*/level", "L*(1)");
+    GammaRow("cie (board)", kLut);
+    GammaRow("power 2.2", led::MakeGamma<PWM_FADE_LEVELS, Board::led_pwm.arr>(led::Curve::Power, 220));
+    GammaRow("linear", led::MakeGamma<PWM_FADE_LEVELS, Board::led_pwm.arr>(led::Curve::Linear));
+    GammaRow("linear 256 (adc/16)", led::MakeGamma<256, Board::led_pwm.arr>(led::Curve::Linear));
+
+    PwmFade_Init();
+    Run(4);
+    Check(m.out.back() == Duty{}, "init: all off");
+
+    printf("\n2. fade 0 -> 999, all channels\n");
+    printf("  %8s %4s %6s %9s %10s %7s %9s %10s\n", "ms", "rcr", "frames", "step us", "actual ms", "err %",
+           "clamped", "monotonic");
+    const uint16_t full[4] = { 999, 999, 999, 999 };
+    for (uint32_t ms : { 50u, 500u, 5000u, 29000u, 40000u }) {
+        for (uint8_t c = 0; c < 4; c++)
+            PwmFade_Set(c, 0);
+        Run(2);
+        uint32_t clamped = PwmFade_Stats()->clamped;
+        size_t start = m.out.size();
+        PwmFade_To(full, ms);
+        const PwmFadeStats *s = PwmFade_Stats();
+        uint32_t step = led::StepUs(Board::led_pwm, s->last_rcr);
+        Run((uint32_t)((s->last_frames + 2u) * (s->last_rcr + 1u)));
+        size_t done = start;
+        while (done < m.out.size() && m.out[done][0] != kLut[999])
+            done++;
+        bool mono = true;
+        for (size_t i = start + 1; i < m.out.size(); i++)
+            for (int c = 0; c < 4; c++)
+                mono = mono && m.out[i][(size_t)c] >= m.out[i - 1][(size_t)c];
+        double actual = (double)(done - start) * kPeriodUs / 1000.0;
+        bool was_clamped = s->clamped != clamped;
+        printf("  %8u %4u %6u %9u %10.1f %7.2f %9s %10s\n", (unsigned)ms, (unsigned)s->last_rcr,
+               (unsigned)s->last_frames, (unsigned)step, actual, was_clamped ? 0.0 : (actual - ms) * 100.0 / ms,
+               was_clamped ? "yes" : "no", mono ? "ok" : "FAIL");
+        Check(done < m.out.size(), "fade reaches target");
+        Check(mono, "fade up never dims");
+        Check(!PwmFade_Busy() && PwmFade_Level(0) == 999, "idle at target after fade");
+        Check(was_clamped || std::fabs(actual - ms) <= step / 1000.0, "duration within one step");
+    }
+
+    printf("\n3. CPU work during a 5 s fade\n");
+    {
+        PwmFade_To(kAll, 10);
+        Run(40);
+        uint32_t irqs = m.irqs;
+        m.dma_writes = 0;
+        PwmFade_To(full, 5000);
+        m.cpu_access = m.irq_access = 0;
+        uint32_t periods = (uint32_t)(5000e3 / kPeriodUs) + 200;
+        Run(periods);
+        uint32_t per_update = (uint32_t)(PWM_FADE_CHANNELS);
+        printf("  dma engine : %u PWM periods, %u DMA halfwords, %u register accesses outside IRQ, %u IRQ (%u accesses)\n",
+               (unsigned)periods, (unsigned)m.dma_writes, (unsigned)m.cpu_access, (unsigned)(m.irqs - irqs),
+               (unsigned)m.irq_access);
+        uint32_t sw = (uint32_t)(5000e3 / kPeriodUs);
+        printf("  timer IRQ  : %u IRQs, %u CCR writes (update every period)\n", (unsigned)sw,
+               (unsigned)(sw * per_update));
+        Check(m.cpu_access == 0, "no CPU register access during fade");
+        Check(m.irqs - irqs == 1, "one completion IRQ per fade");
+    }
+
+    printf("\n4. retarget / set during fade\n");
+    {
+        PwmFade_To(kAll, 10);
+        Run(40);
+        size_t start = m.out.size();
+        PwmFade_To(full, 2000);
+        Run((uint32_t)(700e3 / kPeriodUs));
+        Check(std::abs((int)Lstar(m.out.back()[0]) - (int)Lstar(kLut[PwmFade_Level(0)])) <= 1,
+              "Level() matches output");
+        uint16_t at = PwmFade_Level(0);
+        const uint16_t down[4] = { 200, PWM_FADE_KEEP, 200, 200 };
+        size_t retarget = m.out.size();
+        PwmFade_To(down, 500);
+        uint16_t keep_from = PwmFade_Level(1);
+        Run((uint32_t)(600e3 / kPeriodUs));
+        double normal = MaxJump(start + 2, retarget);
+        double across = MaxJump(retarget - 2, retarget + 8);
+        printf("  0 -> 999 / 2 s, at 700 ms level %u -> 200 / 500 ms: max dL* per period %.2f before, %.2f across\n",
+               (unsigned)at, normal, across);
+        Check(across <= normal + 0.5, "no jump at retarget");
+        Check(m.out.back()[0] == kLut[200] && m.out.back()[2] == kLut[200], "retarget reaches new target");
+        Check(m.out.back()[1] == kLut[keep_from], "KEEP channel stays where it was");
+
+        PwmFade_To(kAll, 1000);
+        Run((uint32_t)(300e3 / kPeriodUs));
+        uint16_t l1 = PwmFade_Level(1), l2 = PwmFade_Level(2);
+        PwmFade_Set(0, 999);
+        Run(4);
+        printf("  set ch0 = 999 during fade: ch0 %u, ch1/ch2 stay %u/%u\n", (unsigned)m.out.back()[0],
+               (unsigned)m.out.back()[1], (unsigned)m.out.back()[2]);
+        Check(!PwmFade_Busy(), "set stops the fade");
+        Check(m.out.back()[0] == kLut[999], "set writes the channel");
+        Check(m.out.back()[1] == kLut[l1] && m.out.back()[2] == kLut[l2], "set leaves other channels in place");
+        Check(PwmFade_To(nullptr, 10) == -1 && PwmFade_To(std::array<uint16_t, 4>{ 1000, 0, 0, 0 }.data(), 10) == -1,
+              "bad arguments rejected");
+    }
+
+    const PwmFadeStats *s = PwmFade_Stats();
+    printf("\nstats: fades %u, retargets %u, completed %u, clamped %u\n", (unsigned)s->fades, (unsigned)s->retargets,
+           (unsigned)s->completed, (unsigned)s->clamped);
+    printf("%s\n", fails ? "FAILED" : "all checks ok");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,482 @@
+// replay.cpp
+// 현장 기록(.srec, sensor_rec.h)을 sys.c 태스크(Sensor -> Logic -> Display) 그대로 다시 돌린다.
+// 가상 시간이라 실제보다 훨씬 빠르고, 같은 기록과 같은 펌웨어면 출력이 바이트 단위로 같다.
+//
+//   - ADC: 기록된 샘플을 시각 기준으로 유지 (SensorTask 가 읽는 시점의 가장 최근 현장 값)
+//   - GPIO 입력 에지: 제 시각에 IDR 을 바꾸고 HAL_GPIO_EXTI_Callback 호출
+//   - 출력: "Sensor:" 줄과 PC13 에지를 가상 시각과 함께 모아 결정적 출력으로 씀
+//     (rt_stats / sensor_rec 바이너리 프레임과 그 밖의 텍스트는 세기만 함)
+//   - 지표: 샘플 -> "Sensor:" 줄 전송 완료까지 지연, 잃어버린 샘플, 큐 드롭, 현장 PC13 에지와의 일치
+//
+// 빌드:
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host -Dmain=firmware_main
+//       Test/sys.c Test/sys_pipeline.c Test/rt_stats.c Test/rules.c Test/sensor_rec.c Test/dlog.c Test/periodic.c
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -I Test -I Test/host Test/calib.cpp Test/board.cpp Test/host/bsp_host.cpp Test/pwm_fade.cpp
+//   g++ -c -O2 -std=c++17 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/sys_graph.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -I Test -I Test/host Test/host/replay.cpp *.o -pthread -o replay
+//
+// 사용:
+//   ./replay [-o out.txt] [-g golden.txt] [-q] rec.srec      재생 (golden 과 다르면 종료 코드 1)
+//   ./replay -E uart_capture.bin -w rec.srec                 UART 캡처에서 기록 프레임만 뽑기
+//   ./replay -G 초 [-r seed] -w rec.srec                     합성 기록 (현장 데이터가 없을 때)
+#include "host_os.h"
+#include "main.h"
+#include "sensor_rec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include "stack_mon.h"
+
+int firmware_main(void);
+
+// stack_mon.c 대신: 호스트 스택 깊이는 실행마다 달라 STK 줄 길이(= UART 시간)가 흔들리므로
+// 재생에서는 리포트를 빼서 출력 시각이 실행마다 같게 함 (스택 확인은 stack_size)
+void StackMon_Register(const char *, osThreadId, uint32_t) {}
+void StackMon_ReportNames(void) {}
+void StackMon_Report(void) {}
+}
+
+struct Rec {
+    uint64_t t_us;
+    uint8_t type;
+    uint8_t a;          // ADC: channel, GPIO: port
+    uint8_t b;          // GPIO: pin
+    uint16_t value;     // ADC: 값, GPIO: level
+};
+
+// --- .srec 읽기/쓰기 ---
+static bool ReadFile(const char *path, std::vector<uint8_t> &out)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+static bool WriteFile(const char *path, const std::vector<uint8_t> &data)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+    return fclose(f) == 0 && ok;
+}
+
+static int Decode(const std::vector<uint8_t> &d, std::vector<Rec> &out, uint32_t *gaps)
+{
+    if (d.size() < SREC_FILE_HEADER || memcmp(d.data(), SREC_MAGIC, 4) != 0 || d[4] != SREC_VERSION)
+        return -1;
+    uint64_t t = 0;
+    size_t i = SREC_FILE_HEADER;
+    while (i < d.size()) {
+        uint8_t type = d[i++];
+        uint32_t dt = 0;
+        for (int shift = 0; i < d.size(); shift += 7) {
+            uint8_t b = d[i++];
+            dt |= (uint32_t)(b & 0x7Fu) << shift;
+            if (!(b & 0x80u)) break;
+        }
+        t += dt;
+        if (type == SREC_GAP) {
+            (*gaps)++;
+            continue;
+        }
+        if (i + 3 > d.size() || type < SREC_ADC || type > SREC_GPIO_OUT)
+            return -1;
+        Rec r = { t, type, d[i], d[i + 1], 0 };
+        r.value = type == SREC_ADC ? (uint16_t)(d[i + 1] | (d[i + 2] << 8)) : d[i + 2];
+        if (type == SREC_ADC) r.b = 0;
+        out.push_back(r);
+        i += 3;
+    }
+    return 0;
+}
+
+static void PutRec(std::vector<uint8_t> &out, uint64_t &last, uint64_t t, uint8_t type,
+                   uint8_t a, uint8_t b, uint8_t c)
+{
+    uint32_t dt = (uint32_t)(t - last);
+    last = t;
+    out.push_back(type);
+    do {
+        uint8_t v = dt & 0x7Fu;
+        dt >>= 7;
+        out.push_back(dt ? (uint8_t)(v | 0x80u) : v);
+    } while (dt);
+    out.push_back(a);
+    out.push_back(b);
+    out.push_back(c);
+}
+
+static std::vector<uint8_t> FileHeader()
+{
+    std::vector<uint8_t> out(SREC_MAGIC, SREC_MAGIC + 4);
+    out.push_back(SREC_VERSION);
+    out.insert(out.end(), 3, 0);
+    return out;
+}
+
+// --- UART 캡처에서 'S' 프레임 뽑기 ---
+static int Extract(const char *in, const char *out_path)
+{
+    std::vector<uint8_t> cap;
+    if (!ReadFile(in, cap)) {
+        fprintf(stderr, "%s: 읽을 수 없음\n", in);
+        return 1;
+    }
+    std::vector<uint8_t> out = FileHeader();
+    uint32_t frames = 0, bad = 0;
+    for (size_t i = 0; i + 5 <= cap.size(); i++) {
+        if (cap[i] != 0xA5 || cap[i + 1] != 0x5A || cap[i + 2] != SREC_FRAME_TYPE)
+            continue;
+        uint8_t n = cap[i + 3];
+        if (i + 5 + n > cap.size())
+            break;
+        uint8_t sum = 0;
+        for (size_t k = i + 2; k < i + 4 + n; k++)
+            sum += cap[k];
+        if (sum != cap[i + 4 + n]) {
+            bad++;
+            continue;
+        }
+        out.insert(out.end(), cap.begin() + (long)i + 4, cap.begin() + (long)i + 4 + n);
+        frames++;
+        i += 4 + n;
+    }
+    if (!WriteFile(out_path, out)) {
+        fprintf(stderr, "%s: 쓸 수 없음\n", out_path);
+        return 1;
+    }
+    printf("%u frames (%u bad checksum), %zu bytes -> %s\n", frames, bad, out.size(), out_path);
+    return 0;
+}
+
+// --- 합성 기록: 천천히 바뀌는 조도 + 구름 + 잡음, 버튼 (채터링 포함), 예전 펌웨어(raw > 2000)의 PC13 ---
+struct GenEvent {
+    uint64_t t;
+    uint8_t type, a, b, c;
+};
+
+static int Generate(double seconds, uint32_t seed, const char *out_path)
+{
+    uint32_t rng = seed;
+    auto rnd = [&rng]() { rng = rng * 1103515245u + 12345u; return (rng >> 8) & 0xFFFFu; };
+
+    std::vector<GenEvent> ev;
+    uint64_t end = (uint64_t)(seconds * 1e6);
+    for (uint64_t press = 3000000; press + 200000 < end; press += 4000000 + (uint64_t)(rnd() % 6000) * 1000) {
+        // 눌림 120 ms, 앞쪽 채터링 몇 번
+        uint64_t t = press;
+        for (int k = 0; k < 3; k++, t += 300 + rnd() % 700)
+            ev.push_back({ t, SREC_GPIO_IN, 'A', 0, (uint8_t)(k % 2 == 0) });
+        ev.push_back({ t + 120000, SREC_GPIO_IN, 'A', 0, 0 });
+    }
+
+    uint64_t cloud_until = 0;
+    int led = -1;
+    for (uint64_t t = 137000; t < end; t += 500000) {
+        double v = 2000 + 900 * sin(2 * M_PI * (t / 1e6) / 60.0) + (double)(rnd() % 81) - 40;
+        if (t >= cloud_until && rnd() % 40 == 0)
+            cloud_until = t + 3000000 + (uint64_t)(rnd() % 5000) * 1000;
+        if (t < cloud_until)
+            v -= 700;
+        uint16_t raw = (uint16_t)std::min(4095.0, std::max(0.0, v));
+        ev.push_back({ t, SREC_ADC, 1, (uint8_t)raw, (uint8_t)(raw >> 8) });
+
+        int on = raw > 2000;
+        if (on != led) {
+            ev.push_back({ t + 1000, SREC_GPIO_OUT, 'C', 13, (uint8_t)!on });
+            led = on;
+        }
+    }
+    std::stable_sort(ev.begin(), ev.end(), [](const GenEvent &x, const GenEvent &y) { return x.t < y.t; });
+
+    std::vector<uint8_t> out = FileHeader();
+    uint64_t last = 0;
+    for (const GenEvent &e : ev)
+        PutRec(out, last, e.t, e.type, e.a, e.b, e.c);
+    if (!WriteFile(out_path, out)) {
+        fprintf(stderr, "%s: 쓸 수 없음\n", out_path);
+        return 1;
+    }
+    printf("%.0f s synthetic recording, %zu records, %zu bytes -> %s\n", seconds, ev.size(), out.size(), out_path);
+    return 0;
+}
+
+// --- 재생 ---
+static std::vector<Rec> recs;
+static std::vector<size_t> adc_idx;         // recs 안의 ADC 레코드 위치
+static std::vector<size_t> gpio_in_idx;
+static size_t next_gpio_in;
+
+struct Read {
+    uint64_t t;
+    uint16_t value;
+};
+static std::deque<Read> reads;
+static uint32_t reads_total;
+
+struct OutEvent {
+    uint64_t t;
+    std::string text;
+};
+static std::vector<OutEvent> outputs;
+static std::vector<uint32_t> latencies;
+static uint32_t lost;
+static uint64_t other_text_bytes, frame_bytes;
+static std::vector<std::pair<uint64_t, int>> replay_edges;
+
+static uint16_t AdcModel(uint64_t now, void *)
+{
+    // 가장 최근 현장 샘플 (처음 샘플 이전이면 첫 샘플)
+    auto it = std::upper_bound(adc_idx.begin(), adc_idx.end(), now,
+                               [](uint64_t t, size_t i) { return t < recs[i].t_us; });
+    size_t i = it == adc_idx.begin() ? adc_idx.front() : *(it - 1);
+    reads.push_back({ now, recs[i].value });
+    reads_total++;
+    return recs[i].value;
+}
+
+static GPIO_TypeDef *Port(uint8_t p)
+{
+    return p == 'A' ? GPIOA : p == 'B' ? GPIOB : GPIOC;
+}
+
+static void GpioInIrq(uint64_t now, void *)
+{
+    const Rec &r = recs[gpio_in_idx[next_gpio_in++]];
+    GPIO_TypeDef *g = Port(r.a);
+    if (r.value) g->IDR |= 1u << r.b;
+    else g->IDR &= ~(1u << r.b);
+    HAL_GPIO_EXTI_Callback((uint16_t)(1u << r.b));
+    if (next_gpio_in < gpio_in_idx.size())
+        HostOs_RaiseIrq(recs[gpio_in_idx[next_gpio_in]].t_us, GpioInIrq, nullptr);
+    (void)now;
+}
+
+static void GpioOut(uint64_t now, char port, uint16_t pin, int state, void *)
+{
+    if (port != 'C' || pin != GPIO_PIN_13)
+        return;
+    if (!replay_edges.empty() && replay_edges.back().second == state)
+        return;
+    replay_edges.push_back({ now, state });
+    char buf[48];
+    snprintf(buf, sizeof(buf), "PC13=%d", state);
+    outputs.push_back({ now, buf });
+}
+
+// 바이너리 프레임(A5 5A 'R'/'S')은 걸러내고 텍스트 줄만 모음
+static std::vector<uint8_t> uart_pending;
+static std::string line;
+
+static void UartOut(uint64_t now, const uint8_t *data, uint16_t len, void *)
+{
+    uart_pending.insert(uart_pending.end(), data, data + len);
+    size_t i = 0;
+    while (i < uart_pending.size()) {
+        if (uart_pending[i] == 0xA5) {
+            if (uart_pending.size() - i < 4) break;
+            if (uart_pending[i + 1] == 0x5A) {
+                uint8_t type = uart_pending[i + 2], n = uart_pending[i + 3];
+                size_t size = type == 'R' ? 4 + 4 + (size_t)n * 10 + 1 : 4 + (size_t)n + 1;
+                if (uart_pending.size() - i < size) break;
+                frame_bytes += size;
+                i += size;
+                continue;
+            }
+        }
+        char c = (char)uart_pending[i++];
+        if (c == '\n') {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            unsigned v;
+            if (sscanf(line.c_str(), "Sensor: %u", &v) == 1) {
+                // 전송이 끝나는 시각 (줄 전체가 이 호출 안에서 나감)
+                uint64_t done = now + (uint64_t)len * 10u * 1000000u / 115200u;
+                while (!reads.empty() && reads.front().value != v) {
+                    reads.pop_front();
+                    lost++;
+                }
+                if (!reads.empty()) {
+                    latencies.push_back((uint32_t)(done - reads.front().t));
+                    reads.pop_front();
+                }
+                outputs.push_back({ now, line });
+            } else {
+                other_text_bytes += line.size() + 2;
+            }
+            line.clear();
+        } else {
+            line += c;
+        }
+    }
+    uart_pending.erase(uart_pending.begin(), uart_pending.begin() + (long)i);
+}
+
+static uint32_t Pct(std::vector<uint32_t> v, double p)
+{
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[(size_t)(p * (double)(v.size() - 1))];
+}
+
+static int Replay(const char *path, const char *out_path, const char *golden, bool quiet)
+{
+    std::vector<uint8_t> data;
+    uint32_t gaps = 0;
+    if (!ReadFile(path, data) || Decode(data, recs, &gaps) != 0) {
+        fprintf(stderr, "%s: .srec 가 아니거나 깨짐\n", path);
+        return 2;
+    }
+    std::vector<std::pair<uint64_t, int>> field_edges;
+    for (size_t i = 0; i < recs.size(); i++) {
+        if (recs[i].type == SREC_ADC && recs[i].a == 1) adc_idx.push_back(i);
+        if (recs[i].type == SREC_GPIO_IN) gpio_in_idx.push_back(i);
+        if (recs[i].type == SREC_GPIO_OUT && recs[i].a == 'C' && recs[i].b == 13)
+            field_edges.push_back({ recs[i].t_us, recs[i].value });
+    }
+    if (adc_idx.empty()) {
+        fprintf(stderr, "%s: ADC 샘플 없음\n", path);
+        return 2;
+    }
+
+    uint64_t duration = recs.back().t_us + 1000000;
+    HostOs_SetAdc(AdcModel, nullptr);
+    HostOs_SetGpio(GpioOut, nullptr);
+    HostOs_SetUart(UartOut, nullptr);
+    if (!gpio_in_idx.empty())
+        HostOs_RaiseIrq(recs[gpio_in_idx[0]].t_us, GpioInIrq, nullptr);
+
+    auto t0 = std::chrono::steady_clock::now();
+    HostOs_Run(firmware_main, duration);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // 결정적 출력
+    std::string text;
+    char buf[96];
+    for (const OutEvent &e : outputs) {
+        snprintf(buf, sizeof(buf), "%10.3f %s\n", e.t / 1000.0, e.text.c_str());
+        text += buf;
+    }
+    uint64_t digest = 1469598103934665603ull;
+    for (unsigned char c : text)
+        digest = (digest ^ c) * 1099511628211ull;
+
+    // 현장 에지와 맞추기: 같은 레벨, 1 초 이내
+    uint32_t matched = 0;
+    std::vector<bool> used(replay_edges.size(), false);
+    for (const auto &fe : field_edges) {
+        for (size_t k = 0; k < replay_edges.size(); k++) {
+            const auto &re = replay_edges[k];
+            uint64_t d = re.first > fe.first ? re.first - fe.first : fe.first - re.first;
+            if (!used[k] && re.second == fe.second && d <= 1000000) {
+                used[k] = true;
+                matched++;
+                break;
+            }
+        }
+    }
+
+    uint64_t queue_drops = 0;
+    uint32_t max_depth = 0;
+    for (int i = 0; i < HostOs_QueueCount(); i++) {
+        HostQueueInfo qi;
+        HostOs_GetQueueInfo(i, &qi);
+        queue_drops += qi.drops;
+        max_depth = std::max(max_depth, (uint32_t)qi.max_depth);
+    }
+
+    if (!quiet)
+        fputs(text.c_str(), stdout);
+    printf("-- recording %s: %zu records (%zu adc, %zu gpio in, %zu field edges, %u gaps)\n", path,
+           recs.size(), adc_idx.size(), gpio_in_idx.size(), field_edges.size(), gaps);
+    printf("-- replayed %.1f s in %.3f s wall (x%.0f)\n", duration / 1e6, wall, duration / 1e6 / wall);
+    // 줄로 나오지 못한 읽기: 뒤 줄에 밀려 건너뛴 것 + 끝까지 짝이 없는 것
+    // (LogicTask 가 DisplayTask 보다 우선순위가 높아 같은 큐에서 자기 DISPLAY_UPDATE 를 도로 가져가면 전부 여기)
+    printf("-- sensor reads %u, lines %zu, never shown %zu, queue drops %llu, max depth %u\n",
+           reads_total, latencies.size(), (size_t)lost + reads.size(), (unsigned long long)queue_drops, max_depth);
+    printf("-- read->line latency p50 %.3f ms  p99 %.3f ms  max %.3f ms\n", Pct(latencies, 0.5) / 1000.0,
+           Pct(latencies, 0.99) / 1000.0, Pct(latencies, 1.0) / 1000.0);
+    printf("-- PC13 edges: replay %zu, field %zu, matched %u\n", replay_edges.size(), field_edges.size(), matched);
+    printf("-- other uart: %llu text bytes, %llu frame bytes\n", (unsigned long long)other_text_bytes,
+           (unsigned long long)frame_bytes);
+    printf("-- output digest %016llx (%zu lines)\n", (unsigned long long)digest, outputs.size());
+
+    if (out_path) {
+        std::vector<uint8_t> bytes(text.begin(), text.end());
+        if (!WriteFile(out_path, bytes)) {
+            fprintf(stderr, "%s: 쓸 수 없음\n", out_path);
+            return 2;
+        }
+    }
+    if (golden) {
+        std::vector<uint8_t> g;
+        if (!ReadFile(golden, g)) {
+            fprintf(stderr, "%s: 읽을 수 없음\n", golden);
+            return 2;
+        }
+        std::string gs(g.begin(), g.end());
+        if (gs != text) {
+            // 처음 다른 줄
+            size_t a = 0, line_no = 1;
+            while (a < gs.size() && a < text.size() && gs[a] == text[a]) {
+                if (gs[a] == '\n') line_no++;
+                a++;
+            }
+            printf("-- DIFF vs %s at line %zu\n", golden, line_no);
+            return 1;
+        }
+        printf("-- matches %s\n", golden);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = nullptr, *golden = nullptr, *extract = nullptr, *write_path = nullptr;
+    double gen_seconds = 0;
+    uint32_t seed = 1;
+    bool quiet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:g:qE:G:r:w:")) != -1) {
+        switch (opt) {
+            case 'o': out_path = optarg; break;
+            case 'g': golden = optarg; break;
+            case 'q': quiet = true; break;
+            case 'E': extract = optarg; break;
+            case 'G': gen_seconds = atof(optarg); break;
+            case 'r': seed = (uint32_t)strtoul(optarg, nullptr, 0); break;
+            case 'w': write_path = optarg; break;
+            default:
+                fprintf(stderr, "usage: %s [-o out] [-g golden] [-q] rec.srec | -E capture -w rec.srec | "
+                                "-G sec [-r seed] -w rec.srec\n", argv[0]);
+                return 2;
+        }
+    }
+    if (extract || gen_seconds > 0) {
+        if (!write_path) {
+            fprintf(stderr, "-w 출력 파일이 필요함\n");
+            return 2;
+        }
+        return extract ? Extract(extract, write_path) : Generate(gen_seconds, seed, write_path);
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "기록 파일이 필요함\n");
+        return 2;
+    }
+    return Replay(argv[optind], out_path, golden, quiet);
+}
@@ -0,0 +1,661 @@
+// rta.cpp
+// 고정 우선순위 응답 시간 분석 (RTA): 선언된 태스크 세트의 우선순위가 최악의 경우에도 마감을 지키는지 본다.
+//
+//   R = J + w,  w = (q+1)C + B + sum_{j in hp} ceil((w + J_j) / T_j) C_j     (q: 바쁜 구간 안의 q 번째 작업)
+//
+//   - hp: 우선순위가 높거나 같은 태스크 (같은 우선순위는 라운드 로빈이라 서로 끼어든다고 봄) + ISR 전부
+//   - B (블로킹): 낮은 우선순위 태스크가 쥔 자원. mutex 는 FreeRTOS 의 우선순위 상속 기준
+//     (자원마다 가장 긴 구간의 합, 낮은 태스크마다 가장 긴 구간의 합 중 작은 값), -p pcp 면 가장 긴 구간 하나.
+//     kernel 은 인터럽트를 막는 구간 (taskENTER_CRITICAL, PRIMASK): 모든 태스크와 ISR 을 막음
+//   - after=<태스크>: 그 태스크가 큐로 보낸 메시지에 깨어나는 태스크. 주기는 보낸 쪽 것,
+//     릴리스 지터는 보낸 쪽 응답 시간 (서로 맞을 때까지 반복)
+//
+// 그리고
+//   - Audsley 방식으로 모든 마감을 지키는 우선순위를 찾아 CMSIS osPriority 로 제안 (안 되면 마감 단조)
+//   - WCET 를 몇 배까지 늘려도 되는지 (breakdown), 선언 / 제안 우선순위 각각
+//   - 잠금 없이 여러 태스크가 쓰는 자원 경고
+//
+// 태스크 세트: sys.c / maung.c / FREE_RTOS.c 가 들어 있음 (-P, -d 로 파일로 뽑아 고쳐 쓰면 됨)
+//   # 주석
+//   resource <이름> mutex|np|none          (선언 안 한 자원은 mutex, kernel 은 np)
+//   isr  <이름> period=<ms> wcet=<us>
+//   task <이름> <우선순위> period=<ms> | after=<태스크>  [deadline=<ms>] wcet=<us> [jitter=<us>] [uses=<자원>:<us>,...]
+//   우선순위: Idle Low BelowNormal Normal AboveNormal High Realtime 또는 -3..3
+//
+// WCET 바꾸기:
+//   -w name=us                    (여러 번), host/periodic_sim -w 가 이 꼴로 측정값을 찍음 (HAL 대기만 셈)
+//   -c capture.bin                보드 UART 캡처의 rt_stats 'R' 프레임 max_run_cycles 와 "RTS <id> task <이름>" 줄
+//
+// 빌드: g++ -O2 -std=c++17 -I Test Test/host/rta.cpp -o rta
+// 사용: ./rta [-P sys|maung|free_rtos] [-p pip|pcp] [-w name=us]... [-c capture.bin] [spec.txt]
+//       ./rta -P sys -d > sys.tasks
+// 종료 코드: 선언된 우선순위로 마감을 놓칠 수 있으면 1
+#include "rt_stats.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const int64_t kInf = INT64_MAX / 4;
+static const int kIsrPrio = 100;            // ISR 은 모든 태스크 위
+
+// --- 내장 태스크 세트 ---
+// WCET: host/periodic_sim -w (HAL 대기, 가상 시간) + host/micro_bench 계산 시간, 올림.
+// 타깃은 dlog 바이너리라 Display / Uart 의 로그는 버퍼에 넣기만 하고 전송은 Monitor 의 DLog_Flush.
+static const struct { const char *name; const char *spec; } kPresets[] = {
+    { "sys",
+      "# sys.c: Sensor -> eventQueue -> Logic -> displayQueue -> Display, Monitor 1 s\n"
+      "resource uart none\n"
+      "isr  systick period=1 wcet=2\n"
+      "task sensor  Normal      period=500 deadline=50 wcet=60 uses=kernel:5\n"
+      "task logic   AboveNormal after=sensor deadline=50 wcet=40 uses=kernel:5\n"
+      "task display BelowNormal after=logic deadline=100 wcet=20 uses=kernel:5\n"
+      "task monitor Low         period=1000 wcet=26000 uses=kernel:20,uart:26000\n" },
+    { "maung",
+      "# maung.c: sys.c 의 원형, Display 가 sprintf + 블로킹 전송\n"
+      "resource uart none\n"
+      "isr  systick period=1 wcet=2\n"
+      "task sensor  Normal      period=500 deadline=50 wcet=40 uses=kernel:5\n"
+      "task logic   AboveNormal after=sensor deadline=50 wcet=20 uses=kernel:5\n"
+      "task display BelowNormal after=logic deadline=100 wcet=980 uses=kernel:5,uart:960\n" },
+    { "free_rtos",
+      "# FREE_RTOS.c: Adc 100 ms -> adcQueue (Uart 가 1 s 마다 엿봄), Led 500 ms, Monitor 1 s\n"
+      "resource uart none\n"
+      "isr  systick period=1 wcet=2\n"
+      "task led     Low         period=500 wcet=10 uses=kernel:2\n"
+      "task uart    Normal      period=1000 wcet=960 uses=kernel:5,uart:960\n"
+      "task adc     AboveNormal period=100 deadline=20 wcet=40 uses=kernel:5\n"
+      "task monitor Idle        period=1000 wcet=30000 uses=kernel:20,uart:30000\n" },
+};
+
+enum ResKind { RES_MUTEX, RES_NP, RES_NONE };
+
+struct Task {
+    std::string name;
+    bool isr = false;
+    int prio = 0;               // 선언된 우선순위
+    int64_t period_us = 0;
+    int64_t deadline_us = 0;
+    int64_t wcet_us = 0;
+    int64_t jitter_us = 0;      // 선언된 릴리스 지터
+    std::string after;
+    std::vector<std::pair<std::string, int64_t>> uses;
+    // 분석 결과
+    int64_t T = 0, J = 0, B = 0, R = 0;
+    std::string blocked_by;
+};
+
+static std::vector<Task> tasks;
+static std::map<std::string, ResKind> resources;
+static bool pcp = false;
+
+static const char *kLevels[] = { "Idle", "Low", "BelowNormal", "Normal", "AboveNormal", "High", "Realtime" };
+
+static bool ParsePrio(const std::string &s, int &out)
+{
+    for (int i = 0; i < 7; i++) {
+        if (s == kLevels[i] || s == std::string("osPriority") + kLevels[i]) {
+            out = i - 3;
+            return true;
+        }
+    }
+    char *end;
+    long v = strtol(s.c_str(), &end, 10);
+    if (*end || v < -3 || v > 3)
+        return false;
+    out = (int)v;
+    return true;
+}
+
+static std::string PrioName(int prio)
+{
+    if (prio >= kIsrPrio) return "isr";
+    return prio >= -3 && prio <= 3 ? kLevels[prio + 3] : std::to_string(prio);
+}
+
+static bool ParseSpec(const std::string &text, const char *src)
+{
+    std::istringstream in(text);
+    std::string line;
+    int lineno = 0;
+    while (std::getline(in, line)) {
+        lineno++;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos)
+            line.resize(hash);
+        std::istringstream ls(line);
+        std::string kind, name;
+        if (!(ls >> kind))
+            continue;
+        auto fail = [&](const std::string &why) {
+            fprintf(stderr, "%s:%d: %s\n", src, lineno, why.c_str());
+            return false;
+        };
+        if (!(ls >> name))
+            return fail("이름이 없음");
+        if (kind == "resource") {
+            std::string k;
+            ls >> k;
+            if (k == "mutex") resources[name] = RES_MUTEX;
+            else if (k == "np") resources[name] = RES_NP;
+            else if (k == "none") resources[name] = RES_NONE;
+            else return fail("resource 종류는 mutex|np|none");
+            continue;
+        }
+        if (kind != "task" && kind != "isr")
+            return fail("task / isr / resource 만 됨: " + kind);
+        Task t;
+        t.name = name;
+        t.isr = kind == "isr";
+        if (t.isr) {
+            t.prio = kIsrPrio;
+        } else {
+            std::string p;
+            if (!(ls >> p) || !ParsePrio(p, t.prio))
+                return fail("우선순위를 모름: " + p);
+        }
+        std::string kv;
+        while (ls >> kv) {
+            size_t eq = kv.find('=');
+            if (eq == std::string::npos)
+                return fail("key=value 가 아님: " + kv);
+            std::string k = kv.substr(0, eq), v = kv.substr(eq + 1);
+            if (k == "period") t.period_us = (int64_t)(atof(v.c_str()) * 1000);
+            else if (k == "deadline") t.deadline_us = (int64_t)(atof(v.c_str()) * 1000);
+            else if (k == "wcet") t.wcet_us = atoll(v.c_str());
+            else if (k == "jitter") t.jitter_us = atoll(v.c_str());
+            else if (k == "after") t.after = v;
+            else if (k == "uses") {
+                std::istringstream us(v);
+                std::string item;
+                while (std::getline(us, item, ',')) {
+                    size_t c = item.find(':');
+                    if (c == std::string::npos)
+                        return fail("uses 는 자원:us");
+                    t.uses.push_back({ item.substr(0, c), atoll(item.c_str() + c + 1) });
+                }
+            } else {
+                return fail("모르는 키: " + k);
+            }
+        }
+        if (t.period_us <= 0 && t.after.empty())
+            return fail(name + ": period 또는 after 가 필요");
+        tasks.push_back(t);
+    }
+    if (!resources.count("kernel"))
+        resources["kernel"] = RES_NP;
+    for (Task &t : tasks) {
+        if (!t.after.empty()) {
+            auto it = std::find_if(tasks.begin(), tasks.end(), [&](const Task &o) { return o.name == t.after; });
+            if (it == tasks.end() || it->name == t.name) {
+                fprintf(stderr, "%s: %s 의 after=%s 가 없음\n", src, t.name.c_str(), t.after.c_str());
+                return false;
+            }
+        }
+    }
+    return !tasks.empty();
+}
+
+static int Find(const std::string &name)
+{
+    for (size_t i = 0; i < tasks.size(); i++)
+        if (tasks[i].name == name)
+            return (int)i;
+    return -1;
+}
+
+// --- 분석 (prio 는 태스크별 우선순위, 큰 값이 높음) ---
+static int64_t CeilDiv(int64_t a, int64_t b) { return (a + b - 1) / b; }
+
+// 자원 천장: 쓰는 태스크 중 가장 높은 우선순위 (np 는 모두 막음)
+static int Ceiling(const std::string &res, const std::vector<int> &prio)
+{
+    auto k = resources.find(res);
+    if (k != resources.end() && k->second == RES_NP)
+        return kIsrPrio + 1;
+    int c = INT32_MIN;
+    for (size_t j = 0; j < tasks.size(); j++)
+        for (auto &u : tasks[j].uses)
+            if (u.first == res)
+                c = std::max(c, prio[j]);
+    return c;
+}
+
+static int64_t Blocking(size_t i, const std::vector<int> &prio, std::string *who)
+{
+    std::map<std::string, int64_t> per_res;            // 자원마다 가장 긴 구간
+    std::vector<int64_t> per_task(tasks.size(), 0);    // 낮은 태스크마다 가장 긴 구간
+    int64_t longest = 0;
+    std::string longest_who;
+    for (size_t j = 0; j < tasks.size(); j++) {
+        if (j == i || tasks[j].isr || prio[j] >= prio[i])
+            continue;
+        for (auto &u : tasks[j].uses) {
+            auto k = resources.find(u.first);
+            ResKind kind = k == resources.end() ? RES_MUTEX : k->second;
+            if (kind == RES_NONE || Ceiling(u.first, prio) < prio[i])
+                continue;
+            if (tasks[i].isr && kind != RES_NP)
+                continue;
+            per_res[u.first] = std::max(per_res[u.first], u.second);
+            per_task[j] = std::max(per_task[j], u.second);
+            if (u.second > longest) {
+                longest = u.second;
+                longest_who = tasks[j].name + ":" + u.first;
+            }
+        }
+    }
+    if (who)
+        *who = longest_who;
+    // ISR 과 PCP 는 한 번만 막힘
+    if (pcp || tasks[i].isr)
+        return longest;
+    int64_t by_res = 0, by_task = 0;
+    for (auto &r : per_res) by_res += r.second;
+    for (int64_t v : per_task) by_task += v;
+    return std::min(by_res, by_task);
+}
+
+static int64_t ResponseTime(size_t i, const std::vector<int> &prio, const std::vector<int64_t> &T,
+                            const std::vector<int64_t> &J, int64_t B, double scale)
+{
+    const Task &t = tasks[i];
+    int64_t C = (int64_t)std::ceil(t.wcet_us * scale);
+    std::vector<size_t> hp;
+    for (size_t j = 0; j < tasks.size(); j++)
+        if (j != i && prio[j] >= prio[i])
+            hp.push_back(j);
+    int64_t limit = std::max<int64_t>(T[i], t.deadline_us) * 1000;
+    int64_t R = 0;
+    for (int64_t q = 0; q < 1000; q++) {
+        int64_t w = (q + 1) * C + B, prev = -1;
+        while (w != prev) {
+            prev = w;
+            w = (q + 1) * C + B;
+            for (size_t j : hp)
+                w += CeilDiv(prev + J[j], T[j]) * (int64_t)std::ceil(tasks[j].wcet_us * scale);
+            if (w > limit)
+                return kInf;
+        }
+        R = std::max(R, w - q * T[i] + J[i]);
+        if (w + J[i] <= (q + 1) * T[i])
+            return R;
+    }
+    return kInf;
+}
+
+// 모든 태스크의 응답 시간 (after 사슬의 지터가 맞을 때까지 반복). 결과는 tasks[].T/J/B/R
+static bool Analyze(const std::vector<int> &prio, double scale)
+{
+    size_t n = tasks.size();
+    std::vector<int64_t> T(n), J(n), R(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        int k = (int)i;
+        for (int hops = 0; !tasks[k].after.empty() && hops < (int)n; hops++)
+            k = Find(tasks[k].after);
+        T[i] = tasks[k].period_us;
+    }
+    for (int iter = 0; iter < 100; iter++) {
+        for (size_t i = 0; i < n; i++) {
+            int src = tasks[i].after.empty() ? -1 : Find(tasks[i].after);
+            J[i] = tasks[i].jitter_us + (src >= 0 ? std::min(R[src], kInf) : 0);
+        }
+        bool changed = false;
+        for (size_t i = 0; i < n; i++) {
+            tasks[i].B = Blocking(i, prio, &tasks[i].blocked_by);
+            int64_t r = J[i] >= kInf ? kInf : ResponseTime(i, prio, T, J, tasks[i].B, scale);
+            if (r != R[i]) {
+                R[i] = r;
+                changed = true;
+            }
+        }
+        if (!changed)
+            break;
+    }
+    bool ok = true;
+    for (size_t i = 0; i < n; i++) {
+        Task &t = tasks[i];
+        t.T = T[i];
+        t.J = J[i];
+        t.R = R[i];
+        int64_t D = t.deadline_us ? t.deadline_us : T[i];
+        if (t.R > D)
+            ok = false;
+    }
+    return ok;
+}
+
+static int64_t Deadline(const Task &t) { return t.deadline_us ? t.deadline_us : t.T; }
+
+// --- 우선순위 제안 ---
+// Audsley: 가장 낮은 자리부터, 거기서도 마감을 지키는 태스크를 pref 순서로 찾아 놓음.
+// 지터가 우선순위에 따라 바뀌므로 배치 -> 지터 다시 계산을 몇 번 반복. 결과는 순위 (0 = 가장 낮음)
+static bool Audsley(const std::vector<size_t> &pref, std::vector<int> &rank)
+{
+    size_t n = tasks.size();
+    rank.assign(n, kIsrPrio);
+    for (size_t k = 0; k < pref.size(); k++)
+        rank[pref[k]] = (int)k;
+    for (int round = 0; round < 5; round++) {
+        Analyze(rank, 1.0);                 // 지금 배치의 지터
+        std::vector<int64_t> T(n), J(n);
+        for (size_t i = 0; i < n; i++) {
+            T[i] = tasks[i].T;
+            J[i] = tasks[i].J;
+        }
+        std::vector<int> next(n, kIsrPrio);
+        std::vector<bool> placed(n, false);
+        for (size_t level = 0; level < pref.size(); level++) {
+            int pick = -1;
+            for (size_t i : pref) {
+                if (placed[i])
+                    continue;
+                std::vector<int> trial = next;
+                for (size_t j : pref)
+                    if (!placed[j])
+                        trial[j] = j == i ? (int)level : (int)pref.size();     // 나머지는 모두 위
+                int64_t B = Blocking(i, trial, nullptr);
+                if (ResponseTime(i, trial, T, J, B, 1.0) <= Deadline(tasks[i])) {
+                    pick = (int)i;
+                    break;
+                }
+            }
+            if (pick < 0)
+                return false;
+            next[pick] = (int)level;
+            placed[pick] = true;
+        }
+        if (next == rank)
+            break;
+        rank = next;
+    }
+    return Analyze(rank, 1.0);
+}
+
+// 순위를 CMSIS 단계로 (Idle 은 비워 두고 Low 부터 위로, 모자라면 맨 위에서 같이 씀)
+static std::vector<int> ToLevels(const std::vector<int> &rank)
+{
+    std::vector<int> prio(rank.size());
+    for (size_t i = 0; i < rank.size(); i++)
+        prio[i] = tasks[i].isr ? kIsrPrio : std::min(-2 + rank[i], 3);
+    return prio;
+}
+
+// 두 배치의 태스크 사이 높낮이가 같은지
+static bool SameOrder(const std::vector<int> &a, const std::vector<int> &b)
+{
+    for (size_t i = 0; i < tasks.size(); i++)
+        for (size_t j = 0; j < tasks.size(); j++)
+            if (!tasks[i].isr && !tasks[j].isr && (a[i] > a[j]) != (b[i] > b[j]))
+                return false;
+    return true;
+}
+
+// WCET 를 몇 배까지 늘려도 마감을 지키는지 (이분 탐색)
+static double Breakdown(const std::vector<int> &prio)
+{
+    if (!Analyze(prio, 1.0))
+        return 0;
+    double lo = 1, hi = 2;
+    while (hi < 1e4 && Analyze(prio, hi)) {
+        lo = hi;
+        hi *= 2;
+    }
+    for (int k = 0; k < 30; k++) {
+        double mid = (lo + hi) / 2;
+        (Analyze(prio, mid) ? lo : hi) = mid;
+    }
+    return lo;
+}
+
+static void PrintTable(const std::vector<int> &prio)
+{
+    bool ok = Analyze(prio, 1.0);
+    double u = 0;
+    for (const Task &t : tasks)
+        u += (double)t.wcet_us / (double)t.T;
+    printf("%-9s %-12s %7s %7s %7s %7s %7s %-16s %8s %8s  %s\n", "task", "prio", "T ms", "D ms", "C us", "J us",
+           "B us", "blocked by", "R us", "slack", "");
+    for (size_t i = 0; i < tasks.size(); i++) {
+        const Task &t = tasks[i];
+        int64_t D = Deadline(t);
+        char r[24], slack[24];
+        if (t.R >= kInf) {
+            snprintf(r, sizeof(r), "inf");
+            snprintf(slack, sizeof(slack), "-");
+        } else {
+            snprintf(r, sizeof(r), "%lld", (long long)t.R);
+            snprintf(slack, sizeof(slack), "%lld", (long long)(D - t.R));
+        }
+        printf("%-9s %-12s %7.1f %7.1f %7lld %7lld %7lld %-16s %8s %8s  %s\n", t.name.c_str(),
+               PrioName(prio[i]).c_str(), t.T / 1000.0, D / 1000.0, (long long)t.wcet_us, (long long)t.J,
+               (long long)t.B, t.blocked_by.empty() ? "-" : t.blocked_by.c_str(), r, slack,
+               t.R > D ? "MISS" : "ok");
+    }
+    printf("utilization %.1f%%, %s, breakdown x%.2f\n", u * 100, ok ? "all deadlines met" : "DEADLINE MISS",
+           Breakdown(prio));
+}
+
+// --- rt_stats 캡처에서 WCET ---
+static bool LoadCapture(const char *path, std::map<std::string, int64_t> &wcet)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    std::vector<uint8_t> buf;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        buf.insert(buf.end(), chunk, chunk + n);
+    fclose(f);
+
+    std::map<int, std::string> names;
+    std::map<int, uint32_t> max_cycles;
+    std::string line;
+    for (size_t i = 0; i < buf.size();) {
+        if (buf[i] == 0xA5 && i + 4 <= buf.size() && buf[i + 1] == 0x5A) {
+            uint8_t type = buf[i + 2], cnt = buf[i + 3];
+            size_t size = type == 'R' ? 4 + 4 + (size_t)cnt * 10 + 1 : 4 + (size_t)cnt + 1;
+            if (i + size > buf.size())
+                break;
+            if (type == 'R') {
+                uint8_t sum = 0;
+                for (size_t k = i + 2; k < i + size - 1; k++)
+                    sum += buf[k];
+                if (sum == buf[i + size - 1]) {
+                    for (size_t e = 0; e < cnt; e++) {
+                        const uint8_t *p = &buf[i + 8 + e * 10];
+                        uint32_t c = (uint32_t)p[6] | (uint32_t)p[7] << 8 | (uint32_t)p[8] << 16 |
+                                     (uint32_t)p[9] << 24;
+                        max_cycles[p[0]] = std::max(max_cycles[p[0]], c);
+                    }
+                }
+            }
+            i += size;
+            continue;
+        }
+        if (buf[i] == '\n') {
+            unsigned id;
+            char kind[8], name[32];
+            if (sscanf(line.c_str(), "RTS %u %7s %31s", &id, kind, name) == 3)
+                names[(int)id] = name;
+            line.clear();
+        } else if (buf[i] != '\r') {
+            line += (char)buf[i];
+        }
+        i++;
+    }
+    for (auto &m : max_cycles)
+        if (names.count(m.first))
+            wcet[names[m.first]] = RtStats_CyclesToUs(m.second);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *preset = "sys";
+    const char *capture = nullptr;
+    bool dump = false;
+    std::vector<std::pair<std::string, int64_t>> overrides;
+    int opt;
+    while ((opt = getopt(argc, argv, "P:p:w:c:d")) != -1) {
+        switch (opt) {
+            case 'P': preset = optarg; break;
+            case 'p':
+                if (strcmp(optarg, "pcp") == 0) pcp = true;
+                else if (strcmp(optarg, "pip") != 0) {
+                    fprintf(stderr, "-p pip|pcp\n");
+                    return 2;
+                }
+                break;
+            case 'w': {
+                const char *eq = strchr(optarg, '=');
+                if (!eq) {
+                    fprintf(stderr, "-w name=us\n");
+                    return 2;
+                }
+                overrides.push_back({ std::string(optarg, (size_t)(eq - optarg)), atoll(eq + 1) });
+                break;
+            }
+            case 'c': capture = optarg; break;
+            case 'd': dump = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-P sys|maung|free_rtos] [-p pip|pcp] [-w name=us]... [-c capture.bin] "
+                                "[-d] [spec.txt]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    std::string text, src;
+    if (optind < argc) {
+        FILE *f = fopen(argv[optind], "rb");
+        if (!f) {
+            fprintf(stderr, "%s: 읽을 수 없음\n", argv[optind]);
+            return 2;
+        }
+        char chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+            text.append(chunk, n);
+        fclose(f);
+        src = argv[optind];
+    } else {
+        for (auto &p : kPresets)
+            if (strcmp(p.name, preset) == 0)
+                text = p.spec;
+        if (text.empty()) {
+            fprintf(stderr, "preset %s 없음 (sys, maung, free_rtos)\n", preset);
+            return 2;
+        }
+        src = preset;
+    }
+    if (dump) {
+        fputs(text.c_str(), stdout);
+        return 0;
+    }
+    if (!ParseSpec(text, src.c_str()))
+        return 2;
+
+    // WCET 덮어쓰기: 캡처 다음 -w (태스크 이름 끝의 "Task" 는 떼고도 맞춰 봄: periodic_sim 은 osThreadDef 이름)
+    std::map<std::string, int64_t> measured;
+    if (capture && !LoadCapture(capture, measured)) {
+        fprintf(stderr, "%s: 읽을 수 없음\n", capture);
+        return 2;
+    }
+    for (auto &o : overrides)
+        measured[o.first] = o.second;
+    for (auto &m : measured) {
+        std::string name = m.first;
+        int i = Find(name);
+        if (i < 0 && name.size() > 4 && name.compare(name.size() - 4, 4, "Task") == 0)
+            i = Find(name.substr(0, name.size() - 4));
+        if (i < 0) {
+            fprintf(stderr, "wcet %s: 태스크 세트에 없음, 무시\n", name.c_str());
+            continue;
+        }
+        // 측정값이 선언값보다 작으면 (HAL 대기만 잰 경우 등) 선언값 유지
+        tasks[i].wcet_us = std::max(tasks[i].wcet_us, m.second);
+    }
+
+    std::vector<int> declared(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++)
+        declared[i] = tasks[i].prio;
+
+    printf("== %s, declared priorities (%s)\n", src.c_str(), pcp ? "priority ceiling" : "priority inheritance");
+    bool declared_ok = Analyze(declared, 1.0);
+    PrintTable(declared);
+
+    // 잠금 없이 나눠 쓰는 자원
+    for (auto &r : resources) {
+        if (r.second != RES_NONE)
+            continue;
+        std::vector<std::string> users;
+        for (const Task &t : tasks)
+            for (auto &u : t.uses)
+                if (u.first == r.first)
+                    users.push_back(t.name);
+        if (users.size() > 1) {
+            printf("warning: %s is used by", r.first.c_str());
+            for (auto &u : users) printf(" %s", u.c_str());
+            printf(" without a lock (no blocking counted, but transfers can collide)\n");
+        }
+    }
+
+    // 후보: 선언 그대로, 선언 순서를 되도록 지키는 Audsley, 마감 단조 순서로 찾는 Audsley, 마감 단조.
+    // 마감을 모두 지키는 것 중 breakdown 이 가장 큰 것 (같으면 앞의 것)
+    std::vector<size_t> by_decl, by_dm;
+    for (size_t i = 0; i < tasks.size(); i++)
+        if (!tasks[i].isr)
+            by_decl.push_back(i);
+    by_dm = by_decl;
+    std::stable_sort(by_decl.begin(), by_decl.end(), [&](size_t a, size_t b) {
+        return declared[a] != declared[b] ? declared[a] < declared[b] : Deadline(tasks[a]) > Deadline(tasks[b]);
+    });
+    std::stable_sort(by_dm.begin(), by_dm.end(), [](size_t a, size_t b) {
+        return Deadline(tasks[a]) > Deadline(tasks[b]);       // 마감이 긴 것부터 (낮은 자리)
+    });
+    struct Candidate { const char *how; std::vector<int> prio; double breakdown; };
+    std::vector<Candidate> cands;
+    cands.push_back({ "declared", declared, 0 });
+    std::vector<int> rank;
+    if (Audsley(by_decl, rank))
+        cands.push_back({ "Audsley, closest to declared", ToLevels(rank), 0 });
+    if (Audsley(by_dm, rank))
+        cands.push_back({ "Audsley, deadline-monotonic first", ToLevels(rank), 0 });
+    rank.assign(tasks.size(), kIsrPrio);
+    for (size_t k = 0; k < by_dm.size(); k++)
+        rank[by_dm[k]] = (int)k;
+    cands.push_back({ "deadline monotonic", ToLevels(rank), 0 });
+    const Candidate *best = nullptr;
+    for (Candidate &c : cands) {
+        if (SameOrder(c.prio, declared))
+            c.prio = declared;          // 순서가 같으면 선언된 단계 그대로
+        c.breakdown = Breakdown(c.prio);
+        if (!best || c.breakdown > best->breakdown * 1.01)
+            best = &c;
+    }
+    const std::vector<int> &suggested = best->prio;
+    printf("\n== suggested priorities (%s%s)\n", best->how,
+           best->breakdown > 0 ? ", largest breakdown" : ", no order meets every deadline");
+    PrintTable(suggested);
+    bool same = true;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        if (tasks[i].isr || suggested[i] == declared[i])
+            continue;
+        same = false;
+        printf("  %-9s osPriority%s -> osPriority%s\n", tasks[i].name.c_str(), PrioName(declared[i]).c_str(),
+               PrioName(suggested[i]).c_str());
+    }
+    if (same)
+        printf("  keep the declared priorities\n");
+    return declared_ok ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+// rules_bench.cpp
+// rules.c 동작 확인과 평가 속도 측정
+//
+// 확인: 조건 종류별로 짧은 입력열을 넣어 동작이 나와야 할 때만 나오는지, 블롭 CRC/범위 검사와
+//       로드 중복(BUSY)이 걸러지는지. 틀리면 종료 코드 1
+// 속도: 규칙 16 ~ 128 개를 블롭으로 만들어 로드하고 Rules_Eval 초당 횟수와 규칙당 ns
+//       (모두 같은 입력인 최악의 경우와 입력 8 개에 고루 나뉜 경우)
+//
+// 빌드:
+//   gcc -c -O2 -DHOST_BUILD -DRULES_MAX=128 -I Test Test/rules.c
+//   g++ -O2 -std=c++17 -DRULES_MAX=128 -I Test Test/host/rules_bench.cpp rules.o -o rules_bench
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "rules.h"
+}
+
+static int failed = 0;
+static std::vector<int> log_;       // 출력 0 동작 기록 (arg)
+static uint32_t sink;
+
+static void Out0(uint8_t arg) { log_.push_back(arg); }
+static void Out1(uint8_t arg) { sink += arg; }
+
+static void Expect(const char *name, const std::vector<int> &want)
+{
+    if (log_ != want) {
+        printf("FAIL %s: got", name);
+        for (int v : log_) printf(" %d", v);
+        printf(", want");
+        for (int v : want) printf(" %d", v);
+        printf("\n");
+        failed = 1;
+    }
+    log_.clear();
+}
+
+static void LoadOne(const Rule &r)
+{
+    Rules_Init();
+    Rules_SetOutput(0, Out0);
+    Rules_LoadTable(&r, 1);
+    log_.clear();
+}
+
+static void Feed(std::initializer_list<int32_t> values, uint32_t step_ms = 100)
+{
+    uint32_t t = 0;
+    for (int32_t v : values) {
+        Rules_Eval(0, v, t);
+        t += step_ms;
+    }
+}
+
+static void CheckKinds()
+{
+    // 임계값: 처음 평가에서 한 번, 그다음은 바뀔 때만
+    LoadOne({ RULE_THRESHOLD, 0, 0, 0, 100, 0, 0, 1, 0, 0 });
+    Feed({ 50, 60, 150, 200, 90, 101 });
+    Expect("threshold", { 0, 1, 0, 1 });
+
+    LoadOne({ RULE_THRESHOLD, RULE_F_BELOW, 0, 0, 100, 0, 0, 1, 0, 0 });
+    Feed({ 50, 150, 99 });
+    Expect("threshold below", { 1, 0, 1 });
+
+    // 히스테리시스 100 / 80: 사이 값은 상태 유지
+    LoadOne({ RULE_HYSTERESIS, 0, 0, 0, 100, 80, 0, 1, 0, 0 });
+    Feed({ 90, 110, 90, 85, 79, 90, 101 });
+    Expect("hysteresis", { 0, 1, 0, 1 });
+
+    // 변화율 > 200/s, 100 ms 간격이면 한 번에 20 넘게 오를 때
+    LoadOne({ RULE_RATE, 0, 0, 0, 200, 0, 0, 1, 0, 0 });
+    Feed({ 0, 10, 40, 45, 45 });
+    Expect("rate", { 0, 1, 0 });
+
+    // 하강 변화율 < -200/s
+    LoadOne({ RULE_RATE, RULE_F_BELOW, 0, 0, -200, 0, 0, 1, 0, 0 });
+    Feed({ 100, 90, 60, 60 });
+    Expect("rate below", { 0, 1, 0 });
+
+    // 최근 4 개 중 3 개 이상 > 50
+    LoadOne({ RULE_WINDOW, 0, 0, 4, 50, 3, 0, 1, 0, 0 });
+    Feed({ 60, 60, 10, 60, 10, 10, 60 });
+    Expect("window", { 0, 1, 0 });
+
+    // 다른 입력 채널은 무시
+    LoadOne({ RULE_THRESHOLD, 0, 3, 0, 100, 0, 0, 1, 0, 0 });
+    Feed({ 500 });
+    Expect("input", {});
+}
+
+static void CheckBlob()
+{
+    Rules_Init();
+    Rule r[2] = {
+        { RULE_THRESHOLD, 0, 0, 0, 100, 0, 0, 1, 0, 0 },
+        { RULE_WINDOW, 0, 1, 8, 10, 4, 1, 1, RULES_OUT_NONE, 0 },
+    };
+    uint8_t blob[RULES_BLOB_SIZE(2)];
+    int n = Rules_Encode(r, 2, blob, sizeof(blob));
+    if (n != (int)sizeof(blob) || Rules_LoadBlob(blob, (uint32_t)n) != RULES_OK) {
+        printf("FAIL blob load\n");
+        failed = 1;
+    }
+    if (Rules_LoadBlob(blob, (uint32_t)n) != RULES_ERR_BUSY) {
+        printf("FAIL blob busy\n");
+        failed = 1;
+    }
+    Rules_Eval(0, 0, 0);        // 적용
+    RulesStats st;
+    Rules_GetStats(&st);
+    if (st.count != 2) {
+        printf("FAIL blob count %u\n", st.count);
+        failed = 1;
+    }
+
+    blob[RULES_BLOB_HEADER + 4] ^= 1;
+    if (Rules_LoadBlob(blob, (uint32_t)n) != RULES_ERR_CRC) {
+        printf("FAIL blob crc\n");
+        failed = 1;
+    }
+    r[1].b = 9;                 // 8 개 중 9 개: 범위 밖
+    n = Rules_Encode(r, 2, blob, sizeof(blob));
+    if (Rules_LoadBlob(blob, (uint32_t)n) != RULES_ERR_RULE) {
+        printf("FAIL blob rule check\n");
+        failed = 1;
+    }
+    if (Rules_LoadBlob(blob, (uint32_t)n - 1) != RULES_ERR_FORMAT) {
+        printf("FAIL blob length\n");
+        failed = 1;
+    }
+    static Rule many[RULES_MAX + 1];
+    static uint8_t big[RULES_BLOB_SIZE(RULES_MAX + 1)];
+    if (Rules_Encode(many, RULES_MAX + 1, big, sizeof(big)) != -1 ||
+        Rules_LoadTable(many, RULES_MAX + 1) != RULES_ERR_FORMAT) {
+        printf("FAIL count > RULES_MAX\n");
+        failed = 1;
+    }
+}
+
+// --- 속도 ---
+static uint32_t rng = 12345;
+static uint32_t Rand() { rng = rng * 1103515245u + 12345u; return rng >> 8; }
+
+static std::vector<Rule> MakeRules(int count, int inputs)
+{
+    std::vector<Rule> v;
+    for (int i = 0; i < count; i++) {
+        Rule r = {};
+        r.kind = (uint8_t)(i % RULE_KIND_COUNT);
+        r.input = (uint8_t)(i % inputs);
+        r.flags = (Rand() & 1) ? RULE_F_BELOW : 0;
+        r.a = (int32_t)(Rand() % 4096);
+        switch (r.kind) {
+            case RULE_HYSTERESIS:
+                r.b = (r.flags & RULE_F_BELOW) ? r.a + 100 : r.a - 100;
+                break;
+            case RULE_RATE:
+                r.a = (int32_t)(Rand() % 2000) - 1000;
+                break;
+            case RULE_WINDOW:
+                r.param = (uint8_t)(1 + Rand() % 32);
+                r.b = 1 + (int32_t)(Rand() % r.param);
+                break;
+        }
+        r.out_on = r.out_off = 1;
+        r.arg_on = 1;
+        r.arg_off = 0;
+        v.push_back(r);
+    }
+    return v;
+}
+
+static void Bench(int count, int inputs)
+{
+    std::vector<Rule> rules = MakeRules(count, inputs);
+    std::vector<uint8_t> blob(RULES_BLOB_SIZE(count));
+    Rules_Init();
+    Rules_SetOutput(1, Out1);
+    Rules_Encode(rules.data(), (uint8_t)count, blob.data(), (uint32_t)blob.size());
+    if (Rules_LoadBlob(blob.data(), (uint32_t)blob.size()) != RULES_OK) {
+        printf("FAIL load %d\n", count);
+        failed = 1;
+        return;
+    }
+
+    // 조도처럼 천천히 흔들리는 입력 + 가끔 튐
+    std::vector<int32_t> values(4096);
+    int32_t v = 2000;
+    for (int32_t &x : values) {
+        v += (int32_t)(Rand() % 61) - 30;
+        if (Rand() % 64 == 0) v += (int32_t)(Rand() % 1001) - 500;
+        v = v < 0 ? 0 : v > 4095 ? 4095 : v;
+        x = v;
+    }
+
+    const int rounds = 200;
+    uint32_t t = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < values.size(); i++, t += 10)
+            Rules_Eval((uint8_t)(i % inputs), values[i], t);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    RulesStats st;
+    Rules_GetStats(&st);
+    double secs = std::chrono::duration<double>(t1 - t0).count();
+    double evals = (double)rounds * values.size();
+    printf("%5d %6d %14.0f %10.1f %10.2f %9.3f\n", count, inputs, evals / secs, secs * 1e9 / evals,
+           secs * 1e9 / st.checks, (double)st.actions / evals);
+}
+
+int main()
+{
+    CheckKinds();
+    CheckBlob();
+    printf("checks: %s\n", failed ? "FAIL" : "ok");
+
+    printf("%5s %6s %14s %10s %10s %9s\n", "rules", "inputs", "evals/s", "ns/eval", "ns/rule", "acts/eval");
+    for (int count : { 16, 32, 64, 128 }) {
+        if (count > RULES_MAX)
+            continue;
+        Bench(count, 1);
+        Bench(count, 8);
+    }
+    printf("table RAM: %zu bytes for %d rules (2 banks + state)\n",
+           (size_t)RULES_MAX * (2 * sizeof(Rule) + 16), RULES_MAX);
+    (void)sink;
+    return failed;
+}
@@ -0,0 +1,328 @@
+// spark_sim.cpp
+// OLED 스파크라인 (oled_spark) 확인: sub.c 처럼 기록(history)에 샘플을 넣고 그래프를 갱신해서
+// oled_async 로 보내고, I2C 를 해석하는 패널 모델의 GDDRAM 을 매 갱신마다 검사한다.
+//   - 패널 == 뒤 버퍼 (화면 전체), 그래프 열마다 켜진 행이 샘플 값에서 계산한 것과 같은지
+//   - 갱신마다 버스로 나간 바이트와 버스 시간
+// 방식: hw = 패널 스크롤(2Dh) + 한 열, sw = 뒤 버퍼만 밀고 차이 전송, full = 매번 Redraw
+//
+// 패널 모델은 페이지 주소 모드 명령, 인자 있는 명령, 2Ch/2Dh content scroll 을 해석한다.
+// 스크롤로 비는 열에는 일부러 쓰레기(0x5A)를 넣어서 드라이버가 그 열을 다시 쓰는지 본다.
+//
+// 빌드:
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/oled_spark.c Test/oled_async.c
+//       Test/i2c_bus.c Test/history.c Test/dlog.c
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/ssd1306_host.c Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -I Test -I Test/host Test/host/spark_sim.cpp *.o -pthread -o spark_sim
+// 사용: ./spark_sim [-n 샘플] [-p 샘플 주기 ms]
+//
+// 데이터는 천천히 움직이는 조도 + 구름 계단 + 가끔 범위를 벗어나는 점프 (Redraw 경로).
+// 설정마다 fork 해서 시뮬레이터 상태를 새로 시작한다.
+#include "host_os.h"
+#include "main.h"
+#include "ssd1306.h"
+extern "C" {
+#include "oled_async.h"
+#include "oled_spark.h"
+#include "i2c_bus.h"
+#include "history.h"
+}
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+extern "C" I2C_HandleTypeDef hi2c1;
+extern "C" UART_HandleTypeDef huart1;
+I2C_HandleTypeDef hi2c1;
+UART_HandleTypeDef huart1;
+
+extern "C" void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2cBus_TxDone(hi2c);
+}
+
+enum Mode { MODE_HW, MODE_SW, MODE_FULL };
+static const char *kModeName[] = { "hw", "sw", "full" };
+
+struct Config {
+    uint32_t hz;
+    Mode mode;
+    uint32_t samples;
+    uint32_t period_us;
+};
+
+struct Result {
+    uint32_t updates = 0;
+    uint32_t redraws = 0;
+    uint32_t busy_skips = 0;
+    uint32_t panel_bad = 0;         // 패널과 뒤 버퍼가 다른 갱신
+    uint32_t pixel_bad = 0;         // 그래프 열이 기대와 다른 갱신
+    uint64_t bytes = 0;
+    std::vector<uint32_t> upd_bytes;
+    std::vector<uint32_t> upd_us;
+};
+
+static Config cfg;
+static Result res;
+
+// --- 패널 모델 ---
+static uint8_t panel[8][128];
+static uint8_t panel_page, panel_col;
+static uint8_t cmd_buf[8];
+static uint8_t cmd_len, cmd_need;
+
+static uint8_t ArgCount(uint8_t c)
+{
+    switch (c) {
+        case 0x20: case 0x81: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0x8D:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27: case 0x2C: case 0x2D:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+static void PanelCommand(const uint8_t *c)
+{
+    if (c[0] >= 0xB0 && c[0] <= 0xB7) {
+        panel_page = c[0] & 7;
+    } else if (c[0] <= 0x0F) {
+        panel_col = (uint8_t)((panel_col & 0xF0) | c[0]);
+    } else if (c[0] <= 0x1F) {
+        panel_col = (uint8_t)((panel_col & 0x0F) | ((c[0] & 0x0F) << 4));
+    } else if (c[0] == 0x2C || c[0] == 0x2D) {
+        uint8_t p0 = c[2] & 7, p1 = c[4] & 7, x0 = c[5] & 127, x1 = c[6] & 127;
+        for (uint8_t p = p0; p <= p1 && x0 < x1; p++) {
+            if (c[0] == 0x2D) {
+                memmove(&panel[p][x0], &panel[p][x0 + 1], x1 - x0);
+                panel[p][x1] = 0x5A;
+            } else {
+                memmove(&panel[p][x0 + 1], &panel[p][x0], x1 - x0);
+                panel[p][x0] = 0x5A;
+            }
+        }
+    }
+}
+
+static void PanelWrite(uint64_t, uint16_t addr, const uint8_t *d, uint16_t len, void *)
+{
+    if (addr != SSD1306_I2C_ADDR || len == 0)
+        return;
+    res.bytes += len;
+    if (d[0] == 0x00) {
+        // 인자는 다음 트랜잭션으로 넘어올 수 있음 (SSD1306_Init 은 한 바이트씩 보냄)
+        for (uint16_t i = 1; i < len; i++) {
+            if (cmd_len == 0)
+                cmd_need = ArgCount(d[i]);
+            cmd_buf[cmd_len++] = d[i];
+            if (cmd_len > cmd_need) {
+                PanelCommand(cmd_buf);
+                cmd_len = 0;
+            }
+        }
+    } else if (d[0] == 0x40) {
+        for (uint16_t i = 1; i < len; i++) {
+            panel[panel_page][panel_col & 127] = d[i];
+            panel_col = (uint8_t)((panel_col + 1) & 127);
+        }
+    }
+}
+
+// --- 데이터 ---
+static uint32_t rng = 99;
+static uint32_t Rand() { rng = rng * 1103515245u + 12345u; return rng >> 8; }
+
+static uint16_t Sample(uint32_t i)
+{
+    static double cloud = 0;
+    if (Rand() % 40 == 0)
+        cloud = (Rand() % 2) ? 0 : -(double)(Rand() % 300);
+    double v = 2000 + 600 * std::sin(i / 400.0) + cloud + (double)(Rand() % 9) - 4;
+    if (i % 700 == 650)
+        v += 1200;              // 범위 밖 점프 (Redraw)
+    return (uint16_t)std::clamp(v, 0.0, 4095.0);
+}
+
+// --- 그래프 갱신 (sub.c 의 Spark_Update 와 같음, full 은 매번 Redraw) ---
+static OledSpark spark;
+static uint32_t spark_seq;
+
+static bool SparkUpdate()
+{
+    static uint16_t v[SSD1306_WIDTH];
+    HistoryStats hs;
+    History_GetStats(&hs);
+    if (hs.total == spark_seq)
+        return true;
+    if (OledAsync_Busy())
+        return false;
+    uint32_t redraws = spark.redraws;
+    uint32_t first = spark_seq;
+    uint32_t n = cfg.mode != MODE_FULL && hs.total - spark_seq < spark.cols
+        ? History_Read(spark_seq, v, spark.cols, &first) : 0;
+    if (n == 0 || first != spark_seq || OledSpark_Push(&spark, v, n) != 0) {
+        n = History_ReadLast(v, spark.cols);
+        OledSpark_Redraw(&spark, v, n);
+    }
+    spark_seq = hs.total;
+    if (spark.redraws != redraws && cfg.mode != MODE_FULL)
+        res.redraws++;
+    return true;
+}
+
+// 그래프 열마다 켜져야 할 행: 앞 샘플 높이 ~ 이번 높이 (Redraw 뒤 첫 열은 점)
+static bool CheckPixels(uint32_t redraw_seq)
+{
+    static uint16_t v[SSD1306_WIDTH + 1];
+    // 맨 왼쪽 열의 앞 샘플까지 하나 더 읽음
+    uint32_t start = spark_seq > spark.cols ? spark_seq - spark.cols - 1 : 0;
+    uint32_t first = 0;
+    uint32_t n = History_Read(start, v, spark_seq - start, &first);
+    const uint8_t *fb = SSD1306_GetBuffer();
+    for (uint8_t c = 0; c < spark.cols; c++) {
+        uint32_t want = 0;
+        uint32_t seq = spark_seq - spark.cols + c;      // 이 열의 샘플 번호 (음수면 빈 열)
+        if (spark_seq + c >= spark.cols && seq >= first && seq - first < n) {
+            uint32_t k = seq - first;
+            uint8_t y = OledSpark_Row(&spark, v[k]);
+            uint8_t a = y, b = y;
+            if (k > 0 && seq > redraw_seq) {
+                uint8_t py = OledSpark_Row(&spark, v[k - 1]);
+                a = std::min(a, py);
+                b = std::max(b, py);
+            }
+            for (uint8_t r = a; r <= b; r++)
+                want |= 1u << r;
+        }
+        uint32_t got = 0;
+        for (uint8_t p = 0; p < spark.pages; p++)
+            got |= (uint32_t)fb[(spark.page0 + p) * SSD1306_WIDTH + spark.x0 + c] << (8 * p);
+        if (got != want)
+            return false;
+    }
+    return true;
+}
+
+static void WaitUntil(uint64_t t)
+{
+    while (HostOs_NowUs() < t)
+        HostOs_Idle(t - HostOs_NowUs());
+}
+
+static int Entry(void)
+{
+    hi2c1.Init.ClockSpeed = cfg.hz;
+    HAL_I2C_Init(&hi2c1);
+    SSD1306_Init();
+    I2cBus_Init(&hi2c1);
+    OledAsync_Init();
+    History_Init();
+    OledSpark_Init(&spark, 0, SSD1306_WIDTH, 6, 2, cfg.mode == MODE_HW);
+    spark_seq = 0;
+
+    uint32_t redraw_seq = 0;
+    uint64_t next = HostOs_NowUs();
+    for (uint32_t i = 0; i < cfg.samples; i++) {
+        WaitUntil(next);
+        next += cfg.period_us;
+
+        History_Append(Sample(i));
+        uint32_t redraws = spark.redraws;
+        if (!SparkUpdate()) {
+            res.busy_skips++;
+            continue;
+        }
+        if (spark.redraws != redraws)
+            redraw_seq = spark_seq - std::min<uint32_t>(spark_seq, spark.cols);
+        uint64_t b0 = res.bytes;
+        if (OledAsync_Flush() < 0) {
+            res.busy_skips++;
+            continue;
+        }
+
+        // 다음 샘플 전에 전송이 끝났는지, 패널이 맞는지
+        WaitUntil(next - 1);
+        OledAsyncStats st;
+        OledAsync_GetStats(&st);
+        res.updates++;
+        res.upd_bytes.push_back((uint32_t)(res.bytes - b0));
+        res.upd_us.push_back(OledAsync_Busy() ? cfg.period_us : st.last_flush_us);
+        if (OledAsync_Busy())
+            continue;               // 아직 보내는 중: 다음에 (밀린 샘플은 여러 열로 한꺼번에 나감)
+        if (memcmp(panel, SSD1306_GetBuffer(), sizeof(panel)) != 0)
+            res.panel_bad++;
+        if (!CheckPixels(redraw_seq))
+            res.pixel_bad++;
+    }
+    return 0;
+}
+
+static uint32_t Pct(std::vector<uint32_t> v, double q)
+{
+    if (v.empty())
+        return 0;
+    std::sort(v.begin(), v.end());
+    return v[(size_t)(q * (double)(v.size() - 1))];
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t samples = 2000;
+    uint32_t period_ms = 100;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:p:")) != -1) {
+        switch (opt) {
+            case 'n': samples = (uint32_t)atoi(optarg); break;
+            case 'p': period_ms = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-n samples] [-p period_ms]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (period_ms == 0) {
+        fprintf(stderr, "period must be > 0\n");
+        return 1;
+    }
+
+    printf("%u samples, one per %u ms, graph 128 x 16 (pages 6-7)\n", (unsigned)samples, (unsigned)period_ms);
+    printf("%-5s %-8s %7s %7s %6s %14s %14s %9s %9s\n", "mode", "bus", "updates", "redraws", "skips",
+           "B/upd p50/max", "bus us p50/max", "panel ok", "pixels ok");
+    for (uint32_t hz : { 100000u, 400000u }) {
+        for (Mode m : { MODE_HW, MODE_SW, MODE_FULL }) {
+            fflush(stdout);
+            pid_t pid = fork();
+            if (pid == 0) {
+                cfg = { hz, m, samples, period_ms * 1000u };
+                HostOs_SetI2c(PanelWrite, nullptr);
+                HostOs_Run(Entry, (uint64_t)(samples + 1) * cfg.period_us + 1000000u);
+                char b[32], t[32];
+                snprintf(b, sizeof(b), "%u/%u", (unsigned)Pct(res.upd_bytes, 0.5), (unsigned)Pct(res.upd_bytes, 1.0));
+                snprintf(t, sizeof(t), "%u/%u", (unsigned)Pct(res.upd_us, 0.5), (unsigned)Pct(res.upd_us, 1.0));
+                printf("%-5s %4u kHz %7u %7u %6u %14s %14s %9s %9s\n", kModeName[m], (unsigned)(hz / 1000),
+                       (unsigned)res.updates, (unsigned)res.redraws, (unsigned)res.busy_skips, b, t,
+                       res.panel_bad ? "FAIL" : "ok", res.pixel_bad ? "FAIL" : "ok");
+                fflush(stdout);
+                _exit(res.panel_bad || res.pixel_bad ? 2 : 0);
+            }
+            int status = 0;
+            waitpid(pid, &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) == 1) {
+                fprintf(stderr, "%s %u kHz: child failed\n", kModeName[m], (unsigned)(hz / 1000));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+// ssd1306.h (호스트용)
+// sub.c 가 쓰는 tm_stm32 SSD1306 API. 구현(ssd1306_host.c)은 원본과 같은 순서로 픽셀을 찍고
+// 같은 I2C 트랜잭션을 HAL_I2C_Master_Transmit 로 보내서 시간과 바이트 수가 실제와 맞는다.
+#ifndef SSD1306_H
+#define SSD1306_H
+
+#include <stdint.h>
+#include "fonts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_I2C_ADDR    0x78
+#define SSD1306_WIDTH       128
+#define SSD1306_HEIGHT      64
+
+typedef enum {
+    SSD1306_COLOR_BLACK = 0x00,
+    SSD1306_COLOR_WHITE = 0x01
+} SSD1306_COLOR_t;
+
+uint8_t SSD1306_Init(void);
+void SSD1306_UpdateScreen(void);
+void SSD1306_ToggleInvert(void);
+void SSD1306_Fill(SSD1306_COLOR_t Color);
+void SSD1306_DrawPixel(uint16_t x, uint16_t y, SSD1306_COLOR_t color);
+void SSD1306_GotoXY(uint16_t x, uint16_t y);
+char SSD1306_Putc(char ch, FontDef_t *Font, SSD1306_COLOR_t color);
+char SSD1306_Puts(char *str, FontDef_t *Font, SSD1306_COLOR_t color);
+
+// 프레임버퍼 (페이지 단위 세로 바이트, buffer[x + (y / 8) * 128])
+// 원본 라이브러리에는 없으므로 타깃 ssd1306.c 에도 같은 한 줄짜리 getter 를 넣어 쓴다 (oled_text.c)
+uint8_t *SSD1306_GetBuffer(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,167 @@
+// ssd1306_host.c
+// tm_stm32 SSD1306 드라이버를 호스트용으로 옮긴 것 (I2C 는 host_hal.c 로 감)
+// 폰트 모양은 자리표시용으로 만들어 쓰지만 글자 크기와 픽셀 순회 횟수는 원본과 같다.
+#include "main.h"
+#include "host_os.h"
+#include "ssd1306.h"
+#include <string.h>
+
+extern I2C_HandleTypeDef hi2c1;
+
+static uint8_t SSD1306_Buffer[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
+
+static struct {
+    uint16_t CurrentX;
+    uint16_t CurrentY;
+    uint8_t Inverted;
+    uint8_t Initialized;
+} SSD1306;
+
+// --- 폰트 (ASCII 32~126) ---
+static uint16_t font7x10_data[95 * 10];
+static uint16_t font11x18_data[95 * 18];
+static uint16_t font16x26_data[95 * 26];
+
+FontDef_t Font_7x10 = { 7, 10, font7x10_data };
+FontDef_t Font_11x18 = { 11, 18, font11x18_data };
+FontDef_t Font_16x26 = { 16, 26, font16x26_data };
+
+static void MakeFont(uint16_t *data, uint8_t w, uint8_t h)
+{
+    for (int ch = 0; ch < 95; ch++) {
+        uint32_t seed = 2166136261u ^ (uint32_t)(ch * 16777619u);
+        for (int row = 0; row < h; row++) {
+            seed = seed * 1103515245u + 12345u;
+            uint16_t bits = (uint16_t)(seed >> 8);
+            uint16_t mask = (uint16_t)(0xFFFFu << (16 - w));
+            // 위아래 한 줄과 오른쪽 한 칸은 글자 간격으로 비움
+            data[ch * h + row] = (ch == 0 || row == 0 || row == h - 1) ? 0 : (uint16_t)(bits & mask & ~(1u << (16 - w)));
+        }
+    }
+}
+
+__attribute__((constructor)) static void MakeFonts(void)
+{
+    MakeFont(font7x10_data, 7, 10);
+    MakeFont(font11x18_data, 11, 18);
+    MakeFont(font16x26_data, 16, 26);
+}
+
+// --- I2C ---
+static void ssd1306_I2C_Write(uint8_t address, uint8_t reg, uint8_t data)
+{
+    uint8_t dt[2] = { reg, data };
+    HAL_I2C_Master_Transmit(&hi2c1, address, dt, 2, 10);
+}
+
+static void ssd1306_I2C_WriteMulti(uint8_t address, uint8_t reg, uint8_t *data, uint16_t count)
+{
+    uint8_t dt[256];
+    dt[0] = reg;
+    memcpy(dt + 1, data, count);
+    HAL_I2C_Master_Transmit(&hi2c1, address, dt, count + 1, 10);
+}
+
+#define SSD1306_WRITECOMMAND(command)   ssd1306_I2C_Write(SSD1306_I2C_ADDR, 0x00, (command))
+
+uint8_t SSD1306_Init(void)
+{
+    static const uint8_t init_cmds[] = {
+        0xAE, 0x20, 0x10, 0xB0, 0xC8, 0x00, 0x10, 0x40, 0x81, 0xFF, 0xA1, 0xA6,
+        0xA8, 0x3F, 0xA4, 0xD3, 0x00, 0xD5, 0xF0, 0xD9, 0x22, 0xDA, 0x12, 0xDB,
+        0x20, 0x8D, 0x14, 0xAF, 0x2E
+    };
+
+    if (HAL_I2C_IsDeviceReady(&hi2c1, SSD1306_I2C_ADDR, 1, 20000) != HAL_OK)
+        return 0;
+    HostOs_Busy(100);       // 원본의 2500 회 빈 루프
+
+    for (size_t i = 0; i < sizeof(init_cmds); i++)
+        SSD1306_WRITECOMMAND(init_cmds[i]);
+
+    SSD1306_Fill(SSD1306_COLOR_BLACK);
+    SSD1306_UpdateScreen();
+
+    SSD1306.CurrentX = 0;
+    SSD1306.CurrentY = 0;
+    SSD1306.Initialized = 1;
+    return 1;
+}
+
+void SSD1306_UpdateScreen(void)
+{
+    for (uint8_t m = 0; m < 8; m++) {
+        SSD1306_WRITECOMMAND(0xB0 + m);
+        SSD1306_WRITECOMMAND(0x00);
+        SSD1306_WRITECOMMAND(0x10);
+        ssd1306_I2C_WriteMulti(SSD1306_I2C_ADDR, 0x40, &SSD1306_Buffer[SSD1306_WIDTH * m], SSD1306_WIDTH);
+    }
+}
+
+void SSD1306_ToggleInvert(void)
+{
+    SSD1306.Inverted = !SSD1306.Inverted;
+    for (size_t i = 0; i < sizeof(SSD1306_Buffer); i++)
+        SSD1306_Buffer[i] = ~SSD1306_Buffer[i];
+}
+
+void SSD1306_Fill(SSD1306_COLOR_t color)
+{
+    memset(SSD1306_Buffer, (color == SSD1306_COLOR_BLACK) ? 0x00 : 0xFF, sizeof(SSD1306_Buffer));
+}
+
+void SSD1306_DrawPixel(uint16_t x, uint16_t y, SSD1306_COLOR_t color)
+{
+    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+        return;
+    if (SSD1306.Inverted)
+        color = (SSD1306_COLOR_t)!color;
+    if (color == SSD1306_COLOR_WHITE)
+        SSD1306_Buffer[x + (y / 8) * SSD1306_WIDTH] |= 1 << (y % 8);
+    else
+        SSD1306_Buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
+}
+
+void SSD1306_GotoXY(uint16_t x, uint16_t y)
+{
+    SSD1306.CurrentX = x;
+    SSD1306.CurrentY = y;
+}
+
+char SSD1306_Putc(char ch, FontDef_t *Font, SSD1306_COLOR_t color)
+{
+    uint32_t i, b, j;
+
+    if (SSD1306_WIDTH <= (SSD1306.CurrentX + Font->FontWidth) ||
+        SSD1306_HEIGHT <= (SSD1306.CurrentY + Font->FontHeight))
+        return 0;
+    if (ch < 32 || ch > 126)
+        ch = '?';
+
+    for (i = 0; i < Font->FontHeight; i++) {
+        b = Font->data[(ch - 32) * Font->FontHeight + i];
+        for (j = 0; j < Font->FontWidth; j++) {
+            if ((b << j) & 0x8000)
+                SSD1306_DrawPixel(SSD1306.CurrentX + j, SSD1306.CurrentY + i, color);
+            else
+                SSD1306_DrawPixel(SSD1306.CurrentX + j, SSD1306.CurrentY + i, (SSD1306_COLOR_t)!color);
+        }
+    }
+    SSD1306.CurrentX += Font->FontWidth;
+    return ch;
+}
+
+char SSD1306_Puts(char *str, FontDef_t *Font, SSD1306_COLOR_t color)
+{
+    while (*str) {
+        if (SSD1306_Putc(*str, Font, color) != *str)
+            return *str;
+        str++;
+    }
+    return *str;
+}
+
+uint8_t *SSD1306_GetBuffer(void)
+{
+    return SSD1306_Buffer;
+}
@@ -0,0 +1,89 @@
+// stack_size.cpp
+// 펌웨어를 host_os 시뮬레이터에서 최악 입력으로 돌리고 태스크별 스택 최소 크기를 추천
+//
+// 빌드 (sys.c 기준, FREE_RTOS.c 는 free_rtos_graph.cpp 와 함께 같은 방식). 로그는 타깃 기본인 바이너리
+// DLOG 로 (-DDLOG_TEXT=0): 호스트 기본인 텍스트 DLOG 는 vsnprintf 가 로그 찍는 태스크마다 스택을 크게 먹는다
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -DDLOG_TEXT=0 -I Test -I Test/host -Dmain=firmware_main
+//       Test/sys.c Test/sys_pipeline.c Test/stack_mon.c Test/rt_stats.c Test/rules.c Test/sensor_rec.c Test/dlog.c Test/periodic.c
+//   g++ -c -O2 -std=c++17 -DHOST_BUILD -DDLOG_TEXT=0 -I Test -I Test/host Test/calib.cpp Test/board.cpp Test/host/bsp_host.cpp Test/pwm_fade.cpp
+//   g++ -c -O2 -std=c++17 -fshort-enums -DHOST_BUILD -DDLOG_TEXT=0 -I Test -I Test/host Test/sys_graph.cpp
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -I Test/host Test/host/stack_size.cpp *.o -pthread -Wl,-z,now -o stack_size
+// 사용: ./stack_size [-s 가상초] [-k 환산비율] [-m 여유비율]
+//
+// 호스트(64비트 glibc) 측정값을 HOST_STACK_SCALE 로 32비트 타깃에 환산한 추정치이므로
+// 최종 확인은 타깃에서 StackMon 리포트로 한다.
+#include "host_os.h"
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" int firmware_main(void);
+
+// 스레드 진입 시 Cortex-M3 가 태스크 스택에 쌓는 문맥 (하드웨어 8 + 소프트웨어 8 + EXC_RETURN)
+static const uint32_t kContextWords = 17;
+static const uint32_t kMinWords = 64;
+
+// 최악 경로: 자릿수가 가장 긴 값과 임계값 양쪽을 번갈아 넣는다
+static uint16_t WorstCaseAdc(uint64_t now_us, void *ctx)
+{
+    (void)ctx;
+    static const uint16_t pattern[] = { 4095, 0, 2001, 1999, 4095, 1000 };
+    return pattern[(now_us / 1000) % (sizeof(pattern) / sizeof(pattern[0]))];
+}
+
+static void QuietUart(uint64_t, const uint8_t *, uint16_t len, void *ctx)
+{
+    *(uint64_t*)ctx += len;
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 60;
+    double scale = HOST_STACK_SCALE;
+    double margin = 1.25;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:k:m:")) != -1) {
+        switch (opt) {
+            case 's': seconds = atof(optarg); break;
+            case 'k': scale = atof(optarg); break;
+            case 'm': margin = atof(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-s sec] [-k scale] [-m margin]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    uint64_t uart_bytes = 0;
+    HostOs_SetAdc(WorstCaseAdc, nullptr);
+    HostOs_SetUart(QuietUart, &uart_bytes);
+    if (HostOs_Run(firmware_main, (uint64_t)(seconds * 1e6)) != 0) {
+        fprintf(stderr, "osKernelStart 에 도달하지 못함\n");
+        return 1;
+    }
+
+    printf("%-14s %5s %9s %10s %9s %9s\n",
+           "task", "prio", "declared", "host used", "est used", "recommend");
+    long saved_words = 0;
+    for (int i = 0; i < HostOs_TaskCount(); i++) {
+        HostTaskInfo ti;
+        HostOs_GetTaskInfo(i, &ti);
+        uint32_t est = (uint32_t)std::ceil((double)ti.stack_used_bytes * scale / 4.0);
+        uint32_t rec = (uint32_t)std::ceil(est * margin) + kContextWords;
+        rec = (rec + 7) & ~7u;
+        if (rec < kMinWords) rec = kMinWords;
+        saved_words += (long)ti.stack_words - (long)rec;
+
+        printf("%-14s %5d %7u w %8zu B %7u w %7u w%s\n",
+               ti.name, ti.priority, ti.stack_words, ti.stack_used_bytes, est, rec,
+               rec > ti.stack_words ? "  ** 부족 **" : "");
+    }
+    printf("UART %llu bytes in %.0f s (가상)\n", (unsigned long long)uart_bytes, seconds);
+    printf("권장값 적용 시 %+ld words (%+ld bytes)\n", saved_words, saved_words * 4);
+    return 0;
+}
@@ -0,0 +1,144 @@
+// text_bench.cpp
+// sub.c 의 OLED 두 줄 그리기: 예전 Fill + Puts 경로와 oled_text 글자 캐시 경로를 비교
+// 같은 문자열 열을 양쪽에 넣고 프레임당 시간(호스트 ns, TSC 사이클)과 프레임버퍼에 쓴 바이트,
+// 결과 화면이 같은지 확인한다.
+//
+// 빌드:
+//   gcc -c -O2 -fshort-enums -DHOST_BUILD -I Test -I Test/host Test/oled_text.c
+//   gcc -c -O2 -fshort-enums -I Test/host Test/host/ssd1306_host.c Test/host/host_os.c Test/host/host_hal.c
+//   g++ -O2 -std=c++17 -I Test -I Test/host Test/host/text_bench.cpp *.o -pthread -o text_bench
+// 사용: ./text_bench [-n 프레임]
+#include "host_os.h"
+#include "main.h"
+#include "ssd1306.h"
+extern "C" {
+#include "oled_text.h"
+}
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+I2C_HandleTypeDef hi2c1;
+
+struct Frame {
+    char line1[32];
+    char line2[32];
+};
+
+// sub.c Job_Oled 와 같은 모양: 5 Hz 로 ADC 가 조금씩 움직이고 시각은 1 초마다
+static std::vector<Frame> MakeFrames(int n)
+{
+    std::vector<Frame> frames(n);
+    uint32_t adc = 2048;
+    uint32_t rng = 1;
+    for (int i = 0; i < n; i++) {
+        rng = rng * 1103515245u + 12345u;
+        adc = (adc + ((rng >> 16) % 41) - 20) & 0x0FFF;
+        int s = 12 * 3600 + i / 5;
+        snprintf(frames[i].line1, sizeof(frames[i].line1), "ADC: %4u", adc);
+        snprintf(frames[i].line2, sizeof(frames[i].line2), "Time: %02d:%02d:%02d",
+                 (s / 3600) % 24, (s / 60) % 60, s % 60);
+    }
+    return frames;
+}
+
+static inline uint64_t Tsc()
+{
+#ifdef HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct Result {
+    double ns_per_frame;
+    double tsc_per_frame;
+    double bytes_per_frame;
+};
+
+template <typename DrawFn>
+static Result Run(const std::vector<Frame> &frames, DrawFn draw)
+{
+    uint8_t *fb = SSD1306_GetBuffer();
+    std::vector<uint8_t> prev(fb, fb + 1024);
+    uint64_t changed = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t c0 = Tsc();
+    for (const Frame &f : frames)
+        draw(f);
+    uint64_t c1 = Tsc();
+    auto t1 = std::chrono::steady_clock::now();
+
+    // 바이트 수는 따로 한 번 더 돌려 센다 (시간 측정에 섞이지 않게)
+    for (const Frame &f : frames) {
+        draw(f);
+        for (int i = 0; i < 1024; i++) {
+            if (fb[i] != prev[i]) changed++;
+            prev[i] = fb[i];
+        }
+    }
+
+    double n = (double)frames.size();
+    return { std::chrono::duration<double, std::nano>(t1 - t0).count() / n,
+             (double)(c1 - c0) / n, (double)changed / n };
+}
+
+int main(int argc, char **argv)
+{
+    int n = 20000;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+            case 'n': n = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-n frames]\n", argv[0]);
+                return 1;
+        }
+    }
+    std::vector<Frame> frames = MakeFrames(n);
+
+    // 예전 경로 (글자 위치만 페이지 경계에 맞춤: y 0, 16)
+    auto puts_path = [](const Frame &f) {
+        SSD1306_Fill(SSD1306_COLOR_BLACK);
+        SSD1306_GotoXY(0, 0);
+        SSD1306_Puts((char*)f.line1, &Font_7x10, SSD1306_COLOR_WHITE);
+        SSD1306_GotoXY(0, 16);
+        SSD1306_Puts((char*)f.line2, &Font_7x10, SSD1306_COLOR_WHITE);
+    };
+    Result a = Run(frames, puts_path);
+    std::vector<uint8_t> ref(SSD1306_GetBuffer(), SSD1306_GetBuffer() + 1024);
+
+    static uint8_t cache[OLED_TEXT_CACHE_BYTES(7, 10)];
+    OledFont font;
+    OledTextSlot s1, s2;
+    OledText_InitFont(&font, &Font_7x10, cache);
+    OledText_InitSlot(&s1, &font, 0, 0);
+    OledText_InitSlot(&s2, &font, 0, 2);
+    uint64_t glyphs = 0;
+    auto cache_path = [&](const Frame &f) {
+        glyphs += OledText_Draw(&s1, f.line1);
+        glyphs += OledText_Draw(&s2, f.line2);
+    };
+    SSD1306_Fill(SSD1306_COLOR_BLACK);
+    Result b = Run(frames, cache_path);
+    bool same = memcmp(ref.data(), SSD1306_GetBuffer(), 1024) == 0;
+
+    printf("%d frames (2 lines, Font_7x10)\n", n);
+    printf("%-14s %10s %12s %12s\n", "path", "ns/frame", "tsc/frame", "fb changed");
+    printf("%-14s %10.1f %12.0f %12.1f\n", "Fill+Puts", a.ns_per_frame, a.tsc_per_frame, a.bytes_per_frame);
+    printf("%-14s %10.1f %12.0f %12.1f\n", "glyph cache", b.ns_per_frame, b.tsc_per_frame, b.bytes_per_frame);
+    printf("speedup x%.1f, %.2f glyphs redrawn/frame, final screen %s\n",
+           a.ns_per_frame / b.ns_per_frame, glyphs / (2.0 * n), same ? "identical" : "DIFFERENT");
+    return same ? 0 : 1;
+}
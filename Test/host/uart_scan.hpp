@@ -0,0 +1,276 @@
+// uart_scan.hpp
+// 보드 UART 스트림 풀기 (host 도구 공용: ingest, mqtt_gw, dlog_decode)
+//
+//   글자 줄: "ADC: %u"                 FREE_RTOS.c, sub.c (RTC 전)
+//            "Sensor: %u"              sys.c
+//            "[hh:mm:ss] ADC: %lu"     sub.c (보드 시각은 clock 으로 초)
+//   바이너리 프레임 0xA5 0x5A type n:
+//            'L' dlog       펌웨어 ELF 의 dlog_fmt 섹션으로 글자 줄로 되돌려서 위와 똑같이 푼다
+//                           (DLOG_TEXT=0 인 타깃 빌드의 기본 출력. ELF 가 없으면 건너뛰고 셈)
+//            'R' rt_stats, 'S' sensor_rec, 'H' history   길이만큼 건너뜀
+//
+// 스캐너는 읽은 버퍼 안에서 바로 푼다 (줄 복사나 문자열 할당 없음, 'L' 프레임만 임시 문자열 하나).
+// 줄 끝은 memchr (glibc 가 SIMD 로 찾음), 머리("ADC: ", "Sensor: ", "[..:..:..] ")는 고정 길이 비교라
+// 워드 비교로 컴파일되고, 숫자는 분기 없는 곱셈-덧셈 루프.
+//
+// dlog.h 가 필요하므로 -I Test.
+#ifndef UART_SCAN_HPP
+#define UART_SCAN_HPP
+
+#include "dlog.h"
+
+#include <elf.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// --- 글자 줄 ---
+enum Kind : uint8_t { KIND_NONE, KIND_ADC, KIND_SENSOR };
+
+static const uint32_t kNoClock = 0xFFFFFFFFu;
+
+static inline bool Digit(char c) { return (unsigned)(c - '0') < 10u; }
+
+// [p, end) 한 줄 ('\n' 빼고). 푼 값이면 true, 보드 시각이 없으면 clock = kNoClock
+static inline bool ParseLine(const char *p, const char *end, uint8_t &kind, uint32_t &clock, uint32_t &value)
+{
+    if (end > p && end[-1] == '\r')
+        end--;
+    clock = kNoClock;
+    if (end - p >= 11 && p[0] == '[' && p[3] == ':' && p[6] == ':' && p[9] == ']' && p[10] == ' ') {
+        if (!(Digit(p[1]) && Digit(p[2]) && Digit(p[4]) && Digit(p[5]) && Digit(p[7]) && Digit(p[8])))
+            return false;
+        clock = (uint32_t)(((p[1] - '0') * 10 + (p[2] - '0')) * 3600 + ((p[4] - '0') * 10 + (p[5] - '0')) * 60 +
+                           (p[7] - '0') * 10 + (p[8] - '0'));
+        p += 11;
+    }
+    if (end - p >= 6 && memcmp(p, "ADC: ", 5) == 0) {
+        kind = KIND_ADC;
+        p += 5;
+    } else if (end - p >= 9 && memcmp(p, "Sensor: ", 8) == 0) {
+        kind = KIND_SENSOR;
+        p += 8;
+    } else {
+        return false;
+    }
+    // 숫자만, 10 자리까지 (uint32 넘으면 버림)
+    if (end - p > 10 || p == end)
+        return false;
+    uint64_t v = 0;
+    for (; p < end; p++) {
+        if (!Digit(*p))
+            return false;
+        v = v * 10 + (uint64_t)(*p - '0');
+    }
+    if (v > 0xFFFFFFFFu)
+        return false;
+    value = (uint32_t)v;
+    return true;
+}
+
+// --- dlog_fmt 섹션 (펌웨어 ELF) ---
+// ELF32 (Cortex-M) / ELF64 (호스트 빌드) 모두, 리틀 엔디언만. out 은 섹션 내용 + '\0'
+template <typename Ehdr, typename Shdr>
+static bool DlogFmtSection(const std::vector<uint8_t> &elf, std::vector<char> &out)
+{
+    if (elf.size() < sizeof(Ehdr)) return false;
+    const Ehdr *eh = (const Ehdr*)elf.data();
+    if (eh->e_shoff == 0 || eh->e_shoff + (uint64_t)eh->e_shnum * sizeof(Shdr) > elf.size() ||
+        eh->e_shstrndx >= eh->e_shnum)
+        return false;
+    const Shdr *sh = (const Shdr*)(elf.data() + eh->e_shoff);
+    const Shdr &strtab = sh[eh->e_shstrndx];
+    for (int i = 0; i < eh->e_shnum; i++) {
+        if (sh[i].sh_name >= strtab.sh_size)
+            continue;
+        const char *sec = (const char*)elf.data() + strtab.sh_offset + sh[i].sh_name;
+        if (strcmp(sec, "dlog_fmt") != 0)
+            continue;
+        if (sh[i].sh_type == SHT_NOBITS || sh[i].sh_offset + sh[i].sh_size > elf.size())
+            return false;       // NOLOAD 로 링크하면 내용이 파일에 없음: INFO 로 해야 함
+        out.assign(elf.begin() + (long)sh[i].sh_offset, elf.begin() + (long)(sh[i].sh_offset + sh[i].sh_size));
+        out.push_back('\0');
+        return true;
+    }
+    return false;
+}
+
+static bool DlogLoadElf(const char *path, std::vector<char> &fmt)
+{
+    std::vector<uint8_t> elf;
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        elf.insert(elf.end(), buf, buf + n);
+    fclose(f);
+    if (elf.size() < EI_NIDENT || memcmp(elf.data(), ELFMAG, SELFMAG) != 0 || elf[EI_DATA] != ELFDATA2LSB)
+        return false;
+    if (elf[EI_CLASS] == ELFCLASS32)
+        return DlogFmtSection<Elf32_Ehdr, Elf32_Shdr>(elf, fmt);
+    return DlogFmtSection<Elf64_Ehdr, Elf64_Shdr>(elf, fmt);
+}
+
+// 못 읽었을 때 알림 (도구마다 같은 말)
+static inline void DlogLoadError(const char *path)
+{
+    fprintf(stderr, "%s: dlog_fmt 섹션을 못 찾음 (DLOG_TEXT=0 빌드인지, 링커 스크립트에 넣었다면 NOLOAD 가 아닌 INFO 인지 확인)\n", path);
+}
+
+// --- 'L' 레코드 풀기 ---
+static inline bool DlogGetLeb(const uint8_t *&p, const uint8_t *end, uint32_t &v)
+{
+    v = 0;
+    for (int shift = 0; p < end && shift < 35; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7Fu) << shift;
+        if (!(b & 0x80u))
+            return true;
+    }
+    return false;
+}
+
+// 포맷 하나를 인자 읽어가며 out 에 덧붙임. 실패하면 false (프레임의 나머지는 버림)
+static bool DlogRender(const char *fmt, const uint8_t *&p, const uint8_t *end, std::string &out)
+{
+    char spec[32], tmp[64];
+    for (const char *f = fmt; *f; f++) {
+        if (*f != '%') {
+            out += *f;
+            continue;
+        }
+        if (f[1] == '%') {
+            out += '%';
+            f++;
+            continue;
+        }
+        // %[flags][width][.prec][length]conv, 길이 수식자는 빼고 32 비트로 찍음
+        size_t n = 0;
+        spec[n++] = '%';
+        f++;
+        while (*f && strchr("-+ #0", *f) && n < 8) spec[n++] = *f++;
+        while (*f >= '0' && *f <= '9' && n < 16) spec[n++] = *f++;
+        if (*f == '.') {
+            spec[n++] = *f++;
+            while (*f >= '0' && *f <= '9' && n < 24) spec[n++] = *f++;
+        }
+        while (*f && strchr("hlzjtL", *f)) f++;
+        char conv = *f;
+        if (!conv || !strchr("diuxXoc", conv))
+            return false;
+        spec[n++] = conv;
+        spec[n] = '\0';
+        uint32_t v;
+        if (!DlogGetLeb(p, end, v))
+            return false;
+        if (conv == 'd' || conv == 'i')
+            snprintf(tmp, sizeof(tmp), spec, (int)(int32_t)v);
+        else if (conv == 'c')
+            snprintf(tmp, sizeof(tmp), spec, (int)(char)v);
+        else
+            snprintf(tmp, sizeof(tmp), spec, (unsigned)v);
+        out += tmp;
+    }
+    return true;
+}
+
+// 'L' 프레임 내용 [p, end) 를 글자로 out 에 덧붙임. 푼 레코드 수, 깨진 레코드에서 멈췄으면 bad = true
+static uint32_t DlogRenderFrame(const std::vector<char> &fmt, const uint8_t *p, const uint8_t *end, std::string &out,
+                                bool &bad)
+{
+    uint32_t records = 0;
+    bad = false;
+    while (p < end) {
+        uint32_t id;
+        if (!DlogGetLeb(p, end, id) || id >= fmt.size() - 1 || !DlogRender(&fmt[id], p, end, out)) {
+            bad = true;
+            break;
+        }
+        records++;
+    }
+    return records;
+}
+
+// --- 프레임 ---
+// 머리 0xA5 0x5A type n 다음 전체 길이 ('R' 만 n 이 태스크 수)
+static inline size_t FrameBytes(uint8_t type, uint8_t n)
+{
+    return type == 'R' ? 4 + 4 + (size_t)n * 10 + 1 : 4 + (size_t)n + 1;
+}
+
+static inline bool FrameSumOk(const uint8_t *f, size_t bytes)
+{
+    uint8_t sum = 0;
+    for (size_t k = 2; k < bytes - 1; k++)
+        sum += f[k];
+    return sum == f[bytes - 1];
+}
+
+// --- 스캐너 ---
+struct ScanCounts {
+    uint64_t frames = 0;        // 바이너리 프레임 전부
+    uint64_t dlog = 0;          // 그중 글자로 푼 'L'
+    uint64_t dlog_skipped = 0;  // ELF 가 없어 건너뛴 'L'
+    uint64_t bad = 0;           // 체크섬이 틀리거나 레코드가 깨진 'L'
+};
+
+// b[0, len) 안의 완성된 줄과 프레임을 처리하고 쓴 바이트 수를 돌려준다 (남은 조각은 다음 read 뒤에 다시).
+// 글자 줄과 'L' 프레임에서 나온 줄 모두 on_line(p, end) 로 ('\n' 빼고). fmt 가 비었으면 'L' 도 건너뜀.
+// tmp 는 'L' 프레임을 글자로 만들 자리 (부르는 쪽이 들고 있어 할당이 한 번뿐)
+template <typename OnLine>
+static size_t ScanUart(const char *b, size_t len, const std::vector<char> &fmt, std::string &tmp, ScanCounts &c,
+                       OnLine on_line)
+{
+    size_t pos = 0;
+    while (pos < len) {
+        if ((uint8_t)b[pos] == 0xA5) {
+            if (len - pos < 4)
+                break;
+            if ((uint8_t)b[pos + 1] == 0x5A) {
+                uint8_t type = (uint8_t)b[pos + 2];
+                size_t flen = FrameBytes(type, (uint8_t)b[pos + 3]);
+                if (len - pos < flen)
+                    break;
+                c.frames++;
+                if (type == DLOG_FRAME_TYPE && fmt.empty()) {
+                    c.dlog_skipped++;
+                } else if (type == DLOG_FRAME_TYPE) {
+                    const uint8_t *f = (const uint8_t*)b + pos;
+                    bool bad = !FrameSumOk(f, flen);
+                    tmp.clear();
+                    if (!bad)
+                        DlogRenderFrame(fmt, f + 4, f + flen - 1, tmp, bad);
+                    if (bad)
+                        c.bad++;
+                    else
+                        c.dlog++;
+                    // 깨진 레코드 앞까지 만든 줄은 그대로 씀
+                    const char *p = tmp.data(), *end = p + tmp.size();
+                    while (p < end) {
+                        const char *nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+                        if (!nl) {
+                            on_line(p, end);
+                            break;
+                        }
+                        on_line(p, nl);
+                        p = nl + 1;
+                    }
+                }
+                pos += flen;
+                continue;
+            }
+        }
+        const char *nl = (const char*)memchr(b + pos, '\n', len - pos);
+        if (!nl)
+            break;
+        on_line(b + pos, nl);
+        pos = (size_t)(nl - b) + 1;
+    }
+    return pos;
+}
+
+#endif // UART_SCAN_HPP
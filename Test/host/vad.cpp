@@ -0,0 +1,745 @@
+// vad.cpp
+// ai.py 앞단: 마이크 스트림에서 말한 구간만 잘라 바로 넘기는 음성 구간 검출 (VAD)
+//
+// ai.py 는 매번 r.adjust_for_ambient_noise(source, 2) 로 2 초를 쓰고, 말이 끝난 뒤에도
+// pause_threshold = 1.2 초를 더 기다린 다음에야 인식을 시작한다 (명령 하나에 3 초 넘게 아무 일도 안 함).
+// 여기서는
+//   - 소음 바닥을 한 번만 잡고 (처음 100 ms) 계속 따라감: 말이 아닌 프레임에서 내려갈 땐 빨리,
+//     올라갈 땐 천천히. 말하는 중에도 최근 1 초의 하위 에너지가 바닥보다 확실히 높으면
+//     (선풍기가 켜졌다든지) 바닥을 거기로 옮김
+//   - 10 ms 프레임마다 에너지 (dBFS, 최근 30 ms 평균) 와 영교차율: 바닥 + on_db 넘으면 말, 또는 조금 넘으면서
+//     영교차율이 높으면 (ㅅ, ㅊ 같은 마찰음) 말. 말하는 중에는 off_db 로 낮춰서 (히스테리시스)
+//   - 시작: 최근 5 프레임 중 3 프레임이 말이면 바로 (앞 150 ms 를 같이 붙여서 첫 자음이 안 잘리게)
+//   - 끝: 말이 아닌 프레임이 hang (기본 300 ms) 이어지면 바로 끊어서 넘김. 구간 끝은 마지막 말 프레임 + 50 ms
+//   - 150 ms 보다 짧은 건 버림 (딸깍 소리), 10 초 넘으면 끊고 바닥을 다시 잡음
+//
+// 한계: 에너지 기반이라 SNR 이 낮으면 (-T 의 8 dB, 작게 말한 발화는 2 dB 까지) 놓치거나 꼬리가 잘린다
+//
+// 넘기기: 줄 단위로 stdout 에 (ai.py 가 파이프로 읽어서 sr.AudioFile(경로) 로 인식)
+//   start <n> <결정 시각 s>
+//   utt <n> <시작 s> <끝 s> <결정 시각 s> [파일]      (-o 접두어면 접두어_NNN.wav 로 저장)
+//
+// 빌드: g++ -O2 -std=c++17 Test/host/vad.cpp -o vad
+// 사용:
+//   ./vad [-o utt] [-l labels.txt] [-H hang_ms] [-N on_db] [-F off_db] [-v] in.wav
+//   arecord -q -f S16_LE -r 16000 -c 1 | ./vad -r 16000 -o /tmp/utt -      (raw s16le 스트림)
+//   ./vad -T [-s seed] [-g synth.wav] [-N on_db] [-F off_db]
+//       합성 말소리 (유성음 + 마찰음 + 단어 사이 쉼) 를 여러 소음 조건에서 만들어서 hang 값별 VAD 와
+//       ai.py (speech_recognition 의 adjust_for_ambient_noise + listen 동작을 그대로 흉내) 를 비교:
+//       찾음 / 놓침 / 헛검출 / 쪼개짐, 시작 결정 지연, 끝 결정 지연 (말 끝 → 넘긴 시각) 백분위, 잘림
+// labels.txt 는 Audacity 레이블 꼴 ("시작초<TAB>끝초[<TAB>글]"), 있으면 실제 WAV 로 같은 지표를 낸다.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// --- WAV ---
+static bool ReadWav(const char *path, std::vector<int16_t> &out, int &rate)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char riff[12];
+    if (fread(riff, 1, 12, f) != 12 || memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) {
+        fprintf(stderr, "%s: not a WAV file\n", path);
+        fclose(f);
+        return false;
+    }
+    int channels = 0, bits = 0;
+    for (;;) {
+        char id[4];
+        uint32_t len;
+        if (fread(id, 1, 4, f) != 4 || fread(&len, 4, 1, f) != 1)
+            break;
+        if (memcmp(id, "fmt ", 4) == 0) {
+            uint8_t fmt[40] = {};
+            if (fread(fmt, 1, std::min<uint32_t>(len, 40), f) < 16)
+                break;
+            if (len > 40)
+                fseek(f, (long)(len - 40), SEEK_CUR);
+            uint16_t tag = (uint16_t)(fmt[0] | fmt[1] << 8);
+            channels = fmt[2] | fmt[3] << 8;
+            rate = (int)(fmt[4] | fmt[5] << 8 | fmt[6] << 16 | (uint32_t)fmt[7] << 24);
+            bits = fmt[14] | fmt[15] << 8;
+            if ((tag != 1 && tag != 0xFFFE) || bits != 16 || channels < 1) {
+                fprintf(stderr, "%s: only 16-bit PCM is supported\n", path);
+                fclose(f);
+                return false;
+            }
+        } else if (memcmp(id, "data", 4) == 0 && channels) {
+            std::vector<int16_t> raw(len / 2);
+            raw.resize(fread(raw.data(), 2, raw.size(), f));
+            out.resize(raw.size() / (size_t)channels);
+            for (size_t i = 0; i < out.size(); i++) {
+                int32_t s = 0;
+                for (int c = 0; c < channels; c++)
+                    s += raw[i * (size_t)channels + (size_t)c];
+                out[i] = (int16_t)(s / channels);    // 여러 채널이면 평균
+            }
+            fclose(f);
+            return true;
+        } else {
+            fseek(f, (long)(len + (len & 1)), SEEK_CUR);
+        }
+    }
+    fprintf(stderr, "%s: no PCM data\n", path);
+    fclose(f);
+    return false;
+}
+
+static bool WriteWav(const char *path, const int16_t *x, size_t n, int rate)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    uint32_t data = (uint32_t)(n * 2), riff = 36 + data, fmt_len = 16, byte_rate = (uint32_t)rate * 2;
+    uint16_t tag = 1, ch = 1, align = 2, bits = 16;
+    fwrite("RIFF", 1, 4, f);
+    fwrite(&riff, 4, 1, f);
+    fwrite("WAVEfmt ", 1, 8, f);
+    fwrite(&fmt_len, 4, 1, f);
+    fwrite(&tag, 2, 1, f);
+    fwrite(&ch, 2, 1, f);
+    fwrite(&rate, 4, 1, f);
+    fwrite(&byte_rate, 4, 1, f);
+    fwrite(&align, 2, 1, f);
+    fwrite(&bits, 2, 1, f);
+    fwrite("data", 1, 4, f);
+    fwrite(&data, 4, 1, f);
+    fwrite(x, 2, n, f);
+    fclose(f);
+    return true;
+}
+
+// --- VAD ---
+struct VadConfig {
+    int rate = 16000;
+    int frame_ms = 10;
+    float on_db = 3;            // 바닥보다 이만큼 크면 말 (30 ms 평균이라 잡음만으로는 1 dB 안쪽에서 흔들림)
+    float off_db = 3;           // 말하는 중에는 이만큼만 넘어도 말
+    float fric_db = 4;          // 이만큼 넘고
+    float fric_zcr = 0.4f;      // 영교차율이 이 이상이면 마찰음
+    int start_frames = 3;       // 최근 start_window 프레임 중 이만큼이 말이면 시작
+    int start_window = 5;
+    int hang_ms = 300;          // 말이 아닌 게 이만큼 이어지면 끝 (단어 사이 쉼보다 길게)
+    int tail_ms = 50;           // 구간 끝에 붙이는 여유
+    int preroll_ms = 150;       // 시작 앞에 붙이는 여유
+    int min_utt_ms = 150;
+    int max_utt_ms = 10000;
+    int seed_ms = 100;          // 처음 바닥 잡는 구간
+    int rebase_ms = 1000;       // 말하는 중 바닥 다시 잡기 창
+};
+
+struct VadEvent {
+    enum Type { START, END, DROP } type;
+    int n;                      // 구간 번호
+    int64_t at;                 // 결정한 시각 (샘플, 스트림 처음부터)
+    int64_t begin, end;         // 구간 (샘플, END / DROP)
+    const std::vector<int16_t> *audio;      // 구간 샘플 (END)
+};
+
+class Vad {
+public:
+    explicit Vad(const VadConfig &c)
+        : c_(c), flen_(c.rate * c.frame_ms / 1000), hang_(c.hang_ms / c.frame_ms),
+          recent_((size_t)std::max(1, c.rebase_ms / c.frame_ms), 0.f)
+    {
+        frame_.reserve((size_t)flen_);
+    }
+
+    template <class F> void Push(const int16_t *x, size_t n, F &&on_event)
+    {
+        for (size_t i = 0; i < n; i++) {
+            frame_.push_back(x[i]);
+            if ((int)frame_.size() == flen_) {
+                Frame(on_event);
+                frame_.clear();
+            }
+        }
+    }
+
+    // 스트림 끝: 말하는 중이면 지금 끊음
+    template <class F> void Finish(F &&on_event)
+    {
+        if (in_utt_)
+            End(on_event);
+    }
+
+    float Floor() const { return floor_db_; }
+    float LastDb() const { return last_db_; }
+    float LastZcr() const { return last_zcr_; }
+    bool InUtterance() const { return in_utt_; }
+
+private:
+    template <class F> void Frame(F &&on_event)
+    {
+        // DC 막기 (한 극 고역 통과) 뒤 에너지와 영교차율
+        double sum = 0;
+        int zc = 0;
+        float prev = 0;
+        for (int i = 0; i < flen_; i++) {
+            float x = frame_[(size_t)i];
+            float y = x - dc_x_ + 0.995f * dc_y_;
+            dc_x_ = x;
+            dc_y_ = y;
+            sum += (double)y * y;
+            if (i > 0 && ((y >= 0) != (prev >= 0)))
+                zc++;
+            prev = y;
+        }
+        // 판정은 최근 3 프레임 (30 ms) 평균 전력으로: 잡음이 한 프레임 튀어서 끝 대기가 다시 시작되지 않게
+        double pw = sum / flen_ / (32768.0 * 32768.0);
+        pw_[pw_pos_++ % 3] = pw;
+        float db = (float)(10.0 * log10((pw_[0] + pw_[1] + pw_[2]) / 3 + 1e-10));
+        float zcr = (float)zc / (float)(flen_ - 1);
+        last_db_ = db;
+        last_zcr_ = zcr;
+        recent_[recent_pos_++ % recent_.size()] = db;
+
+        // 프리롤 링 (시작 창 + preroll)
+        for (int16_t s : frame_)
+            pre_.push_back(s);
+        size_t pre_max = (size_t)(c_.rate * c_.preroll_ms / 1000 + c_.start_window * flen_);
+        while (pre_.size() > pre_max)
+            pre_.pop_front();
+
+        int64_t frame_end = pos_ + flen_;
+        if (frames_++ < c_.seed_ms / c_.frame_ms) {
+            seed_sum_ += db;
+            floor_db_ = (float)(seed_sum_ / frames_);
+            pos_ = frame_end;
+            return;
+        }
+
+        float over = db - floor_db_;
+        bool speech = over > (in_utt_ ? c_.off_db : c_.on_db) || (over > c_.fric_db && zcr >= c_.fric_zcr);
+
+        if (!in_utt_) {
+            window_ = ((window_ << 1) | (speech ? 1u : 0u)) & ((1u << c_.start_window) - 1);
+            if (over < c_.off_db) {
+                // 바닥 따라가기: 내려갈 땐 빨리, 올라갈 땐 천천히 (약 0.5 s). 말 같은 프레임에서는 멈춤
+                floor_db_ += (db - floor_db_) * (db < floor_db_ ? 0.3f : 0.02f);
+            }
+            if (__builtin_popcount(window_) >= c_.start_frames) {
+                in_utt_ = true;
+                utt_.assign(pre_.begin(), pre_.end());
+                begin_ = frame_end - (int64_t)utt_.size();
+                last_speech_end_ = frame_end;
+                quiet_ = 0;
+                window_ = 0;
+                on_event(VadEvent{ VadEvent::START, count_ + 1, frame_end, begin_, 0, nullptr });
+            }
+        } else {
+            utt_.insert(utt_.end(), frame_.begin(), frame_.end());
+            if (speech) {
+                last_speech_end_ = frame_end;
+                quiet_ = 0;
+            } else {
+                quiet_++;
+            }
+            // 말하는 중에도 최근 1 초의 하위 10% 가 바닥보다 확실히 높으면 소음이 커진 것 (말에는 늘 틈이 있음).
+            // 바닥은 하위 30% 로 (최소로 잡으면 새 잡음이 계속 off_db 를 넘어서 끝나지 않음)
+            if (recent_pos_ >= recent_.size()) {
+                sorted_ = recent_;
+                size_t n10 = sorted_.size() / 10, n30 = sorted_.size() * 3 / 10;
+                std::nth_element(sorted_.begin(), sorted_.begin() + (long)n30, sorted_.end());
+                float p30 = sorted_[n30];
+                std::nth_element(sorted_.begin(), sorted_.begin() + (long)n10, sorted_.begin() + (long)n30);
+                if (sorted_[n10] - floor_db_ > c_.off_db) {
+                    floor_db_ = p30;
+                    rebases_++;
+                }
+            }
+            pos_ = frame_end;
+            if (quiet_ >= hang_ || frame_end - begin_ >= (int64_t)c_.rate * c_.max_utt_ms / 1000)
+                End(on_event);
+            return;
+        }
+        pos_ = frame_end;
+    }
+
+    template <class F> void End(F &&on_event)
+    {
+        in_utt_ = false;
+        int64_t end = std::min(pos_, last_speech_end_ + (int64_t)c_.rate * c_.tail_ms / 1000);
+        utt_.resize((size_t)(end - begin_));
+        bool keep = end - begin_ - (int64_t)c_.rate * c_.preroll_ms / 1000 >= (int64_t)c_.rate * c_.min_utt_ms / 1000;
+        if (keep)
+            count_++;
+        on_event(VadEvent{ keep ? VadEvent::END : VadEvent::DROP, keep ? count_ : count_ + 1, pos_, begin_, end,
+                           &utt_ });
+    }
+
+    VadConfig c_;
+    int flen_, hang_;
+    std::vector<int16_t> frame_;
+    std::deque<int16_t> pre_;
+    std::vector<int16_t> utt_;
+    std::vector<float> recent_, sorted_;
+    size_t recent_pos_ = 0;
+    float dc_x_ = 0, dc_y_ = 0;
+    double pw_[3] = {};
+    unsigned pw_pos_ = 0;
+    float floor_db_ = -90, last_db_ = -90, last_zcr_ = 0;
+    double seed_sum_ = 0;
+    int64_t frames_ = 0, pos_ = 0, begin_ = 0, last_speech_end_ = 0;
+    uint32_t window_ = 0;
+    int quiet_ = 0, count_ = 0;
+    bool in_utt_ = false;
+
+public:
+    int rebases_ = 0;
+};
+
+// --- ai.py 흉내 (speech_recognition 3.x 의 Recognizer 그대로) ---
+// 매 반복: adjust_for_ambient_noise(source, 2) → listen(source, timeout=5, phrase_time_limit=15)
+//          (energy_threshold 300 시작, dynamic_energy_threshold, damping 0.15, ratio 1.5, CHUNK 1024,
+//           pause_threshold 1.2, non_speaking_duration 0.5, phrase_threshold 0.3), 인식 시간은 0 으로 침
+class SrBaseline {
+public:
+    explicit SrBaseline(int rate) : rate_(rate), spb_(1024.0 / rate) {}
+
+    template <class F> void Run(const std::vector<int16_t> &x, F &&on_event)
+    {
+        size_t pos = 0;
+        int n = 0;
+        while (pos + 1024 <= x.size()) {
+            // adjust_for_ambient_noise(source, 2)
+            for (double t = 0; t < 2.0 && pos + 1024 <= x.size(); t += spb_, pos += 1024)
+                Adjust(Rms(&x[pos]));
+            // listen: 넘을 때까지 기다리며 문턱도 따라감 (timeout 5 초 넘으면 WaitTimeoutError 로 다시 처음부터)
+            std::deque<size_t> frames;
+            size_t non_speaking = (size_t)ceil(0.5 / spb_);
+            bool started = false;
+            for (double t = 0; t < 5.0 && pos + 1024 <= x.size(); t += spb_, pos += 1024) {
+                frames.push_back(pos);
+                if (frames.size() > non_speaking)
+                    frames.pop_front();
+                double e = Rms(&x[pos]);
+                if (e > threshold_) {
+                    started = true;
+                    pos += 1024;
+                    break;
+                }
+                Adjust(e);
+            }
+            if (!started)
+                continue;
+            int64_t begin = (int64_t)frames.front();
+            on_event(VadEvent{ VadEvent::START, n + 1, (int64_t)pos, begin, 0, nullptr });
+            int pause = 0, phrase = 0;
+            int pause_buffers = (int)ceil(1.2 / spb_), limit = (int)ceil(15.0 / spb_);
+            for (; pos + 1024 <= x.size(); pos += 1024) {
+                phrase++;
+                if (Rms(&x[pos]) > threshold_)
+                    pause = 0;
+                else
+                    pause++;
+                if (pause > pause_buffers || phrase >= limit) {
+                    pos += 1024;
+                    break;
+                }
+            }
+            // 끝에서 쉼 (pause_threshold - non_speaking_duration) 만큼 잘라 넘김
+            int64_t end = (int64_t)pos - (int64_t)((pause_buffers - non_speaking) * 1024);
+            static std::vector<int16_t> none;
+            if (phrase - pause >= (int)ceil(0.3 / spb_))
+                on_event(VadEvent{ VadEvent::END, ++n, (int64_t)pos, begin, std::max(end, begin), &none });
+            else
+                on_event(VadEvent{ VadEvent::DROP, n + 1, (int64_t)pos, begin, std::max(end, begin), &none });
+        }
+    }
+
+private:
+    static double Rms(const int16_t *p)
+    {
+        double s = 0;
+        for (int i = 0; i < 1024; i++)
+            s += (double)p[i] * p[i];
+        return sqrt(s / 1024);
+    }
+
+    void Adjust(double energy)
+    {
+        double damping = pow(0.15, spb_);
+        threshold_ = threshold_ * damping + energy * 1.5 * (1 - damping);
+    }
+
+    int rate_;
+    double spb_;
+    double threshold_ = 300;
+};
+
+// --- 지표 ---
+struct Truth {
+    int64_t begin, end;         // 샘플
+};
+
+struct Metrics {
+    int truths = 0, found = 0, missed = 0, false_alarms = 0, splits = 0, merged = 0;
+    std::vector<double> onset_ms, end_ms, clip_ms;
+};
+
+struct Detect {
+    int64_t start_at = -1, end_at = 0, begin = 0, end = 0;
+};
+
+static Metrics Score(const std::vector<Truth> &truth, const std::vector<Detect> &det, int rate)
+{
+    Metrics m;
+    m.truths = (int)truth.size();
+    std::vector<int> used(det.size(), 0);
+    for (const Truth &t : truth) {
+        int hits = 0;
+        const Detect *first = nullptr, *last = nullptr;
+        for (size_t i = 0; i < det.size(); i++) {
+            if (det[i].end <= t.begin || det[i].begin >= t.end)
+                continue;
+            used[i]++;
+            hits++;
+            if (!first)
+                first = &det[i];
+            last = &det[i];
+        }
+        if (!hits) {
+            m.missed++;
+            continue;
+        }
+        m.found++;
+        if (hits > 1)
+            m.splits++;
+        double ms = 1000.0 / rate;
+        m.onset_ms.push_back((double)(first->start_at - t.begin) * ms);
+        m.end_ms.push_back((double)(last->end_at - t.end) * ms);
+        // 말소리가 구간 밖으로 잘려 나간 양 (앞 + 뒤)
+        m.clip_ms.push_back((double)(std::max<int64_t>(0, first->begin - t.begin) +
+                                     std::max<int64_t>(0, t.end - last->end)) * ms);
+    }
+    for (int u : used)
+        m.false_alarms += u ? 0 : 1;
+    for (int u : used)
+        m.merged += u > 1 ? 1 : 0;        // 한 구간에 발화 여럿 (앞 발화는 뒤 발화가 끝나야 넘어감)
+    return m;
+}
+
+static double Pct(std::vector<double> v, double q)
+{
+    if (v.empty())
+        return NAN;
+    std::sort(v.begin(), v.end());
+    return v[(size_t)(q * (double)(v.size() - 1) + 0.5)];
+}
+
+// --- 합성 ---
+struct Synth {
+    std::vector<int16_t> pcm;
+    std::vector<Truth> truth;
+};
+
+// 말소리 비슷한 것: 음절 = (마찰음 30%) + 유성음 (f0 에 배음 1/k, 느린 포먼트), 음절 사이 짧은 닫힘,
+// 가끔 단어 사이 쉼 (150~250 ms, 한 발화 안). 발화 세기는 -22 dBFS ± 6 dB
+static Synth MakeSynth(uint32_t seed, int rate, int utts, double snr_db, double step_db)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(0, 1);
+    std::normal_distribution<double> g(0, 1);
+    Synth s;
+    std::vector<double> x;
+    auto silence = [&](double sec) { x.resize(x.size() + (size_t)(sec * rate), 0.0); };
+    silence(1.0 + u(rng));
+    for (int k = 0; k < utts; k++) {
+        double level = pow(10, (-22 + (u(rng) * 12 - 6)) / 20) * 32768;
+        Truth t;
+        t.begin = (int64_t)x.size();
+        int syll = 3 + (int)(u(rng) * 8);
+        double f0 = 110 + u(rng) * 110;
+        for (int j = 0; j < syll; j++) {
+            if (u(rng) < 0.3) {
+                // 마찰음: 미분한 백색 잡음 (고역), 유성음보다 12 dB 작게
+                int n = (int)((0.06 + u(rng) * 0.06) * rate);
+                double prev = 0;
+                for (int i = 0; i < n; i++) {
+                    double w = g(rng), env = sin(M_PI * i / n);
+                    x.push_back((w - prev) * 0.5 * level * 0.25 * env);
+                    prev = w;
+                }
+            }
+            int n = (int)((0.1 + u(rng) * 0.12) * rate);
+            double ph = 0, f1 = 400 + u(rng) * 500;
+            for (int i = 0; i < n; i++) {
+                double f = f0 * (1 + 0.1 * sin(2 * M_PI * i / n));
+                ph += 2 * M_PI * f / rate;
+                double v = 0;
+                for (int h = 1; h * f < rate * 0.45 && h <= 30; h++)
+                    v += sin(h * ph) / h * (1 + 2 * exp(-pow((h * f - f1) / 200, 2)));
+                double a = std::min(1.0, std::min(i, n - i) / (0.02 * rate));   // 20 ms 오르내림
+                x.push_back(v * 0.35 * level * a * a);
+            }
+            if (j + 1 < syll)
+                silence(u(rng) < 0.15 ? 0.15 + u(rng) * 0.1 : 0.02 + u(rng) * 0.1);
+        }
+        t.end = (int64_t)x.size();
+        s.truth.push_back(t);
+        silence(1.2 + u(rng) * 1.8);
+    }
+    // 잡음: 분홍빛 (백색 + 한 극 저역), 말 -22 dBFS 기준 SNR. step_db 면 절반 지점에서 그만큼 커짐 (선풍기 켜짐)
+    double noise_rms = pow(10, (-22 - snr_db) / 20) * 32768, lp = 0;
+    std::vector<double> nz(x.size());
+    double acc = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+        double w = g(rng);
+        lp = 0.97 * lp + 0.03 * w;
+        nz[i] = 0.4 * w + 3.0 * lp;
+        acc += nz[i] * nz[i];
+    }
+    double scale = noise_rms / sqrt(acc / (double)x.size() + 1e-12);
+    s.pcm.resize(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        double gain = (step_db != 0 && i >= x.size() / 2) ? pow(10, step_db / 20) : 1;
+        double v = x[i] + nz[i] * scale * gain;
+        s.pcm[i] = (int16_t)std::max(-32768.0, std::min(32767.0, v));
+    }
+    return s;
+}
+
+// VAD 로 전체를 스트림처럼 (512 샘플씩) 흘려서 구간 모음 + 프레임당 처리 시간
+static std::vector<Detect> RunVad(const std::vector<int16_t> &pcm, const VadConfig &c, double *ns_per_frame)
+{
+    Vad vad(c);
+    std::vector<Detect> det;
+    Detect cur;
+    auto sink = [&](const VadEvent &e) {
+        if (e.type == VadEvent::START) {
+            cur = Detect();
+            cur.start_at = e.at;
+        } else if (e.type == VadEvent::END) {
+            cur.end_at = e.at;
+            cur.begin = e.begin;
+            cur.end = e.end;
+            det.push_back(cur);
+        }
+    };
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pcm.size(); i += 512)
+        vad.Push(&pcm[i], std::min<size_t>(512, pcm.size() - i), sink);
+    vad.Finish(sink);
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    if (ns_per_frame)
+        *ns_per_frame = ns / ((double)pcm.size() / (c.rate * c.frame_ms / 1000));
+    return det;
+}
+
+static std::vector<Detect> RunBaseline(const std::vector<int16_t> &pcm, int rate)
+{
+    SrBaseline sr(rate);
+    std::vector<Detect> det;
+    Detect cur;
+    sr.Run(pcm, [&](const VadEvent &e) {
+        if (e.type == VadEvent::START) {
+            cur = Detect();
+            cur.start_at = e.at;
+        } else if (e.type == VadEvent::END) {
+            cur.end_at = e.at;
+            cur.begin = e.begin;
+            cur.end = e.end;
+            det.push_back(cur);
+        }
+    });
+    return det;
+}
+
+static void PrintRow(const char *scen, const char *who, const Metrics &m, double ns)
+{
+    printf("%-16s %-14s %3d/%-3d %4d %5d %5d %5d %7.0f %7.0f %7.0f %7.0f %7.0f %6.0f", scen, who, m.found, m.truths,
+           m.missed, m.false_alarms, m.splits, m.merged, Pct(m.onset_ms, 0.5), Pct(m.end_ms, 0.5), Pct(m.end_ms, 0.95),
+           Pct(m.end_ms, 1.0), Pct(m.clip_ms, 0.5), Pct(m.clip_ms, 1.0));
+    if (ns > 0)
+        printf(" %7.0f", ns);
+    printf("\n");
+}
+
+static void Bench(const VadConfig &base, uint32_t seed, const char *synth_out)
+{
+    const int rate = 16000;
+    struct Scen {
+        const char *name;
+        double snr, step;
+    } scens[] = {
+        { "quiet 35 dB", 35, 0 },
+        { "fan 15 dB", 15, 0 },
+        { "noisy 8 dB", 8, 0 },
+        { "fan turns on", 25, 12 },
+    };
+    printf("16 kHz, 10 ms frames, 12 utterances per scenario. latencies in ms:\n"
+           "  onset = start decided - speech start, end = utterance handed off - speech end, clip = speech cut off\n\n");
+    printf("%-16s %-14s %7s %4s %5s %5s %5s %7s %7s %7s %7s %7s %6s %7s\n", "scenario", "detector", "found",
+           "miss", "false", "split", "merge", "onset50", "end50", "end95", "endmax", "clip50", "clipmx", "ns/frm");
+    for (const Scen &sc : scens) {
+        Synth s = MakeSynth(seed, rate, 12, sc.snr, sc.step);
+        if (synth_out && &sc == &scens[1])
+            WriteWav(synth_out, s.pcm.data(), s.pcm.size(), rate);
+        for (int hang : { 150, 200, 300 }) {
+            VadConfig c = base;
+            c.rate = rate;
+            c.hang_ms = hang;
+            double ns = 0;
+            std::vector<Detect> det = RunVad(s.pcm, c, &ns);
+            char who[32];
+            snprintf(who, sizeof(who), "vad hang %d", hang);
+            PrintRow(sc.name, who, Score(s.truth, det, rate), ns);
+        }
+        PrintRow(sc.name, "ai.py (sr)", Score(s.truth, RunBaseline(s.pcm, rate), rate), 0);
+    }
+    if (synth_out)
+        printf("\nwrote %s (fan 15 dB scenario)\n", synth_out);
+}
+
+static bool ReadLabels(const char *path, int rate, std::vector<Truth> &out)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        double a, b;
+        if (sscanf(line, "%lf %lf", &a, &b) == 2 && b > a)
+            out.push_back(Truth{ (int64_t)(a * rate), (int64_t)(b * rate) });
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    VadConfig c;
+    const char *out_prefix = nullptr, *labels = nullptr, *synth_out = nullptr;
+    bool bench = false, verbose = false;
+    uint32_t seed = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:l:H:N:F:r:vTs:g:")) != -1) {
+        switch (opt) {
+            case 'o': out_prefix = optarg; break;
+            case 'l': labels = optarg; break;
+            case 'H': c.hang_ms = atoi(optarg); break;
+            case 'N': c.on_db = (float)atof(optarg); break;
+            case 'F': c.off_db = (float)atof(optarg); break;
+            case 'r': c.rate = atoi(optarg); break;
+            case 'v': verbose = true; break;
+            case 'T': bench = true; break;
+            case 's': seed = (uint32_t)strtoul(optarg, nullptr, 0); break;
+            case 'g': synth_out = optarg; break;
+            default:
+                fprintf(stderr,
+                        "usage: %s [-o prefix] [-l labels.txt] [-H hang_ms] [-N on_db] [-F off_db] [-v] in.wav\n"
+                        "       %s -r rate [-o prefix] -          (raw s16le mono on stdin)\n"
+                        "       %s -T [-s seed] [-g synth.wav] [-N on_db] [-F off_db]\n",
+                        argv[0], argv[0], argv[0]);
+                return 1;
+        }
+    }
+    if (bench) {
+        Bench(c, seed, synth_out);
+        return 0;
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "need an input (.wav or - for raw stdin)\n");
+        return 1;
+    }
+
+    std::vector<int16_t> pcm;
+    bool stream = strcmp(argv[optind], "-") == 0;
+    if (!stream && !ReadWav(argv[optind], pcm, c.rate))
+        return 1;
+    if (c.rate < 8000 || c.hang_ms < c.frame_ms) {
+        fprintf(stderr, "rate must be >= 8000 and hang >= one frame\n");
+        return 1;
+    }
+
+    Vad vad(c);
+    std::vector<Detect> det;
+    Detect cur;
+    double sec = 1.0 / c.rate;
+    int64_t frames_seen = 0;
+    auto sink = [&](const VadEvent &e) {
+        if (e.type == VadEvent::START) {
+            cur = Detect();
+            cur.start_at = e.at;
+            printf("start %d %.3f\n", e.n, e.at * sec);
+        } else if (e.type == VadEvent::END) {
+            cur.end_at = e.at;
+            cur.begin = e.begin;
+            cur.end = e.end;
+            det.push_back(cur);
+            char path[512] = "";
+            if (out_prefix) {
+                snprintf(path, sizeof(path), "%s_%03d.wav", out_prefix, e.n);
+                WriteWav(path, e.audio->data(), e.audio->size(), c.rate);
+            }
+            printf("utt %d %.3f %.3f %.3f %s\n", e.n, e.begin * sec, e.end * sec, e.at * sec, path);
+        } else if (verbose) {
+            printf("drop %.3f %.3f\n", e.begin * sec, e.end * sec);
+        }
+        fflush(stdout);     // 파이프로 읽는 쪽이 바로 받게
+    };
+    auto trace = [&]() {
+        int64_t f = (int64_t)frames_seen;
+        frames_seen++;
+        if (verbose)
+            fprintf(stderr, "%8.2f %6.1f dB floor %6.1f zcr %.2f %s\n", (double)f * c.frame_ms / 1000.0,
+                    vad.LastDb(), vad.Floor(), vad.LastZcr(), vad.InUtterance() ? "#" : "");
+    };
+    int flen = c.rate * c.frame_ms / 1000;
+    if (stream) {
+        // 한 프레임씩 넣어서 -v 로 프레임마다 볼 수 있게
+        std::vector<int16_t> buf((size_t)flen);
+        size_t have = 0;
+        for (;;) {
+            ssize_t n = read(0, (char*)buf.data() + have, buf.size() * 2 - have);
+            if (n <= 0)
+                break;
+            have += (size_t)n;
+            if (have == buf.size() * 2) {
+                vad.Push(buf.data(), buf.size(), sink);
+                trace();
+                have = 0;
+            }
+        }
+    } else {
+        for (size_t i = 0; i + (size_t)flen <= pcm.size(); i += (size_t)flen) {
+            vad.Push(&pcm[i], (size_t)flen, sink);
+            trace();
+        }
+    }
+    vad.Finish(sink);
+    fprintf(stderr, "%d utterances, noise floor %.1f dBFS (rebased %d times)\n", (int)det.size(), vad.Floor(),
+            vad.rebases_);
+
+    if (labels) {
+        std::vector<Truth> truth;
+        if (!ReadLabels(labels, c.rate, truth))
+            return 1;
+        Metrics m = Score(truth, det, c.rate);
+        printf("%-16s %-14s %7s %4s %5s %5s %5s %7s %7s %7s %7s %7s %6s\n", "input", "detector", "found", "miss",
+               "false", "split", "merge", "onset50", "end50", "end95", "endmax", "clip50", "clipmx");
+        char who[32];
+        snprintf(who, sizeof(who), "vad hang %d", c.hang_ms);
+        PrintRow("file", who, m, 0);
+        if (!stream)
+            PrintRow("file", "ai.py (sr)", Score(truth, RunBaseline(pcm, c.rate), c.rate), 0);
+    }
+    return 0;
+}
@@ -0,0 +1,255 @@
+#include "i2c_bus.h"
+#include "dlog.h"
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#define I2C_BUS_LOCK()      do {} while (0)
+#define I2C_BUS_UNLOCK()    do {} while (0)
+#else
+#define I2C_BUS_LOCK()      uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define I2C_BUS_UNLOCK()    __set_PRIMASK(primask)
+#endif
+
+static I2C_HandleTypeDef *bus;
+static I2cTxn *head[I2C_BUS_PRIOS];
+static I2cTxn *tail[I2C_BUS_PRIOS];
+static I2cTxn *active;              // 버스에 나가 있는 조각의 트랜잭션
+static uint16_t active_len;
+static uint8_t saved_byte;
+static uint8_t patched;
+static uint32_t active_start;
+static uint32_t window_start;
+static I2cBusStats stats;
+
+static inline uint32_t NowUs(void)
+{
+#ifdef HOST_BUILD
+    return (uint32_t)HostOs_NowUs();
+#else
+    return DWT->CYCCNT / (I2C_BUS_CPU_HZ / 1000000u);
+#endif
+}
+
+static inline uint32_t Since(uint32_t stamp)
+{
+#ifdef HOST_BUILD
+    return (uint32_t)HostOs_NowUs() - stamp;
+#else
+    // 사이클 카운터가 59 초마다 돌므로 us 도 그 주기로 돈다
+    uint32_t wrap_us = 0xFFFFFFFFu / (I2C_BUS_CPU_HZ / 1000000u) + 1u;
+    uint32_t now = NowUs();
+    return now >= stamp ? now - stamp : now + wrap_us - stamp;
+#endif
+}
+
+void I2cBus_Init(I2C_HandleTypeDef *hi2c)
+{
+#ifndef HOST_BUILD
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    bus = hi2c;
+    memset(head, 0, sizeof(head));
+    memset(tail, 0, sizeof(tail));
+    active = NULL;
+    memset(&stats, 0, sizeof(stats));
+    window_start = NowUs();
+}
+
+uint8_t I2cBus_Idle(void)
+{
+    if (active)
+        return 0;
+    for (uint8_t p = 0; p < I2C_BUS_PRIOS; p++) {
+        if (head[p])
+            return 0;
+    }
+    return 1;
+}
+
+static void Complete(I2cTxn *t, int status);
+
+// 버스가 비어 있으면 가장 높은 우선순위의 다음 조각을 보냄 (lock 안에서)
+static void Kick(void)
+{
+    while (!active) {
+        I2cTxn *t = NULL;
+        for (uint8_t p = 0; p < I2C_BUS_PRIOS && !t; p++)
+            t = head[p];
+        if (!t)
+            return;
+
+        HAL_StatusTypeDef st;
+        I2cBusPrioStats *ps = &stats.prio[t->prio];
+        if (t->offset == 0) {
+            uint32_t wait = Since(t->submit_stamp);
+            if (wait > ps->max_wait_us) ps->max_wait_us = wait;
+        }
+        active = t;
+        active_start = NowUs();
+        patched = 0;
+
+        if (t->rx_len) {
+            active_len = t->rx_len;
+            st = HAL_I2C_Mem_Read_DMA(bus, t->addr, t->reg, I2C_MEMADD_SIZE_8BIT, t->rx, t->rx_len);
+        } else {
+            uint16_t left = t->tx_len - t->offset;
+            uint8_t *start = &t->tx[t->offset];
+            uint8_t repeat = t->offset && (t->flags & I2C_TXN_REPEAT_FIRST);
+            uint16_t room = t->chunk ? (uint16_t)(t->chunk - repeat) : left;   // 조각 하나가 버스에 내는 바이트 = chunk
+            uint16_t len = left > room ? room : left;
+            active_len = len;
+            if (repeat) {
+                // 조각 바로 앞 바이트 자리에 tx[0] 을 잠깐 넣어 한 번에 보냄
+                start--;
+                saved_byte = *start;
+                *start = t->tx[0];
+                patched = 1;
+                len++;
+            }
+            st = HAL_I2C_Master_Transmit_DMA(bus, t->addr, start, len);
+        }
+        ps->chunks++;
+        if (st != HAL_OK) {
+            active = NULL;
+            if (patched)
+                t->tx[t->offset - 1] = saved_byte;
+            Complete(t, -1);
+        }
+    }
+}
+
+static void Unlink(I2cTxn *t)
+{
+    I2cTxn **pp = &head[t->prio];
+    I2cTxn *prev = NULL;
+    while (*pp && *pp != t) {
+        prev = *pp;
+        pp = &(*pp)->next;
+    }
+    if (!*pp)
+        return;
+    *pp = t->next;
+    if (tail[t->prio] == t)
+        tail[t->prio] = prev;
+}
+
+static void Complete(I2cTxn *t, int status)
+{
+    I2cBusPrioStats *ps = &stats.prio[t->prio];
+    uint32_t latency = Since(t->submit_stamp);
+    Unlink(t);
+    ps->txns++;
+    ps->total_latency_us += latency;
+    if (latency > ps->max_latency_us) ps->max_latency_us = latency;
+    if (status)
+        ps->errors++;
+    if (t->done)
+        t->done(t, status);       // 여기서 다시 Submit 해도 됨
+}
+
+int I2cBus_Submit(I2cTxn *t)
+{
+    if (!bus || !t || t->prio >= I2C_BUS_PRIOS || (!t->rx_len && !t->tx_len))
+        return -1;
+    if ((t->flags & I2C_TXN_REPEAT_FIRST) && t->chunk < 2)
+        return -1;
+
+    I2C_BUS_LOCK();
+    t->next = NULL;
+    t->offset = 0;
+    t->submit_stamp = NowUs();
+    if (tail[t->prio])
+        tail[t->prio]->next = t;
+    else
+        head[t->prio] = t;
+    tail[t->prio] = t;
+    Kick();
+    I2C_BUS_UNLOCK();
+    return 0;
+}
+
+static void ChunkDone(int status)
+{
+    I2cTxn *t = active;
+    if (!t)
+        return;
+    uint32_t busy = Since(active_start);
+    stats.busy_us += busy;
+    stats.window_busy_us += busy;
+    active = NULL;
+
+    if (patched)
+        t->tx[t->offset - 1] = saved_byte;
+    if (status == 0 && !t->rx_len) {
+        t->offset += active_len;
+        if (t->offset < t->tx_len) {
+            Kick();             // 더 높은 우선순위가 기다리면 그쪽이 먼저
+            return;
+        }
+    }
+    Complete(t, status);
+    Kick();
+}
+
+void I2cBus_TxDone(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != bus)
+        return;
+    I2C_BUS_LOCK();
+    ChunkDone(0);
+    I2C_BUS_UNLOCK();
+}
+
+void I2cBus_RxDone(I2C_HandleTypeDef *hi2c)
+{
+    I2cBus_TxDone(hi2c);
+}
+
+void I2cBus_Error(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != bus)
+        return;
+    I2C_BUS_LOCK();
+    ChunkDone(-1);
+    I2C_BUS_UNLOCK();
+}
+
+void I2cBus_CloseWindow(void)
+{
+    I2C_BUS_LOCK();
+    uint32_t elapsed = Since(window_start);
+    stats.window_us = elapsed;
+    stats.util_permille = elapsed ? (uint16_t)((uint64_t)stats.window_busy_us * 1000u / elapsed) : 0;
+    stats.window_busy_us = 0;
+    window_start = NowUs();
+    I2C_BUS_UNLOCK();
+}
+
+void I2cBus_GetStats(I2cBusStats *out)
+{
+    I2C_BUS_LOCK();
+    *out = stats;
+    I2C_BUS_UNLOCK();
+}
+
+int I2cBus_LogLine(int line)
+{
+    I2cBusStats s;
+    if (line < 0 || line > I2C_BUS_PRIOS)
+        return -1;
+    I2cBus_GetStats(&s);
+    if (line == 0) {
+        DLOG("I2C util %u.%u%% over %lu ms\r\n", (unsigned)(s.util_permille / 10), (unsigned)(s.util_permille % 10),
+             (unsigned long)(s.window_us / 1000u));
+        return 0;
+    }
+    const I2cBusPrioStats *ps = &s.prio[line - 1];
+    if (ps->txns)
+        DLOG("I2C p%u txn %lu chunk %lu err %lu wait max %lu us lat avg/max %lu/%lu us\r\n", (unsigned)(line - 1),
+             (unsigned long)ps->txns, (unsigned long)ps->chunks, (unsigned long)ps->errors,
+             (unsigned long)ps->max_wait_us, (unsigned long)(ps->total_latency_us / ps->txns),
+             (unsigned long)ps->max_latency_us);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include "main.h"
+
+// 공유 I2C 버스 트랜잭션 스케줄러
+// - 클라이언트는 I2cTxn 을 채워 I2cBus_Submit 로 넣고, 끝나면 done 콜백을 받는다 (인터럽트 문맥)
+// - 우선순위별 FIFO, 0 이 가장 높음. 버스가 비면 가장 높은 큐의 맨 앞을 보낸다
+// - chunk 를 주면 쓰기를 그 크기씩 나눠 보내고, 조각 사이마다 다시 고르므로
+//   긴 디스플레이 전송 중에도 센서 읽기는 조각 하나만 기다린다
+// - 전송은 모두 DMA, HAL 완료 콜백에서 I2cBus_TxDone / RxDone / Error 를 부른다
+//
+// 트랜잭션 구조체는 끝날 때까지 클라이언트가 들고 있어야 함 (정적 할당)
+
+#define I2C_BUS_PRIOS       4
+#define I2C_BUS_CPU_HZ      72000000u
+
+#define I2C_TXN_REPEAT_FIRST    0x01    // 조각마다 tx[0] (SSD1306 제어 바이트 등)을 앞에 다시 붙임
+
+struct I2cTxn;
+typedef void (*I2cDoneFn)(struct I2cTxn *txn, int status);
+
+typedef struct I2cTxn {
+    uint16_t addr;              // 8비트 형식 (HAL 과 같음)
+    uint8_t prio;
+    uint8_t flags;
+    uint8_t *tx;                // 쓰기: tx_len 바이트
+    uint16_t tx_len;
+    uint8_t *rx;                // 읽기: reg 에서 rx_len 바이트 (rx_len 이 0 이 아니면 읽기)
+    uint16_t rx_len;
+    uint8_t reg;
+    uint16_t chunk;             // 0 이면 나누지 않음
+    I2cDoneFn done;             // status 0 성공, -1 실패
+    void *ctx;
+
+    // 스케줄러 내부
+    struct I2cTxn *next;
+    uint16_t offset;
+    uint32_t submit_stamp;
+} I2cTxn;
+
+typedef struct {
+    uint32_t txns;
+    uint32_t chunks;
+    uint32_t errors;
+    uint32_t max_wait_us;       // 넣은 뒤 첫 바이트가 나가기까지
+    uint32_t max_latency_us;    // 넣은 뒤 끝날 때까지
+    uint64_t total_latency_us;
+} I2cBusPrioStats;
+
+typedef struct {
+    uint64_t busy_us;
+    uint32_t window_busy_us;
+    uint32_t window_us;
+    uint16_t util_permille;     // 마지막으로 닫은 구간
+    I2cBusPrioStats prio[I2C_BUS_PRIOS];
+} I2cBusStats;
+
+void I2cBus_Init(I2C_HandleTypeDef *hi2c);
+// 메인 루프나 인터럽트에서 호출 가능, 인자가 잘못됐으면 -1
+int I2cBus_Submit(I2cTxn *txn);
+uint8_t I2cBus_Idle(void);
+
+void I2cBus_TxDone(I2C_HandleTypeDef *hi2c);
+void I2cBus_RxDone(I2C_HandleTypeDef *hi2c);
+void I2cBus_Error(I2C_HandleTypeDef *hi2c);
+
+// 사용률 구간을 닫고 통계를 복사
+void I2cBus_CloseWindow(void);
+void I2cBus_GetStats(I2cBusStats *out);
+// DLOG 레코드 한 줄 (UART 를 기다리지 않음): line 0 은 "I2C util ..%", 1 ~ I2C_BUS_PRIOS 는 우선순위별
+// "I2C p<n> ..." (트랜잭션이 없던 우선순위는 건너뜀). 구간은 I2cBus_CloseWindow 로 먼저 닫는다. 범위 밖이면 -1
+int I2cBus_LogLine(int line);
+
+#endif
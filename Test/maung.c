@@ -1,5 +1,6 @@
 #include "main.h"
 #include "cmsis_os.h"
+#include "board.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -86,9 +87,9 @@ int main(void)
 {
     HAL_Init();
     SystemClock_Config();
-    MX_GPIO_Init();
-    MX_ADC1_Init();
-    MX_USART1_UART_Init();
+    // GPIO / USART1 / ADC1: board.hpp 설정을 레지스터로, HAL 핸들은 같은 설정으로 채우기만
+    Board_Init();
+    Board_BindHal(&huart1, &hadc1);
 
     eventQueueHandle = osMessageCreate(osMessageQ(eventQueue), NULL);
 
@@ -125,50 +126,3 @@ void SystemClock_Config(void)
     RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
     HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2);
 }
-
-static void MX_ADC1_Init(void)
-{
-    ADC_ChannelConfTypeDef sConfig = {0};
-    __HAL_RCC_ADC1_CLK_ENABLE();
-
-    hadc1.Instance = ADC1;
-    hadc1.Init.ScanConvMode = ADC_SCAN_DISABLE;
-    hadc1.Init.ContinuousConvMode = DISABLE;
-    hadc1.Init.DiscontinuousConvMode = DISABLE;
-    hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
-    hadc1.Init.NbrOfConversion = 1;
-    HAL_ADC_Init(&hadc1);
-
-    sConfig.Channel = ADC_CHANNEL_1;
-    sConfig.Rank = 1;
-    sConfig.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
-    HAL_ADC_ConfigChannel(&hadc1, &sConfig);
-}
-
-static void MX_USART1_UART_Init(void)
-{
-    __HAL_RCC_USART1_CLK_ENABLE();
-    huart1.Instance = USART1;
-    huart1.Init.BaudRate = 115200;
-    huart1.Init.WordLength = UART_WORDLENGTH_8B;
-    huart1.Init.StopBits = UART_STOPBITS_1;
-    huart1.Init.Parity = UART_PARITY_NONE;
-    huart1.Init.Mode = UART_MODE_TX_RX;
-    HAL_UART_Init(&huart1);
-}
-
-static void MX_GPIO_Init(void)
-{
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-    __HAL_RCC_GPIOC_CLK_ENABLE();
-    __HAL_RCC_GPIOA_CLK_ENABLE();
-
-    // LED PC13
-    GPIO_InitStruct.Pin = GPIO_PIN_13;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
-    HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
-}
-
-
-return 0;
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "main.h"
+#include "oled_async.h"
+#include "i2c_bus.h"
+#include "ssd1306.h"
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#endif
+
+// 페이지마다 [0x40][128 열], 부분 전송은 x0 바로 앞 바이트를 잠깐 0x40 으로 바꿔서 보낸다
+static uint8_t front[OLED_ASYNC_PAGES][1 + OLED_ASYNC_COLS];
+static uint8_t cmd[4];
+static uint8_t scroll_cmd[8];
+
+// 패널 초기화 (SSD1306_Init 과 같은 목록, 맨 앞은 명령 스트림 제어 바이트)
+static const uint8_t panel_cmds[] = {
+    0x00,
+    0xAE, 0x20, 0x10, 0xB0, 0xC8, 0x00, 0x10, 0x40, 0x81, 0xFF, 0xA1, 0xA6,
+    0xA8, 0x3F, 0xA4, 0xD3, 0x00, 0xD5, 0xF0, 0xD9, 0x22, 0xDA, 0x12, 0xDB,
+    0x20, 0x8D, 0x14, 0xAF, 0x2E
+};
+
+typedef struct {
+    uint8_t x0;
+    uint8_t x1;                 // 포함
+} PageSpan;
+
+static PageSpan spans[OLED_ASYNC_PAGES];
+static uint8_t dirty_pages;
+static uint8_t cur_page;
+static uint8_t sending_data;
+static uint8_t sending_scroll;
+static uint8_t scroll_pending;
+static uint8_t sending_panel;
+static volatile int8_t panel_state;
+static uint8_t saved_byte;
+static volatile uint8_t busy;
+static uint8_t force_all;
+static uint32_t flush_start;
+
+static I2cTxn txn;
+static OledAsyncStats stats;
+
+static inline uint32_t NowUs(void)
+{
+#ifdef HOST_BUILD
+    return (uint32_t)HostOs_NowUs();
+#else
+    return HAL_GetTick() * 1000u;
+#endif
+}
+
+void OledAsync_Init(void)
+{
+    memset(front, 0, sizeof(front));
+    for (uint8_t p = 0; p < OLED_ASYNC_PAGES; p++)
+        front[p][0] = 0x40;
+    memset(&stats, 0, sizeof(stats));
+    busy = 0;
+    force_all = 0;
+    scroll_pending = 0;
+    sending_panel = 0;
+    panel_state = 0;
+}
+
+void OledAsync_Invalidate(void)
+{
+    force_all = 1;
+}
+
+uint8_t OledAsync_Busy(void)
+{
+    return busy;
+}
+
+static void TxnDone(I2cTxn *t, int status);
+
+static void Abort(void)
+{
+    // 패널이 앞 버퍼와 같은지 모르므로 다음 Flush 는 전부 보냄
+    if (sending_data)
+        front[cur_page][spans[cur_page].x0] = saved_byte;
+    sending_scroll = 0;
+    force_all = 1;
+    busy = 0;
+}
+
+static void Send(uint8_t *data, uint16_t len, uint16_t chunk)
+{
+    memset(&txn, 0, sizeof(txn));
+    txn.addr = SSD1306_I2C_ADDR;
+    txn.prio = OLED_ASYNC_PRIO;
+    txn.flags = chunk ? I2C_TXN_REPEAT_FIRST : 0;
+    txn.tx = data;
+    txn.tx_len = len;
+    txn.chunk = chunk;
+    txn.done = TxnDone;
+    stats.bytes += len;
+    if (chunk && len > chunk)
+        stats.bytes += (len - chunk + chunk - 2) / (chunk - 1);    // 조각마다 다시 붙는 제어 바이트
+    if (I2cBus_Submit(&txn) != 0)
+        Abort();
+}
+
+static void FinishFlush(void)
+{
+    busy = 0;
+    stats.last_flush_us = NowUs() - flush_start;
+    if (stats.last_flush_us > stats.max_flush_us)
+        stats.max_flush_us = stats.last_flush_us;
+}
+
+// 다음 dirty 페이지의 명령을 보냄, 없으면 끝
+static void StartPage(void)
+{
+    while (cur_page < OLED_ASYNC_PAGES && !(dirty_pages & (1u << cur_page)))
+        cur_page++;
+    if (cur_page >= OLED_ASYNC_PAGES) {
+        FinishFlush();
+        return;
+    }
+
+    uint8_t x0 = spans[cur_page].x0;
+    cmd[0] = 0x00;                      // 명령 스트림
+    cmd[1] = 0xB0 + cur_page;
+    cmd[2] = 0x00 | (x0 & 0x0F);
+    cmd[3] = 0x10 | (x0 >> 4);
+    sending_data = 0;
+    stats.pages++;
+    Send(cmd, sizeof(cmd), 0);
+}
+
+static void StartData(void)
+{
+    PageSpan s = spans[cur_page];
+    uint8_t *start = &front[cur_page][s.x0];   // 열 x0 의 한 칸 앞 (x0 = 0 이면 원래 0x40 자리)
+    uint16_t len = (uint16_t)(s.x1 - s.x0 + 2);
+    saved_byte = *start;
+    *start = 0x40;
+    sending_data = 1;
+    Send(start, len, OLED_ASYNC_CHUNK);
+}
+
+// i2c_bus 완료 콜백 (인터럽트 문맥)
+static void TxnDone(I2cTxn *t, int status)
+{
+    (void)t;
+    if (!busy)
+        return;
+    if (sending_panel) {
+        // 패널 RAM 은 모르는 상태: 첫 Flush 가 앞 버퍼(빈 화면)와 상관없이 전부 보냄
+        sending_panel = 0;
+        panel_state = status == 0 ? 1 : -1;
+        force_all = 1;
+        busy = 0;
+        return;
+    }
+    if (status != 0) {
+        Abort();
+        return;
+    }
+    if (sending_scroll) {
+        sending_scroll = 0;
+        StartPage();
+        return;
+    }
+    if (!sending_data) {
+        StartData();
+        return;
+    }
+    front[cur_page][spans[cur_page].x0] = saved_byte;
+    dirty_pages &= ~(1u << cur_page);
+    cur_page++;
+    StartPage();
+}
+
+int OledAsync_StartPanel(void)
+{
+    if (busy)
+        return -1;
+    panel_state = 0;
+    sending_panel = 1;
+    busy = 1;
+    Send((uint8_t *)panel_cmds, sizeof(panel_cmds), 0);     // DMA 는 플래시에서 바로 읽음
+    if (!busy) {
+        sending_panel = 0;
+        panel_state = -1;
+        return -1;
+    }
+    return 0;
+}
+
+int OledAsync_PanelState(void)
+{
+    return panel_state;
+}
+
+int OledAsync_ScrollLeft(uint8_t page0, uint8_t page1, uint8_t x0, uint8_t x1)
+{
+    if (busy || scroll_pending || page0 > page1 || page1 >= OLED_ASYNC_PAGES || x0 >= x1 ||
+        x1 >= OLED_ASYNC_COLS)
+        return -1;
+    for (uint8_t p = page0; p <= page1; p++) {
+        memmove(&front[p][1 + x0], &front[p][2 + x0], (size_t)(x1 - x0));
+        front[p][1 + x1] = 0;           // 패널이 오른쪽 끝에 뭘 채우는지는 모름: Flush 가 덮어씀
+    }
+    scroll_cmd[0] = 0x00;               // 명령 스트림
+    scroll_cmd[1] = 0x2D;               // 왼쪽으로 한 열
+    scroll_cmd[2] = 0x00;
+    scroll_cmd[3] = page0;
+    scroll_cmd[4] = 0x01;
+    scroll_cmd[5] = page1;
+    scroll_cmd[6] = x0;
+    scroll_cmd[7] = x1;
+    scroll_pending = 1;
+    return 0;
+}
+
+int OledAsync_Flush(void)
+{
+    if (busy) {
+        stats.skipped++;
+        return -1;
+    }
+
+    const uint8_t *back = SSD1306_GetBuffer();
+    uint32_t total = 0;
+    dirty_pages = 0;
+    for (uint8_t p = 0; p < OLED_ASYNC_PAGES; p++) {
+        const uint8_t *src = &back[p * OLED_ASYNC_COLS];
+        uint8_t *dst = &front[p][1];
+        int x0 = 0, x1 = OLED_ASYNC_COLS - 1;
+        if (!force_all) {
+            while (x0 < OLED_ASYNC_COLS && src[x0] == dst[x0]) x0++;
+            while (x1 >= 0 && src[x1] == dst[x1]) x1--;
+            if (scroll_pending && p >= scroll_cmd[3] && p <= scroll_cmd[5]) {
+                // 스크롤로 비는 열은 같아 보여도 보냄
+                int sx = scroll_cmd[7];
+                if (x0 > sx) x0 = sx;
+                if (x1 < sx) x1 = sx;
+            }
+            if (x0 == OLED_ASYNC_COLS)
+                continue;
+        }
+        memcpy(&dst[x0], &src[x0], (size_t)(x1 - x0 + 1));
+        spans[p].x0 = (uint8_t)x0;
+        spans[p].x1 = (uint8_t)x1;
+        dirty_pages |= 1u << p;
+        total += sizeof(cmd) + (uint32_t)(x1 - x0 + 2);
+    }
+    // 전부 다시 보내면 스크롤은 필요 없음
+    uint8_t scroll = scroll_pending && !force_all;
+    force_all = 0;
+    scroll_pending = 0;
+
+    if (!dirty_pages && !scroll) {
+        stats.clean++;
+        return 0;
+    }
+    stats.flushes++;
+    flush_start = NowUs();
+    busy = 1;
+    cur_page = 0;
+    if (scroll) {
+        total += sizeof(scroll_cmd);
+        stats.scrolls++;
+        sending_scroll = 1;
+        sending_data = 0;
+        Send(scroll_cmd, sizeof(scroll_cmd), 0);
+    } else {
+        StartPage();
+    }
+    return (int)total;
+}
+
+void OledAsync_GetStats(OledAsyncStats *out)
+{
+    *out = stats;
+}
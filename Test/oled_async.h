@@ -0,0 +1,56 @@
+#ifndef OLED_ASYNC_H
+#define OLED_ASYNC_H
+
+#include <stdint.h>
+
+// SSD1306 이중 버퍼 + DMA 비동기 전송
+// - 뒤 버퍼: ssd1306 라이브러리 버퍼 (앱은 지금처럼 SSD1306_* / OledText 로 그림)
+// - 앞 버퍼: 패널에 보낸(보내는 중인) 내용. OledAsync_Flush 가 바뀐 페이지의 바뀐 열만
+//   앞 버퍼로 옮기고 DMA 로 보낸다. 전송 중에도 앱은 뒤 버퍼에 계속 그릴 수 있다.
+// - 페이지마다 명령(페이지/열 주소) 한 번 + 데이터 한 번을 i2c_bus 로 보내고,
+//   다음 페이지는 완료 콜백에서 넣는다. 데이터는 OLED_ASYNC_CHUNK 바이트씩 나눠 나가므로
+//   같은 버스의 센서 읽기가 화면 전송 전체를 기다리지 않는다.
+//
+// - OledAsync_ScrollLeft: 패널 RAM 의 한 구역을 한 열 왼쪽으로 미는 SSD1306 명령(2Dh, content scroll)을
+//   다음 Flush 맨 앞에 끼우고 앞 버퍼도 똑같이 민다. 앱이 뒤 버퍼를 같이 밀면 Flush 는 새로 생긴
+//   오른쪽 열만 보낸다 (oled_spark). 2Ch/2Dh 가 없는 패널(옛 SSD1306, SH1106)에는 쓰지 말 것.
+//
+// 타깃에서는 I2C1 의 DMA 연결 (HAL_I2C_MspInit 의 hdmatx / hdmarx) 과 I2C1_EV / I2C1_ER /
+// DMA1_Channel6 / DMA1_Channel7 핸들러가 있어야 전송이 끝난다 (sub.c 에 있음).
+//
+// I2cBus_Init 과 SSD1306_Init(패널을 지움) 뒤에 OledAsync_Init 을 부른다 (앞 버퍼를 빈 화면으로 시작).
+// 블로킹 SSD1306_Init(~100 ms) 대신 OledAsync_Init 다음 OledAsync_StartPanel 로 초기화 명령을 i2c_bus 에
+// 넣고 OledAsync_PanelState 가 1 이 될 때까지 기다려도 된다. 그 뒤 첫 Flush 가 화면 전체를 보낸다 (지우기).
+
+#define OLED_ASYNC_PAGES    8
+#define OLED_ASYNC_COLS     128
+#define OLED_ASYNC_PRIO     3       // i2c_bus 우선순위 (가장 낮음)
+#define OLED_ASYNC_CHUNK    32      // 버스 트랜잭션 하나의 바이트 수 (제어 바이트 포함)
+
+typedef struct {
+    uint32_t flushes;           // 전송을 시작한 Flush
+    uint32_t skipped;           // 앞 전송이 안 끝나서 거절된 Flush
+    uint32_t clean;             // 바뀐 게 없던 Flush
+    uint32_t pages;
+    uint32_t scrolls;           // 보낸 한 열 스크롤 명령
+    uint32_t bytes;             // 명령 + 데이터, 제어 바이트 포함
+    uint32_t last_flush_us;     // 마지막 Flush 시작 → 마지막 페이지 완료
+    uint32_t max_flush_us;
+} OledAsyncStats;
+
+void OledAsync_Init(void);
+// SSD1306_Init 과 같은 명령 목록을 보냄. 버스에 못 넣으면 -1
+int OledAsync_StartPanel(void);
+// 0 보내는 중, 1 끝남, -1 패널이 응답하지 않음 (NACK)
+int OledAsync_PanelState(void);
+// 반환값: 보낼 바이트 수, 바뀐 게 없으면 0, 앞 전송 중이면 -1 (뒤 버퍼는 그대로 남으니 다음에 다시)
+int OledAsync_Flush(void);
+// 앞 버퍼를 통째로 다시 보내게 함 (패널을 다른 경로로 건드린 뒤)
+void OledAsync_Invalidate(void);
+// 페이지 page0~page1, 열 x0~x1 을 한 열 왼쪽으로 (x1 열은 다음 Flush 가 반드시 다시 씀)
+// 전송 중이거나 보내지 않은 스크롤이 이미 있으면 -1. 패널은 스크롤 명령 사이에 2 프레임(~30 ms) 이상 필요
+int OledAsync_ScrollLeft(uint8_t page0, uint8_t page1, uint8_t x0, uint8_t x1);
+uint8_t OledAsync_Busy(void);
+void OledAsync_GetStats(OledAsyncStats *out);
+
+#endif
@@ -0,0 +1,129 @@
+#include "oled_spark.h"
+#include "oled_async.h"
+#include "ssd1306.h"
+#include <string.h>
+
+#define ADC_MAX     4095
+
+void OledSpark_Init(OledSpark *s, uint8_t x0, uint8_t cols, uint8_t page0, uint8_t pages, uint8_t hw_scroll)
+{
+    memset(s, 0, sizeof(*s));
+    if (pages > OLED_SPARK_MAX_PAGES)
+        pages = OLED_SPARK_MAX_PAGES;
+    if (page0 + pages > SSD1306_HEIGHT / 8)
+        pages = (uint8_t)(SSD1306_HEIGHT / 8 - page0);
+    if (x0 + cols > SSD1306_WIDTH)
+        cols = (uint8_t)(SSD1306_WIDTH - x0);
+    s->x0 = x0;
+    s->cols = cols;
+    s->page0 = page0;
+    s->pages = pages;
+    s->hw_scroll = hw_scroll;
+    s->hi = ADC_MAX;
+}
+
+uint8_t OledSpark_Row(const OledSpark *s, uint16_t v)
+{
+    uint32_t h = s->pages * 8u - 1u;
+    if (v < s->lo) v = s->lo;
+    if (v > s->hi) v = s->hi;
+    uint32_t span = (uint32_t)(s->hi - s->lo);
+    return (uint8_t)(span ? h - (uint32_t)(v - s->lo) * h / span : h);
+}
+
+// 열 x 에 앞 열 높이부터 y 까지 (앞 열이 없으면 점 하나)
+static void DrawColumn(OledSpark *s, uint8_t *fb, uint8_t x, uint8_t y)
+{
+    uint8_t a = y, b = y;
+    if (s->has_last) {
+        if (s->last_y < a) a = s->last_y;
+        if (s->last_y > b) b = s->last_y;
+    }
+    uint32_t mask = (b >= 31 ? 0xFFFFFFFFu : ((1u << (b + 1)) - 1u)) & ~((1u << a) - 1u);
+    for (uint8_t p = 0; p < s->pages; p++)
+        fb[(s->page0 + p) * SSD1306_WIDTH + x] = (uint8_t)(mask >> (8 * p));
+    s->last_y = y;
+    s->has_last = 1;
+}
+
+int OledSpark_Push(OledSpark *s, const uint16_t *v, uint32_t n)
+{
+    if (n == 0)
+        return 0;
+    if (!s->ranged)
+        return 1;
+    for (uint32_t i = 0; i < n; i++)
+        if (v[i] < s->lo || v[i] > s->hi)
+            return 1;
+    if (n >= s->cols) {
+        OledSpark_Redraw(s, v, n);
+        return 0;
+    }
+
+    // 한 개면 패널도 같이 밀고, 아니면(또는 전송 중이면) 뒤 버퍼만 밀어서 Flush 가 차이를 보냄
+    uint8_t p1 = (uint8_t)(s->page0 + s->pages - 1);
+    uint8_t x1 = (uint8_t)(s->x0 + s->cols - 1);
+    if (n == 1 && s->hw_scroll && OledAsync_ScrollLeft(s->page0, p1, s->x0, x1) == 0)
+        s->hw_scrolls++;
+    else
+        s->sw_shifts++;
+
+    uint8_t *fb = SSD1306_GetBuffer();
+    for (uint8_t p = 0; p < s->pages; p++) {
+        uint8_t *row = &fb[(s->page0 + p) * SSD1306_WIDTH + s->x0];
+        memmove(row, row + n, s->cols - n);
+    }
+    for (uint32_t i = 0; i < n; i++)
+        DrawColumn(s, fb, (uint8_t)(x1 - (n - 1 - i)), OledSpark_Row(s, v[i]));
+    s->pushed += n;
+    return 0;
+}
+
+void OledSpark_Redraw(OledSpark *s, const uint16_t *v, uint32_t n)
+{
+    if (n > s->cols) {
+        v += n - s->cols;
+        n = s->cols;
+    }
+    s->redraws++;
+    s->has_last = 0;
+
+    if (n == 0) {
+        s->ranged = 0;
+        s->lo = 0;
+        s->hi = ADC_MAX;
+    } else {
+        // 최소~최대에 위아래로 폭의 1/4 씩 여유 (조금 움직일 때마다 다시 그리지 않게)
+        uint16_t mn = v[0], mx = v[0];
+        for (uint32_t i = 1; i < n; i++) {
+            if (v[i] < mn) mn = v[i];
+            if (v[i] > mx) mx = v[i];
+        }
+        int32_t pad = (mx - mn) / 4;
+        int32_t lo = mn - pad, hi = mx + pad;
+        if (hi - lo < OLED_SPARK_MIN_SPAN) {
+            lo = (mn + mx) / 2 - OLED_SPARK_MIN_SPAN / 2;
+            hi = lo + OLED_SPARK_MIN_SPAN;
+        }
+        if (lo < 0) {
+            hi -= lo;
+            lo = 0;
+        }
+        if (hi > ADC_MAX) {
+            lo -= hi - ADC_MAX;
+            hi = ADC_MAX;
+            if (lo < 0) lo = 0;
+        }
+        s->lo = (uint16_t)lo;
+        s->hi = (uint16_t)hi;
+        s->ranged = 1;
+    }
+
+    uint8_t *fb = SSD1306_GetBuffer();
+    for (uint8_t p = 0; p < s->pages; p++)
+        memset(&fb[(s->page0 + p) * SSD1306_WIDTH + s->x0], 0, s->cols);
+    uint8_t x = (uint8_t)(s->x0 + s->cols - n);
+    for (uint32_t i = 0; i < n; i++)
+        DrawColumn(s, fb, (uint8_t)(x + i), OledSpark_Row(s, v[i]));
+    s->pushed += n;
+}
@@ -0,0 +1,46 @@
+#ifndef OLED_SPARK_H
+#define OLED_SPARK_H
+
+#include <stdint.h>
+
+// SSD1306 스크롤 스파크라인: 화면의 페이지 구역에 최근 샘플을 한 열에 하나씩, 오른쪽이 최신.
+// 열마다 앞 샘플 높이부터 이번 높이까지 세로로 이어서 칠함 (선이 끊기지 않게)
+//
+// 새 샘플 하나는 뒤 버퍼의 구역을 한 열 왼쪽으로 밀고 오른쪽 끝 열만 그린다.
+// hw_scroll 이면 OledAsync_ScrollLeft 로 패널 RAM 도 같이 밀어서, 다음 Flush 가 보내는 건
+// 스크롤 명령 8 바이트 + 페이지마다 (주소 4 + 데이터 2) 바이트뿐이다.
+// hw_scroll 이 아니거나 한 번에 여러 개면 뒤 버퍼만 밀고 Flush 의 차이 비교가 페이지를 다시 보냄.
+//
+// 세로 범위는 고정이고, 범위를 벗어난 샘플이 오면 Push 가 1 을 돌려준다.
+// 그러면 호출한 쪽이 최근 기록으로 Redraw (범위를 다시 잡고 전부 그림) 한다.
+// 화면을 건드리는 건 SSD1306 뒤 버퍼와 oled_async 뿐: OledAsync_Init 뒤에 쓸 것.
+
+#define OLED_SPARK_MAX_PAGES    4           // 높이 32 까지 (열 하나를 uint32_t 로 만듦)
+#define OLED_SPARK_MIN_SPAN     32          // Redraw 가 잡는 범위의 최소 폭 (원값)
+
+typedef struct {
+    uint8_t x0;
+    uint8_t cols;
+    uint8_t page0;
+    uint8_t pages;
+    uint8_t hw_scroll;
+    uint8_t ranged;             // 0 이면 아직 데이터로 범위를 못 잡음
+    uint8_t last_y;             // 마지막 열의 높이 (0 = 맨 위)
+    uint8_t has_last;
+    uint16_t lo;                // 세로 범위 (원값, 포함)
+    uint16_t hi;
+    uint32_t pushed;            // 그린 샘플
+    uint32_t hw_scrolls;
+    uint32_t sw_shifts;
+    uint32_t redraws;
+} OledSpark;
+
+void OledSpark_Init(OledSpark *s, uint8_t x0, uint8_t cols, uint8_t page0, uint8_t pages, uint8_t hw_scroll);
+// 새 샘플 n 개 (오래된 것부터). 0 이면 그림, 1 이면 범위 밖이라 아무것도 안 그림 (Redraw 할 것)
+int OledSpark_Push(OledSpark *s, const uint16_t *v, uint32_t n);
+// 최근 샘플 n 개 (오래된 것부터, cols 개 넘으면 뒤쪽만)로 범위를 다시 잡고 구역 전체를 그림
+void OledSpark_Redraw(OledSpark *s, const uint16_t *v, uint32_t n);
+// 원값 → 구역 안의 행 (0 = 맨 위). 호스트 검사용
+uint8_t OledSpark_Row(const OledSpark *s, uint16_t v);
+
+#endif
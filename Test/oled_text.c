@@ -0,0 +1,97 @@
+#include "oled_text.h"
+#include "ssd1306.h"
+#include <string.h>
+
+#define UNKNOWN_CHAR    '\x01'      // 화면 내용을 모름 (Draw 가 반드시 다시 그림)
+
+int OledText_InitFont(OledFont *font, const FontDef_t *src, uint8_t *storage)
+{
+    uint8_t pages = (uint8_t)((src->FontHeight + 7) / 8);
+    if (pages > OLED_TEXT_MAX_PAGES || src->FontWidth > 16)
+        return -1;
+
+    font->width = src->FontWidth;
+    font->pages = pages;
+    font->glyphs = storage;
+    memset(storage, 0, OLED_TEXT_CACHE_BYTES(src->FontWidth, src->FontHeight));
+
+    // 원본 행 형식(행마다 uint16_t, 왼쪽 픽셀이 MSB)을 열마다 세로 바이트로
+    for (uint16_t ch = 0; ch < OLED_TEXT_GLYPHS; ch++) {
+        const uint16_t *rows = &src->data[ch * src->FontHeight];
+        uint8_t *g = &storage[ch * font->width * pages];
+        for (uint8_t row = 0; row < src->FontHeight; row++) {
+            uint16_t bits = rows[row];
+            uint8_t *dst = &g[(row / 8) * font->width];
+            uint8_t mask = (uint8_t)(1u << (row % 8));
+            for (uint8_t col = 0; col < font->width; col++) {
+                if ((bits << col) & 0x8000)
+                    dst[col] |= mask;
+            }
+        }
+    }
+    return 0;
+}
+
+void OledText_InitSlot(OledTextSlot *slot, const OledFont *font, uint8_t x, uint8_t page)
+{
+    slot->font = font;
+    slot->x = x;
+    slot->page = page;
+    // SSD1306_Putc 와 같은 규칙: 글자 오른쪽 끝이 마지막 열(127)을 넘지 않는 만큼
+    uint8_t fit = (uint8_t)((SSD1306_WIDTH - 1 - x) / font->width);
+    if (page + font->pages > SSD1306_HEIGHT / 8)
+        fit = 0;
+    slot->max_chars = fit < OLED_TEXT_MAX_CHARS ? fit : OLED_TEXT_MAX_CHARS;
+    OledText_Invalidate(slot);
+}
+
+void OledText_Invalidate(OledTextSlot *slot)
+{
+    memset(slot->shown, UNKNOWN_CHAR, slot->max_chars);
+    slot->shown[slot->max_chars] = '\0';
+}
+
+// 4 바이트씩 복사 (Cortex-M3 는 정렬 안 된 LDR/STR 을 한 번에 처리, memcpy 가 그렇게 컴파일됨)
+static inline void CopyCols(uint8_t *dst, const uint8_t *src, uint8_t n)
+{
+    while (n >= 4) {
+        uint32_t w;
+        memcpy(&w, src, 4);
+        memcpy(dst, &w, 4);
+        dst += 4;
+        src += 4;
+        n -= 4;
+    }
+    while (n--)
+        *dst++ = *src++;
+}
+
+uint8_t OledText_Draw(OledTextSlot *slot, const char *str)
+{
+    const OledFont *f = slot->font;
+    uint8_t *fb = SSD1306_GetBuffer();
+    uint16_t glyph_bytes = (uint16_t)(f->width * f->pages);
+    uint8_t redrawn = 0;
+    uint8_t ended = 0;
+
+    for (uint8_t i = 0; i < slot->max_chars; i++) {
+        char want = ' ';
+        if (!ended) {
+            if (str[i] == '\0')
+                ended = 1;
+            else
+                want = (str[i] < 32 || str[i] > 126) ? '?' : str[i];
+        }
+        if (slot->shown[i] == want)
+            continue;
+
+        const uint8_t *g = &f->glyphs[(want - OLED_TEXT_FIRST_CHAR) * glyph_bytes];
+        uint8_t *dst = &fb[slot->page * SSD1306_WIDTH + slot->x + i * f->width];
+        for (uint8_t p = 0; p < f->pages; p++)
+            CopyCols(dst + p * SSD1306_WIDTH, g + p * f->width, f->width);
+
+        slot->shown[i] = want;
+        redrawn++;
+    }
+    return redrawn;
+}
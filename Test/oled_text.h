@@ -0,0 +1,44 @@
+#ifndef OLED_TEXT_H
+#define OLED_TEXT_H
+
+#include <stdint.h>
+#include "fonts.h"
+
+// SSD1306 텍스트 레이어
+// 글자를 미리 SSD1306 프레임버퍼 형식(페이지 단위 세로 바이트)으로 바꿔 두고,
+// 슬롯(화면의 한 줄 자리)마다 지난번 문자열을 기억해서 바뀐 글자만 복사한다.
+// 슬롯은 페이지(8 행) 경계에 놓이므로 글자 하나는 페이지마다 FontWidth 바이트를 그대로 복사하면 된다.
+// 흰 글자 / 검은 바탕만 지원 (sub.c 가 쓰는 모양)
+
+#define OLED_TEXT_FIRST_CHAR    32
+#define OLED_TEXT_GLYPHS        95          // ASCII 32~126
+#define OLED_TEXT_MAX_PAGES     4           // 글자 높이 32 까지
+#define OLED_TEXT_MAX_CHARS     21          // 128 / 6
+
+typedef struct {
+    uint8_t width;
+    uint8_t pages;
+    uint8_t *glyphs;            // [글자][페이지][열], 글자당 width * pages 바이트
+} OledFont;
+
+typedef struct {
+    const OledFont *font;
+    uint8_t x;
+    uint8_t page;
+    uint8_t max_chars;
+    char shown[OLED_TEXT_MAX_CHARS + 1];
+} OledTextSlot;
+
+// 글자 캐시 크기 (바이트), storage 는 이만큼 있어야 함
+#define OLED_TEXT_CACHE_BYTES(w, h)     (OLED_TEXT_GLYPHS * (w) * (((h) + 7) / 8))
+
+// src 글꼴을 storage 에 래스터화, 글자 높이가 OLED_TEXT_MAX_PAGES 페이지를 넘으면 -1
+int OledText_InitFont(OledFont *font, const FontDef_t *src, uint8_t *storage);
+// 슬롯을 비운 상태로 초기화 (화면은 건드리지 않음, 처음 Draw 때 전부 그림)
+void OledText_InitSlot(OledTextSlot *slot, const OledFont *font, uint8_t x, uint8_t page);
+// 지난번과 다른 글자만 프레임버퍼에 복사, 반환값은 다시 그린 글자 수
+uint8_t OledText_Draw(OledTextSlot *slot, const char *str);
+// 다음 Draw 가 전부 다시 그리도록 (다른 코드가 화면을 지운 뒤)
+void OledText_Invalidate(OledTextSlot *slot);
+
+#endif
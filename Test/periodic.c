@@ -0,0 +1,181 @@
+#include "main.h"
+#include "cmsis_os.h"
+#include "periodic.h"
+#include "dlog.h"
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#define PERIODIC_LOCK()     do {} while (0)
+#define PERIODIC_UNLOCK()   do {} while (0)
+#else
+#define PERIODIC_LOCK()     uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define PERIODIC_UNLOCK()   __set_PRIMASK(primask)
+#endif
+
+static PeriodicTask *tasks[PERIODIC_MAX];
+static uint8_t task_count = 0;
+
+// --- 시각: 틱 + 틱 안의 us (틱 1 kHz 가정) ---
+static void Now(uint32_t *tick, uint32_t *sub_us)
+{
+#ifdef HOST_BUILD
+    uint64_t us = HostOs_NowUs();
+    *tick = (uint32_t)(us / 1000u);
+    *sub_us = (uint32_t)(us % 1000u);
+#else
+    uint32_t t, val;
+    do {
+        t = osKernelSysTick();
+        val = SysTick->VAL;
+    } while (t != osKernelSysTick());      // 읽는 사이 틱이 넘어가면 다시
+    *tick = t;
+    *sub_us = (SysTick->LOAD - val) / (SystemCoreClock / 1000000u);
+#endif
+}
+
+// 격자 시각 release 부터 지금까지 (us, 넘치면 포화)
+static uint32_t Since(uint32_t release, uint32_t tick, uint32_t sub_us)
+{
+    uint32_t ms = tick - release;
+    if (ms >= UINT32_MAX / 1000u)
+        return UINT32_MAX;
+    return ms * 1000u + sub_us;
+}
+
+static uint8_t Bin(uint32_t us)
+{
+    uint8_t bin = 0;
+    us >>= 4;
+    while (us && bin < PERIODIC_BINS - 1) {
+        us >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+int Periodic_Init(PeriodicTask *p, const char *name, uint32_t period_ms, uint32_t deadline_ms)
+{
+    if (!p || period_ms == 0 || task_count >= PERIODIC_MAX)
+        return -1;
+    memset(p, 0, sizeof(*p));
+    p->name = name;
+    p->period_ms = period_ms;
+    p->deadline_us = (deadline_ms ? deadline_ms : period_ms) * 1000u;
+    tasks[task_count] = p;
+    return task_count++;
+}
+
+void Periodic_Wait(PeriodicTask *p)
+{
+    uint32_t tick, sub;
+    Now(&tick, &sub);
+    if (!p->started) {
+        // 첫 릴리스는 지금 틱
+        p->started = 1;
+        p->release_tick = tick;
+        p->runs++;
+        return;
+    }
+
+    // 지난 주기 마감
+    uint32_t resp = Since(p->release_tick, tick, sub);
+    uint32_t skip = 0;
+    uint32_t next = p->release_tick + p->period_ms;
+    if ((int32_t)(tick - next) >= (int32_t)p->period_ms) {
+        // 다음 릴리스 뒤 주기까지 넘김: 지나간 가장 최근 격자로 (밀린 주기를 몰아서 돌리지 않음)
+        skip = (tick - next) / p->period_ms;
+        p->release_tick += skip * p->period_ms;
+    }
+    {
+        PERIODIC_LOCK();
+        p->resp_hist[Bin(resp)]++;
+        if (resp > p->resp_max_us)
+            p->resp_max_us = resp;
+        if (resp > p->deadline_us)
+            p->misses++;
+        p->skipped += skip;
+        PERIODIC_UNLOCK();
+    }
+
+    osDelayUntil(&p->release_tick, p->period_ms);
+
+    Now(&tick, &sub);
+    uint32_t jitter = Since(p->release_tick, tick, sub);
+    PERIODIC_LOCK();
+    p->jitter_hist[Bin(jitter)]++;
+    if (jitter > p->jitter_max_us)
+        p->jitter_max_us = jitter;
+    p->runs++;
+    PERIODIC_UNLOCK();
+}
+
+int Periodic_Count(void)
+{
+    return task_count;
+}
+
+int Periodic_Get(int id, PeriodicTask *out)
+{
+    if (id < 0 || id >= task_count || !out)
+        return -1;
+    PERIODIC_LOCK();
+    memcpy(out, tasks[id], sizeof(*out));
+    PERIODIC_UNLOCK();
+    return 0;
+}
+
+uint32_t Periodic_Percentile(const uint32_t *hist, uint32_t permille)
+{
+    uint64_t total = 0, acc = 0;
+    for (uint8_t i = 0; i < PERIODIC_BINS; i++)
+        total += hist[i];
+    if (total == 0)
+        return 0;
+    for (uint8_t i = 0; i < PERIODIC_BINS; i++) {
+        acc += hist[i];
+        if (acc * 1000u >= total * permille)
+            return Periodic_BinUpperUs(i);
+    }
+    return Periodic_BinUpperUs(PERIODIC_BINS - 1);
+}
+
+void Periodic_Reset(int id)
+{
+    if (id < 0 || id >= task_count)
+        return;
+    PeriodicTask *p = tasks[id];
+    PERIODIC_LOCK();
+    p->runs = p->misses = p->skipped = 0;
+    p->jitter_max_us = p->resp_max_us = 0;
+    memset(p->jitter_hist, 0, sizeof(p->jitter_hist));
+    memset(p->resp_hist, 0, sizeof(p->resp_hist));
+    PERIODIC_UNLOCK();
+}
+
+// 분위수는 bin 윗값이라 최대보다 클 수 있음: 최대로 자름
+static uint32_t P99(const uint32_t *hist, uint32_t max_us)
+{
+    uint32_t us = Periodic_Percentile(hist, 990);
+    return us < max_us ? us : max_us;
+}
+
+void Periodic_Report(void)
+{
+    PeriodicTask s;
+    for (int i = 0; i < task_count; i++) {
+        Periodic_Get(i, &s);
+        DLOG("PER %u run %u miss %u skip %u jit %u/%u resp %u/%u us\r\n",
+             (unsigned)i, (unsigned)s.runs, (unsigned)s.misses, (unsigned)s.skipped,
+             (unsigned)P99(s.jitter_hist, s.jitter_max_us), (unsigned)s.jitter_max_us,
+             (unsigned)P99(s.resp_hist, s.resp_max_us), (unsigned)s.resp_max_us);
+    }
+}
+
+void Periodic_ReportNames(void)
+{
+    for (int i = 0; i < task_count; i++) {
+        DLog_Text("PER %d = %s %lu ms dl %lu us\r\n", i, tasks[i]->name,
+                  (unsigned long)tasks[i]->period_ms, (unsigned long)tasks[i]->deadline_us);
+    }
+}
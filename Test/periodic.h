@@ -0,0 +1,71 @@
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 주기 태스크: osDelay(period) 대신 osDelayUntil 로 틱 격자에 맞춰 깨우고,
+// 매 주기마다 릴리스 지터(격자에서 실제 시작까지)와 응답 시간(격자에서 다음 대기 진입까지)을 잰다.
+// 응답 시간이 마감을 넘으면 miss, 다음 릴리스까지 넘기면 그 주기들은 건너뛰고 (skip) 격자로 되돌아간다
+// (vTaskDelayUntil 처럼 밀린 주기를 몰아서 돌리지 않음: 샘플 간격이 뭉치는 것보다 비는 게 낫다).
+//
+//   static PeriodicTask adc_period;
+//   Periodic_Init(&adc_period, "adc", 100, 20);     // main 에서, osKernelStart 전
+//   for (;;) {
+//       Periodic_Wait(&adc_period);
+//       ... 한 주기 일 ...
+//   }
+//
+// 시각은 틱(osKernelSysTick) + SysTick 카운터로 만든 us (타깃), HostOs_NowUs (호스트).
+// FreeRTOSConfig.h 에 INCLUDE_vTaskDelayUntil 1 필요 (cmsis_os.c 의 osDelayUntil).
+//
+// 히스토그램: bin 0 = 16 us 미만, bin k = [2^(k+3), 2^(k+4)) us, 마지막 bin 은 262 ms 이상 전부.
+
+#define PERIODIC_MAX            8
+#define PERIODIC_BINS           16
+
+typedef struct {
+    const char *name;
+    uint32_t period_ms;
+    uint32_t deadline_us;
+    uint32_t release_tick;      // 지금 주기의 격자 시각 (osDelayUntil 의 PreviousWakeTime)
+    uint8_t started;
+    uint32_t runs;
+    uint32_t misses;            // 응답 시간 > 마감
+    uint32_t skipped;           // 넘겨 버린 릴리스 수
+    uint32_t jitter_max_us;
+    uint32_t resp_max_us;
+    uint32_t jitter_hist[PERIODIC_BINS];
+    uint32_t resp_hist[PERIODIC_BINS];
+} PeriodicTask;
+
+// 등록 (PERIODIC_MAX 까지), 반환값은 리포트 번호 또는 -1
+int Periodic_Init(PeriodicTask *p, const char *name, uint32_t period_ms, uint32_t deadline_ms);
+// 주기 맨 앞에서 호출: 지난 주기를 마감하고 다음 릴리스까지 잠든다 (처음 한 번은 바로 돌아옴)
+void Periodic_Wait(PeriodicTask *p);
+
+int Periodic_Count(void);
+// 통계 복사 (다른 태스크에서 읽을 때)
+int Periodic_Get(int id, PeriodicTask *out);
+// 히스토그램에서 permille 분위수가 들어간 bin 의 윗값 (us)
+uint32_t Periodic_Percentile(const uint32_t *hist, uint32_t permille);
+void Periodic_Reset(int id);
+
+// "PER <id> run .. miss .. skip .. jit <p99>/<max> resp <p99>/<max> us" 태스크마다 한 줄 (DLOG)
+void Periodic_Report(void);
+// "PER <id> = <name> <period> ms dl <deadline> us" (텍스트, 시작할 때 한 번)
+void Periodic_ReportNames(void);
+
+static inline uint32_t Periodic_BinUpperUs(uint8_t bin)
+{
+    return bin + 1u >= PERIODIC_BINS ? UINT32_MAX : 16u << bin;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
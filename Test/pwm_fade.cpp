@@ -0,0 +1,200 @@
+// pwm_fade.cpp
+// LED 밝기 엔진: 감마 테이블은 board.hpp 설정으로 컴파일 중에 만들어져 플래시에 있고,
+// 페이드는 미리 계산한 CCR 프레임을 TIM1 갱신 이벤트마다 DMA 가 버스트로 넣는다.
+#include "board.hpp"
+#include "pwm_fade.h"
+
+namespace {
+
+constexpr led::Bank kBank = Board::led_pwm;
+constexpr auto kLut = led::MakeGamma<PWM_FADE_LEVELS, kBank.arr>(Board::led_curve, Board::led_gamma_x100);
+
+static_assert(led::BankValid(kBank), "LED 뱅크: TIM1 / DMA1 채널 5 / CH4 는 N 없음 / PWM 200 Hz 이상이어야 함");
+static_assert(led::GammaValid(kLut, kBank.arr), "감마 테이블이 0 ~ ARR 단조 증가가 아님");
+static_assert(PWM_FADE_CHANNELS == 4, "프레임은 DMAR 버스트 한 번에 CCR1~4");
+static_assert(PWM_FADE_MAX_FRAMES * 4 <= 0xFFFF, "DMA CNDTR 는 16비트");
+
+constexpr uint32_t kTim = bsp::addr::TIM1;
+constexpr uint32_t kDma = bsp::addr::DmaChannel(kBank.dma_channel);
+constexpr uint8_t kDmaIrq = 15;            // DMA1_Channel5_IRQn
+// 메모리 -> DMAR, 16비트, 메모리 증가, 완료 인터럽트 (EN 은 따로)
+constexpr uint32_t kDmaCfg = bsp::bits::DMA_CCR_DIR | bsp::bits::DMA_CCR_MINC | bsp::bits::DMA_CCR_P16 |
+                             bsp::bits::DMA_CCR_M16 | bsp::bits::DMA_CCR_TCIE;
+// DCR: 시작 = CCR1 (0x34 / 4), 길이 4
+constexpr uint32_t kDcr = (bsp::addr::TIM_CCR1 / 4u) | (3u << 8);
+
+uint16_t frames[PWM_FADE_MAX_FRAMES][4];
+uint16_t level[4];                  // 페이드 중이 아닐 때 채널마다 단계
+uint16_t from[4], to[4];            // 진행 중인 페이드
+uint16_t n_frames;
+volatile uint8_t busy;
+PwmFadeStats stats;
+
+inline uint32_t Ccr(int ch) { return kTim + bsp::addr::TIM_CCR1 + 4u * (uint32_t)ch; }
+
+inline uint16_t Lerp(int ch, uint32_t done)
+{
+    int32_t d = (int32_t)to[ch] - (int32_t)from[ch];
+    return (uint16_t)((int32_t)from[ch] + d * (int32_t)done / (int32_t)n_frames);
+}
+
+// DMA 가 넣은 프레임 수 (버스트 도중에 멈췄으면 넣다 만 프레임까지)
+uint32_t FramesDone()
+{
+    uint32_t left = bsp::reg::Read(kDma + bsp::addr::DMA_CNDTR) & 0xFFFFu;
+    return ((uint32_t)n_frames * 4u - left + 3u) / 4u;
+}
+
+// 페이드를 그 자리에서 멈춤: 넣은 데까지를 지금 값으로, 넣다 만 프레임은 CCR 을 다시 써서 맞춤.
+// RCR 이 크면 다음 갱신이 최대 233 ms 뒤라 RCR = 0 + UG 로 바로 내보냄 (주기 하나가 짧아질 뿐)
+void Stop()
+{
+    using namespace bsp;
+    reg::Write(kTim + addr::TIM_DIER, reg::Read(kTim + addr::TIM_DIER) & ~bits::TIM_DIER_UDE);
+    reg::Write(kDma + addr::DMA_CCR, kDmaCfg);
+    reg::Write(addr::DMA1 + addr::DMA_IFCR, bits::DmaCgif(kBank.dma_channel));
+    uint32_t done = FramesDone();
+    for (int ch = 0; ch < 4; ch++) {
+        level[ch] = Lerp(ch, done);
+        if (kBank.out[(size_t)ch] != led::Out::None)
+            reg::Write(Ccr(ch), kLut[level[ch]]);
+    }
+    reg::Write(kTim + addr::TIM_RCR, 0);
+    reg::Write(kTim + addr::TIM_EGR, bits::TIM_EGR_UG);
+    busy = 0;
+}
+
+} // namespace
+
+extern "C" void PwmFade_Init(void)
+{
+    using namespace bsp;
+    reg::Write(addr::RCC_AHBENR, reg::Read(addr::RCC_AHBENR) | bits::AHB_DMA1);
+    reg::Write(addr::RCC_APB2ENR, reg::Read(addr::RCC_APB2ENR) | bits::APB2_TIM1);
+
+    // PWM1 + CCR 프리로드, 켜진 출력만 CCxE / CCxNE (극성 그대로: N 만 켜면 OCxN = OCxREF)
+    constexpr uint32_t oc = bits::TIM_OC_PWM1 | bits::TIM_OC_PE;
+    uint32_t ccer = 0;
+    for (int ch = 0; ch < 4; ch++) {
+        if (kBank.out[(size_t)ch] == led::Out::Main) ccer |= 1u << (4 * ch);
+        if (kBank.out[(size_t)ch] == led::Out::Comp) ccer |= 4u << (4 * ch);
+    }
+    reg::Write(kTim + addr::TIM_PSC, 0);
+    reg::Write(kTim + addr::TIM_ARR, kBank.arr);
+    reg::Write(kTim + addr::TIM_RCR, 0);
+    reg::Write(kTim + addr::TIM_CCMR1, oc | (oc << 8));
+    reg::Write(kTim + addr::TIM_CCMR2, oc | (oc << 8));
+    for (int ch = 0; ch < 4; ch++) {
+        reg::Write(Ccr(ch), 0);
+        level[ch] = 0;
+    }
+    reg::Write(kTim + addr::TIM_CCER, ccer);
+    reg::Write(kTim + addr::TIM_DCR, kDcr);
+    reg::Write(kTim + addr::TIM_BDTR, bits::TIM_BDTR_MOE);
+    reg::Write(kTim + addr::TIM_CR1, bits::TIM_CR1_ARPE | bits::TIM_CR1_CEN);
+    reg::Write(kTim + addr::TIM_EGR, bits::TIM_EGR_UG);
+
+    reg::Write(kDma + addr::DMA_CCR, kDmaCfg);
+    reg::Write(kDma + addr::DMA_CPAR, kTim + addr::TIM_DMAR);
+    reg::Write8(addr::NVIC_IPR + kDmaIrq, (uint8_t)(15u << 4));       // 가장 낮게: 끝 처리만 함
+    reg::Write(addr::NVIC_ISER, 1u << kDmaIrq);
+
+    busy = 0;
+    stats = PwmFadeStats();
+}
+
+extern "C" void PwmFade_Set(uint8_t ch, uint16_t lvl)
+{
+    if (ch >= 4 || lvl >= PWM_FADE_LEVELS)
+        return;
+    if (busy)
+        Stop();
+    level[ch] = lvl;
+    bsp::reg::Write(Ccr(ch), kLut[lvl]);
+}
+
+extern "C" int PwmFade_To(const uint16_t *targets, uint32_t ms)
+{
+    using namespace bsp;
+    if (!targets)
+        return -1;
+    for (int ch = 0; ch < 4; ch++)
+        if (targets[ch] != PWM_FADE_KEEP && targets[ch] >= PWM_FADE_LEVELS)
+            return -1;
+    if (busy) {
+        Stop();
+        stats.retargets++;
+    }
+    for (int ch = 0; ch < 4; ch++) {
+        from[ch] = level[ch];
+        to[ch] = targets[ch] == PWM_FADE_KEEP ? level[ch] : targets[ch];
+    }
+
+    // 버퍼에 들어가는 가장 짧은 단계 간격
+    uint32_t us = ms * 1000u, rcr = 0;
+    while (rcr < 255 && (us + led::StepUs(kBank, rcr) - 1) / led::StepUs(kBank, rcr) > PWM_FADE_MAX_FRAMES)
+        rcr++;
+    uint32_t step = led::StepUs(kBank, rcr);
+    uint32_t n = (us + step / 2) / step;
+    if (n > PWM_FADE_MAX_FRAMES) {
+        n = PWM_FADE_MAX_FRAMES;
+        stats.clamped++;
+    }
+    if (n == 0)
+        n = 1;
+    n_frames = (uint16_t)n;
+    for (uint32_t i = 0; i < n; i++)
+        for (int ch = 0; ch < 4; ch++)
+            frames[i][ch] = kBank.out[(size_t)ch] != led::Out::None ? kLut[Lerp(ch, i + 1)] : 0;
+
+    // RCR 을 쓰고 UG: 지금부터 단계가 시작되고, UG 의 DMA 요청으로 첫 프레임이 프리로드에 들어감
+    reg::Write(kTim + addr::TIM_RCR, rcr);
+    reg::Write(kDma + addr::DMA_CCR, kDmaCfg);
+    reg::Write(addr::DMA1 + addr::DMA_IFCR, bits::DmaCgif(kBank.dma_channel));
+    reg::Write(kDma + addr::DMA_CMAR, (uint32_t)(uintptr_t)&frames[0][0]);
+    reg::Write(kDma + addr::DMA_CNDTR, n * 4u);
+    reg::Write(kDma + addr::DMA_CCR, kDmaCfg | bits::DMA_CCR_EN);
+    busy = 1;
+    reg::Write(kTim + addr::TIM_DIER, reg::Read(kTim + addr::TIM_DIER) | bits::TIM_DIER_UDE);
+    reg::Write(kTim + addr::TIM_EGR, bits::TIM_EGR_UG);
+
+    stats.fades++;
+    stats.last_frames = (uint16_t)n;
+    stats.last_rcr = (uint8_t)rcr;
+    return 0;
+}
+
+extern "C" int PwmFade_Busy(void)
+{
+    return busy;
+}
+
+extern "C" uint16_t PwmFade_Level(uint8_t ch)
+{
+    if (ch >= 4)
+        return 0;
+    if (busy)
+        return Lerp(ch, FramesDone());
+    return level[ch];
+}
+
+// 마지막 프레임은 방금 프리로드에 들어갔고 다음 갱신에 나간다. 여기서는 DMA 요청만 끔
+extern "C" void PwmFade_DmaIrq(void)
+{
+    using namespace bsp;
+    if (!(reg::Read(addr::DMA1 + addr::DMA_ISR) & bits::DmaTcif(kBank.dma_channel)))
+        return;
+    reg::Write(addr::DMA1 + addr::DMA_IFCR, bits::DmaCgif(kBank.dma_channel));
+    reg::Write(kTim + addr::TIM_DIER, reg::Read(kTim + addr::TIM_DIER) & ~bits::TIM_DIER_UDE);
+    reg::Write(kDma + addr::DMA_CCR, kDmaCfg);
+    reg::Write(kTim + addr::TIM_RCR, 0);        // 다음 PwmFade_Set 이 한 주기 안에 나가게
+    for (int ch = 0; ch < 4; ch++)
+        level[ch] = to[ch];
+    busy = 0;
+    stats.completed++;
+}
+
+extern "C" const PwmFadeStats *PwmFade_Stats(void)
+{
+    return &stats;
+}
@@ -0,0 +1,59 @@
+#ifndef PWM_FADE_H
+#define PWM_FADE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// LED 밝기 엔진 (TIM1 CH1~4, board.hpp 의 led_pwm). 밝기는 ai.py 와 같은 0~999 단계이고
+// 컴파일 중에 만든 감마 테이블로 CCR 이 된다.
+//
+// 페이드: PwmFade_To 가 단계마다의 CCR 값(채널 4 개 한 묶음 = 프레임)을 버퍼에 미리 다 계산해 두고
+// TIM1 갱신 이벤트마다 DMA 가 DMAR 버스트로 한 프레임씩 CCR1~4 에 넣는다. 단계 간격은 반복 카운터로
+// (RCR+1) PWM 주기. 페이드 도중에는 CPU 가 하는 일이 없고, 끝날 때 DMA 완료 인터럽트 한 번뿐이다.
+// CCR 프리로드라 값은 다음 갱신에 바뀌어 주기 중간에 튀지 않는다.
+//
+// 레지스터는 bsp::reg 로만 만진다 (HOST_BUILD 는 host/pwm_sim 의 TIM1 + DMA 모델).
+
+#define PWM_FADE_CHANNELS       4
+#define PWM_FADE_LEVELS         1000        // 0 = 꺼짐, 999 = 100%
+#define PWM_FADE_KEEP           0xFFFFu     // PwmFade_To: 이 채널은 지금 값 그대로
+#define PWM_FADE_MAX_FRAMES     128         // 페이드 한 번의 단계 수 한도 (버퍼 1 KB)
+
+typedef struct {
+    uint32_t fades;             // PwmFade_To 로 시작한 페이드
+    uint32_t retargets;         // 그중 진행 중인 페이드를 그 자리에서 이어받은 것
+    uint32_t completed;         // DMA 완료 인터럽트 (= 끝까지 간 페이드)
+    uint32_t clamped;           // 너무 길어서 최대 길이로 줄인 것
+    uint16_t last_frames;       // 마지막 페이드의 단계 수
+    uint8_t last_rcr;           // 마지막 페이드의 RCR (단계 = RCR+1 PWM 주기)
+} PwmFadeStats;
+
+// 클럭, TIM1 (PWM1, 프리로드, MOE), DMA1 채널 5, NVIC. 핀은 Board_Init (board.hpp pins)
+void PwmFade_Init(void);
+
+// 바로 바꿈. 페이드 중이면 그 자리에서 멈추고 (다른 채널은 지금 위치에 남음)
+void PwmFade_Set(uint8_t ch, uint16_t level);
+
+// 채널마다 목표 단계 (PWM_FADE_KEEP 은 그대로) 로 ms 동안. 페이드 중이면 지금 위치에서 이어받음.
+// 단계 간격은 PWM_FADE_MAX_FRAMES 에 들어가는 가장 짧은 것 (1 주기 0.9 ms ~ 256 주기 233 ms),
+// 그래서 최대 길이는 약 29.8 초 (넘으면 줄이고 clamped). 0 이면 성공, -1 이면 인자 오류
+int PwmFade_To(const uint16_t *targets, uint32_t ms);
+
+int PwmFade_Busy(void);
+
+// 지금 밝기 단계. 페이드 중이면 DMA 남은 개수로 어디까지 왔는지 계산
+uint16_t PwmFade_Level(uint8_t ch);
+
+// DMA1_Channel5_IRQHandler 에서 부름
+void PwmFade_DmaIrq(void);
+
+const PwmFadeStats *PwmFade_Stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
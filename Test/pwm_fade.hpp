@@ -0,0 +1,149 @@
+// pwm_fade.hpp
+// LED 밝기 PWM: 감마 테이블을 컴파일 중에 만들고, 타이머 뱅크 설정을 static_assert 로 검사하는 부분
+//
+// 밝기 단계(ai.py 의 0~999)는 눈에 보이는 밝기로 고르게 나뉘어야 한다. 듀티를 단계에 비례시키면
+// (main.c 의 adc_value / 16) 어두운 쪽은 한 단계에 확 밝아지고 밝은 쪽은 차이가 안 보인다.
+// MakeGamma 는 단계 -> CCR 값을 constexpr 로 계산해 플래시에 둔다 (런타임 pow/float 없음).
+//   Curve::Cie   : CIE 1976 L* (지각 밝기) 가 단계에 비례. L* <= 8 은 선형 구간이라 0 근처도 매끄러움
+//   Curve::Power : 단계^gamma (gamma_x100 / 100, 흔히 2.2)
+//   Curve::Linear: 비교용
+// 0 은 꺼짐, 맨 끝은 Top (100%), 단조 증가가 아니면 빌드가 깨진다.
+#ifndef PWM_FADE_HPP
+#define PWM_FADE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace led {
+
+enum class Curve : uint8_t { Cie, Power, Linear };
+
+// 타이머 채널 출력: CHx 핀 또는 상보 CHxN 핀 (CH4 는 N 이 없음)
+enum class Out : uint8_t { None, Main, Comp };
+
+// 뱅크 하나 = 고급 타이머 하나의 CH1~4. 갱신 이벤트마다 DMA 가 DMAR 버스트로 CCR1~4 를 한 번에 씀.
+// 반복 카운터(RCR)가 갱신을 (RCR+1) 주기마다로 늦춰서 페이드 단계 간격이 된다.
+struct Bank {
+    uint8_t timer;              // 1 (F103 에서 RCR 이 있는 건 TIM1 뿐)
+    uint8_t dma_channel;        // DMA1 채널 (TIM1_UP = 5)
+    uint32_t timer_hz;          // 타이머 클럭 (APB2 분주 1 이면 PCLK2)
+    uint32_t arr;               // PWM 최대값 (주기 = arr + 1 클럭)
+    std::array<Out, 4> out;
+};
+
+namespace detail {
+
+// constexpr ln / exp (급수). x 는 (0, 1]
+constexpr double Ln(double x)
+{
+    int k = 0;
+    while (x < 0.5) {
+        x *= 2;
+        k++;
+    }
+    double z = (x - 1) / (x + 1), z2 = z * z, term = z, sum = 0;
+    for (int n = 1; n < 60; n += 2) {
+        sum += term / n;
+        term *= z2;
+    }
+    return 2 * sum - k * 0.69314718055994531;
+}
+
+constexpr double Exp(double y)
+{
+    int k = 0;
+    while (y < -0.5) {
+        y += 0.69314718055994531;
+        k++;
+    }
+    double term = 1, sum = 1;
+    for (int n = 1; n < 30; n++) {
+        term *= y / n;
+        sum += term;
+    }
+    for (; k > 0; k--)
+        sum /= 2;
+    return sum;
+}
+
+// 단계 t (0~1) -> 상대 밝기 (0~1)
+constexpr double Luminance(Curve c, double t, uint32_t gamma_x100)
+{
+    if (t <= 0)
+        return 0;
+    switch (c) {
+        case Curve::Cie: {
+            double l = t * 100;
+            if (l <= 8)
+                return l / 903.3;
+            double f = (l + 16) / 116;
+            return f * f * f;
+        }
+        case Curve::Power:
+            return Exp(gamma_x100 / 100.0 * Ln(t));
+        case Curve::Linear:
+            return t;
+    }
+    return t;
+}
+
+} // namespace detail
+
+template <uint32_t Levels, uint32_t Top>
+constexpr std::array<uint16_t, Levels> MakeGamma(Curve c, uint32_t gamma_x100 = 220)
+{
+    static_assert(Levels >= 2 && Top <= 65535, "단계는 2 개 이상, CCR 은 16비트");
+    std::array<uint16_t, Levels> lut{};
+    for (uint32_t i = 0; i < Levels; i++) {
+        double y = detail::Luminance(c, (double)i / (Levels - 1), gamma_x100);
+        lut[i] = (uint16_t)(y * Top + 0.5);
+    }
+    lut[Levels - 1] = (uint16_t)Top;
+    return lut;
+}
+
+template <size_t N>
+constexpr bool GammaValid(const std::array<uint16_t, N> &lut, uint32_t top)
+{
+    if (lut[0] != 0 || lut[N - 1] != top)
+        return false;
+    for (size_t i = 1; i < N; i++)
+        if (lut[i] < lut[i - 1]) return false;
+    return true;
+}
+
+// 서로 다른 CCR 값 개수 (같은 값이 이어지면 그 단계들은 눈으로 구분 안 됨)
+template <size_t N>
+constexpr uint32_t GammaDistinct(const std::array<uint16_t, N> &lut)
+{
+    uint32_t n = 1;
+    for (size_t i = 1; i < N; i++)
+        n += lut[i] != lut[i - 1] ? 1u : 0u;
+    return n;
+}
+
+constexpr uint32_t Channels(const Bank &b)
+{
+    uint32_t n = 0;
+    for (Out o : b.out)
+        n += o != Out::None ? 1u : 0u;
+    return n;
+}
+
+// TIM1 + TIM1_UP 의 DMA1 채널 5, CH4 에 N 출력 없음, PWM 주파수는 깜빡임이 안 보이게 200 Hz 이상
+constexpr bool BankValid(const Bank &b)
+{
+    return b.timer == 1 && b.dma_channel == 5 && b.arr >= 255 && b.arr <= 65535 && Channels(b) >= 1 &&
+           b.out[3] != Out::Comp && b.timer_hz / (b.arr + 1) >= 200;
+}
+
+// 페이드 단계 하나 (us), RCR = rcr 일 때
+constexpr uint32_t StepUs(const Bank &b, uint32_t rcr)
+{
+    return (uint32_t)((uint64_t)(rcr + 1) * (b.arr + 1) * 1000000u / b.timer_hz);
+}
+
+} // namespace led
+
+#endif
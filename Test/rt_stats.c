@@ -0,0 +1,257 @@
+#include "main.h"
+#include "rt_stats.h"
+#include "dlog.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#define RT_STATS_LOCK()     do {} while (0)
+#define RT_STATS_UNLOCK()   do {} while (0)
+#else
+#define RT_STATS_LOCK()     uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define RT_STATS_UNLOCK()   __set_PRIMASK(primask)
+#endif
+
+extern UART_HandleTypeDef huart1;
+
+static RtStatsEntry entries[RT_STATS_MAX_ENTRIES];
+static void *handles[RT_STATS_MAX_ENTRIES];
+static uint8_t entry_count = 0;
+
+static int current = -1;            // 실행 중인 태스크 엔트리
+static uint32_t run_start;
+static uint32_t isr_at_start;       // 태스크 시작 시점의 ISR 누적 시간
+static uint32_t isr_accum;          // 가장 바깥 ISR 들이 쓴 시간 합 (태스크 시간에서 뺌)
+static uint32_t isr_start[RT_STATS_MAX_ENTRIES];
+static uint32_t isr_outer_start;
+static uint8_t isr_depth = 0;
+static uint32_t window_start;
+static uint32_t last_window;
+
+// --- 사이클 카운터 ---
+static inline uint32_t Cycles(void)
+{
+#ifdef HOST_BUILD
+    // 가상 시간 (HostOs_Busy 로 흉내낸 실행 시간이 그대로 사이클이 됨)
+    return (uint32_t)(HostOs_NowUs() * (RT_STATS_CPU_HZ / 1000000u));
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+void RtStats_Init(void)
+{
+#ifndef HOST_BUILD
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    entry_count = 0;
+    current = -1;
+    isr_depth = 0;
+    isr_accum = 0;
+    window_start = Cycles();
+}
+
+static int Register(const char *name, void *handle, uint8_t kind)
+{
+    if (entry_count >= RT_STATS_MAX_ENTRIES)
+        return -1;
+    memset(&entries[entry_count], 0, sizeof(RtStatsEntry));
+    entries[entry_count].name = name;
+    entries[entry_count].kind = kind;
+    handles[entry_count] = handle;
+    return entry_count++;
+}
+
+int RtStats_RegisterTask(const char *name, void *handle)
+{
+    return handle ? Register(name, handle, RT_STATS_TASK) : -1;
+}
+
+int RtStats_RegisterIsr(const char *name)
+{
+    return Register(name, NULL, RT_STATS_ISR);
+}
+
+static void Account(int id, uint32_t run)
+{
+    RtStatsEntry *e = &entries[id];
+    e->total_cycles += run;
+    e->window_cycles += run;
+    e->window_runs++;
+    if (run > e->max_run_cycles)
+        e->max_run_cycles = run;
+}
+
+// --- 태스크 전환 (커널 안에서 호출, 이미 임계 구역) ---
+void RtStats_SwitchIn(void *handle)
+{
+    current = -1;
+    for (uint8_t i = 0; i < entry_count; i++) {
+        if (handles[i] == handle) {
+            current = i;
+            break;
+        }
+    }
+    run_start = Cycles();
+    isr_at_start = isr_accum;
+}
+
+void RtStats_SwitchOut(void *handle)
+{
+    if (current < 0 || handles[current] != handle)
+        return;
+    uint32_t run = Cycles() - run_start - (isr_accum - isr_at_start);
+    Account(current, run);
+    current = -1;
+}
+
+// --- ISR (중첩 허용, 바깥 ISR 시간만 태스크에서 뺌) ---
+void RtStats_IsrEnter(int id)
+{
+    uint32_t now = Cycles();
+    if (isr_depth++ == 0)
+        isr_outer_start = now;
+    if (id >= 0 && id < entry_count)
+        isr_start[id] = now;
+}
+
+void RtStats_IsrExit(int id)
+{
+    uint32_t now = Cycles();
+    if (id >= 0 && id < entry_count)
+        Account(id, now - isr_start[id]);
+    if (isr_depth > 0 && --isr_depth == 0)
+        isr_accum += now - isr_outer_start;
+}
+
+// --- 리포트 구간 ---
+void RtStats_CloseWindow(void)
+{
+    RT_STATS_LOCK();
+    uint32_t now = Cycles();
+    uint32_t elapsed = now - window_start;
+    if (elapsed == 0)
+        elapsed = 1;
+    for (uint8_t i = 0; i < entry_count; i++) {
+        RtStatsEntry *e = &entries[i];
+        uint32_t permille = (uint32_t)((uint64_t)e->window_cycles * 1000u / elapsed);
+        if (permille > 1000)
+            permille = 1000;
+        e->load_permille = (uint16_t)((3u * e->load_permille + permille) / 4u);
+    }
+    last_window = elapsed;
+    window_start = now;
+    RT_STATS_UNLOCK();
+}
+
+int RtStats_Get(int id, RtStatsEntry *out)
+{
+    if (id < 0 || id >= entry_count)
+        return -1;
+    *out = entries[id];
+    return 0;
+}
+
+int RtStats_Count(void)
+{
+    return entry_count;
+}
+
+static uint8_t *Put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *Put32(uint8_t *p, uint32_t v)
+{
+    p = Put16(p, (uint16_t)v);
+    return Put16(p, (uint16_t)(v >> 16));
+}
+
+// 호출 전에 RtStats_CloseWindow 로 구간을 마감해야 window_runs 가 의미 있음
+uint16_t RtStats_BuildFrame(uint8_t *buf, uint16_t size)
+{
+    uint16_t len = 4 + 4 + entry_count * 10 + 1;
+    if (size < len)
+        return 0;
+
+    RT_STATS_LOCK();
+    uint8_t *p = buf;
+    *p++ = 0xA5;
+    *p++ = 0x5A;
+    *p++ = 'R';
+    *p++ = entry_count;
+    p = Put32(p, last_window);
+    for (uint8_t i = 0; i < entry_count; i++) {
+        RtStatsEntry *e = &entries[i];
+        *p++ = i;
+        *p++ = e->kind;
+        p = Put16(p, e->load_permille);
+        p = Put16(p, e->window_runs);
+        p = Put32(p, e->max_run_cycles);
+        e->window_cycles = 0;
+        e->window_runs = 0;
+    }
+    RT_STATS_UNLOCK();
+
+    uint8_t sum = 0;
+    for (uint8_t *q = buf + 2; q < p; q++)
+        sum += *q;
+    *p++ = sum;
+    return (uint16_t)(p - buf);
+}
+
+void RtStats_Report(void)
+{
+    static uint8_t frame[4 + 4 + RT_STATS_MAX_ENTRIES * 10 + 1];
+    RtStats_CloseWindow();
+    uint16_t len = RtStats_BuildFrame(frame, sizeof(frame));
+    if (len)
+        HAL_UART_Transmit(&huart1, frame, len, HAL_MAX_DELAY);
+}
+
+// RtStats_Report 의 DLOG 판: 엔트리 하나를 레코드 하나로, UART 를 기다리지 않음 (슈퍼루프 잡에서).
+// 먼저 RtStats_CloseWindow 로 구간을 닫는다
+int RtStats_LogEntry(int id)
+{
+    if (id < 0 || id >= entry_count)
+        return -1;
+    RtStatsEntry e;
+    {
+        RT_STATS_LOCK();
+        e = entries[id];
+        entries[id].window_cycles = 0;
+        entries[id].window_runs = 0;
+        RT_STATS_UNLOCK();
+    }
+    DLOG("RTS %u load %u permille runs %u max %lu us\r\n", (unsigned)id, (unsigned)e.load_permille,
+         (unsigned)e.window_runs, (unsigned long)RtStats_CyclesToUs(e.max_run_cycles));
+    return 0;
+}
+
+// 프레임의 id 와 이름 매핑 (시작할 때 한 번)
+void RtStats_ReportNames(void)
+{
+    char msg[40];
+    for (uint8_t i = 0; i < entry_count; i++) {
+        snprintf(msg, sizeof(msg), "RTS %u %s %s\r\n", i,
+                 entries[i].kind == RT_STATS_ISR ? "isr" : "task", entries[i].name);
+        HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
+    }
+}
+
+#ifdef HOST_BUILD
+// host_os 스케줄러가 전환할 때마다 부름
+void HostOs_TraceSwitch(void *from, void *to)
+{
+    if (from)
+        RtStats_SwitchOut(from);
+    if (to)
+        RtStats_SwitchIn(to);
+}
+#endif
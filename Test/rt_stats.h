@@ -0,0 +1,63 @@
+#ifndef RT_STATS_H
+#define RT_STATS_H
+
+#include <stdint.h>
+
+// 태스크 / ISR 실행 시간 통계
+// - 타깃: DWT->CYCCNT (코어 클럭 사이클)
+// - 호스트(HOST_BUILD): host_os 가상 시간을 RT_STATS_CPU_HZ 사이클로 환산
+//
+// 태스크 전환은 FreeRTOSConfig.h 의 trace 매크로로 연결한다:
+//   #define traceTASK_SWITCHED_IN()   RtStats_SwitchIn((void*)pxCurrentTCB)
+//   #define traceTASK_SWITCHED_OUT()  RtStats_SwitchOut((void*)pxCurrentTCB)
+// ISR 은 핸들러(HAL 콜백) 앞뒤에 RtStats_IsrEnter(id) / RtStats_IsrExit(id) 를 넣는다 (sub.c).
+//
+// 리포트 프레임 (리틀 엔디언):
+//   0xA5 0x5A 'R' n | window_cycles(u32) | n x { id(u8) kind(u8) load_permille(u16) runs(u16) max_run_cycles(u32) } | sum(u8)
+//   sum 은 'R' 부터 마지막 엔트리까지 바이트 합
+
+#define RT_STATS_MAX_ENTRIES    12
+#define RT_STATS_CPU_HZ         72000000u
+#define RT_STATS_PERIOD_MS      1000
+
+typedef enum {
+    RT_STATS_TASK = 0,
+    RT_STATS_ISR  = 1
+} RtStatsKind;
+
+typedef struct {
+    const char *name;
+    uint8_t kind;
+    uint64_t total_cycles;      // 누적
+    uint32_t max_run_cycles;    // 한 번 실행의 최대
+    uint32_t window_cycles;     // 이번 리포트 구간
+    uint16_t window_runs;
+    uint16_t load_permille;     // 구간별 사용률의 이동 평균 (1/4 가중)
+} RtStatsEntry;
+
+void RtStats_Init(void);
+int RtStats_RegisterTask(const char *name, void *handle);
+int RtStats_RegisterIsr(const char *name);
+
+void RtStats_SwitchIn(void *handle);
+void RtStats_SwitchOut(void *handle);
+void RtStats_IsrEnter(int id);
+void RtStats_IsrExit(int id);
+
+// 구간을 마감하고 사용률을 갱신 (RtStats_Report 가 호출)
+void RtStats_CloseWindow(void);
+int RtStats_Get(int id, RtStatsEntry *out);
+int RtStats_Count(void);
+
+// 프레임을 만들어 buf 에 씀, 반환값은 길이 (모자라면 0)
+uint16_t RtStats_BuildFrame(uint8_t *buf, uint16_t size);
+void RtStats_Report(void);
+int RtStats_LogEntry(int id);
+void RtStats_ReportNames(void);
+
+static inline uint32_t RtStats_CyclesToUs(uint32_t cycles)
+{
+    return cycles / (RT_STATS_CPU_HZ / 1000000u);
+}
+
+#endif
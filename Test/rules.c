@@ -0,0 +1,301 @@
+#include "rules.h"
+#include <string.h>
+
+#ifdef HOST_BUILD
+#define RULES_LOCK()        do {} while (0)
+#define RULES_UNLOCK()      do {} while (0)
+#else
+#include "main.h"
+#define RULES_LOCK()        uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define RULES_UNLOCK()      __set_PRIMASK(primask)
+#endif
+
+#define STATE_UNKNOWN       0xFFu
+
+static RulesEngine default_engine;
+
+void RulesEngine_Init(RulesEngine *eng)
+{
+    memset(eng, 0, sizeof(*eng));
+    eng->active = &eng->banks[0];
+    eng->staged = &eng->banks[1];
+}
+
+void RulesEngine_SetOutput(RulesEngine *eng, uint8_t out, RuleOutputFn fn)
+{
+    if (out < RULES_MAX_OUTPUTS)
+        eng->outputs[out] = fn;
+}
+
+// --- 검사 ---
+static int OutputOk(uint8_t out)
+{
+    return out == RULES_OUT_NONE || out < RULES_MAX_OUTPUTS;
+}
+
+static int RuleOk(const Rule *r)
+{
+    if (r->kind >= RULE_KIND_COUNT || r->input >= RULES_MAX_INPUTS || (r->flags & ~RULE_F_BELOW))
+        return 0;
+    if (!OutputOk(r->out_on) || !OutputOk(r->out_off))
+        return 0;
+    switch (r->kind) {
+        case RULE_HYSTERESIS:
+            return (r->flags & RULE_F_BELOW) ? r->b >= r->a : r->b <= r->a;
+        case RULE_WINDOW:
+            return r->param >= 1 && r->param <= 32 && r->b >= 1 && r->b <= r->param;
+        default:
+            return 1;
+    }
+}
+
+static int Stage(RulesEngine *eng, const Rule *rules, uint8_t count)
+{
+    if (count > RULES_MAX) {
+        eng->stats.load_errors++;
+        return RULES_ERR_FORMAT;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (!RuleOk(&rules[i])) {
+            eng->stats.load_errors++;
+            return RULES_ERR_RULE;
+        }
+    }
+
+    // 예비 벌은 평가 쪽이 바꿔 끼우기 전까지 한 번만 채울 수 있음
+    {
+        RULES_LOCK();
+        uint8_t busy = eng->pending;
+        if (!busy)
+            eng->pending = 2;   // 채우는 중
+        RULES_UNLOCK();
+        if (busy) {
+            eng->stats.load_errors++;
+            return RULES_ERR_BUSY;
+        }
+    }
+    memcpy(eng->staged->rules, rules, (size_t)count * sizeof(Rule));
+    eng->staged->count = count;
+    eng->stats.loads++;
+    eng->pending = 1;
+    return RULES_OK;
+}
+
+int RulesEngine_LoadTable(RulesEngine *eng, const Rule *rules, uint8_t count)
+{
+    return Stage(eng, rules, count);
+}
+
+// --- 블롭 ---
+static uint16_t Crc16(uint16_t crc, const uint8_t *p, uint32_t len)
+{
+    while (len--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (int i = 0; i < 8; i++)
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+static int32_t GetI32(const uint8_t *p)
+{
+    return (int32_t)((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+static void PutI32(uint8_t *p, int32_t v)
+{
+    uint32_t u = (uint32_t)v;
+    p[0] = (uint8_t)u;
+    p[1] = (uint8_t)(u >> 8);
+    p[2] = (uint8_t)(u >> 16);
+    p[3] = (uint8_t)(u >> 24);
+}
+
+int RulesEngine_LoadBlob(RulesEngine *eng, const uint8_t *blob, uint32_t len)
+{
+    if (!blob || len < RULES_BLOB_HEADER || memcmp(blob, "RULE", 4) != 0 ||
+        blob[4] != RULES_BLOB_VERSION || blob[5] > RULES_MAX || len != (uint32_t)RULES_BLOB_SIZE(blob[5])) {
+        eng->stats.load_errors++;
+        return RULES_ERR_FORMAT;
+    }
+    uint8_t count = blob[5];
+    uint16_t crc = Crc16(0xFFFFu, blob, 6);
+    crc = Crc16(crc, blob + RULES_BLOB_HEADER, (uint32_t)count * RULES_BLOB_RULE);
+    if (crc != (uint16_t)(blob[6] | (blob[7] << 8))) {
+        eng->stats.load_errors++;
+        return RULES_ERR_CRC;
+    }
+
+    // 스택을 아끼려고 정적 버퍼에 풀어냄 (엔진이 여럿이어도 LoadBlob 을 두 곳에서 동시에 부르지 않을 것)
+    static Rule decoded[RULES_MAX];
+    const uint8_t *p = blob + RULES_BLOB_HEADER;
+    for (uint8_t i = 0; i < count; i++, p += RULES_BLOB_RULE) {
+        Rule *r = &decoded[i];
+        r->kind = p[0];
+        r->flags = p[1];
+        r->input = p[2];
+        r->param = p[3];
+        r->a = GetI32(p + 4);
+        r->b = GetI32(p + 8);
+        r->out_on = p[12];
+        r->arg_on = p[13];
+        r->out_off = p[14];
+        r->arg_off = p[15];
+    }
+    return Stage(eng, decoded, count);
+}
+
+int Rules_Encode(const Rule *rules, uint8_t count, uint8_t *out, uint32_t cap)
+{
+    if (count > RULES_MAX || cap < RULES_BLOB_SIZE((uint32_t)count))
+        return -1;
+    memcpy(out, "RULE", 4);
+    out[4] = RULES_BLOB_VERSION;
+    out[5] = count;
+    uint8_t *p = out + RULES_BLOB_HEADER;
+    for (uint8_t i = 0; i < count; i++, p += RULES_BLOB_RULE) {
+        const Rule *r = &rules[i];
+        p[0] = r->kind;
+        p[1] = r->flags;
+        p[2] = r->input;
+        p[3] = r->param;
+        PutI32(p + 4, r->a);
+        PutI32(p + 8, r->b);
+        p[12] = r->out_on;
+        p[13] = r->arg_on;
+        p[14] = r->out_off;
+        p[15] = r->arg_off;
+    }
+    uint16_t crc = Crc16(0xFFFFu, out, 6);
+    crc = Crc16(crc, out + RULES_BLOB_HEADER, (uint32_t)count * RULES_BLOB_RULE);
+    out[6] = (uint8_t)crc;
+    out[7] = (uint8_t)(crc >> 8);
+    return (int)RULES_BLOB_SIZE((uint32_t)count);
+}
+
+// --- 평가 ---
+static void Swap(RulesEngine *eng)
+{
+    RuleBank *old = eng->active;
+    eng->active = eng->staged;
+    eng->staged = old;
+    memset(eng->states, 0, sizeof(eng->states));
+    for (uint8_t i = 0; i < eng->active->count; i++)
+        eng->states[i].state = STATE_UNKNOWN;
+    eng->stats.count = eng->active->count;
+    eng->pending = 0;
+}
+
+static inline int Above(const Rule *r, int32_t value, int32_t limit)
+{
+    return (r->flags & RULE_F_BELOW) ? value < limit : value > limit;
+}
+
+uint32_t RulesEngine_Eval(RulesEngine *eng, uint8_t input, int32_t value, uint32_t now_ms)
+{
+    if (eng->pending == 1)
+        Swap(eng);
+
+    uint32_t fired = 0;
+    uint32_t checks = 0;
+    const Rule *r = eng->active->rules;
+    RuleState *s = eng->states;
+    for (uint8_t i = eng->active->count; i; i--, r++, s++) {
+        if (r->input != input)
+            continue;
+        checks++;
+
+        uint8_t cond;
+        switch (r->kind) {
+            case RULE_THRESHOLD:
+                cond = (uint8_t)Above(r, value, r->a);
+                break;
+            case RULE_HYSTERESIS:
+                if (Above(r, value, r->a))
+                    cond = 1;
+                else if (!Above(r, value, r->b) && value != r->b)
+                    cond = 0;
+                else
+                    cond = s->state == 1;
+                break;
+            case RULE_RATE: {
+                // 나눗셈 없이: (value - prev) * 1000 > a * dt
+                cond = 0;
+                uint32_t dt = now_ms - s->prev_ms;
+                if (s->primed && dt) {
+                    int64_t lhs = ((int64_t)value - s->prev) * 1000;
+                    int64_t rhs = (int64_t)r->a * dt;
+                    cond = (uint8_t)((r->flags & RULE_F_BELOW) ? lhs < rhs : lhs > rhs);
+                }
+                s->prev = value;
+                s->prev_ms = now_ms;
+                s->primed = 1;
+                break;
+            }
+            case RULE_WINDOW: {
+                uint32_t mask = r->param >= 32 ? 0xFFFFFFFFu : ((1u << r->param) - 1u);
+                s->hist = ((s->hist << 1) | (uint32_t)Above(r, value, r->a)) & mask;
+                cond = (uint8_t)(__builtin_popcount(s->hist) >= r->b);
+                break;
+            }
+            default:
+                continue;
+        }
+
+        // 조건이 바뀐 때(처음 포함)만 동작
+        if (cond != s->state) {
+            s->state = cond;
+            uint8_t out = cond ? r->out_on : r->out_off;
+            if (out != RULES_OUT_NONE && eng->outputs[out]) {
+                eng->outputs[out](cond ? r->arg_on : r->arg_off);
+                fired++;
+            }
+        }
+    }
+
+    eng->stats.evals++;
+    eng->stats.checks += checks;
+    eng->stats.actions += fired;
+    return fired;
+}
+
+void RulesEngine_GetStats(const RulesEngine *eng, RulesStats *out)
+{
+    *out = eng->stats;
+}
+
+// --- 기본 엔진 ---
+RulesEngine *Rules_Default(void)
+{
+    return &default_engine;
+}
+
+void Rules_Init(void)
+{
+    RulesEngine_Init(&default_engine);
+}
+
+void Rules_SetOutput(uint8_t out, RuleOutputFn fn)
+{
+    RulesEngine_SetOutput(&default_engine, out, fn);
+}
+
+int Rules_LoadTable(const Rule *rules, uint8_t count)
+{
+    return RulesEngine_LoadTable(&default_engine, rules, count);
+}
+
+int Rules_LoadBlob(const uint8_t *blob, uint32_t len)
+{
+    return RulesEngine_LoadBlob(&default_engine, blob, len);
+}
+
+uint32_t Rules_Eval(uint8_t input, int32_t value, uint32_t now_ms)
+{
+    return RulesEngine_Eval(&default_engine, input, value, now_ms);
+}
+
+void Rules_GetStats(RulesStats *out)
+{
+    RulesEngine_GetStats(&default_engine, out);
+}
@@ -0,0 +1,135 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 표 기반 규칙 엔진
+// - 규칙 하나는 입력 채널 하나에 대한 조건 하나와, 조건이 바뀔 때 실행할 동작 두 개 (참/거짓)
+// - Rules_Eval 은 규칙 수만큼 한 번 훑고 끝 (O(규칙 수)), 동적 할당 없음
+// - 규칙표는 두 벌: 로드는 예비 벌에 검사해서 채우고, 평가하는 쪽이 다음 Rules_Eval 시작에서 바꿔 끼운다.
+//   평가 도중에 표가 바뀌지 않으므로 평가하는 태스크는 하나여야 함
+// - Rules_* 는 펌웨어에 하나 있는 기본 엔진. 한 프로세스에서 보드 여러 개를 흉내낼 때 (host/fleet_sim) 는
+//   보드마다 RulesEngine 을 두고 RulesEngine_* 를 쓴다
+//
+// 블롭 형식 (리틀 엔디언):
+//   'R' 'U' 'L' 'E' | version(u8)=1 | count(u8) | crc16(u16) | count x 규칙(16 바이트)
+//   규칙: kind(u8) flags(u8) input(u8) param(u8) a(i32) b(i32) out_on(u8) arg_on(u8) out_off(u8) arg_off(u8)
+//   crc16 은 CRC-16/CCITT-FALSE, crc 필드를 뺀 헤더 6 바이트 + 규칙들
+
+#ifndef RULES_MAX
+#define RULES_MAX           32
+#endif
+// count 가 u8 이라 255 면 개수 검사가 항상 거짓이 됨. 128 개면 표 RAM 이 6 KB 라 그 위는 이 칩에 안 맞음
+#if RULES_MAX < 1 || RULES_MAX > 128
+#error "RULES_MAX must be 1..128"
+#endif
+#define RULES_MAX_INPUTS    8
+#define RULES_MAX_OUTPUTS   8
+#define RULES_OUT_NONE      0xFFu
+
+#define RULES_BLOB_HEADER   8
+#define RULES_BLOB_RULE     16
+#define RULES_BLOB_VERSION  1
+#define RULES_BLOB_SIZE(n)  (RULES_BLOB_HEADER + (n) * RULES_BLOB_RULE)
+
+typedef enum {
+    RULE_THRESHOLD = 0,     // value > a
+    RULE_HYSTERESIS,        // value > a 이면 참, value < b 이면 거짓, 사이는 유지 (b <= a)
+    RULE_RATE,              // 초당 변화량 > a (이전 샘플과의 차이 / 경과 시간)
+    RULE_WINDOW,            // 최근 param(1~32) 개 중 value > a 인 것이 b 개 이상
+    RULE_KIND_COUNT
+} RuleKind;
+
+// RULE_F_BELOW: 비교 방향을 뒤집음 (value < a, 히스테리시스는 b >= a, 변화율은 < a)
+#define RULE_F_BELOW        0x01u
+
+typedef struct {
+    uint8_t kind;
+    uint8_t flags;
+    uint8_t input;
+    uint8_t param;
+    int32_t a;
+    int32_t b;
+    uint8_t out_on;         // 조건이 참이 될 때
+    uint8_t arg_on;
+    uint8_t out_off;        // 거짓이 될 때
+    uint8_t arg_off;
+} Rule;
+
+typedef void (*RuleOutputFn)(uint8_t arg);
+
+typedef struct {
+    uint32_t evals;         // Rules_Eval 호출
+    uint32_t checks;        // 입력이 맞아 조건을 따져본 규칙 수
+    uint32_t actions;
+    uint16_t loads;
+    uint16_t load_errors;
+    uint8_t count;          // 지금 쓰는 규칙 수
+} RulesStats;
+
+typedef enum {
+    RULES_OK = 0,
+    RULES_ERR_FORMAT = -1,  // 길이/매직/버전
+    RULES_ERR_CRC = -2,
+    RULES_ERR_RULE = -3,    // 범위를 벗어난 규칙
+    RULES_ERR_BUSY = -4     // 앞서 로드한 표가 아직 적용되지 않음
+} RulesStatus;
+
+// 엔진 상태: 규칙표 두 벌, 규칙별 평가 상태, 출력
+typedef struct {
+    int32_t prev;           // RATE: 이전 값
+    uint32_t prev_ms;
+    uint32_t hist;          // WINDOW: 최근 샘플 조건 비트 (bit0 이 가장 최근)
+    uint8_t state;          // 0, 1, 처음 (0xFF)
+    uint8_t primed;         // RATE: 이전 값이 있음
+} RuleState;
+
+typedef struct {
+    Rule rules[RULES_MAX];
+    uint8_t count;
+} RuleBank;
+
+typedef struct {
+    RuleBank banks[2];
+    RuleBank *active;
+    RuleBank *staged;
+    volatile uint8_t pending;
+    RuleState states[RULES_MAX];
+    RuleOutputFn outputs[RULES_MAX_OUTPUTS];
+    RulesStats stats;
+} RulesEngine;
+
+void RulesEngine_Init(RulesEngine *eng);
+void RulesEngine_SetOutput(RulesEngine *eng, uint8_t out, RuleOutputFn fn);
+int RulesEngine_LoadTable(RulesEngine *eng, const Rule *rules, uint8_t count);
+int RulesEngine_LoadBlob(RulesEngine *eng, const uint8_t *blob, uint32_t len);
+uint32_t RulesEngine_Eval(RulesEngine *eng, uint8_t input, int32_t value, uint32_t now_ms);
+void RulesEngine_GetStats(const RulesEngine *eng, RulesStats *out);
+
+// 기본 엔진 (아래 Rules_* 가 쓰는 것)
+RulesEngine *Rules_Default(void);
+
+void Rules_Init(void);
+// 출력 번호 -> 동작 (LED, 이벤트 전송 등)
+void Rules_SetOutput(uint8_t out, RuleOutputFn fn);
+
+// 어느 태스크에서나 호출 가능, 다음 Rules_Eval 에서 적용
+int Rules_LoadTable(const Rule *rules, uint8_t count);
+int Rules_LoadBlob(const uint8_t *blob, uint32_t len);
+// 규칙을 블롭으로 (호스트 도구/시험용), 쓴 바이트 수 또는 -1
+int Rules_Encode(const Rule *rules, uint8_t count, uint8_t *out, uint32_t cap);
+
+// input 채널 값 하나로 규칙을 평가하고 조건이 바뀐 규칙의 동작을 실행. 실행한 동작 수를 돌려줌
+uint32_t Rules_Eval(uint8_t input, int32_t value, uint32_t now_ms);
+
+void Rules_GetStats(RulesStats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
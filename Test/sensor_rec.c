@@ -0,0 +1,192 @@
+#include "main.h"
+#include "sensor_rec.h"
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include "host_os.h"
+#define SENSOR_REC_LOCK()     do {} while (0)
+#define SENSOR_REC_UNLOCK()   do {} while (0)
+#else
+#define SENSOR_REC_LOCK()     uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define SENSOR_REC_UNLOCK()   __set_PRIMASK(primask)
+#endif
+
+extern UART_HandleTypeDef huart1;
+
+static uint8_t ring[SENSOR_REC_RING];
+static uint16_t head;               // 가장 오래된 레코드 (Flush 가 읽을 자리), 쓸 자리는 head + used
+static uint16_t used;
+static uint64_t last_us;
+static uint8_t gap_pending;
+static uint32_t dropped;
+static uint32_t tx_errors;
+
+#ifndef HOST_BUILD
+static uint32_t last_cycles;
+static uint32_t cycle_frac;
+static uint64_t now_us;
+#endif
+
+// --- 시간 (타깃은 DWT 사이클을 us 로 누적, 59 초 넘게 안 불려도 레코드마다 갱신되므로 충분) ---
+static uint64_t NowUs(void)
+{
+#ifdef HOST_BUILD
+    return HostOs_NowUs();
+#else
+    uint32_t c = DWT->CYCCNT;
+    uint32_t d = c - last_cycles + cycle_frac;
+    last_cycles = c;
+    now_us += d / (SENSOR_REC_CPU_HZ / 1000000u);
+    cycle_frac = d % (SENSOR_REC_CPU_HZ / 1000000u);
+    return now_us;
+#endif
+}
+
+void SensorRec_Init(void)
+{
+#ifndef HOST_BUILD
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    last_cycles = DWT->CYCCNT;
+    cycle_frac = 0;
+    now_us = 0;
+#endif
+    head = used = 0;
+    gap_pending = 0;
+    dropped = 0;
+    tx_errors = 0;
+    last_us = NowUs();
+}
+
+static uint8_t Leb128(uint8_t *out, uint32_t v)
+{
+    uint8_t n = 0;
+    do {
+        uint8_t b = v & 0x7Fu;
+        v >>= 7;
+        out[n++] = v ? (uint8_t)(b | 0x80u) : b;
+    } while (v);
+    return n;
+}
+
+static void RingPut(const uint8_t *p, uint8_t n)
+{
+    for (uint8_t i = 0; i < n; i++) {
+        ring[(head + used) % SENSOR_REC_RING] = p[i];
+        used++;
+    }
+}
+
+// 레코드 하나를 통째로 넣거나 통째로 버림 (LOCK 안에서)
+static void Append(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    uint8_t rec[16];
+    uint64_t now = NowUs();
+    uint64_t dt = now - last_us;
+    if (dt > 0xFFFFFFFFu)
+        dt = 0xFFFFFFFFu;
+
+    uint8_t n = 0;
+    if (gap_pending) {
+        rec[n++] = SREC_GAP;
+        n += Leb128(&rec[n], (uint32_t)dt);
+        dt = 0;
+    }
+    rec[n++] = type;
+    n += Leb128(&rec[n], (uint32_t)dt);
+    memcpy(&rec[n], payload, len);
+    n += len;
+
+    if (used + n > SENSOR_REC_RING) {
+        dropped++;
+        gap_pending = 1;
+        return;
+    }
+    RingPut(rec, n);
+    last_us = now;
+    gap_pending = 0;
+}
+
+void SensorRec_Adc(uint8_t channel, uint16_t value)
+{
+    uint8_t p[3] = { channel, (uint8_t)value, (uint8_t)(value >> 8) };
+    SENSOR_REC_LOCK();
+    Append(SREC_ADC, p, sizeof(p));
+    SENSOR_REC_UNLOCK();
+}
+
+void SensorRec_Gpio(uint8_t type, char port, uint8_t pin, uint8_t level)
+{
+    uint8_t p[3] = { (uint8_t)port, pin, level ? 1u : 0u };
+    SENSOR_REC_LOCK();
+    Append(type, p, sizeof(p));
+    SENSOR_REC_UNLOCK();
+}
+
+// ring[pos] 에서 시작하는 레코드 길이
+static uint8_t RecordLen(uint16_t pos)
+{
+    uint8_t type = ring[pos % SENSOR_REC_RING];
+    uint8_t n = 1;
+    while (ring[(pos + n) % SENSOR_REC_RING] & 0x80u)
+        n++;
+    n++;
+    return (uint8_t)(n + (type == SREC_GAP ? 0 : 3));
+}
+
+// 레코드는 전송이 성공한 뒤에 링에서 뺀다 (읽는 쪽은 여기뿐이고 쓰는 쪽은 head + used 뒤에만 붙임).
+// 전송이 실패하면 남겨 두고 다음 Flush 에서 다시, 그 사이 링이 차면 Append 가 GAP 으로 표시
+uint32_t SensorRec_Flush(void)
+{
+    uint8_t frame[4 + SREC_FRAME_MAX + 1];
+    uint32_t sent = 0;
+
+    for (;;) {
+        uint8_t n = 0;
+        {
+            SENSOR_REC_LOCK();
+            while (n < used) {
+                uint8_t len = RecordLen((uint16_t)(head + n));
+                if (n + len > SREC_FRAME_MAX)
+                    break;
+                n += len;
+            }
+            for (uint8_t i = 0; i < n; i++)
+                frame[4 + i] = ring[(head + i) % SENSOR_REC_RING];
+            SENSOR_REC_UNLOCK();
+        }
+        if (n == 0)
+            break;
+
+        frame[0] = 0xA5;
+        frame[1] = 0x5A;
+        frame[2] = SREC_FRAME_TYPE;
+        frame[3] = n;
+        uint8_t sum = 0;
+        for (uint8_t i = 2; i < 4 + n; i++)
+            sum += frame[i];
+        frame[4 + n] = sum;
+        if (HAL_UART_Transmit(&huart1, frame, (uint16_t)(5 + n), HAL_MAX_DELAY) != HAL_OK) {
+            tx_errors++;
+            break;
+        }
+        {
+            SENSOR_REC_LOCK();
+            head = (uint16_t)((head + n) % SENSOR_REC_RING);
+            used -= n;
+            SENSOR_REC_UNLOCK();
+        }
+        sent += 5u + n;
+    }
+    return sent;
+}
+
+uint32_t SensorRec_Dropped(void)
+{
+    return dropped;
+}
+
+uint32_t SensorRec_TxErrors(void)
+{
+    return tx_errors;
+}
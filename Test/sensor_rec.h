@@ -0,0 +1,45 @@
+#ifndef SENSOR_REC_H
+#define SENSOR_REC_H
+
+#include <stdint.h>
+
+// 현장 기록: ADC 샘플과 GPIO 에지를 시각과 함께 남겨 호스트에서 sys.c 태스크로 다시 돌린다
+// (host/replay.cpp)
+//
+// 레코드 (바이트 스트림):
+//   type(u8) | dt_us (LEB128, 앞 레코드로부터) | 내용
+//   SREC_ADC       channel(u8) value(u16 LE)
+//   SREC_GPIO_IN   port(u8, 'A'..) pin(u8) level(u8)    보드로 들어온 에지 (버튼 등)
+//   SREC_GPIO_OUT  port(u8) pin(u8) level(u8)           펌웨어가 낸 에지 (재생 결과와 비교용)
+//   SREC_GAP       없음                                 버퍼가 차서 레코드를 잃은 자리
+//
+// 파일 (.srec): 'S' 'R' 'E' 'C' | version(u8)=1 | 0 0 0 | 레코드들
+//
+// 타깃은 레코드를 RAM 링에 모아 SensorRec_Flush 에서 rt_stats 와 같은 꼴의 UART 프레임으로 보낸다:
+//   0xA5 0x5A 'S' n | n 바이트 (레코드 단위로 잘림) | sum(u8, 'S' 부터 합)
+// 호스트 replay -E 가 UART 캡처에서 프레임만 뽑아 .srec 로 만든다.
+
+#define SREC_MAGIC          "SREC"
+#define SREC_VERSION        1
+#define SREC_FILE_HEADER    8
+
+#define SREC_ADC            0x01u
+#define SREC_GPIO_IN        0x02u
+#define SREC_GPIO_OUT       0x03u
+#define SREC_GAP            0x04u
+
+#define SREC_FRAME_TYPE     'S'
+#define SREC_FRAME_MAX      200     // 프레임 하나의 최대 내용 바이트
+#define SENSOR_REC_RING     512
+#define SENSOR_REC_CPU_HZ   72000000u
+
+void SensorRec_Init(void);
+void SensorRec_Adc(uint8_t channel, uint16_t value);
+void SensorRec_Gpio(uint8_t type, char port, uint8_t pin, uint8_t level);
+// 모인 레코드를 UART 로 (모니터 태스크 등 느린 곳에서). 보낸 바이트 수.
+// 전송이 실패하면 그 프레임의 레코드는 링에 남기고 멈춤 (SensorRec_TxErrors 로 셈)
+uint32_t SensorRec_Flush(void);
+uint32_t SensorRec_Dropped(void);
+uint32_t SensorRec_TxErrors(void);
+
+#endif
@@ -0,0 +1,64 @@
+#include "main.h"
+#include "cmsis_os.h"
+#include "stack_mon.h"
+#include "dlog.h"
+#include <stdio.h>
+#include <string.h>
+
+extern UART_HandleTypeDef huart1;
+
+typedef struct {
+    const char *name;
+    osThreadId handle;
+    uint32_t depth_words;
+} StackMonEntry;
+
+static StackMonEntry entries[STACK_MON_MAX_TASKS];
+static uint8_t entry_count = 0;
+
+// --- 태스크 등록 (osThreadCreate 직후 호출) ---
+void StackMon_Register(const char *name, osThreadId handle, uint32_t depth_words)
+{
+    if (handle == NULL || entry_count >= STACK_MON_MAX_TASKS)
+        return;
+    entries[entry_count].name = name;
+    entries[entry_count].handle = handle;
+    entries[entry_count].depth_words = depth_words;
+    entry_count++;
+}
+
+// --- 이름 (시작할 때 한 번, DLOG 는 %s 를 못 실음): "STK 0 = sensor 128 w" ---
+void StackMon_ReportNames(void)
+{
+    char msg[40];
+    for (uint8_t i = 0; i < entry_count; i++) {
+        snprintf(msg, sizeof(msg), "STK %u = %s %lu w\r\n", i, entries[i].name,
+                 (unsigned long)entries[i].depth_words);
+        HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
+    }
+}
+
+// --- 리포트 (DLOG 레코드, 번호는 ReportNames): "STK 0 used 74/128 w free 54 w low 0" ---
+void StackMon_Report(void)
+{
+    for (uint8_t i = 0; i < entry_count; i++) {
+        StackMonEntry *e = &entries[i];
+        uint32_t free_words = (uint32_t)uxTaskGetStackHighWaterMark((TaskHandle_t)e->handle);
+        DLOG("STK %u used %lu/%lu w free %lu w low %u\r\n", (unsigned)i,
+             (unsigned long)(e->depth_words - free_words), (unsigned long)e->depth_words,
+             (unsigned long)free_words, (unsigned)(free_words < 16));
+    }
+}
+
+#if (configCHECK_FOR_STACK_OVERFLOW > 0)
+// 오버플로가 나면 더 진행하지 말고 이름만 남기고 멈춤
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    (void)xTask;
+    HAL_UART_Transmit(&huart1, (uint8_t*)"STK OVERFLOW ", 13, 100);
+    HAL_UART_Transmit(&huart1, (uint8_t*)pcTaskName, strlen(pcTaskName), 100);
+    HAL_UART_Transmit(&huart1, (uint8_t*)"\r\n", 2, 100);
+    __disable_irq();
+    while (1) {}
+}
+#endif
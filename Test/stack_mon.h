@@ -0,0 +1,17 @@
+#ifndef STACK_MON_H
+#define STACK_MON_H
+
+#include "cmsis_os.h"
+
+// 스택 high-water 모니터
+// FreeRTOS 는 태스크 생성 시 스택을 0xA5 로 칠해 두므로 (INCLUDE_uxTaskGetStackHighWaterMark = 1)
+// 칠이 벗겨진 깊이로 최대 사용량을 알 수 있다.
+
+#define STACK_MON_MAX_TASKS     8
+
+void StackMon_Register(const char *name, osThreadId handle, uint32_t depth_words);
+// 번호 -> 이름 줄 (시작할 때 한 번), 리포트는 번호로 DLOG
+void StackMon_ReportNames(void);
+void StackMon_Report(void);
+
+#endif
@@ -1,6 +1,21 @@
 #include "main.h"
+#include "board.h"
 #include "ssd1306.h"
 #include "fonts.h"
+#include "boot_prof.h"
+#include "coop_sched.h"
+#include "fast_path.h"
+#include "oled_text.h"
+#include "oled_async.h"
+#include "oled_spark.h"
+#include "i2c_bus.h"
+#include "calib.h"
+#include "dlog.h"
+#include "history.h"
+#include "rt_stats.h"
+#ifdef EDGE_BENCH
+#include "edge_bench.h"
+#endif
 #include "stdio.h"
 #include "string.h"
 
@@ -11,117 +26,455 @@ RTC_HandleTypeDef hrtc;
 ADC_HandleTypeDef hadc1;
 TIM_HandleTypeDef htim3;
 
-char uart_buf[100];
 uint32_t adc_val = 0;
-volatile uint8_t button_flag = 0;
 RTC_TimeTypeDef sTime;
 RTC_DateTypeDef sDate;
 
+// 잡 주기와 ISR 이벤트
+#define ADC_PERIOD_US       1000      // 1 kHz
+#define OLED_PERIOD_US      200000    // 5 Hz
+#define LOG_PERIOD_US       500000
+#define BRINGUP_PERIOD_US   1000
+#define REPORT_PERIOD_US    10000000
+#define REPORT_STEP_US      20000     // 리포트 중에는 이 간격으로 한 줄씩
+#define DLOG_PERIOD_US      1000000   // 로그 레코드 모아서 1 초마다 한 프레임
+#define HIST_PERIOD_US      250000    // 덤프 중이면 블록 하나씩
+#define HIST_EVERY          4         // 1 초마다 기록 (4 KB 에 2 시간쯤)
+
+#define EVT_BUTTON          (1u << 0)
+
+// -DEDGE_BENCH: PB0-PA0 루프백으로 버튼 → LED 반응 시간 측정
+#define EDGE_BENCH_COUNT    1000
+#define EDGE_BENCH_GAP_US   20000
+
+// 느린 주변장치(I2C/RTC/OLED)는 샘플링을 시작한 뒤 bringup 잡이 한 번에 한 단계씩 올린다
+typedef enum {
+  BRINGUP_I2C = 0,
+  BRINGUP_RTC,
+  BRINGUP_OLED,
+  BRINGUP_REPORT,
+  BRINGUP_DONE
+} BringupStep;
+
+static BringupStep bringup = BRINGUP_I2C;
+static uint8_t rtc_ready = 0;
+static uint8_t oled_ready = 0;
+static uint8_t oled_started = 0;
+static uint8_t first_sample = 0;
+static int bringup_job = -1;
+static int report_job = -1;
+static int boot_line = 0;
+static int led_action = -1;
+
+// 콜백 실행 시간 (rt_stats). RTS 레코드 id 는 등록 순서: 0 exti0, 1 i2c, 2 i2c_err
+static int isr_exti = -1;
+static int isr_i2c = -1;
+static int isr_i2c_err = -1;
+
+// OLED 텍스트: 7x10 글꼴 캐시와 세 줄 (페이지 0, 2, 4)
+static uint8_t font7x10_cache[OLED_TEXT_CACHE_BYTES(7, 10)];
+static OledFont font7x10;
+static OledTextSlot adc_slot;
+static OledTextSlot time_slot;
+static OledTextSlot lux_slot;
+
+// 아래 두 페이지: 기록(1 초에 하나)의 스파크라인, 새 샘플마다 패널 스크롤 + 한 열
+#define SPARK_PAGE          6
+#define SPARK_PAGES         2
+#define SPARK_HW_SCROLL     1         // 2Dh 가 없는 패널이면 0 (뒤 버퍼만 밀고 두 페이지를 다시 보냄)
+static OledSpark spark;
+static uint32_t spark_seq;            // 다음에 그릴 기록 번호
+
 // --- 초기화 함수들 선언 ---
 void SystemClock_Config(void);
-static void MX_GPIO_Init(void);
-static void MX_USART1_UART_Init(void);
+static void Button_Init(void);
+static void MX_DMA_Init(void);
 static void MX_I2C1_Init(void);
 static void MX_RTC_Init(void);
-static void MX_ADC1_Init(void);
+static void ADC1_SelectChannel(uint32_t channel, uint32_t sampling);
 static void MX_TIM3_Init(void);
+static void Bringup_Step(void);
+
+static void Fast_ButtonLed(void);
+static void Job_Button(void);
+static void Job_Adc(void);
+static void Job_Log(void);
+static void Job_Oled(void);
+static void Job_Report(void);
+static void Job_Dlog(void);
+static void Job_Hist(void);
 
 // --- 메인 함수 ---
 int main(void)
 {
+  BootProf_Start();
   HAL_Init();
   SystemClock_Config();
-
-  MX_GPIO_Init();
-  MX_USART1_UART_Init();
-  MX_I2C1_Init();
-  MX_RTC_Init();
-  MX_ADC1_Init();
+  BootProf_Mark("clock");
+
+  // 인터럽트를 켜기 전에
+  RtStats_Init();
+  isr_exti = RtStats_RegisterIsr("exti0");
+  isr_i2c = RtStats_RegisterIsr("i2c");
+  isr_i2c_err = RtStats_RegisterIsr("i2c_err");
+
+  // 샘플링에 필요한 것만 먼저
+  // GPIO / USART1 / ADC1 은 board.hpp (sys.c 와 같음), 버튼 EXTI 는 이 펌웨어만 써서 여기서
+  Board_Init();
+  Board_BindHal(&huart1, &hadc1);
+  Button_Init();
+  FastPath_Init();
+  led_action = FastPath_Register(Fast_ButtonLed);
   MX_TIM3_Init();
-
   HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
-  SSD1306_Init();
-
-  // 디스플레이 초기 메시지
-  SSD1306_GotoXY(10, 10);
-  SSD1306_Puts("System Start", &Font_11x18, 1);
-  SSD1306_UpdateScreen();
-
-  HAL_UART_Transmit(&huart1, (uint8_t*)"System Initialized\r\n", 21, HAL_MAX_DELAY);
+  BootProf_Mark("core");
+
+  History_Init();
+
+  // 등록 순서가 우선순위: 버튼 > ADC > 로그 > OLED > 초기화 > 리포트 > 로그 전송 > 기록
+  Coop_Init();
+  Coop_AddJob("button", Job_Button, 0, EVT_BUTTON);
+  Coop_AddJob("adc", Job_Adc, ADC_PERIOD_US, 0);
+  Coop_AddJob("log", Job_Log, LOG_PERIOD_US, 0);
+  Coop_AddJob("oled", Job_Oled, OLED_PERIOD_US, 0);
+  bringup_job = Coop_AddJob("bringup", Bringup_Step, BRINGUP_PERIOD_US, 0);
+  report_job = Coop_AddJob("report", Job_Report, REPORT_PERIOD_US, 0);
+  Coop_AddJob("dlog", Job_Dlog, DLOG_PERIOD_US, 0);
+  Coop_AddJob("hist", Job_Hist, HIST_PERIOD_US, 0);
+
+#ifdef EDGE_BENCH
+  EdgeBench_Start(EDGE_BENCH_COUNT, EDGE_BENCH_GAP_US);
+#endif
+  Coop_Run();
+}
 
-  while (1)
+// --- 잡 ---
+static void ReadClock(void)
+{
+  if (rtc_ready)
   {
-    // --- ADC 값 읽기 ---
-    HAL_ADC_Start(&hadc1);
-    if (HAL_ADC_PollForConversion(&hadc1, HAL_MAX_DELAY) == HAL_OK)
-    {
-      adc_val = HAL_ADC_GetValue(&hadc1);
-    }
-    HAL_ADC_Stop(&hadc1);
-
-    // --- PWM 제어 (서보모터 제어 예시: 0~180도) ---
-    uint32_t pulse = 500 + (adc_val * 2000 / 4095); // 0.5ms ~ 2.5ms
-    __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pulse);
-
-    // --- 시간 읽기 ---
     HAL_RTC_GetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
     HAL_RTC_GetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
+  }
+}
+
+// EXTI 바로 뒤 (PendSV): LED 만 바꾸고 보고는 잡으로 넘김
+static void Fast_ButtonLed(void)
+{
+  HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_13); // LED Toggle
+#ifdef EDGE_BENCH
+  EdgeBench_MarkOutput();
+#endif
+  Coop_Signal(EVT_BUTTON);
+}
 
-    // --- OLED 디스플레이 출력 ---
-    char line1[32], line2[32];
-    sprintf(line1, "ADC: %4lu", adc_val);
-    sprintf(line2, "Time: %02d:%02d:%02d", sTime.Hours, sTime.Minutes, sTime.Seconds);
-
-    SSD1306_Fill(SSD1306_COLOR_BLACK);
-    SSD1306_GotoXY(0, 0);
-    SSD1306_Puts(line1, &Font_7x10, 1);
-    SSD1306_GotoXY(0, 12);
-    SSD1306_Puts(line2, &Font_7x10, 1);
-    SSD1306_UpdateScreen();
-
-    // --- UART로 값 출력 ---
-    sprintf(uart_buf, "[%02d:%02d:%02d] ADC: %lu\r\n", sTime.Hours, sTime.Minutes, sTime.Seconds, adc_val);
-    HAL_UART_Transmit(&huart1, (uint8_t*)uart_buf, strlen(uart_buf), HAL_MAX_DELAY);
-
-    // --- 버튼 인터럽트 이벤트 처리 ---
-    if (button_flag)
-    {
-      HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_13); // LED Toggle
-      HAL_UART_Transmit(&huart1, (uint8_t*)"Button Pressed!\r\n", 17, HAL_MAX_DELAY);
-      button_flag = 0;
-    }
-
-    HAL_Delay(500);
+// 버튼을 누르면 기록 덤프도 시작 ('H' 프레임, host/history_bench -x 로 풂)
+static void Job_Button(void)
+{
+  DLOG("Button Pressed!\r\n");
+  History_DumpStart();
+}
+
+static void Job_Adc(void)
+{
+  HAL_ADC_Start(&hadc1);
+  if (HAL_ADC_PollForConversion(&hadc1, HAL_MAX_DELAY) == HAL_OK)
+  {
+    adc_val = HAL_ADC_GetValue(&hadc1);
+  }
+  HAL_ADC_Stop(&hadc1);
+  if (!first_sample)
+  {
+    BootProf_Mark("first_sample");
+    first_sample = 1;
   }
+
+  // --- PWM 제어 (서보모터 제어 예시: 0~180도) ---
+  uint32_t pulse = 500 + (adc_val * 2000 / 4095); // 0.5ms ~ 2.5ms
+  __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pulse);
+}
+
+// VDDA 보정용 VREFINT 한 번 (17.1 us 이상 샘플링 필요, 끝나면 PA1 로 되돌림)
+static void SampleVrefint(void)
+{
+  ADC1_SelectChannel(ADC_CHANNEL_VREFINT, ADC_SAMPLETIME_239CYCLES_5);
+  HAL_ADC_Start(&hadc1);
+  if (HAL_ADC_PollForConversion(&hadc1, HAL_MAX_DELAY) == HAL_OK)
+  {
+    Calib_SetVrefint((uint16_t)HAL_ADC_GetValue(&hadc1));
+  }
+  HAL_ADC_Stop(&hadc1);
+  ADC1_SelectChannel(ADC_CHANNEL_1, ADC_SAMPLETIME_71CYCLES_5);
+}
+
+// --- UART로 값 출력 (RTC 가 올라오기 전에는 시각 없이, 글자는 호스트 dlog_decode 가 만듦) ---
+static void Job_Log(void)
+{
+  SampleVrefint();
+  ReadClock();
+  if (rtc_ready)
+    DLOG("[%02d:%02d:%02d] ADC: %lu\r\n", sTime.Hours, sTime.Minutes, sTime.Seconds, (unsigned long)adc_val);
+  else
+    DLOG("ADC: %lu\r\n", (unsigned long)adc_val);
+}
+
+// 기록에 새로 들어온 샘플을 그래프에 붙임 (범위를 벗어나면 최근 기록으로 다시 그림)
+static void Spark_Update(void)
+{
+  static uint16_t v[SSD1306_WIDTH];
+  HistoryStats hs;
+  History_GetStats(&hs);
+  if (hs.total == spark_seq || OledAsync_Busy())
+    return;   // 전송 중이면 스크롤을 못 끼우므로 다음 주기에
+
+  uint32_t first = spark_seq;
+  uint32_t n = hs.total - spark_seq < spark.cols ? History_Read(spark_seq, v, spark.cols, &first) : 0;
+  if (n == 0 || first != spark_seq || OledSpark_Push(&spark, v, n) != 0)
+  {
+    n = History_ReadLast(v, spark.cols);
+    OledSpark_Redraw(&spark, v, n);
+  }
+  spark_seq = hs.total;
+}
+
+static void Job_Oled(void)
+{
+  if (!oled_ready)
+    return;
+  ReadClock();
+
+  char line1[32], line2[32], line3[32];
+  uint32_t lux = Calib_RawToLuxQ16((uint16_t)adc_val);
+  sprintf(line1, "ADC: %4lu", (unsigned long)adc_val);
+  sprintf(line2, "Time: %02d:%02d:%02d", sTime.Hours, sTime.Minutes, sTime.Seconds);
+  sprintf(line3, "Lux: %4lu.%lu", (unsigned long)CALIB_Q16_INT(lux), (unsigned long)CALIB_Q16_TENTHS(lux));
+
+  // 바뀐 글자만 다시 그림 (화면 전체를 지우지 않음)
+  OledText_Draw(&adc_slot, line1);
+  OledText_Draw(&time_slot, line2);
+  OledText_Draw(&lux_slot, line3);
+  Spark_Update();
+  OledAsync_Flush();    // 앞 전송이 안 끝났으면 다음 주기에 (뒤 버퍼에 그린 건 남아있음)
+}
+
+// 10 초마다 통계 리포트. 한 번 돌 때 DLOG 레코드 한 줄만 내고 REPORT_STEP_US 뒤에 다음 줄
+// (UART 를 기다리지 않음). 줄 순서: JOB 잡마다 (id = 등록 순서), I2C util / 우선순위별, RTS 엔트리마다
+static void Job_Report(void)
+{
+  static int line = -1;
+  if (bringup != BRINGUP_DONE)
+    return;
+
+  if (line < 0)
+  {
+    // 모든 줄이 같은 구간을 보도록 시작할 때 한 번 닫음
+    I2cBus_CloseWindow();
+    RtStats_CloseWindow();
+    Coop_SetPeriod(report_job, REPORT_STEP_US);
+    line = 0;
+  }
+
+  int i = line++;
+  if (Coop_LogJob(i) == 0)
+    return;
+  i -= Coop_Count();
+  if (I2cBus_LogLine(i) == 0)
+    return;
+  i -= I2C_BUS_PRIOS + 1;
+  if (RtStats_LogEntry(i) == 0)
+    return;
+
+#ifdef EDGE_BENCH
+  if (EdgeBench_Done())
+    EdgeBench_Report();
+#endif
+  line = -1;
+  Coop_SetPeriod(report_job, REPORT_PERIOD_US);
+}
+
+static void Job_Dlog(void)
+{
+  DLog_Flush();
+}
+
+// ADC 기록 (압축해서 RAM 에), 덤프 중이면 블록 하나 전송
+static void Job_Hist(void)
+{
+  static uint8_t tick = 0;
+  if (first_sample && ++tick >= HIST_EVERY)
+  {
+    tick = 0;
+    History_Append((uint16_t)adc_val);
+  }
+  History_DumpStep();
+}
+
+// --- 지연 초기화: 한 번에 한 단계, 끝나면 잡을 멈춤 ---
+static void Bringup_Step(void)
+{
+  switch (bringup)
+  {
+    case BRINGUP_I2C:
+      MX_DMA_Init();
+      MX_I2C1_Init();
+      I2cBus_Init(&hi2c1);
+      BootProf_Mark("i2c");
+      break;
+    case BRINGUP_RTC:
+      MX_RTC_Init();
+      rtc_ready = 1;
+      BootProf_Mark("rtc");
+      break;
+    case BRINGUP_OLED:
+      // 초기화 명령은 i2c_bus 로 (블로킹 SSD1306_Init 대신), 끝날 때까지 이 단계에서 매번 확인만.
+      // 화면 지우기는 oled 잡의 첫 Flush 가 전부 보내면서
+      if (!oled_started)
+      {
+        oled_started = 1;
+        SSD1306_Fill(SSD1306_COLOR_BLACK);
+        OledAsync_Init();
+        if (OledAsync_StartPanel() == 0)
+          return;
+      }
+      else if (OledAsync_PanelState() == 0)
+      {
+        return;
+      }
+      if (OledAsync_PanelState() > 0 && OledText_InitFont(&font7x10, &Font_7x10, font7x10_cache) == 0)
+      {
+        OledText_InitSlot(&adc_slot, &font7x10, 0, 0);
+        OledText_InitSlot(&time_slot, &font7x10, 0, 2);
+        OledText_InitSlot(&lux_slot, &font7x10, 0, 4);
+        OledSpark_Init(&spark, 0, SSD1306_WIDTH, SPARK_PAGE, SPARK_PAGES, SPARK_HW_SCROLL);
+        spark_seq = 0;
+        oled_ready = 1;
+      }
+      BootProf_Mark("oled");
+      break;
+    case BRINGUP_REPORT:
+      // 단계마다 한 줄 (BOOT <Mark 순서>: clock, core, first_sample, i2c, rtc, oled), 다 내면 배너
+      if (BootProf_LogPhase(boot_line++) == 0)
+        return;
+      DLOG("System Initialized\r\n");
+      break;
+    default:
+      Coop_SetPeriod(bringup_job, 0);
+      return;
+  }
+  bringup++;
 }
 
 // --- 외부 인터럽트 콜백 ---
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
+  RtStats_IsrEnter(isr_exti);
   if (GPIO_Pin == GPIO_PIN_0)
   {
-    button_flag = 1;
+    FastPath_Post(led_action);
   }
+  RtStats_IsrExit(isr_exti);
+}
+
+// --- I2C DMA 완료: 공유 버스 스케줄러로 ---
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  RtStats_IsrEnter(isr_i2c);
+  I2cBus_TxDone(hi2c);
+  RtStats_IsrExit(isr_i2c);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  RtStats_IsrEnter(isr_i2c);
+  I2cBus_RxDone(hi2c);
+  RtStats_IsrExit(isr_i2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  RtStats_IsrEnter(isr_i2c_err);
+  I2cBus_Error(hi2c);
+  RtStats_IsrExit(isr_i2c_err);
 }
 
 // --- Peripheral Initialization Functions ---
 
-static void MX_ADC1_Init(void)
+// I2C1 TX = DMA1 채널 6, RX = 채널 7 (hdma 연결은 아래 HAL_I2C_MspInit 에서)
+static void MX_DMA_Init(void)
 {
-  ADC_ChannelConfTypeDef sConfig = {0};
-  __HAL_RCC_ADC1_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  HAL_NVIC_SetPriority(DMA1_Channel6_IRQn, 3, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+  HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 3, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+}
+
+#ifndef HOST_BUILD
+// CubeMX 라면 stm32f1xx_hal_msp.c / stm32f1xx_it.c 에 있을 것들 (이 트리에는 그 파일이 없음).
+// 없으면 i2c_bus 의 DMA 전송이 시작되지 않거나 완료 콜백이 오지 않아 OLED Flush 가 끝나지 않는다
+static DMA_HandleTypeDef hdma_i2c1_tx;
+static DMA_HandleTypeDef hdma_i2c1_rx;
+
+static void I2C1_DmaInit(DMA_HandleTypeDef *hdma, DMA_Channel_TypeDef *ch, uint32_t dir)
+{
+  hdma->Instance = ch;
+  hdma->Init.Direction = dir;
+  hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma->Init.MemInc = DMA_MINC_ENABLE;
+  hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  hdma->Init.Mode = DMA_NORMAL;
+  hdma->Init.Priority = DMA_PRIORITY_LOW;
+  HAL_DMA_Init(hdma);
+}
+
+// HAL_I2C_Init 이 부름: PB6 SCL / PB7 SDA (AF 오픈 드레인), DMA 채널 연결 (MX_DMA_Init 다음이어야 함)
+void HAL_I2C_MspInit(I2C_HandleTypeDef *hi2c)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+  if (hi2c->Instance != I2C1)
+    return;
+
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  GPIO_InitStruct.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_OD;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+  HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+  __HAL_RCC_I2C1_CLK_ENABLE();
+
+  I2C1_DmaInit(&hdma_i2c1_tx, DMA1_Channel6, DMA_MEMORY_TO_PERIPH);
+  __HAL_LINKDMA(hi2c, hdmatx, hdma_i2c1_tx);
+  I2C1_DmaInit(&hdma_i2c1_rx, DMA1_Channel7, DMA_PERIPH_TO_MEMORY);
+  __HAL_LINKDMA(hi2c, hdmarx, hdma_i2c1_rx);
+}
+
+void I2C1_EV_IRQHandler(void)
+{
+  HAL_I2C_EV_IRQHandler(&hi2c1);
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(&hi2c1);
+}
+
+void DMA1_Channel6_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_i2c1_tx);
+}
 
-  hadc1.Instance = ADC1;
-  hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
-  hadc1.Init.ScanConvMode = ADC_SCAN_DISABLE;
-  hadc1.Init.ContinuousConvMode = DISABLE;
-  hadc1.Init.NbrOfConversion = 1;
-  hadc1.Init.DiscontinuousConvMode = DISABLE;
-  HAL_ADC_Init(&hadc1);
+void DMA1_Channel7_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_i2c1_rx);
+}
+#endif
 
-  sConfig.Channel = ADC_CHANNEL_1;
+static void ADC1_SelectChannel(uint32_t channel, uint32_t sampling)
+{
+  ADC_ChannelConfTypeDef sConfig = {0};
+  sConfig.Channel = channel;
   sConfig.Rank = 1;
-  sConfig.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
+  sConfig.SamplingTime = sampling;
   HAL_ADC_ConfigChannel(&hadc1, &sConfig);
 }
 
@@ -143,18 +496,6 @@ static void MX_TIM3_Init(void)
   HAL_TIM_PWM_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_1);
 }
 
-static void MX_USART1_UART_Init(void)
-{
-  __HAL_RCC_USART1_CLK_ENABLE();
-  huart1.Instance = USART1;
-  huart1.Init.BaudRate = 115200;
-  huart1.Init.WordLength = UART_WORDLENGTH_8B;
-  huart1.Init.StopBits = UART_STOPBITS_1;
-  huart1.Init.Parity = UART_PARITY_NONE;
-  huart1.Init.Mode = UART_MODE_TX_RX;
-  HAL_UART_Init(&huart1);
-}
-
 static void MX_I2C1_Init(void)
 {
   __HAL_RCC_I2C1_CLK_ENABLE();
@@ -165,6 +506,12 @@ static void MX_I2C1_Init(void)
   hi2c1.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
   hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
   HAL_I2C_Init(&hi2c1);
+
+  // DMA 전송의 주소 단계와 완료 처리는 I2C 이벤트 인터럽트에서
+  HAL_NVIC_SetPriority(I2C1_EV_IRQn, 3, 0);
+  HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+  HAL_NVIC_SetPriority(I2C1_ER_IRQn, 3, 0);
+  HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
 }
 
 static void MX_RTC_Init(void)
@@ -188,19 +535,10 @@ static void MX_RTC_Init(void)
   HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
 }
 
-static void MX_GPIO_Init(void)
+// PA0 버튼: 상승 에지 인터럽트 (핀 자체는 Board_Init 이 입력으로)
+static void Button_Init(void)
 {
   GPIO_InitTypeDef GPIO_InitStruct = {0};
-  __HAL_RCC_GPIOC_CLK_ENABLE();
-  __HAL_RCC_GPIOA_CLK_ENABLE();
-
-  // PC13: LED 출력
-  GPIO_InitStruct.Pin = GPIO_PIN_13;
-  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
-  HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
-
-  // PA0: 버튼 입력 (인터럽트)
   GPIO_InitStruct.Pin = GPIO_PIN_0;
   GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
@@ -1,48 +1,49 @@
 #include "main.h"
 #include "cmsis_os.h"
+#include "stack_mon.h"
+#include "rt_stats.h"
+#include "rules.h"
+#include "sensor_rec.h"
+#include "sys_pipeline.h"
+#include "dlog.h"
+#include "periodic.h"
+#include "sys_graph.h"
+#include "board.h"
+#include "pwm_fade.h"
 #include <stdio.h>
 #include <string.h>
 
-// --- 타입 정의 ---
-typedef enum {
-    EVENT_SENSOR_READ,
-    EVENT_DISPLAY_UPDATE,
-    EVENT_ERROR
-} EventType;
-
-typedef struct {
-    EventType type;
-    uint16_t value;
-} Event;
-
 // --- 핸들 정의 ---
 ADC_HandleTypeDef hadc1;
 UART_HandleTypeDef huart1;
-osThreadId sensorTaskHandle;
-osThreadId logicTaskHandle;
-osThreadId displayTaskHandle;
-osMessageQId eventQueueHandle;
+osMessageQId eventQueueHandle;      // Sensor -> Logic
+osMessageQId displayQueueHandle;    // Logic -> Display
+
+// --- 주기 태스크 통계 ---
+static PeriodicTask sensorPeriod;
 
-// --- 큐 정의 ---
-osMessageQDef(eventQueue, 16, Event);
+// --- 규칙 블롭 / LED 밝기 수신 (USART1 RX 인터럽트로 한 바이트씩, 프레임은 sys_pipeline.h) ---
+static uint8_t rxByte;
+static volatile uint8_t rxArmed;        // Receive_IT 가 걸려 있음, 못 걸었으면 MonitorTask 가 다시
+static int isrUartRx = -1;
 
 // --- 유틸 함수 ---
+// 화면 갱신은 Display 의 큐로, 나머지는 Logic 의 큐로 (한 큐를 둘이 꺼내면 먼저 깨어난 쪽이 가져감)
 void SendEvent(EventType type, uint16_t value) {
     Event evt = { .type = type, .value = value };
-    osMessagePut(eventQueueHandle, *(uint32_t*)&evt, 0);
+    osMessageQId q = (type == EVENT_DISPLAY_UPDATE) ? displayQueueHandle : eventQueueHandle;
+    osMessagePut(q, *(uint32_t*)&evt, 0);
 }
 
 // --- 태스크 정의 ---
 void SensorTask(void const *arg) {
     uint16_t adcVal = 0;
+    uint32_t reads = 0;
     while (1) {
-        HAL_ADC_Start(&hadc1);
-        if (HAL_ADC_PollForConversion(&hadc1, 100) == HAL_OK) {
-            adcVal = HAL_ADC_GetValue(&hadc1);
+        Periodic_Wait(&sensorPeriod);
+        if (SysPipe_Sense(&hadc1, reads++, &adcVal)) {
             SendEvent(EVENT_SENSOR_READ, adcVal);
         }
-        HAL_ADC_Stop(&hadc1);
-        osDelay(500);
     }
 }
 
@@ -52,22 +53,9 @@ void LogicTask(void const *arg) {
         evt = osMessageGet(eventQueueHandle, osWaitForever);
         if (evt.status == osEventMessage) {
             Event e = *(Event*)&evt.value.v;
-            switch (e.type) {
-                case EVENT_SENSOR_READ:
-                    if (e.value > 2000) {
-                        HAL_GPIO_WritePin(GPIOC, GPIO_PIN_13, GPIO_PIN_RESET); // LED ON
-                    } else {
-                        HAL_GPIO_WritePin(GPIOC, GPIO_PIN_13, GPIO_PIN_SET);   // LED OFF
-                    }
-                    SendEvent(EVENT_DISPLAY_UPDATE, e.value);
-                    break;
-
-                case EVENT_ERROR:
-                    // Future error handler
-                    break;
-
-                default:
-                    break;
+            Event out;
+            if (SysPipe_Logic(Rules_Default(), &e, osKernelSysTick(), &out)) {
+                SendEvent(out.type, out.value);
             }
         }
     }
@@ -75,87 +63,136 @@ void LogicTask(void const *arg) {
 
 void DisplayTask(void const *arg) {
     osEvent evt;
-    char msg[32];
     while (1) {
-        evt = osMessageGet(eventQueueHandle, osWaitForever);
+        evt = osMessageGet(displayQueueHandle, osWaitForever);
         if (evt.status == osEventMessage) {
             Event e = *(Event*)&evt.value.v;
-            if (e.type == EVENT_DISPLAY_UPDATE) {
-                sprintf(msg, "Sensor: %u\r\n", e.value);
-                HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
-            }
+            SysPipe_Display(&e);
+        }
+    }
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart != &huart1) {
+        return;
+    }
+    RtStats_IsrEnter(isrUartRx);
+    SysPipe_RxByte(rxByte);
+    rxArmed = (HAL_UART_Receive_IT(&huart1, &rxByte, 1) == HAL_OK);
+    RtStats_IsrExit(isrUartRx);
+}
+
+// 오버런 등으로 HAL 이 수신을 멈춤
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+    if (huart == &huart1) {
+        rxArmed = 0;
+    }
+}
+
+// 받은 프레임 처리, 결과는 로그 한 줄
+//   규칙 블롭: 로드 (다음 Rules_Eval 에서 적용), 평가 중이라 못 하면 남겨 두고 다음 초에 다시
+//   LED 밝기: pwm_fade 페이드 시작 (진행 중이면 지금 위치에서 이어받음)
+static void PollRx(void) {
+    if (!rxArmed) {
+        rxArmed = (HAL_UART_Receive_IT(&huart1, &rxByte, 1) == HAL_OK);
+    }
+    SysRxFrame f;
+    if (!SysPipe_RxGet(&f)) {
+        return;
+    }
+    if (f.type == SYS_RX_RULES) {
+        int r = RulesEngine_LoadBlob(Rules_Default(), f.data, f.len);
+        if (r == RULES_ERR_BUSY) {
+            return;
+        }
+        DLOG("RULES load %d dropped %lu\r\n", r, (unsigned long)SysPipe_RxDropped());
+    } else {
+        uint16_t targets[SYS_LED_CHANNELS];
+        uint32_t ms = 0;
+        int r = SysPipe_ParseLed(&f, targets, &ms);
+        if (r == 0) {
+            r = PwmFade_To(targets, ms);
+        }
+        DLOG("LED fade %d ms %lu dropped %lu\r\n", r, (unsigned long)ms, (unsigned long)SysPipe_RxDropped());
+    }
+    SysPipe_RxRelease();
+}
+
+// MonitorTask: 1초마다 받은 프레임 (규칙, LED) 처리, CPU 사용률 프레임, 현장 기록 프레임, 로그 프레임,
+// 5초마다 스택 / 주기 태스크 리포트
+void MonitorTask(void const *arg) {
+    uint32_t count = 0;
+    RtStats_ReportNames();
+    Periodic_ReportNames();
+    StackMon_ReportNames();
+    while (1) {
+        osDelay(RT_STATS_PERIOD_MS);
+        PollRx();
+        RtStats_Report();
+        SensorRec_Flush();
+        DLog_Flush();
+        if (++count % 5 == 0) {
+            StackMon_Report();
+            Periodic_Report();
         }
     }
 }
 
 // --- 시스템 초기화 ---
 void SystemClock_Config(void);
-static void MX_GPIO_Init(void);
-static void MX_ADC1_Init(void);
-static void MX_USART1_UART_Init(void);
 
 int main(void)
 {
     HAL_Init();
     SystemClock_Config();
-    MX_GPIO_Init();
-    MX_ADC1_Init();
-    MX_USART1_UART_Init();
 
-    // 큐 생성
-    eventQueueHandle = osMessageCreate(osMessageQ(eventQueue), NULL);
+    // GPIO / USART1 / ADC1: board.hpp 설정을 레지스터로, HAL 핸들은 같은 설정으로 채우기만
+    Board_Init();
+    Board_BindHal(&huart1, &hadc1);
+
+    // LED 밝기: TIM1 PWM + DMA1 채널 5 (핀은 Board_Init), 밝기는 UART 'P' 프레임으로
+    PwmFade_Init();
+
+    // 현장 기록 (host/replay.cpp 로 다시 돌림)
+    SensorRec_Init();
+
+    // 규칙 엔진: 출력 연결 후 기본 규칙 (sys_pipeline.c, 첫 평가에서 적용)
+    SysPipe_InitRules(Rules_Default(), SysPipe_RuleLed);
 
-    // 태스크 생성
-    osThreadDef(sensorTask, SensorTask, osPriorityNormal, 0, 128);
-    osThreadDef(logicTask,  LogicTask,  osPriorityAboveNormal, 0, 128);
-    osThreadDef(displayTask, DisplayTask, osPriorityBelowNormal, 0, 128);
-    sensorTaskHandle  = osThreadCreate(osThread(sensorTask), NULL);
-    logicTaskHandle   = osThreadCreate(osThread(logicTask), NULL);
-    displayTaskHandle = osThreadCreate(osThread(displayTask), NULL);
+    // 큐와 태스크: sys_graph.cpp 의 그래프 (연결 검사는 빌드 때, 저장소는 정적)
+    TaskGraph_Create();
+    eventQueueHandle   = TaskGraph_Queue(SYS_QUEUE_EVENT);
+    displayQueueHandle = TaskGraph_Queue(SYS_QUEUE_DISPLAY);
+
+    // 스택 high-water 모니터, 실행 시간 통계 등록
+    RtStats_Init();
+    for (uint32_t i = 0; i < SYS_TASK_COUNT; i++) {
+        StackMon_Register(TaskGraph_TaskName(i), TaskGraph_Thread(i), TaskGraph_StackWords(i));
+        RtStats_RegisterTask(TaskGraph_TaskName(i), TaskGraph_Thread(i));
+    }
+    isrUartRx = RtStats_RegisterIsr("uart_rx");
+
+    // 규칙 블롭 / LED 밝기 수신: USART1 RX 인터럽트 (ISR 은 RTOS API 를 부르지 않음)
+    HAL_NVIC_SetPriority(USART1_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
+    rxArmed = (HAL_UART_Receive_IT(&huart1, &rxByte, 1) == HAL_OK);
+
+    // 주기 태스크: 500 ms 격자, 마감 50 ms
+    Periodic_Init(&sensorPeriod, "sensor", SYS_SENSOR_PERIOD_MS, SYS_SENSOR_DEADLINE_MS);
 
     osKernelStart(); // RTOS 시작
 
     while (1) {} // 도달하지 않음
 }
 
-// --- 초기화 함수들 ---
-static void MX_ADC1_Init(void)
+#ifndef HOST_BUILD
+void USART1_IRQHandler(void)
 {
-    ADC_ChannelConfTypeDef sConfig = {0};
-    __HAL_RCC_ADC1_CLK_ENABLE();
-    hadc1.Instance = ADC1;
-    hadc1.Init.ScanConvMode = ADC_SCAN_DISABLE;
-    hadc1.Init.ContinuousConvMode = DISABLE;
-    hadc1.Init.DiscontinuousConvMode = DISABLE;
-    hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
-    hadc1.Init.NbrOfConversion = 1;
-    HAL_ADC_Init(&hadc1);
-
-    sConfig.Channel = ADC_CHANNEL_1;
-    sConfig.Rank = 1;
-    sConfig.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
-    HAL_ADC_ConfigChannel(&hadc1, &sConfig);
+    HAL_UART_IRQHandler(&huart1);
 }
 
-static void MX_USART1_UART_Init(void)
+void DMA1_Channel5_IRQHandler(void)
 {
-    __HAL_RCC_USART1_CLK_ENABLE();
-    huart1.Instance = USART1;
-    huart1.Init.BaudRate = 115200;
-    huart1.Init.WordLength = UART_WORDLENGTH_8B;
-    huart1.Init.StopBits = UART_STOPBITS_1;
-    huart1.Init.Parity = UART_PARITY_NONE;
-    huart1.Init.Mode = UART_MODE_TX_RX;
-    HAL_UART_Init(&huart1);
-}
-
-static void MX_GPIO_Init(void)
-{
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-    __HAL_RCC_GPIOC_CLK_ENABLE();
-
-    GPIO_InitStruct.Pin = GPIO_PIN_13;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
-    HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
+    PwmFade_DmaIrq();
 }
+#endif
@@ -0,0 +1,115 @@
+// sys_coro.cpp
+// sys.c 와 같은 일 (Sensor -> eventQueue -> Logic -> displayQueue -> Display, Monitor) 을 RTOS 없이
+// 코루틴 태스크로 (coro.hpp). 네 태스크가 main 스택 하나를 같이 쓴다.
+//
+// sys.c 와 다른 점
+// - 태스크 스택 / TCB / FreeRTOS 힙이 없다. 태스크 몫은 프레임 + Slot (host/coro_bench 로 비교)
+// - 선점 없음: Logic 이 Sensor 보다 우선이 아니라 Sensor 가 잠든 뒤에 돈다 (500 ms 주기라 차이 없음)
+// - MonitorTask 는 RtStats / StackMon 대신 CORO 리포트 (태스크가 스레드가 아니라서)
+// - UART 수신 프레임 (규칙 블롭, LED 밝기) 은 받지 않음
+#include "main.h"
+#include "board.h"
+#include "coro.hpp"
+#include "dlog.h"
+#include "sys_pipeline.h"
+extern "C" {
+#include "rules.h"
+#include "sensor_rec.h"
+}
+
+// --- 핸들 정의 ---
+ADC_HandleTypeDef hadc1;
+UART_HandleTypeDef huart1;
+
+static coro::Executor sched;
+static coro::Queue<Event, SYS_EVENT_QUEUE_LEN> eventQueue;       // Sensor -> Logic
+static coro::Queue<Event, SYS_DISPLAY_QUEUE_LEN> displayQueue;   // Logic -> Display
+
+#define MONITOR_PERIOD_MS    1000
+
+// --- 유틸 함수 ---
+// osMessagePut(.., 0) 처럼 가득 차면 버림
+static void SendEvent(EventType type, uint16_t value)
+{
+    Event evt = { type, value };
+    if (type == EVENT_DISPLAY_UPDATE)
+        displayQueue.TryPut(evt);
+    else
+        eventQueue.TryPut(evt);
+}
+
+// --- 태스크 정의 ---
+// 단계 본문은 sys.c 와 같은 sys_pipeline.c
+static coro::Task SensorTask()
+{
+    coro::Tick prev = coro::Now();
+    uint32_t reads = 0;
+    for (;;) {
+        co_await coro::SleepUntil{ prev, SYS_SENSOR_PERIOD_MS };
+        uint16_t adcVal;
+        if (SysPipe_Sense(&hadc1, reads++, &adcVal)) {
+            SendEvent(EVENT_SENSOR_READ, adcVal);
+        }
+    }
+}
+
+static coro::Task LogicTask()
+{
+    for (;;) {
+        Event e = co_await eventQueue.Get();
+        Event out;
+        if (SysPipe_Logic(Rules_Default(), &e, coro::Now(), &out)) {
+            SendEvent(out.type, out.value);
+        }
+    }
+}
+
+static coro::Task DisplayTask()
+{
+    for (;;) {
+        Event e = co_await displayQueue.Get();
+        SysPipe_Display(&e);
+    }
+}
+
+// MonitorTask: 1초마다 현장 기록 / 로그 프레임, 5초마다 태스크 리포트
+static coro::Task MonitorTask()
+{
+    coro::Tick prev = coro::Now();
+    uint32_t count = 0;
+    sched.ReportNames();
+    for (;;) {
+        co_await coro::SleepUntil{ prev, MONITOR_PERIOD_MS };
+        SensorRec_Flush();
+        DLog_Flush();
+        if (++count % 5 == 0) {
+            sched.Report();
+        }
+    }
+}
+
+// --- 시스템 초기화 ---
+extern "C" void SystemClock_Config(void);
+
+int main(void)
+{
+    HAL_Init();
+    SystemClock_Config();
+
+    // GPIO / USART1 / ADC1: sys.c 와 같이 board.hpp 설정을 레지스터로, HAL 핸들은 채우기만
+    Board_Init();
+    Board_BindHal(&huart1, &hadc1);
+
+    SensorRec_Init();
+
+    // 규칙 엔진: 출력 연결 후 기본 규칙 (sys_pipeline.c)
+    SysPipe_InitRules(Rules_Default(), SysPipe_RuleLed);
+
+    // 만드는 순서가 처음 도는 순서. 프레임이 아레나에 안 들어가면 여기서 멈춤
+    if (sched.Spawn("sensor", SensorTask()) < 0 || sched.Spawn("logic", LogicTask()) < 0 ||
+        sched.Spawn("display", DisplayTask()) < 0 || sched.Spawn("monitor", MonitorTask()) < 0) {
+        for (;;) {}
+    }
+
+    sched.Run();
+}
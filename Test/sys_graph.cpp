@@ -0,0 +1,51 @@
+// sys_graph.cpp
+// sys.c 의 태스크 / 큐 그래프. 스택 크기는 타깃과 같은 바이너리 DLOG (-DDLOG_TEXT=0) 로 잰
+// host/stack_size 권장값, 바꾼 뒤에는 타깃 StackMon 리포트로 다시 확인
+#include "task_graph.hpp"
+#include "sys_graph.h"
+#include "sys_pipeline.h"
+
+extern "C" {
+void SensorTask(void const *arg);
+void LogicTask(void const *arg);
+void DisplayTask(void const *arg);
+void MonitorTask(void const *arg);
+}
+
+namespace {
+
+using tg::Use;
+
+// 큐 항목은 Event 를 uint32_t 로 넣은 것 (SendEvent)
+constexpr tg::Graph<4, 2, 4> kSysGraph = {
+    {{
+        { "sensor",  SensorTask,  osPriorityNormal,       80 },
+        { "logic",   LogicTask,   osPriorityAboveNormal,  96 },
+        { "display", DisplayTask, osPriorityBelowNormal,  96 },
+        { "monitor", MonitorTask, osPriorityLow,         368 },   // 시작할 때 이름 줄의 snprintf / vsnprintf
+    }},
+    {{
+        { "eventQueue",   SYS_EVENT_QUEUE_LEN,   sizeof(uint32_t) },
+        { "displayQueue", SYS_DISPLAY_QUEUE_LEN, sizeof(uint32_t) },
+    }},
+    {{
+        { "sensor",  Use::Put, "eventQueue" },
+        { "logic",   Use::Get, "eventQueue" },
+        { "logic",   Use::Put, "displayQueue" },
+        { "display", Use::Get, "displayQueue" },
+    }},
+};
+
+static_assert(tg::StageIndex(kSysGraph, "sensor") == SYS_TASK_SENSOR &&
+              tg::StageIndex(kSysGraph, "logic") == SYS_TASK_LOGIC &&
+              tg::StageIndex(kSysGraph, "display") == SYS_TASK_DISPLAY &&
+              tg::StageIndex(kSysGraph, "monitor") == SYS_TASK_MONITOR && kSysGraph.stages.size() == SYS_TASK_COUNT,
+              "sys_graph.h 태스크 번호가 그래프 순서와 다름");
+static_assert(tg::QueueIndex(kSysGraph, "eventQueue") == SYS_QUEUE_EVENT &&
+              tg::QueueIndex(kSysGraph, "displayQueue") == SYS_QUEUE_DISPLAY &&
+              kSysGraph.queues.size() == SYS_QUEUE_COUNT,
+              "sys_graph.h 큐 번호가 그래프 순서와 다름");
+
+} // namespace
+
+TASK_GRAPH_EXPORT(kSysGraph)
@@ -0,0 +1,22 @@
+#ifndef SYS_GRAPH_H
+#define SYS_GRAPH_H
+
+#include "task_graph.h"
+
+// sys.c 의 태스크 / 큐 번호 (sys_graph.cpp 그래프에 적은 순서, static_assert 로 맞춤)
+//   sensor -> eventQueue -> logic -> displayQueue -> display, monitor 는 큐 없음
+enum {
+    SYS_TASK_SENSOR,
+    SYS_TASK_LOGIC,
+    SYS_TASK_DISPLAY,
+    SYS_TASK_MONITOR,
+    SYS_TASK_COUNT
+};
+
+enum {
+    SYS_QUEUE_EVENT,
+    SYS_QUEUE_DISPLAY,
+    SYS_QUEUE_COUNT
+};
+
+#endif
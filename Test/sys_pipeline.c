@@ -0,0 +1,190 @@
+#include "main.h"
+#include "sys_pipeline.h"
+#include "calib.h"
+#include "dlog.h"
+#include "pwm_fade.h"
+#include "sensor_rec.h"
+
+// 기본 규칙: 예전 raw > 2000 (3.3 V 에서 1612 mV, 약 349 lx) 자리, VDDA 가 바뀌어도 같은 밝기에서 켜짐.
+// 실행 중에는 UART 로 받은 블롭 (SYS_RX_RULES 프레임, MonitorTask 가 로드) 으로 바꾼다
+static const Rule default_rules[] = {
+    { RULE_THRESHOLD, 0, RULE_IN_LUX, 0, 349, 0, RULE_OUT_LED, 1, RULE_OUT_LED, 0 },
+};
+
+void SysPipe_InitRules(RulesEngine *eng, RuleOutputFn led)
+{
+    RulesEngine_Init(eng);
+    RulesEngine_SetOutput(eng, RULE_OUT_LED, led);
+    RulesEngine_LoadTable(eng, default_rules, sizeof(default_rules) / sizeof(default_rules[0]));
+}
+
+int SysPipe_Logic(RulesEngine *eng, const Event *in, uint32_t now_ms, Event *out)
+{
+    switch (in->type) {
+        case EVENT_SENSOR_READ:
+            // 조건이 바뀐 규칙만 동작 (LED 는 켜고 끌 때만 씀)
+            RulesEngine_Eval(eng, RULE_IN_RAW, in->value, now_ms);
+            RulesEngine_Eval(eng, RULE_IN_LUX, (int32_t)CALIB_Q16_INT(Calib_RawToLuxQ16(in->value)), now_ms);
+            out->type = EVENT_DISPLAY_UPDATE;
+            out->value = in->value;
+            return 1;
+
+        case EVENT_ERROR:
+            // Future error handler
+            return 0;
+
+        default:
+            return 0;
+    }
+}
+
+void SysPipe_Display(const Event *e)
+{
+    if (e->type == EVENT_DISPLAY_UPDATE) {
+        DLOG("Sensor: %u\r\n", e->value);
+    }
+}
+
+// --- 보드 쪽 단계 ---
+static void SelectChannel(ADC_HandleTypeDef *hadc, uint32_t channel, uint32_t sampling)
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+    sConfig.Channel = channel;
+    sConfig.Rank = 1;
+    sConfig.SamplingTime = sampling;
+    HAL_ADC_ConfigChannel(hadc, &sConfig);
+}
+
+// VREFINT 한 번 재서 보정 갱신, PA1 로 되돌림
+static void SampleVrefint(ADC_HandleTypeDef *hadc)
+{
+    SelectChannel(hadc, ADC_CHANNEL_VREFINT, ADC_SAMPLETIME_239CYCLES_5);
+    HAL_ADC_Start(hadc);
+    if (HAL_ADC_PollForConversion(hadc, 100) == HAL_OK) {
+        Calib_SetVrefint((uint16_t)HAL_ADC_GetValue(hadc));
+    }
+    HAL_ADC_Stop(hadc);
+    SelectChannel(hadc, ADC_CHANNEL_1, ADC_SAMPLETIME_71CYCLES_5);
+}
+
+int SysPipe_Sense(ADC_HandleTypeDef *hadc, uint32_t reads, uint16_t *raw)
+{
+    int ok = 0;
+    if (reads % SYS_VREFINT_EVERY == 0) {
+        SampleVrefint(hadc);
+    }
+    HAL_ADC_Start(hadc);
+    if (HAL_ADC_PollForConversion(hadc, 100) == HAL_OK) {
+        *raw = (uint16_t)HAL_ADC_GetValue(hadc);
+        SensorRec_Adc(1, *raw);
+        ok = 1;
+    }
+    HAL_ADC_Stop(hadc);
+    return ok;
+}
+
+void SysPipe_RuleLed(uint8_t on)
+{
+    HAL_GPIO_WritePin(GPIOC, GPIO_PIN_13, on ? GPIO_PIN_RESET : GPIO_PIN_SET);   // active low
+    SensorRec_Gpio(SREC_GPIO_OUT, 'C', 13, !on);
+}
+
+// --- 수신 프레임 ---
+enum { RX_SYNC0, RX_SYNC1, RX_TYPE, RX_LEN0, RX_LEN1, RX_DATA, RX_SUM };
+
+static uint8_t rx_blob[SYS_RX_MAX];
+static uint16_t rx_len, rx_pos;
+static uint8_t rx_state, rx_sum, rx_type;
+static volatile uint8_t rx_ready;       // rx_blob 에 프레임 하나, Release 할 때까지 다음 프레임은 버림
+static volatile uint32_t rx_dropped;
+
+void SysPipe_RxByte(uint8_t b)
+{
+    switch (rx_state) {
+        case RX_SYNC0:
+            rx_state = (b == SYS_RX_SYNC0) ? RX_SYNC1 : RX_SYNC0;
+            break;
+        case RX_SYNC1:
+            rx_state = (b == SYS_RX_SYNC1) ? RX_TYPE : (b == SYS_RX_SYNC0) ? RX_SYNC1 : RX_SYNC0;
+            break;
+        case RX_TYPE:
+            if (b != SYS_RX_RULES && b != SYS_RX_LED) {
+                rx_state = RX_SYNC0;
+            } else if (rx_ready) {
+                rx_dropped++;               // 앞 프레임을 아직 처리 중, 헤더부터 덮지 않음
+                rx_state = RX_SYNC0;
+            } else {
+                rx_type = b;
+                rx_sum = b;
+                rx_state = RX_LEN0;
+            }
+            break;
+        case RX_LEN0:
+            rx_len = b;
+            rx_sum += b;
+            rx_state = RX_LEN1;
+            break;
+        case RX_LEN1:
+            rx_len |= (uint16_t)(b << 8);
+            rx_sum += b;
+            rx_pos = 0;
+            if (rx_len == 0 || rx_len > SYS_RX_MAX) {
+                rx_dropped++;
+                rx_state = RX_SYNC0;
+            } else {
+                rx_state = RX_DATA;
+            }
+            break;
+        case RX_DATA:
+            rx_blob[rx_pos++] = b;
+            rx_sum += b;
+            if (rx_pos == rx_len)
+                rx_state = RX_SUM;
+            break;
+        case RX_SUM:
+            if (b == rx_sum)
+                rx_ready = 1;
+            else
+                rx_dropped++;
+            rx_state = RX_SYNC0;
+            break;
+        default:
+            rx_state = RX_SYNC0;
+            break;
+    }
+}
+
+int SysPipe_RxGet(SysRxFrame *out)
+{
+    if (!rx_ready)
+        return 0;
+    out->type = rx_type;
+    out->len = rx_len;
+    out->data = rx_blob;
+    return 1;
+}
+
+void SysPipe_RxRelease(void)
+{
+    rx_ready = 0;
+}
+
+uint32_t SysPipe_RxDropped(void)
+{
+    return rx_dropped;
+}
+
+int SysPipe_ParseLed(const SysRxFrame *f, uint16_t targets[SYS_LED_CHANNELS], uint32_t *ms)
+{
+    if (f->type != SYS_RX_LED || (f->len != 4 && f->len != 2 + 2 * SYS_LED_CHANNELS))
+        return -1;
+    *ms = (uint32_t)(f->data[0] | f->data[1] << 8);
+    for (int ch = 0; ch < SYS_LED_CHANNELS; ch++) {
+        const uint8_t *p = f->data + 2 + (f->len == 4 ? 0 : 2 * ch);
+        uint16_t level = (uint16_t)(p[0] | p[1] << 8);
+        if (level >= PWM_FADE_LEVELS && level != PWM_FADE_KEEP)
+            return -1;
+        targets[ch] = level;
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+#ifndef SYS_PIPELINE_H
+#define SYS_PIPELINE_H
+
+#include <stdint.h>
+#include "rules.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// sys.c 파이프라인 (Sensor -> eventQueue -> Logic -> displayQueue -> Display) 의 단계 본문.
+// 큐와 태스크는 부르는 쪽 것이고 여기에는 한 항목을 처리하는 일만 있다:
+//   sys.c          FreeRTOS 태스크 (osMessageGet 으로 받아서)
+//   sys_coro.cpp   코루틴 태스크 (co_await 로 받아서)
+//   host/fleet_sim 보드마다 RulesEngine 하나, 워커 스레드가 한 주기씩
+
+// --- 타입 정의 ---
+typedef enum {
+    EVENT_SENSOR_READ,
+    EVENT_DISPLAY_UPDATE,
+    EVENT_ERROR
+} EventType;
+
+typedef struct {
+    EventType type;
+    uint16_t value;
+} Event;
+
+// --- 주기 / 큐 깊이 (sys_graph.cpp 의 큐 크기도 이것) ---
+#define SYS_SENSOR_PERIOD_MS     500
+#define SYS_SENSOR_DEADLINE_MS   50
+#define SYS_EVENT_QUEUE_LEN      16     // Sensor -> Logic
+#define SYS_DISPLAY_QUEUE_LEN    8      // Logic -> Display
+#define SYS_VREFINT_EVERY        20     // SensorTask 20 회(10 초)마다 VDDA 다시 잼
+
+// --- 규칙 엔진 입력 채널 / 출력 ---
+#define RULE_IN_RAW              0      // ADC raw
+#define RULE_IN_LUX              1      // 보정된 조도 (lx, 정수)
+#define RULE_OUT_LED             0      // arg 1 = 켬, 0 = 끔
+
+// --- 수신 프레임 (UART RX, 리틀 엔디언) ---
+//   0xA5 0x5A type len(u16) | 내용 len 바이트 | sum(u8, type 부터 내용 끝까지 합)
+//   'B'  규칙 블롭 (rules.h 형식)
+//   'P'  LED 밝기 (pwm_fade): ms(u16) | level(u16) 하나 (네 채널 모두) 또는 넷 (채널마다).
+//        단계는 ai.py 와 같은 0~999, 0xFFFF 는 그 채널 그대로
+// 보내는 프레임 (rt_stats, sensor_rec, dlog) 과 같은 꼴이고 블롭이 255 바이트를 넘을 수 있어 길이만 u16
+#define SYS_RX_SYNC0             0xA5u
+#define SYS_RX_SYNC1             0x5Au
+#define SYS_RX_RULES             'B'
+#define SYS_RX_LED               'P'
+#define SYS_RX_MAX               RULES_BLOB_SIZE(RULES_MAX)
+#define SYS_LED_CHANNELS         4
+
+typedef struct {
+    uint8_t type;
+    uint16_t len;
+    const uint8_t *data;
+} SysRxFrame;
+
+// 출력 연결 후 기본 규칙 (첫 평가에서 적용)
+void SysPipe_InitRules(RulesEngine *eng, RuleOutputFn led);
+
+// LogicTask 한 항목: 센서 값이면 규칙을 평가하고 화면 갱신 이벤트를 out 에. out 을 채웠으면 1
+int SysPipe_Logic(RulesEngine *eng, const Event *in, uint32_t now_ms, Event *out);
+
+// DisplayTask 한 항목: "Sensor: <raw>" 로그 한 줄
+void SysPipe_Display(const Event *e);
+
+// --- 보드 쪽 단계 (HAL, sys.c / sys_coro.cpp) ---
+// SensorTask 한 번 (reads 는 0 부터 센 횟수): SYS_VREFINT_EVERY 번마다 VREFINT 로 보정 갱신,
+// PA1 을 읽어 현장 기록에 남기고 raw 에. 변환이 끝났으면 1.
+// main.h 다음에 포함했을 때만 보인다 (board.h 와 같은 이유)
+#if defined(MAIN_H) || defined(__MAIN_H)
+int SysPipe_Sense(ADC_HandleTypeDef *hadc, uint32_t reads, uint16_t *raw);
+#endif
+
+// 규칙 출력 LED (RULE_OUT_LED): PC13, active low. 현장 기록에도 남김
+void SysPipe_RuleLed(uint8_t on);
+
+// 수신 바이트 하나 (UART RX 완료 인터럽트에서). 앞 프레임을 로드하기 전에 온 프레임, 길이/합이 틀린
+// 프레임은 버리고 센다
+void SysPipe_RxByte(uint8_t b);
+// 다 받은 프레임이 있으면 out 에 채우고 1, 없으면 0. 내용은 SysPipe_RxRelease 까지 유효하고
+// 그 전에 온 프레임은 버림 (처리를 미룰 때는 Release 하지 않고 다음에 다시 Get)
+int SysPipe_RxGet(SysRxFrame *out);
+void SysPipe_RxRelease(void);
+uint32_t SysPipe_RxDropped(void);
+
+// 'P' 내용을 채널별 목표 (PwmFade_To 인자) 와 페이드 ms 로. 길이나 단계가 틀리면 -1
+int SysPipe_ParseLed(const SysRxFrame *f, uint16_t targets[SYS_LED_CHANNELS], uint32_t *ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include <stdint.h>
+#include "cmsis_os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 펌웨어의 태스크 / 큐 그래프 (task_graph.hpp 로 선언한 그래프 TU 가 구현: sys_graph.cpp 등).
+// 번호는 그래프에 적은 순서이고, 펌웨어 헤더(sys_graph.h 등)의 enum 과 static_assert 로 맞춘다.
+
+// 큐를 만들고 태스크를 만든다 (모두 정적 저장소). osKernelStart 전에 한 번
+void TaskGraph_Create(void);
+
+uint32_t TaskGraph_TaskCount(void);
+uint32_t TaskGraph_QueueCount(void);
+osThreadId TaskGraph_Thread(uint32_t i);
+osMessageQId TaskGraph_Queue(uint32_t i);
+const char *TaskGraph_TaskName(uint32_t i);
+const char *TaskGraph_QueueName(uint32_t i);
+uint32_t TaskGraph_StackWords(uint32_t i);
+
+// 스택 + TCB + 큐 버퍼 + 큐 제어 블록 (컴파일 중에 정해짐)
+uint32_t TaskGraph_StaticBytes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
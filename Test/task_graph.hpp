@@ -0,0 +1,284 @@
+// task_graph.hpp
+// 태스크 / 큐 연결을 constexpr 로 선언하고, 잘못된 연결은 빌드에서 막고, 저장소는 정적으로 만든다
+//
+// 펌웨어마다 그래프 TU 하나 (sys_graph.cpp 등): 단계(태스크), 큐, 그리고 "어느 단계가 어느 큐에
+// 넣고 / 꺼내고 / 들여다보는지" 간선을 이름으로 적는다. tg::Instance<그래프> 가
+//   - 검사: 이름이 다 있는지, 겹치는 이름, 우선순위 / 스택 / 큐 크기 범위,
+//           넣는 쪽 없는 큐, 꺼내는 쪽이 둘 이상인 큐, 아무도 꺼내지 않는 큐 (Peek 만으로는 안 빠짐),
+//           단계 사이 순환 (큐가 차면 서로 기다리다 멈춤, 자기가 꺼내는 큐에 넣는 것도 여기 걸림)
+//   - 저장소: 스택, TCB, 큐 버퍼와 제어 블록을 크기가 정해진 정적 배열로 (힙 0, 링커 맵에 다 보임)
+//   - 생성: 큐를 먼저 만들고 태스크를 osThreadDef_t.buffer / controlblock 으로 만든다
+//           (configSUPPORT_STATIC_ALLOCATION, 호스트는 host_os 가 받아서 정적이라고 표시만 함)
+// TASK_GRAPH_EXPORT 가 C 펌웨어에서 부를 task_graph.h 함수를 만든다.
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include "cmsis_os.h"
+#include "task_graph.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tg {
+
+enum class Use : uint8_t { Put, Get, Peek };
+
+struct Stage {
+    const char *name;
+    os_pthread fn;
+    osPriority prio;
+    uint32_t stack_words;
+};
+
+struct Queue {
+    const char *name;
+    uint32_t depth;
+    uint32_t item_sz;           // CMSIS v1 메시지는 32비트 하나라 1 ~ 4
+};
+
+struct Edge {
+    const char *stage;
+    Use use;
+    const char *queue;
+};
+
+template <size_t S, size_t Q, size_t E>
+struct Graph {
+    std::array<Stage, S> stages;
+    std::array<Queue, Q> queues;
+    std::array<Edge, E> edges;
+};
+
+constexpr uint32_t kMinStackWords = 64;     // configMINIMAL_STACK_SIZE
+constexpr uint32_t kMaxQueueDepth = 255;
+
+constexpr bool StrEq(const char *a, const char *b)
+{
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr int StageIndex(const Graph<S, Q, E> &g, const char *name)
+{
+    for (size_t i = 0; i < S; i++)
+        if (StrEq(g.stages[i].name, name)) return (int)i;
+    return -1;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr int QueueIndex(const Graph<S, Q, E> &g, const char *name)
+{
+    for (size_t i = 0; i < Q; i++)
+        if (StrEq(g.queues[i].name, name)) return (int)i;
+    return -1;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr bool EdgesResolve(const Graph<S, Q, E> &g)
+{
+    for (const Edge &e : g.edges)
+        if (StageIndex(g, e.stage) < 0 || QueueIndex(g, e.queue) < 0) return false;
+    return true;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr bool NamesUnique(const Graph<S, Q, E> &g)
+{
+    for (size_t i = 0; i < S; i++)
+        if (StageIndex(g, g.stages[i].name) != (int)i) return false;
+    for (size_t i = 0; i < Q; i++)
+        if (QueueIndex(g, g.queues[i].name) != (int)i) return false;
+    return true;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr bool StagesValid(const Graph<S, Q, E> &g)
+{
+    for (const Stage &s : g.stages)
+        if (!s.fn || s.prio < osPriorityIdle || s.prio > osPriorityRealtime || s.stack_words < kMinStackWords)
+            return false;
+    return true;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr bool QueuesValid(const Graph<S, Q, E> &g)
+{
+    for (const Queue &q : g.queues)
+        if (q.depth < 1 || q.depth > kMaxQueueDepth || q.item_sz < 1 || q.item_sz > 4) return false;
+    return true;
+}
+
+// 큐 q 에 use 로 붙은 간선 수
+template <size_t S, size_t Q, size_t E>
+constexpr uint32_t Count(const Graph<S, Q, E> &g, size_t q, Use use)
+{
+    uint32_t n = 0;
+    for (const Edge &e : g.edges)
+        n += (QueueIndex(g, e.queue) == (int)q && e.use == use) ? 1u : 0u;
+    return n;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr bool EveryQueueFed(const Graph<S, Q, E> &g)
+{
+    for (size_t q = 0; q < Q; q++)
+        if (Count(g, q, Use::Put) == 0) return false;
+    return true;
+}
+
+// 꺼내는 쪽이 둘이면 메시지가 종류와 상관없이 먼저 깨어난 쪽으로 간다
+template <size_t S, size_t Q, size_t E>
+constexpr bool OneConsumer(const Graph<S, Q, E> &g)
+{
+    for (size_t q = 0; q < Q; q++)
+        if (Count(g, q, Use::Get) > 1) return false;
+    return true;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr bool EveryQueueDrained(const Graph<S, Q, E> &g)
+{
+    for (size_t q = 0; q < Q; q++)
+        if (Count(g, q, Use::Get) == 0) return false;
+    return true;
+}
+
+// 단계 a 가 넣는 큐를 단계 b 가 꺼내면 a -> b. 들어오는 간선 없는 단계부터 지워 나가서 다 지워지면 순환 없음
+template <size_t S, size_t Q, size_t E>
+constexpr bool Acyclic(const Graph<S, Q, E> &g)
+{
+    if (!EdgesResolve(g))
+        return true;            // 이름 오류는 따로 알림
+    std::array<std::array<bool, S>, S> to{};
+    for (const Edge &p : g.edges)
+        for (const Edge &c : g.edges)
+            if (p.use == Use::Put && c.use == Use::Get && QueueIndex(g, p.queue) == QueueIndex(g, c.queue))
+                to[(size_t)StageIndex(g, p.stage)][(size_t)StageIndex(g, c.stage)] = true;
+    std::array<bool, S> gone{};
+    for (size_t round = 0; round < S; round++) {
+        bool removed = false;
+        for (size_t b = 0; b < S; b++) {
+            if (gone[b]) continue;
+            bool has_in = false;
+            for (size_t a = 0; a < S; a++)
+                has_in = has_in || (!gone[a] && to[a][b]);
+            if (!has_in) {
+                gone[b] = true;
+                removed = true;
+            }
+        }
+        if (!removed) break;
+    }
+    for (bool x : gone)
+        if (!x) return false;
+    return true;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr uint32_t StackWords(const Graph<S, Q, E> &g)
+{
+    uint32_t n = 0;
+    for (const Stage &s : g.stages)
+        n += s.stack_words;
+    return n;
+}
+
+template <size_t S, size_t Q, size_t E>
+constexpr uint32_t QueueBytes(const Graph<S, Q, E> &g)
+{
+    uint32_t n = 0;
+    for (const Queue &q : g.queues)
+        n += q.depth * q.item_sz;
+    return n;
+}
+
+template <const auto &G>
+class Instance {
+    static constexpr size_t S = G.stages.size();
+    static constexpr size_t Q = G.queues.size();
+
+    static_assert(EdgesResolve(G), "간선에 없는 단계 / 큐 이름");
+    static_assert(NamesUnique(G), "단계 또는 큐 이름이 겹침");
+    static_assert(StagesValid(G), "태스크 함수 없음, 우선순위 범위 밖, 또는 스택이 configMINIMAL_STACK_SIZE 보다 작음");
+    static_assert(QueuesValid(G), "큐 깊이 1 ~ 255, 항목 1 ~ 4 바이트");
+    static_assert(EveryQueueFed(G), "아무도 넣지 않는 큐");
+    static_assert(OneConsumer(G), "꺼내는 태스크가 둘 이상인 큐 (메시지가 엉뚱한 쪽으로 감)");
+    static_assert(EveryQueueDrained(G), "아무도 꺼내지 않는 큐 (Peek 만으로는 비지 않음)");
+    static_assert(Acyclic(G), "태스크 사이 순환 (자기가 꺼내는 큐에 넣는 것 포함)");
+
+    template <size_t N, typename F>
+    static constexpr std::array<uint32_t, N> Offsets(F size)
+    {
+        std::array<uint32_t, N> off{};
+        for (size_t i = 1; i < N; i++)
+            off[i] = off[i - 1] + size(i - 1);
+        return off;
+    }
+    static constexpr auto stack_off = Offsets<S>([](size_t i) { return G.stages[i].stack_words; });
+    static constexpr auto queue_off = Offsets<Q>([](size_t i) { return G.queues[i].depth * G.queues[i].item_sz; });
+
+    static inline std::array<uint32_t, StackWords(G)> stacks;
+    static inline std::array<osStaticThreadDef_t, S> tcbs;
+    static inline std::array<uint8_t, QueueBytes(G)> qbufs;
+    static inline std::array<osStaticMessageQDef_t, Q> qcbs;
+
+public:
+    static constexpr uint32_t kStaticBytes =
+        (uint32_t)(sizeof(stacks) + sizeof(tcbs) + sizeof(qbufs) + sizeof(qcbs));
+
+    static inline std::array<osThreadId, S> threads;
+    static inline std::array<osMessageQId, Q> queues;
+
+    // 큐를 먼저 (태스크가 시작하자마자 쓸 수 있게). def 는 생성 중에만 읽히므로 스택에 둬도 됨
+    static void Create()
+    {
+        for (size_t i = 0; i < Q; i++) {
+            const Queue &q = G.queues[i];
+            osMessageQDef_t def = { q.depth, q.item_sz, &qbufs[queue_off[i]], &qcbs[i] };
+            queues[i] = osMessageCreate(&def, NULL);
+        }
+        for (size_t i = 0; i < S; i++) {
+            const Stage &s = G.stages[i];
+            osThreadDef_t def = { const_cast<char *>(s.name), s.fn, s.prio, 0, s.stack_words,
+                                  &stacks[stack_off[i]], &tcbs[i] };
+            threads[i] = osThreadCreate(&def, NULL);
+        }
+    }
+};
+
+} // namespace tg
+
+// task_graph.h 의 C 함수들. 그래프 TU 에서 한 번
+#define TASK_GRAPH_EXPORT(graph)                                                                       \
+    using TaskGraphInstance = tg::Instance<graph>;                                                     \
+    extern "C" void TaskGraph_Create(void) { TaskGraphInstance::Create(); }                            \
+    extern "C" uint32_t TaskGraph_TaskCount(void) { return (uint32_t)graph.stages.size(); }            \
+    extern "C" uint32_t TaskGraph_QueueCount(void) { return (uint32_t)graph.queues.size(); }           \
+    extern "C" osThreadId TaskGraph_Thread(uint32_t i)                                                 \
+    {                                                                                                  \
+        return i < graph.stages.size() ? TaskGraphInstance::threads[i] : NULL;                         \
+    }                                                                                                  \
+    extern "C" osMessageQId TaskGraph_Queue(uint32_t i)                                                \
+    {                                                                                                  \
+        return i < graph.queues.size() ? TaskGraphInstance::queues[i] : NULL;                          \
+    }                                                                                                  \
+    extern "C" const char *TaskGraph_TaskName(uint32_t i)                                              \
+    {                                                                                                  \
+        return i < graph.stages.size() ? graph.stages[i].name : NULL;                                  \
+    }                                                                                                  \
+    extern "C" const char *TaskGraph_QueueName(uint32_t i)                                             \
+    {                                                                                                  \
+        return i < graph.queues.size() ? graph.queues[i].name : NULL;                                  \
+    }                                                                                                  \
+    extern "C" uint32_t TaskGraph_StackWords(uint32_t i)                                               \
+    {                                                                                                  \
+        return i < graph.stages.size() ? graph.stages[i].stack_words : 0;                              \
+    }                                                                                                  \
+    extern "C" uint32_t TaskGraph_StaticBytes(void) { return TaskGraphInstance::kStaticBytes; }
+
+#endif